@@ -0,0 +1,171 @@
+#include "cwCommon.h"
+#include "cwLog.h"
+#include "cwCommonImpl.h"
+#include "cwTest.h"
+#include "cwMem.h"
+#include "cwTime.h"
+#include "cwMath.h"
+#include "cwVectOps.h"
+#include "cwDspTypes.h"
+#include "cwDsp.h"
+#include "cwFFT.h"
+
+using namespace cw;
+using namespace cw::dsp;
+
+// Time a real forward/inverse FFT pair with the native FFT and, when it is linked, with FFTW.
+//
+// Usage: fft_bench {<iter_cnt>}
+
+namespace
+{
+  template< typename T >
+  double _time_native( unsigned n, unsigned iterN, const T* xV, T* wV, std::complex<T>* cV, T* yV )
+  {
+    native_fft::plan_str<T>* p = native_fft::create<T>(n);
+
+    for(unsigned i=0; i<iterN/10+1; ++i)
+    {
+      memcpy(wV,xV,n*sizeof(T));
+      native_fft::exec_r2c(p,wV,cV);
+      native_fft::exec_c2r(p,cV,yV);
+    }
+
+    time::spec_t t0 = time::current_time();
+
+    for(unsigned i=0; i<iterN; ++i)
+    {
+      memcpy(wV,xV,n*sizeof(T));
+      native_fft::exec_r2c(p,wV,cV);
+      native_fft::exec_c2r(p,cV,yV);
+    }
+
+    double ns = (double)time::elapsedNanos(t0,time::current_time()) / iterN;
+
+    native_fft::destroy(p);
+    return ns;
+  }
+
+#ifdef cwFFTW
+  template< typename T >
+  double _time_fftw( unsigned n, unsigned iterN, const T* xV, T* wV, std::complex<T>* cV, T* yV )
+  {
+    double ns = 0;
+
+    if constexpr (std::is_same<T,float>::value)
+    {
+      fftwf_plan r2c = fftwf_plan_dft_r2c_1d((int)n, wV, reinterpret_cast<fftwf_complex*>(cV), FFTW_MEASURE);
+      fftwf_plan c2r = fftwf_plan_dft_c2r_1d((int)n, reinterpret_cast<fftwf_complex*>(cV), yV, FFTW_MEASURE);
+
+      for(unsigned i=0; i<iterN/10+1; ++i)
+      {
+        memcpy(wV,xV,n*sizeof(T));
+        fftwf_execute(r2c);
+        fftwf_execute(c2r);
+      }
+
+      time::spec_t t0 = time::current_time();
+
+      for(unsigned i=0; i<iterN; ++i)
+      {
+        memcpy(wV,xV,n*sizeof(T));
+        fftwf_execute(r2c);
+        fftwf_execute(c2r);
+      }
+
+      ns = (double)time::elapsedNanos(t0,time::current_time()) / iterN;
+
+      fftwf_destroy_plan(r2c);
+      fftwf_destroy_plan(c2r);
+    }
+    else
+    {
+      fftw_plan r2c = fftw_plan_dft_r2c_1d((int)n, wV, reinterpret_cast<fftw_complex*>(cV), FFTW_MEASURE);
+      fftw_plan c2r = fftw_plan_dft_c2r_1d((int)n, reinterpret_cast<fftw_complex*>(cV), yV, FFTW_MEASURE);
+
+      for(unsigned i=0; i<iterN/10+1; ++i)
+      {
+        memcpy(wV,xV,n*sizeof(T));
+        fftw_execute(r2c);
+        fftw_execute(c2r);
+      }
+
+      time::spec_t t0 = time::current_time();
+
+      for(unsigned i=0; i<iterN; ++i)
+      {
+        memcpy(wV,xV,n*sizeof(T));
+        fftw_execute(r2c);
+        fftw_execute(c2r);
+      }
+
+      ns = (double)time::elapsedNanos(t0,time::current_time()) / iterN;
+
+      fftw_destroy_plan(r2c);
+      fftw_destroy_plan(c2r);
+    }
+
+    return ns;
+  }
+#endif
+
+  template< typename T >
+  void _bench( const char* type_label, unsigned iterN )
+  {
+    for(unsigned n=64; n<=16384; n*=2)
+    {
+      // the iteration count is scaled so that each size runs for about the same time
+      unsigned         itN = std::max(10u,(unsigned)(((unsigned long long)iterN*64)/n));
+      T*               xV  = (T*)fftw_malloc(n*sizeof(T));
+      T*               wV  = (T*)fftw_malloc(n*sizeof(T));
+      T*               yV  = (T*)fftw_malloc(n*sizeof(T));
+      std::complex<T>* cV  = (std::complex<T>*)fftw_malloc((n/2+1)*sizeof(std::complex<T>));
+
+      for(unsigned i=0; i<n; ++i)
+        xV[i] = (T)std::sin(0.01*i);
+
+      double native_ns = _time_native(n,itN,xV,wV,cV,yV);
+
+#ifdef cwFFTW
+      double fftw_ns   = _time_fftw(n,itN,xV,wV,cV,yV);
+      printf("%-6s %6i native:%10.1f ns fftw:%10.1f ns native/fftw:%6.2f\n",type_label,n,native_ns,fftw_ns,fftw_ns>0 ? native_ns/fftw_ns : 0.0);
+#else
+      printf("%-6s %6i native:%10.1f ns\n",type_label,n,native_ns);
+#endif
+
+      fftw_free(xV);
+      fftw_free(wV);
+      fftw_free(yV);
+      fftw_free(cV);
+    }
+  }
+}
+
+int main( int argc, char** argv )
+{
+  unsigned iterN = 20000;
+  cw::log::log_args_t log_args;
+
+  init_minimum_args( log_args );
+
+  cw::log::createGlobal(log_args);
+
+  if( argc > 1 )
+    iterN = (unsigned)atoi(argv[1]);
+
+  if( iterN == 0 )
+  {
+    printf("Usage: fft_bench {<iter_cnt>}\n");
+    cw::log::destroyGlobal();
+    return 1;
+  }
+
+  printf("Forward and inverse real FFT pair. iterations at n=64:%i\n",iterN);
+
+  _bench<float>( "float", iterN);
+  _bench<double>("double",iterN);
+
+  cw::log::destroyGlobal();
+
+  return 0;
+}
@@ -0,0 +1,66 @@
+#include "cwCommon.h"
+#include "cwLog.h"
+#include "cwCommonImpl.h"
+#include "cwTest.h"
+#include "cwMem.h"
+#include "cwText.h"
+#include "cwObject.h"
+#include "cwFlowBench.h"
+
+using namespace cw;
+
+int main( int argc, char** argv )
+{
+  
+  rc_t rc = kOkRC;
+  object_t* cfg = nullptr;
+  object_t* obj = nullptr;
+  cw::log::log_args_t log_args;
+
+  init_minimum_args( log_args );
+
+  cw::log::createGlobal(log_args);
+  
+  if( argc < 2 )
+  {
+    printf("Usage: flow_bench <cfg_file> {<out_json_file>}\n");
+    rc = kSyntaxErrorRC;
+    goto errLabel;
+  }
+
+  if((rc = objectFromFile( argv[1], cfg )) != kOkRC )
+  {
+    printf("The configuration could not be read from the file '%s'.",cwStringNullGuard(argv[1]));
+    goto errLabel;
+  }
+
+  // the optional second argument overrides the cfg. 'out_fname'
+  if( argc > 2 )
+  {
+    if((obj = cfg->find("out_fname")) != nullptr )
+    {
+      obj = obj->parent;
+      obj->unlink();
+      obj->free();
+    }
+
+    newPairObject("out_fname",argv[2],cfg);
+  }
+
+  if((rc = flow::bench::run(cfg)) != kOkRC )
+  {
+    printf("The 'flow_bench' application reported an error '%i' on exit.",rc);
+    goto errLabel;
+  }
+
+
+errLabel:
+
+  if( cfg != nullptr )
+      cfg->free();
+
+  cw::log::destroyGlobal();
+  
+  return rc == kOkRC ? 0 : 1;
+  
+}
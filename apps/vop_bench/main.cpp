@@ -0,0 +1,120 @@
+#include "cwCommon.h"
+#include "cwLog.h"
+#include "cwCommonImpl.h"
+#include "cwTest.h"
+#include "cwMem.h"
+#include "cwTime.h"
+#include "cwVectOps.h"
+
+using namespace cw;
+
+// Time the float and double vop kernels for each instruction set supported by this CPU.
+//
+// Usage: vop_bench {<frame_cnt> {<iter_cnt>}}
+
+namespace
+{
+  volatile double g_sink = 0;  // prevents the compiler from discarding the benchmarked calls
+
+  enum { kMulOpId, kMulScalarOpId, kAddOpId, kScaleAddOpId, kMacOpId, kSumOpId, kSumSqOpId, kInterleaveOpId, kDeinterleaveOpId, kOpCnt };
+
+  const char* _op_labels[] = { "mul", "mul_scalar", "add", "scale_add", "mac", "sum", "sum_sq", "interleave", "deinterleave" };
+
+  template< typename T >
+  void _exec( unsigned op_id, T* y, const T* x0, const T* x1, unsigned n )
+  {
+    switch( op_id )
+    {
+      case kMulOpId:          vop::mul(y,x0,x1,n);                     break;
+      case kMulScalarOpId:    vop::mul(y,x0,(T)0.5,n);                 break;
+      case kAddOpId:          vop::add(y,x0,x1,n);                     break;
+      case kScaleAddOpId:     vop::scale_add(y,x0,(T)0.5,x1,(T)0.25,n); break;
+      case kMacOpId:          g_sink = g_sink + vop::mac(x0,x1,n);     break;
+      case kSumOpId:          g_sink = g_sink + vop::sum(x0,n);        break;
+      case kSumSqOpId:        g_sink = g_sink + vop::sum_sq(x0,n);     break;
+      case kInterleaveOpId:   vop::interleave(y,x0,n/2,2);             break;
+      case kDeinterleaveOpId: vop::deinterleave(y,x0,n/2,2);           break;
+    }
+  }
+
+  template< typename T >
+  void _bench( const char* type_label, unsigned frameN, unsigned iterN )
+  {
+    vop::simd::isa_id_t max_isa_id = vop::simd::detect_isa();
+
+    T* x0 = mem::allocZ<T>(frameN);
+    T* x1 = mem::allocZ<T>(frameN);
+    T* y  = mem::allocZ<T>(frameN);
+
+    for(unsigned i=0; i<frameN; ++i)
+    {
+      x0[i] = (T)std::sin(0.01*i);
+      x1[i] = (T)std::cos(0.01*i);
+    }
+
+    for(unsigned op_id=0; op_id<kOpCnt; ++op_id)
+    {
+      double scalar_ns = 0;
+
+      for(unsigned isa_id=vop::simd::kScalarIsaId; isa_id<=max_isa_id; ++isa_id)
+      {
+        vop::simd::set_isa((vop::simd::isa_id_t)isa_id);
+
+        // warm up the cache and the branch predictor
+        for(unsigned i=0; i<iterN/10+1; ++i)
+          _exec(op_id,y,x0,x1,frameN);
+
+        time::spec_t t0 = time::current_time();
+
+        for(unsigned i=0; i<iterN; ++i)
+          _exec(op_id,y,x0,x1,frameN);
+
+        double ns = (double)time::elapsedNanos(t0,time::current_time()) / iterN;
+
+        if( isa_id == vop::simd::kScalarIsaId )
+          scalar_ns = ns;
+
+        printf("%-6s %-12s %-6s %10.1f ns/call %7.2f x\n",type_label,_op_labels[op_id],vop::simd::isa_label((vop::simd::isa_id_t)isa_id),ns,ns>0 ? scalar_ns/ns : 0.0);
+      }
+    }
+
+    vop::simd::set_isa(max_isa_id);
+
+    mem::release(x0);
+    mem::release(x1);
+    mem::release(y);
+  }
+}
+
+int main( int argc, char** argv )
+{
+  unsigned frameN = 256;
+  unsigned iterN  = 100000;
+  cw::log::log_args_t log_args;
+
+  init_minimum_args( log_args );
+
+  cw::log::createGlobal(log_args);
+
+  if( argc > 1 )
+    frameN = (unsigned)atoi(argv[1]);
+
+  if( argc > 2 )
+    iterN = (unsigned)atoi(argv[2]);
+
+  if( frameN == 0 || iterN == 0 )
+  {
+    printf("Usage: vop_bench {<frame_cnt> {<iter_cnt>}}\n");
+    cw::log::destroyGlobal();
+    return 1;
+  }
+
+  printf("frames:%i iterations:%i cpu:%s\n",frameN,iterN,vop::simd::isa_label(vop::simd::detect_isa()));
+
+  _bench<float>( "float", frameN,iterN);
+  _bench<double>("double",frameN,iterN);
+
+  cw::log::destroyGlobal();
+
+  return 0;
+}
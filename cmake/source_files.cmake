@@ -9,7 +9,7 @@ list( APPEND CORE_HDR_FILES  core/cwText.h   core/cwTextBuf.h )
 list( APPEND CORE_SRC_FILES  core/cwText.cpp core/cwTextBuf.cpp )
 
 list( APPEND CORE_HDR_FILES core/cwMath.h   core/cwVectOps.h )
-list( APPEND CORE_SRC_FILES core/cwMath.cpp core/cwVectOps.cpp )
+list( APPEND CORE_SRC_FILES core/cwMath.cpp core/cwVectOps.cpp core/cwVectOpsKernels.h )
 
 list( APPEND CORE_HDR_FILES core/cwB23Tree.h   core/cwMtx.h   core/cwVariant.h )
 list( APPEND CORE_SRC_FILES core/cwB23Tree.cpp core/cwMtx.cpp core/cwVariant.cpp)
@@ -71,8 +71,8 @@ list( APPEND IO_SRC_FILES io/cwIo.cpp )
 
 #-------------------------------------
 # flow source files
-set(  FLOW_HDR_FILES flow/cwFlowDecl.h flow/cwFlowValue.h   flow/cwFlowTypes.h   flow/cwFlowNet.h   flow/cwFlow.h   flow/cwFlowPerf.h   flow/cwFlowProc.h   flow/cwFlowGutim.h   flow/cwFlowTest.h )
-set(  FLOW_SRC_FILES                   flow/cwFlowValue.cpp flow/cwFlowTypes.cpp flow/cwFlowNet.cpp flow/cwFlow.cpp flow/cwFlowPerf.cpp flow/cwFlowProc.cpp flow/cwFlowGutim.cpp flow/cwFlowTest.cpp)
+set(  FLOW_HDR_FILES flow/cwFlowDecl.h flow/cwFlowValue.h   flow/cwFlowTypes.h   flow/cwFlowNet.h   flow/cwFlow.h   flow/cwFlowPerf.h   flow/cwFlowProc.h   flow/cwFlowGutim.h   flow/cwFlowTest.h flow/cwFlowBatch.h flow/cwFlowBench.h flow/cwFlowSwap.h )
+set(  FLOW_SRC_FILES                   flow/cwFlowValue.cpp flow/cwFlowTypes.cpp flow/cwFlowNet.cpp flow/cwFlow.cpp flow/cwFlowPerf.cpp flow/cwFlowProc.cpp flow/cwFlowGutim.cpp flow/cwFlowTest.cpp flow/cwFlowBatch.cpp flow/cwFlowBench.cpp flow/cwFlowSwap.cpp)
 
 
 #-------------------------------------
@@ -827,6 +827,329 @@ namespace cw
       
     } 
 
+    //---------------------------------------------------------------------------------------------------------------------------------
+    // Multi-channel Phase Vocoder (Analysis)
+    //
+    // Equivalent to 'chN' pv_anl objects with identical parameters.
+    // Every channel must receive the same count of samples on each call to exec()
+    // so that the channels produce frames together. The frames of all channels are
+    // windowed directly into the FFT input buffers and transformed with one batched FFT.
+    
+    namespace multi_ch_pv_anl
+    {
+      template< typename T0, typename T1 >
+      struct obj_str
+      {
+        unsigned                          chN;
+        struct shift_buf::obj_str<T0>**   sbA;  // sbA[chN]
+        struct wnd_func::obj_str<T0>*     wf;   // window shared by all channels
+        struct multi_ch_fft::obj_str<T1>* ft;
+        struct phs_to_frq::obj_str<T1>**  pfA;  // pfA[chN]
+        
+        unsigned               flags;           // pv_anl::kCalcHzPvaFl
+        unsigned               procSmpCnt;
+        T1                     srate;
+        
+        unsigned               maxWndSmpCnt;
+        unsigned               maxBinCnt;
+        
+        unsigned               wndSmpCnt;
+        unsigned               hopSmpCnt;
+        unsigned               binCnt;
+      };
+
+      template< typename T0, typename T1 >
+      rc_t destroy( struct obj_str<T0,T1>*& p );
+      
+      template< typename T0, typename T1 >
+      rc_t create( struct obj_str<T0,T1>*& p, unsigned chN, unsigned procSmpCnt, const T1& srate, unsigned maxWndSmpCnt, unsigned wndSmpCnt, unsigned hopSmpCnt, unsigned flags )
+      {
+        rc_t rc = kOkRC;
+        
+        p = mem::allocZ< struct obj_str<T0,T1> >();
+
+        p->chN          = chN;
+        p->sbA          = mem::allocZ< struct shift_buf::obj_str<T0>* >(chN);
+        p->pfA          = mem::allocZ< struct phs_to_frq::obj_str<T1>* >(chN);
+        p->flags        = flags;
+        p->procSmpCnt   = procSmpCnt;
+        p->srate        = srate;
+        p->maxWndSmpCnt = maxWndSmpCnt;
+        p->maxBinCnt    = window_sample_count_to_bin_count(maxWndSmpCnt);
+        p->wndSmpCnt    = wndSmpCnt;
+        p->hopSmpCnt    = hopSmpCnt;
+        p->binCnt       = p->maxBinCnt;
+
+        if((rc = multi_ch_fft::create( p->ft, chN, maxWndSmpCnt, FFT::kToPolarFl )) != kOkRC )
+          goto errLabel;
+        
+        if((rc = wnd_func::create( p->wf, wnd_func::kHannWndId | wnd_func::kNormByLengthWndFl, maxWndSmpCnt, wndSmpCnt, 0 )) != kOkRC )
+          goto errLabel;
+        
+        for(unsigned i=0; i<chN; ++i)
+        {
+          if((rc = shift_buf::create( p->sbA[i], procSmpCnt, maxWndSmpCnt, wndSmpCnt, hopSmpCnt )) != kOkRC )
+            goto errLabel;
+          
+          if((rc = phs_to_frq::create( p->pfA[i], srate, p->binCnt, hopSmpCnt )) != kOkRC )
+            goto errLabel;
+        }
+
+      errLabel:
+        if( rc != kOkRC )
+        {
+          rc = cwLogError(rc,"Multi-channel PV analysis create failed.");
+          destroy(p);
+        }
+        
+        return rc;
+      }
+
+      template< typename T0, typename T1 >
+      rc_t destroy( struct obj_str<T0,T1>*& p )
+      {
+        if( p != nullptr )
+        {
+          for(unsigned i=0; i<p->chN; ++i)
+          {
+            shift_buf::destroy( p->sbA[i] );
+            phs_to_frq::destroy( p->pfA[i] );
+          }
+          
+          wnd_func::destroy( p->wf );
+          multi_ch_fft::destroy( p->ft );
+          mem::release( p->sbA );
+          mem::release( p->pfA );
+          mem::release( p );
+        }
+        return kOkRC;
+      }
+
+      // xA[chN][xN] Returns true if a new frame is available for all channels.
+      template< typename T0, typename T1 >
+      bool exec( struct obj_str<T0,T1>* p, const T0* const* xA, unsigned xN )
+      {
+        bool fl = false;
+        
+        for(;;)
+        {
+          bool readyFl = shift_buf::exec(p->sbA[0],xA[0],xN);
+          
+          for(unsigned i=1; i<p->chN; ++i)
+            if( shift_buf::exec(p->sbA[i],xA[i],xN) != readyFl )
+              assert(0);  // the channels must remain in lock-step
+
+          if( !readyFl )
+            break;
+
+          unsigned        wndN = p->wf->wndN;
+          const T0*       wndV = p->wf->wndV;
+          
+          for(unsigned i=0; i<p->chN; ++i)
+          {
+            const T0* sV = p->sbA[i]->outV;
+            T1*       yV = multi_ch_fft::in(p->ft,i);
+            
+            if constexpr (std::is_same<T0,T1>::value)
+              vop::mul(yV,wndV,sV,wndN);
+            else
+              for(unsigned j=0; j<wndN; ++j)
+                yV[j] = (T1)(wndV[j] * sV[j]);
+            
+            // zero pad to the FFT length
+            if( wndN < p->ft->inN )
+              memset(yV + wndN, 0, sizeof(T1) * (p->ft->inN-wndN) );
+          }
+
+          multi_ch_fft::exec(p->ft);
+
+          if( cwIsFlag(p->flags,pv_anl::kCalcHzPvaFl) )
+            for(unsigned i=0; i<p->chN; ++i)
+              phs_to_frq::exec(p->pfA[i],multi_ch_fft::phase(p->ft,i));
+
+          fl = true;
+        }
+
+        return fl;
+      }
+
+      template< typename T0, typename T1 >
+      rc_t set_window_length( struct obj_str<T0,T1>* p, unsigned wndSmpCnt )
+      {
+        rc_t rc = kOkRC;
+        
+        for(unsigned i=0; i<p->chN; ++i)
+          if((rc = shift_buf::set_window_sample_count( p->sbA[i], wndSmpCnt )) != kOkRC )
+            return rc;
+        
+        if((rc = wnd_func::set_window_sample_count( p->wf, wndSmpCnt )) == kOkRC )
+          p->wndSmpCnt = wndSmpCnt;
+          
+        return rc;
+      }
+
+      // Amplitude (not power) spectrum, phase and (when kCalcHzPvaFl is set) frequency of channel 'ch'.
+      template< typename T0, typename T1 >
+      const T1* magn( struct obj_str<T0,T1>* p, unsigned ch ) { return multi_ch_fft::magn(p->ft,ch); }
+
+      template< typename T0, typename T1 >
+      const T1* phase( struct obj_str<T0,T1>* p, unsigned ch ) { return multi_ch_fft::phase(p->ft,ch); }
+
+      template< typename T0, typename T1 >
+      const T1* hz( struct obj_str<T0,T1>* p, unsigned ch ) { return p->pfA[ch]->hzV; }
+    }
+    
+    //---------------------------------------------------------------------------------------------------------------------------------
+    // Multi-channel Phase Vocoder (Synthesis)
+    //
+    // Equivalent to 'chN' pv_syn objects with identical parameters.
+    // The spectra of all channels are inverse transformed with one batched IFFT.
+    
+    namespace multi_ch_pv_syn
+    {
+      template< typename T0, typename T1 >
+      struct obj_str
+      {
+        unsigned                           chN;
+        struct multi_ch_ifft::obj_str<T1>* ft;
+        struct ola::obj_str<T0>**          olaA;    // olaA[chN]
+        
+        T1*                    itrV;    // itrV[binCnt] shared by all channels
+        T1*                    phs0V;   // phs0V[chN*binCnt]
+        T1*                    phsV;    // phsV[chN*binCnt]
+        T0*                    cvtV;    // cvtV[wndSmpCnt] - only used when T0 and T1 differ
+        
+        double                 outSrate;
+        unsigned               procSmpCnt;
+        unsigned               wndSmpCnt;
+        unsigned               hopSmpCnt;
+        unsigned               binCnt;
+      };
+
+      template< typename T0, typename T1 >
+      rc_t destroy( struct obj_str<T0,T1>*& p );
+      
+      template< typename T0, typename T1 >
+      rc_t create( struct obj_str<T0,T1>*& p, unsigned chN, unsigned procSmpCnt, const T1& outSrate, unsigned wndSmpCnt, unsigned hopSmpCnt, unsigned wndTypeId=wnd_func::kHannWndId )
+      {
+        rc_t rc = kOkRC;
+        
+        p = mem::allocZ< struct obj_str<T0,T1> >();
+
+        double twoPi = 2.0 * M_PI;
+
+        p->chN        = chN;
+        p->outSrate   = outSrate;
+        p->procSmpCnt = procSmpCnt;
+        p->wndSmpCnt  = wndSmpCnt;
+        p->hopSmpCnt  = hopSmpCnt;
+        p->binCnt     = wndSmpCnt / 2 + 1;
+        p->olaA       = mem::allocZ< struct ola::obj_str<T0>* >(chN);
+        p->itrV       = mem::allocZ<T1>( p->binCnt );
+        p->phs0V      = mem::allocZ<T1>( chN * p->binCnt );
+        p->phsV       = mem::allocZ<T1>( chN * p->binCnt );
+
+        if( !std::is_same<T0,T1>::value )
+          p->cvtV = mem::allocZ<T0>( wndSmpCnt );
+
+        if((rc = multi_ch_ifft::create( p->ft, chN, p->binCnt )) != kOkRC )
+          goto errLabel;
+        
+        for(unsigned i=0; i<chN; ++i)
+          if((rc = ola::create( p->olaA[i], wndSmpCnt, hopSmpCnt, procSmpCnt, wndTypeId )) != kOkRC )
+            goto errLabel;
+        
+        // complete revolutions per hop in radians
+        for(unsigned k=0; k<p->binCnt; ++k)
+          p->itrV[k] = twoPi * floor((double)k * hopSmpCnt / wndSmpCnt ); 
+
+      errLabel:
+        if( rc != kOkRC )
+        {
+          rc = cwLogError(rc,"Multi-channel PV synthesis create failed.");
+          destroy(p);
+        }
+
+        return rc;  
+      }
+      
+      template< typename T0, typename T1 >
+      rc_t destroy( struct obj_str<T0,T1>*& p )
+      {
+        if( p != nullptr )
+        {
+          for(unsigned i=0; i<p->chN; ++i)
+            ola::destroy(p->olaA[i]);
+          
+          multi_ch_ifft::destroy(p->ft);
+
+          mem::release(p->olaA);
+          mem::release(p->itrV);
+          mem::release(p->phs0V);
+          mem::release(p->phsV);
+          mem::release(p->cvtV);
+          mem::release( p );
+        }
+        return kOkRC;
+      }
+
+      // magA[chN][binCnt],phsA[chN][binCnt]
+      // Only the channels whose readyFlA[] flag is set are synthesized. Set readyFlA to nullptr to synthesize all channels.
+      template< typename T0, typename T1 >
+      rc_t exec( struct obj_str<T0,T1>* p, const T1* const* magA, const T1* const* phsA, const bool* readyFlA=nullptr )
+      {
+        double   twoPi = 2.0 * M_PI;
+        unsigned n     = 0;
+
+        for(unsigned i=0; i<p->chN; ++i)
+          if( readyFlA==nullptr || readyFlA[i] )
+          {
+            const T1* inPhsV = phsA[i];
+            T1*       phs0V  = p->phs0V + i*p->binCnt;
+            T1*       phsV   = p->phsV  + i*p->binCnt;
+            
+            for(unsigned k=0; k<p->binCnt; ++k)
+            {
+              // See pv_syn::exec()
+              T1 dev = inPhsV[k] - phs0V[k] - p->itrV[k];
+
+              while( dev >  M_PI ) dev -= (T1)twoPi;
+              while( dev < -M_PI ) dev += (T1)twoPi;
+
+              phsV[k]  = phs0V[k] + p->itrV[k] + dev;
+              phs0V[k] = inPhsV[k];
+            }
+
+            multi_ch_ifft::set_polar(p->ft, i, magA[i], phsV );
+            ++n;
+          }
+
+        if( n == 0 )
+          return kOkRC;
+        
+        // Synthesize the time signal of every channel
+        multi_ch_ifft::exec( p->ft );
+
+        for(unsigned i=0; i<p->chN; ++i)
+          if( readyFlA==nullptr || readyFlA[i] )
+          {
+            if constexpr (std::is_same<T0,T1>::value)
+              ola::exec( p->olaA[i], multi_ch_ifft::out(p->ft,i), p->ft->outN );
+            else
+            {
+              vop::copy( p->cvtV, multi_ch_ifft::out(p->ft,i), p->ft->outN );
+              ola::exec( p->olaA[i], p->cvtV, p->ft->outN );
+            }
+          }
+        
+        return kOkRC;
+      }
+
+      // Returns the next procSmpCnt output samples of channel 'ch' or nullptr if none are available.
+      template< typename T0, typename T1 >
+      const T0* execOut( struct obj_str<T0,T1>* p, unsigned ch ) { return ola::execOut(p->olaA[ch]); }
+    }
+
     
     //---------------------------------------------------------------------------------------------------------------------------------
     // Spectral Distortion
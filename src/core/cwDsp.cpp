@@ -10,12 +10,335 @@
 #include "cwDspTypes.h"
 #include "cwDsp.h"
 #include "cwText.h"
+#include "cwFile.h"
+#include "cwFileSys.h"
 
+#include <pthread.h>
+
+
+//----------------------------------------------------------------------------------------------------------------------
+//  fft_plan
+//
+
+namespace cw
+{
+  namespace dsp
+  {
+    namespace fft_plan
+    {
+      enum { kR2cPlanId, kC2rPlanId };
+
+      typedef struct plan_str
+      {
+        unsigned         n;
+        unsigned         howN;     // count of signals per execution
+        unsigned         rDist;    // distance between real signals
+        unsigned         cDist;    // distance between complex signals
+        unsigned         dirId;    // kR2cPlanId or kC2rPlanId
+        bool             float_fl;
+        unsigned         refCnt;
+        union
+        {
+          fftw_plan  dplan;
+          fftwf_plan fplan;
+        } u;
+        struct plan_str* link;
+      } plan_t;
+
+      // The FFTW planner is not thread-safe. All planning and all access to the plan list happens under this lock.
+      pthread_mutex_t g_mutex       = PTHREAD_MUTEX_INITIALIZER;
+      plan_t*         g_planL       = nullptr;
+      bool            g_new_plan_fl = false;   // set when a plan is created which was not in the cache
+
+      thread_local effort_t g_effort_id = kPatientEffortId;
+
+      idLabelPair_t effortLabelA[] = {
+        { kEstimateEffortId,   "estimate"   },
+        { kMeasureEffortId,    "measure"    },
+        { kPatientEffortId,    "patient"    },
+        { kExhaustiveEffortId, "exhaustive" },
+        { kInvalidEffortId,    nullptr      }
+      };
+
+      unsigned _effort_flags()
+      {
+        switch( g_effort_id )
+        {
+          case kEstimateEffortId:   return FFTW_ESTIMATE;
+          case kMeasureEffortId:    return FFTW_MEASURE;
+          case kExhaustiveEffortId: return FFTW_EXHAUSTIVE;
+          default:
+            break;
+        }
+        return FFTW_PATIENT;
+      }
+
+      // Return a cached plan with an incremented reference count or nullptr if no matching plan exists.
+      plan_t* _find( unsigned n, unsigned howN, unsigned rDist, unsigned cDist, unsigned dirId, bool float_fl )
+      {
+        for(plan_t* p=g_planL; p!=nullptr; p=p->link)
+          if( p->n==n && p->howN==howN && p->rDist==rDist && p->cDist==cDist && p->dirId==dirId && p->float_fl==float_fl )
+          {
+            p->refCnt += 1;
+            return p;
+          }
+        return nullptr;
+      }
+
+      plan_t* _insert( unsigned n, unsigned howN, unsigned rDist, unsigned cDist, unsigned dirId, bool float_fl )
+      {
+        plan_t* p   = mem::allocZ<plan_t>();
+        p->n        = n;
+        p->howN     = howN;
+        p->rDist    = rDist;
+        p->cDist    = cDist;
+        p->dirId    = dirId;
+        p->float_fl = float_fl;
+        p->refCnt   = 1;
+        p->link     = g_planL;
+        g_planL     = p;
+        g_new_plan_fl = true;
+        return p;
+      }
+
+      template< typename T >
+      void _release( T plan, bool float_fl )
+      {
+        plan_t* p0 = nullptr;
+
+        pthread_mutex_lock(&g_mutex);
+
+        for(plan_t* p=g_planL; p!=nullptr; p=p->link)
+        {
+          if( p->float_fl==float_fl && (float_fl ? (void*)p->u.fplan==(void*)plan : (void*)p->u.dplan==(void*)plan) )
+          {
+            if( --p->refCnt == 0 )
+            {
+              if( p0 == nullptr )
+                g_planL = p->link;
+              else
+                p0->link = p->link;
+
+              if( float_fl )
+                fftwf_destroy_plan(p->u.fplan);
+              else
+                fftw_destroy_plan(p->u.dplan);
+
+              mem::release(p);
+            }
+            break;
+          }
+          p0 = p;
+        }
+
+        pthread_mutex_unlock(&g_mutex);
+      }
+    }
+  }
+}
+
+cw::dsp::fft_plan::effort_t cw::dsp::fft_plan::effort_from_label( const char* label )
+{
+  unsigned id;
+  if( label==nullptr || (id = labelToId(effortLabelA,label,kInvalidEffortId)) == kInvalidEffortId )
+    return kInvalidEffortId;
+  return (effort_t)id;
+}
+
+const char* cw::dsp::fft_plan::effort_label( effort_t effort_id )
+{ return idToLabel(effortLabelA,effort_id,kInvalidEffortId); }
+
+cw::dsp::fft_plan::effort_t cw::dsp::fft_plan::set_effort( effort_t effort_id )
+{
+  effort_t prev_id = g_effort_id;
+  if( effort_id < kInvalidEffortId )
+    g_effort_id = effort_id;
+  return prev_id;
+}
+
+cw::dsp::fft_plan::effort_t cw::dsp::fft_plan::effort()
+{ return g_effort_id; }
+
+cw::rc_t cw::dsp::fft_plan::load_wisdom( const char* fname )
+{
+  rc_t  rc  = kOkRC;
+  char* buf = nullptr;
+  char* fbuf;
+
+  if( fname == nullptr || !filesys::isFile(fname) )
+    return kOkRC;
+
+  if((buf = file::fnToStr(fname,nullptr)) == nullptr )
+  {
+    rc = cwLogError(kReadFailRC,"The FFTW wisdom file '%s' could not be read.",fname);
+    goto errLabel;
+  }
+
+  // The file holds the double precision wisdom followed by the single precision wisdom.
+  if((fbuf = strstr(buf,"(fftw-")) != nullptr )
+    if((fbuf = strstr(fbuf+1,"(fftw-")) != nullptr )
+      fbuf[-1] = 0;
+
+  pthread_mutex_lock(&g_mutex);
+
+  if( fftw_import_wisdom_from_string(buf) == 0 || (fbuf != nullptr && fftwf_import_wisdom_from_string(fbuf) == 0) )
+    rc = cwLogError(kSyntaxErrorRC,"The FFTW wisdom file '%s' could not be parsed.",fname);
+
+  g_new_plan_fl = false;
+
+  pthread_mutex_unlock(&g_mutex);
+
+errLabel:
+  mem::release(buf);
+  return rc;
+}
+
+cw::rc_t cw::dsp::fft_plan::save_wisdom( const char* fname, bool force_fl )
+{
+  rc_t  rc   = kOkRC;
+  char* dbuf = nullptr;
+  char* fbuf = nullptr;
+  char* buf  = nullptr;
+
+  if( fname == nullptr )
+    return kOkRC;
+
+  pthread_mutex_lock(&g_mutex);
+
+  if( force_fl || g_new_plan_fl || !filesys::isFile(fname) )
+  {
+    dbuf = fftw_export_wisdom_to_string();
+    fbuf = fftwf_export_wisdom_to_string();
+
+    // the native FFT has no wisdom
+    if( dbuf == nullptr && fbuf == nullptr )
+      goto errLabel;
+
+    buf  = mem::printf(buf,"%s\n%s",dbuf==nullptr ? "" : dbuf, fbuf==nullptr ? "" : fbuf);
+
+    if((rc = file::fnWrite(fname,buf,textLength(buf))) != kOkRC )
+      rc = cwLogError(rc,"The FFTW wisdom file '%s' could not be written.",fname);
+    else
+      g_new_plan_fl = false;
+  }
+
+errLabel:
+  pthread_mutex_unlock(&g_mutex);
+
+  free(dbuf);
+  free(fbuf);
+  mem::release(buf);
+  return rc;
+}
+
+namespace cw
+{
+  namespace dsp
+  {
+    namespace fft_plan
+    {
+      // Normalize the batch geometry so that equivalent requests share a cache entry.
+      void _batch_args( unsigned n, unsigned& howN, unsigned& rDist, unsigned& cDist )
+      {
+        howN  = std::max(1u,howN);
+        rDist = howN==1 || rDist==0 ? n     : rDist;
+        cDist = howN==1 || cDist==0 ? n/2+1 : cDist;
+      }
+    }
+  }
+}
+
+fftwf_plan cw::dsp::fft_plan::create_r2c( unsigned n, float* inV, std::complex<float>* outV, unsigned howN, unsigned realDist, unsigned cplxDist )
+{
+  _batch_args(n,howN,realDist,cplxDist);
+  pthread_mutex_lock(&g_mutex);
+  plan_t* p;
+  if((p = _find(n,howN,realDist,cplxDist,kR2cPlanId,true)) == nullptr )
+  {
+    int nn     = (int)n;
+    p          = _insert(n,howN,realDist,cplxDist,kR2cPlanId,true);
+    if( howN == 1 )
+      p->u.fplan = fftwf_plan_dft_r2c_1d(nn, inV, reinterpret_cast<fftwf_complex*>(outV), _effort_flags() );
+    else
+      p->u.fplan = fftwf_plan_many_dft_r2c(1, &nn, (int)howN, inV, nullptr, 1, (int)realDist, reinterpret_cast<fftwf_complex*>(outV), nullptr, 1, (int)cplxDist, _effort_flags() );
+  }
+  pthread_mutex_unlock(&g_mutex);
+  return p->u.fplan;
+}
+
+fftw_plan cw::dsp::fft_plan::create_r2c( unsigned n, double* inV, std::complex<double>* outV, unsigned howN, unsigned realDist, unsigned cplxDist )
+{
+  _batch_args(n,howN,realDist,cplxDist);
+  pthread_mutex_lock(&g_mutex);
+  plan_t* p;
+  if((p = _find(n,howN,realDist,cplxDist,kR2cPlanId,false)) == nullptr )
+  {
+    int nn     = (int)n;
+    p          = _insert(n,howN,realDist,cplxDist,kR2cPlanId,false);
+    if( howN == 1 )
+      p->u.dplan = fftw_plan_dft_r2c_1d(nn, inV, reinterpret_cast<fftw_complex*>(outV), _effort_flags() );
+    else
+      p->u.dplan = fftw_plan_many_dft_r2c(1, &nn, (int)howN, inV, nullptr, 1, (int)realDist, reinterpret_cast<fftw_complex*>(outV), nullptr, 1, (int)cplxDist, _effort_flags() );
+  }
+  pthread_mutex_unlock(&g_mutex);
+  return p->u.dplan;
+}
+
+fftwf_plan cw::dsp::fft_plan::create_c2r( unsigned n, std::complex<float>* inV, float* outV, unsigned howN, unsigned realDist, unsigned cplxDist )
+{
+  _batch_args(n,howN,realDist,cplxDist);
+  pthread_mutex_lock(&g_mutex);
+  plan_t* p;
+  if((p = _find(n,howN,realDist,cplxDist,kC2rPlanId,true)) == nullptr )
+  {
+    int nn     = (int)n;
+    p          = _insert(n,howN,realDist,cplxDist,kC2rPlanId,true);
+    if( howN == 1 )
+      p->u.fplan = fftwf_plan_dft_c2r_1d(nn, reinterpret_cast<fftwf_complex*>(inV), outV, FFTW_BACKWARD | _effort_flags() );
+    else
+      p->u.fplan = fftwf_plan_many_dft_c2r(1, &nn, (int)howN, reinterpret_cast<fftwf_complex*>(inV), nullptr, 1, (int)cplxDist, outV, nullptr, 1, (int)realDist, _effort_flags() );
+  }
+  pthread_mutex_unlock(&g_mutex);
+  return p->u.fplan;
+}
+
+fftw_plan cw::dsp::fft_plan::create_c2r( unsigned n, std::complex<double>* inV, double* outV, unsigned howN, unsigned realDist, unsigned cplxDist )
+{
+  _batch_args(n,howN,realDist,cplxDist);
+  pthread_mutex_lock(&g_mutex);
+  plan_t* p;
+  if((p = _find(n,howN,realDist,cplxDist,kC2rPlanId,false)) == nullptr )
+  {
+    int nn     = (int)n;
+    p          = _insert(n,howN,realDist,cplxDist,kC2rPlanId,false);
+    if( howN == 1 )
+      p->u.dplan = fftw_plan_dft_c2r_1d(nn, reinterpret_cast<fftw_complex*>(inV), outV, FFTW_BACKWARD | _effort_flags() );
+    else
+      p->u.dplan = fftw_plan_many_dft_c2r(1, &nn, (int)howN, reinterpret_cast<fftw_complex*>(inV), nullptr, 1, (int)cplxDist, outV, nullptr, 1, (int)realDist, _effort_flags() );
+  }
+  pthread_mutex_unlock(&g_mutex);
+  return p->u.dplan;
+}
+
+void cw::dsp::fft_plan::release( fftwf_plan plan )
+{ _release(plan,true); }
+
+void cw::dsp::fft_plan::release( fftw_plan plan )
+{ _release(plan,false); }
+
+unsigned cw::dsp::fft_plan::plan_count()
+{
+  unsigned n = 0;
+  pthread_mutex_lock(&g_mutex);
+  for(plan_t* p=g_planL; p!=nullptr; p=p->link)
+    ++n;
+  pthread_mutex_unlock(&g_mutex);
+  return n;
+}
 
 //----------------------------------------------------------------------------------------------------------------------
 //  fft
 //
-#ifdef cwFFTW
 
 cw::rc_t cw::dsp::fft::test()
 {
@@ -100,7 +423,6 @@ cw::rc_t cw::dsp::ifft::test()
   return rc;
   
 }
-#endif // cwFFTW
 
 //----------------------------------------------------------------------------------------------------------------------
 //  intel_fft
@@ -352,11 +352,67 @@ namespace cw
 
     
 
-#ifdef cwFFTW    
+    //---------------------------------------------------------------------------------------------------------------------------------
+    // FFT Plan Cache
+    //
+    // FFTW plans are shared process-wide. Transforms with the same size, direction and precision
+    // use one plan which is executed on the caller's arrays with the FFTW new-array execute API.
+    // The arrays must therefore be allocated with fftw_malloc()/fftwf_malloc().
+    //
+    // Wisdom gathered while planning can be saved to a file and loaded on the next run
+    // so that programs do not repeat expensive FFTW_PATIENT planning at startup.
+    //
+    // When FFTW is not linked the plans are native_fft plans (cwFFT.h), the effort is ignored
+    // and no wisdom is produced.
+    //
+    namespace fft_plan
+    {
+      typedef enum
+      {
+        kEstimateEffortId,   // FFTW_ESTIMATE
+        kMeasureEffortId,    // FFTW_MEASURE
+        kPatientEffortId,    // FFTW_PATIENT (default)
+        kExhaustiveEffortId, // FFTW_EXHAUSTIVE
+        kInvalidEffortId
+      } effort_t;
+
+      // Convert between effort labels ("estimate","measure","patient","exhaustive") and id's.
+      // effort_from_label() returns kInvalidEffortId if the label is not recognized.
+      effort_t    effort_from_label( const char* label );
+      const char* effort_label( effort_t effort_id );
+
+      // Set the planning effort used by plans created on the calling thread.
+      // Returns the previous effort. Plans which are already cached are reused regardless of effort.
+      effort_t set_effort( effort_t effort_id );
+      effort_t effort();
+
+      // Import FFTW wisdom (double and float) from 'fname'. A missing file is not an error.
+      rc_t load_wisdom( const char* fname );
+
+      // Write the accumulated FFTW wisdom to 'fname'.
+      // Unless 'force_fl' is set the file is only written if new plans were created since the last load/save.
+      rc_t save_wisdom( const char* fname, bool force_fl=false );
+
+      // Acquire a shared plan. 'inV' and 'outV' are only used while a new plan is created.
+      // Every acquired plan must be returned with release().
+      // A plan with howN > 1 transforms 'howN' signals per execution. Successive signals are 'realDist'
+      // real and 'cplxDist' complex elements apart (0 selects n and n/2+1).
+      fftwf_plan create_r2c( unsigned n, float*                inV, std::complex<float>*  outV, unsigned howN=1, unsigned realDist=0, unsigned cplxDist=0 );
+      fftw_plan  create_r2c( unsigned n, double*               inV, std::complex<double>* outV, unsigned howN=1, unsigned realDist=0, unsigned cplxDist=0 );
+      fftwf_plan create_c2r( unsigned n, std::complex<float>*  inV, float*                outV, unsigned howN=1, unsigned realDist=0, unsigned cplxDist=0 );
+      fftw_plan  create_c2r( unsigned n, std::complex<double>* inV, double*               outV, unsigned howN=1, unsigned realDist=0, unsigned cplxDist=0 );
+
+      void release( fftwf_plan plan );
+      void release( fftw_plan  plan );
+
+      // Count of distinct plans currently cached.
+      unsigned plan_count();
+    }
+
     //---------------------------------------------------------------------------------------------------------------------------------
     // FFT
     //
-    
+
     namespace fft
     {      
       enum
@@ -410,14 +466,14 @@ namespace cw
         {
           p->inV      = (T*)fftwf_malloc( sizeof(T)*xN );
           p->cplxV    = (std::complex<T>*)fftwf_malloc( sizeof(std::complex<T>)*xN);
-          p->u.fplan  = fftwf_plan_dft_r2c_1d((int)xN, (float*)p->inV, reinterpret_cast<fftwf_complex*>(p->cplxV), FFTW_PATIENT );
+          p->u.fplan  = fft_plan::create_r2c(xN, (float*)p->inV, reinterpret_cast<std::complex<float>*>(p->cplxV) );
           
         }
         else
         {
           p->inV     = (T*)fftw_malloc( sizeof(T)*xN );
           p->cplxV   = (std::complex<T>*)fftw_malloc( sizeof(std::complex<T>)*xN);
-          p->u.dplan = fftw_plan_dft_r2c_1d((int)xN, (double*)p->inV, reinterpret_cast<fftw_complex*>(p->cplxV), FFTW_PATIENT );          
+          p->u.dplan = fft_plan::create_r2c(xN, (double*)p->inV, reinterpret_cast<std::complex<double>*>(p->cplxV) );
         }
 
       errLabel:
@@ -432,13 +488,13 @@ namespace cw
 
         if( std::is_same<T,float>::value )
         {
-          fftwf_destroy_plan( p->u.fplan );
+          fft_plan::release( p->u.fplan );
           fftwf_free(p->inV);
           fftwf_free(p->cplxV);
         }
         else
         {
-          fftw_destroy_plan( p->u.dplan );
+          fft_plan::release( p->u.dplan );
           fftw_free(p->inV);
           fftw_free(p->cplxV);
         }
@@ -469,9 +525,9 @@ namespace cw
 
         // execute the FT
         if( std::is_same<T,float>::value )
-          fftwf_execute(p->u.fplan);
+          fftwf_execute_dft_r2c(p->u.fplan, (float*)p->inV, reinterpret_cast<fftwf_complex*>(p->cplxV));
         else
-          fftw_execute(p->u.dplan);
+          fftw_execute_dft_r2c(p->u.dplan, (double*)p->inV, reinterpret_cast<fftw_complex*>(p->cplxV));
 
         // convert to polar
         if( cwIsFlag(p->flags,kToPolarFl) )
@@ -559,13 +615,13 @@ namespace cw
         {
           p->outV  = (T*)fftwf_malloc( sizeof(T)*p->outN );
           p->cplxV = (std::complex<T>*)fftwf_malloc( sizeof(std::complex<T>)*p->outN);  
-          p->u.fplan  = fftwf_plan_dft_c2r_1d((int)p->outN, reinterpret_cast<fftwf_complex*>(p->cplxV), (float*)p->outV, FFTW_BACKWARD | FFTW_PATIENT );          
+          p->u.fplan  = fft_plan::create_c2r(p->outN, reinterpret_cast<std::complex<float>*>(p->cplxV), (float*)p->outV );
         }
         else
         {
           p->outV  = (T*)fftw_malloc( sizeof(T)*p->outN );
           p->cplxV = (std::complex<T>*)fftw_malloc( sizeof(std::complex<T>)*p->outN);  
-          p->u.dplan = fftw_plan_dft_c2r_1d((int)p->outN, reinterpret_cast<fftw_complex*>(p->cplxV), (double*)p->outV, FFTW_BACKWARD | FFTW_PATIENT );          
+          p->u.dplan = fft_plan::create_c2r(p->outN, reinterpret_cast<std::complex<double>*>(p->cplxV), (double*)p->outV );
         }
 
       errLabel:
@@ -580,13 +636,13 @@ namespace cw
 
         if( std::is_same<T,float>::value )
         {
-          fftwf_destroy_plan( p->u.fplan );
+          fft_plan::release( p->u.fplan );
           fftwf_free(p->outV);
           fftwf_free(p->cplxV);
         }
         else
         {
-          fftw_destroy_plan( p->u.dplan );
+          fft_plan::release( p->u.dplan );
           fftw_free(p->outV);
           fftw_free(p->cplxV);
         }
@@ -606,9 +662,9 @@ namespace cw
         real_polar_to_complex(p->cplxV, p->outN, magV, phsV, p->binN);
         
         if( std::is_same<T,float>::value )
-          fftwf_execute(p->u.fplan);
+          fftwf_execute_dft_c2r(p->u.fplan, reinterpret_cast<fftwf_complex*>(p->cplxV), (float*)p->outV);
         else
-          fftw_execute(p->u.dplan);
+          fftw_execute_dft_c2r(p->u.dplan, reinterpret_cast<fftw_complex*>(p->cplxV), (double*)p->outV);
         
         return rc;
       }
@@ -621,9 +677,9 @@ namespace cw
         real_rect_to_complex(p->cplxV, p->outN, rV, iV, p->binN);
         
         if( std::is_same<T,float>::value )
-          fftwf_execute(p->u.fplan);
+          fftwf_execute_dft_c2r(p->u.fplan, reinterpret_cast<fftwf_complex*>(p->cplxV), (float*)p->outV);
         else
-          fftw_execute(p->u.dplan);          
+          fftw_execute_dft_c2r(p->u.dplan, reinterpret_cast<fftw_complex*>(p->cplxV), (double*)p->outV);
         
         return rc;
       }
@@ -637,7 +693,304 @@ namespace cw
       
       rc_t test();         
     }
-#endif // cwFFTW
+
+    //---------------------------------------------------------------------------------------------------------------------------------
+    // Multi-channel FFT
+    //
+    // Transform 'chN' equal length channels with one batched plan.
+    // The channels are stored in consecutive blocks of a single aligned allocation.
+    // Each block is padded to a multiple of 64 bytes so every channel starts on an aligned address.
+    // Fill in(p,ch) for every channel and then call exec().
+    
+    // Round 'n' up to a multiple of 64 bytes.
+    template< typename T >
+    unsigned aligned_channel_count( unsigned n )
+    {
+      unsigned k = 64 / sizeof(T);
+      return ((n + k - 1) / k) * k;
+    }
+
+    // Allocate/release zeroed FFTW aligned memory.
+    template< typename T >
+    T* fft_alloc( unsigned n )
+    {
+      T* v = (T*)fftw_malloc(sizeof(T)*n);
+      memset((void*)v,0,sizeof(T)*n);
+      return v;
+    }
+
+    template< typename T >
+    void fft_free( T*& v )
+    {
+      if( v != nullptr )
+        fftw_free(v);
+      v = nullptr;
+    }
+    
+    namespace multi_ch_fft
+    {
+      template< typename T >
+        struct obj_str
+      {
+        unsigned         flags;   // fft::kToPolarFl or fft::kToRectFl
+        unsigned         chN;     // count of channels
+        unsigned         inN;     // inN is a power of two
+        unsigned         binN;    // binN = inN/2 + 1
+        unsigned         inDist;  // distance between channels in inV[]
+        unsigned         binDist; // distance between channels in cplxV[],magV[] and phsV[]
+        
+        T*               inV;     // inV[   chN*inDist ]
+        std::complex<T>* cplxV;   // cplxV[ chN*binDist ]
+        T*               magV;    // magV[  chN*binDist ] - magnitude or real part
+        T*               phsV;    // phsV[  chN*binDist ] - phase or imag. part
+        
+        union
+        {
+          fftw_plan  dplan;
+          fftwf_plan fplan;
+        } u;
+      };
+
+      template< typename T >
+      rc_t destroy( struct obj_str<T>*& p );
+      
+      template< typename T >
+      rc_t create( struct obj_str<T>*& p, unsigned chN, unsigned xN, unsigned flags=fft::kToPolarFl )
+      {
+        rc_t rc = kOkRC;
+        p = mem::allocZ< obj_str<T> >(1);
+
+        if( !math::isPowerOfTwo(xN) || chN == 0 )
+        {
+          rc = cwLogError(kInvalidArgRC,"The multi-channel FFT length must be a power of two (%i) and the channel count (%i) must be greater than zero.",xN,chN);
+          goto errLabel;
+        }
+
+        p->flags   = flags;
+        p->chN     = chN;
+        p->inN     = xN;
+        p->binN    = window_sample_count_to_bin_count(xN);
+        p->inDist  = aligned_channel_count<T>(xN);
+        p->binDist = aligned_channel_count< std::complex<T> >(p->binN);
+        p->inV     = fft_alloc<T>( chN * p->inDist );
+        p->cplxV   = fft_alloc< std::complex<T> >( chN * p->binDist );
+        p->magV    = fft_alloc<T>( chN * p->binDist );
+        p->phsV    = fft_alloc<T>( chN * p->binDist );
+
+        if( std::is_same<T,float>::value )
+          p->u.fplan = fft_plan::create_r2c(xN, (float*)p->inV,  reinterpret_cast<std::complex<float>*>(p->cplxV),  chN, p->inDist, p->binDist );
+        else
+          p->u.dplan = fft_plan::create_r2c(xN, (double*)p->inV, reinterpret_cast<std::complex<double>*>(p->cplxV), chN, p->inDist, p->binDist );
+        
+        if( p->u.dplan == nullptr )
+          rc = cwLogError(kOpFailRC,"The multi-channel FFT plan create failed.");
+        
+      errLabel:
+        if( rc != kOkRC )
+          destroy(p);
+        
+        return rc;
+      }
+
+      template< typename T >
+      rc_t destroy( struct obj_str<T>*& p )
+      {
+        if( p == nullptr )
+          return kOkRC;
+
+        if( p->u.dplan != nullptr )
+        {
+          if( std::is_same<T,float>::value )
+            fft_plan::release( p->u.fplan );
+          else
+            fft_plan::release( p->u.dplan );
+        }
+
+        fft_free(p->inV);
+        fft_free(p->cplxV);
+        fft_free(p->magV);
+        fft_free(p->phsV);
+        mem::release(p);
+        
+        return kOkRC;
+      }
+
+      // Channel 'ch' input buffer. inV[inN] is destroyed by exec().
+      template< typename T >
+      T* in( struct obj_str<T>* p, unsigned ch ) { return p->inV + ch*p->inDist; }
+
+      // Transform all channels.
+      template< typename T >
+      rc_t exec( struct obj_str<T>* p )
+      {
+        if( std::is_same<T,float>::value )
+          fftwf_execute_dft_r2c(p->u.fplan, (float*)p->inV, reinterpret_cast<fftwf_complex*>(p->cplxV));
+        else
+          fftw_execute_dft_r2c(p->u.dplan, (double*)p->inV, reinterpret_cast<fftw_complex*>(p->cplxV));
+
+        if( cwIsFlag(p->flags,fft::kToPolarFl) || cwIsFlag(p->flags,fft::kToRectFl) )
+        {
+          T norm = (T)p->inN/2;
+          
+          for(unsigned ch=0; ch<p->chN; ++ch)
+          {
+            const std::complex<T>* c = p->cplxV + ch*p->binDist;
+            T*                     m = p->magV  + ch*p->binDist;
+            T*                     a = p->phsV  + ch*p->binDist;
+
+            if( cwIsFlag(p->flags,fft::kToPolarFl) )
+              for(unsigned i=0; i<p->binN; ++i)
+              {
+                m[i] = std::abs(c[i])/norm;
+                a[i] = std::arg(c[i]);
+              }
+            else
+              for(unsigned i=0; i<p->binN; ++i)
+              {
+                m[i] = std::real(c[i])/norm;
+                a[i] = std::imag(c[i])/norm;
+              }
+          }
+        }
+        
+        return kOkRC;
+      }
+
+      template< typename T >
+        unsigned bin_count( struct obj_str<T>* p ) { return p->binN; }
+
+      template< typename T >
+        const T* magn( struct obj_str<T>* p, unsigned ch ) { return p->magV + ch*p->binDist; }
+      
+      template< typename T >
+        const T* phase( struct obj_str<T>* p, unsigned ch ) { return p->phsV + ch*p->binDist; }
+
+      template< typename T >
+        const std::complex<T>* cplx( struct obj_str<T>* p, unsigned ch ) { return p->cplxV + ch*p->binDist; }
+    }
+    
+    //---------------------------------------------------------------------------------------------------------------------------------
+    // Multi-channel IFFT
+    //
+    // Inverse transform 'chN' equal length channels with one batched plan.
+    // The storage layout follows multi_ch_fft.
+    // Fill cplx(p,ch) (directly or with set_polar()) for every channel and then call exec().
+    namespace multi_ch_ifft
+    {
+      template< typename T >
+        struct obj_str
+      {
+        unsigned         chN;     // count of channels
+        unsigned         outN;    // outN = (binN-1)*2
+        unsigned         binN;    // (binN-1)*2 is a power of two
+        unsigned         outDist; // distance between channels in outV[]
+        unsigned         binDist; // distance between channels in cplxV[]
+        
+        T*               outV;    // outV[  chN*outDist ]
+        std::complex<T>* cplxV;   // cplxV[ chN*binDist ]
+        
+        union
+        {
+          fftw_plan  dplan;
+          fftwf_plan fplan;
+        } u;
+      };
+
+      template< typename T >
+      rc_t destroy( struct obj_str<T>*& p );
+      
+      template< typename T >
+      rc_t create( struct obj_str<T>*& p, unsigned chN, unsigned binN )
+      {
+        rc_t rc = kOkRC;
+        p = mem::allocZ< obj_str<T> >(1);
+
+        if( binN < 2 || !math::isPowerOfTwo( bin_count_to_window_sample_count(binN) ) || chN == 0 )
+        {
+          rc = cwLogError(kInvalidArgRC,"The multi-channel IFFT (binN-1)*2 must be a power of two (binN:%i) and the channel count (%i) must be greater than zero.",binN,chN);
+          goto errLabel;
+        }
+
+        p->chN     = chN;
+        p->binN    = binN;
+        p->outN    = bin_count_to_window_sample_count(binN);
+        p->outDist = aligned_channel_count<T>(p->outN);
+        p->binDist = aligned_channel_count< std::complex<T> >(binN);
+        p->outV    = fft_alloc<T>( chN * p->outDist );
+        p->cplxV   = fft_alloc< std::complex<T> >( chN * p->binDist );
+
+        if( std::is_same<T,float>::value )
+          p->u.fplan = fft_plan::create_c2r(p->outN, reinterpret_cast<std::complex<float>*>(p->cplxV),  (float*)p->outV,  chN, p->outDist, p->binDist );
+        else
+          p->u.dplan = fft_plan::create_c2r(p->outN, reinterpret_cast<std::complex<double>*>(p->cplxV), (double*)p->outV, chN, p->outDist, p->binDist );
+
+        if( p->u.dplan == nullptr )
+          rc = cwLogError(kOpFailRC,"The multi-channel IFFT plan create failed.");
+        
+      errLabel:
+        if( rc != kOkRC )
+          destroy(p);
+        
+        return rc;
+      }
+
+      template< typename T >
+      rc_t destroy( struct obj_str<T>*& p )
+      {
+        if( p == nullptr )
+          return kOkRC;
+
+        if( p->u.dplan != nullptr )
+        {
+          if( std::is_same<T,float>::value )
+            fft_plan::release( p->u.fplan );
+          else
+            fft_plan::release( p->u.dplan );
+        }
+
+        fft_free(p->outV);
+        fft_free(p->cplxV);
+        mem::release(p);
+        
+        return kOkRC;
+      }
+
+      // Channel 'ch' spectrum. cplxV[binN] is destroyed by exec().
+      template< typename T >
+      std::complex<T>* cplx( struct obj_str<T>* p, unsigned ch ) { return p->cplxV + ch*p->binDist; }
+
+      // Fill the spectrum of channel 'ch' from a polar spectrum. The scaling follows ifft::exec_polar().
+      template< typename T >
+      void set_polar( struct obj_str<T>* p, unsigned ch, const T* magV, const T* phsV )
+      {
+        std::complex<T>* c = cplx(p,ch);
+        unsigned         n = p->binN-1;
+        
+        c[0] = std::complex<T>( std::polar( magV[0] * (T)0.5, phsV[0] ).real(), 0 );          
+        c[n] = std::complex<T>( std::polar( magV[n] * (T)0.5, phsV[n] ).real(), 0 );
+        
+        for(unsigned i=1; i<n; ++i)
+          c[i] = std::polar( magV[i] * (T)0.5, phsV[i] );
+      }
+
+      // Inverse transform all channels.
+      template< typename T >
+      rc_t exec( struct obj_str<T>* p )
+      {
+        if( std::is_same<T,float>::value )
+          fftwf_execute_dft_c2r(p->u.fplan, reinterpret_cast<fftwf_complex*>(p->cplxV), (float*)p->outV);
+        else
+          fftw_execute_dft_c2r(p->u.dplan, reinterpret_cast<fftw_complex*>(p->cplxV), (double*)p->outV);
+        
+        return kOkRC;
+      }
+      
+      template< typename T >
+        unsigned out_count( struct obj_str<T>* p ) { return p->outN; }
+
+      template< typename T >
+        const T* out( struct obj_str<T>* p, unsigned ch ) { return p->outV + ch*p->outDist; }
+    }
     
 #ifdef cwMKL
     
@@ -1107,6 +1460,276 @@ namespace cw
         
       
     }
+
+    //---------------------------------------------------------------------------------------------------------------------------------
+    // Partitioned Convolution
+    //
+    // Uniformly partitioned overlap-save convolution with a frequency domain delay line (FDL).
+    // The impulse response is split into partitions of 'procSmpN' samples so the latency is zero
+    // and the cost per exec() is independent of the length of the impulse response
+    // (one FFT/IFFT of 2*procSmpN and one complex multiply-accumulate per partition).
+    //
+    // If 'tailFact' is greater than one the impulse response is split into two segments.
+    // The first (2*tailFact - 1)*procSmpN samples are processed as above and the remainder
+    // is processed in partitions of tailFact*procSmpN samples. The work for each tail partition
+    // is spread evenly over tailFact cycles which reduces the cost of long impulse responses
+    // by roughly a factor of tailFact while keeping the cost per cycle flat.
+    //
+    namespace part_convolve
+    {
+      template< typename T >
+        struct segment_str
+      {
+        struct FFT::obj_str<T>*  ft;   // ft->inN == 2*partN
+        struct IFFT::obj_str<T>* ift;  // ift->outN == 2*partN
+        
+        unsigned partN;  // partition length in samples
+        unsigned binN;   // partN + 1
+        unsigned pN;     // count of partitions
+        
+        T*       hrV;    // hrV[ pN*binN ] impulse response partition spectra (real part)
+        T*       hiV;    // hiV[ pN*binN ]                                     (imag. part)
+        T*       xrV;    // xrV[ pN*binN ] FDL of input spectra (real part)
+        T*       xiV;    // xiV[ pN*binN ]                      (imag. part)
+        unsigned xi;     // FDL slot of the most recent input spectrum
+        
+        T*       yrV;    // yrV[ binN ] output spectrum accumulator
+        T*       yiV;    // yiV[ binN ]
+        T*       inV;    // inV[ 2*partN ] overlap-save input window
+        T*       outV;   // outV[ partN ]  (tail segment only)
+      };
+      
+      template< typename T >
+        struct obj_str
+      {
+        struct segment_str<T> head;     // head.partN == procSmpN
+        struct segment_str<T> tail;     // tail.partN == procSmpN*tailFact, tail.pN == 0 if the tail is not used.
+        
+        unsigned procSmpN; 
+        unsigned tailFact; 
+        unsigned cycleIdx; // count of calls to exec()
+        
+        T*       outV;     // outV[ outN ]
+        unsigned outN;     // outN == procSmpN
+      };
+
+      template< typename T >
+        rc_t _segment_create( struct segment_str<T>& seg, const T* hV, unsigned hN, unsigned partN, T hScale )
+      {
+        rc_t rc = kOkRC;
+        
+        seg.partN = partN;
+        seg.binN  = partN + 1;
+        seg.pN    = (hN + partN - 1) / partN;
+
+        if((rc = FFT::create<T>(seg.ft,2*partN,0)) != kOkRC )
+          goto errLabel;
+
+        if((rc = IFFT::create<T>(seg.ift,seg.binN)) != kOkRC )
+          goto errLabel;
+        
+        seg.hrV  = mem::allocZ<T>( seg.pN*seg.binN );
+        seg.hiV  = mem::allocZ<T>( seg.pN*seg.binN );
+        seg.xrV  = mem::allocZ<T>( seg.pN*seg.binN );
+        seg.xiV  = mem::allocZ<T>( seg.pN*seg.binN );
+        seg.yrV  = mem::allocZ<T>( seg.binN );
+        seg.yiV  = mem::allocZ<T>( seg.binN );
+        seg.inV  = mem::allocZ<T>( 2*partN );
+        seg.outV = mem::allocZ<T>( partN );
+
+        // the IFFT is not normalized therefore the scale factor is included in the impulse response spectra
+        hScale /= 2*partN;
+        
+        for(unsigned i=0; i<seg.pN; ++i)
+        {
+          unsigned hi = i*partN;
+          FFT::exec( seg.ft, hV + hi, std::min(partN, hN-hi) );
+
+          for(unsigned j=0; j<seg.binN; ++j)
+          {
+            seg.hrV[ i*seg.binN + j ] = hScale * seg.ft->cplxV[j].real();
+            seg.hiV[ i*seg.binN + j ] = hScale * seg.ft->cplxV[j].imag();
+          }
+        }
+
+      errLabel:
+        return rc;
+      }
+
+      template< typename T >
+        void _segment_destroy( struct segment_str<T>& seg )
+      {
+        FFT::destroy(seg.ft);
+        IFFT::destroy(seg.ift);
+        mem::release(seg.hrV);
+        mem::release(seg.hiV);
+        mem::release(seg.xrV);
+        mem::release(seg.xiV);
+        mem::release(seg.yrV);
+        mem::release(seg.yiV);
+        mem::release(seg.inV);
+        mem::release(seg.outV);
+      }
+
+      // Transform the input window into the next FDL slot and clear the accumulator.
+      template< typename T >
+        void _segment_input( struct segment_str<T>& seg )
+      {
+        seg.xi = (seg.xi + 1) % seg.pN;
+        
+        FFT::exec( seg.ft, seg.inV, 2*seg.partN );
+
+        T* xrV = seg.xrV + seg.xi*seg.binN;
+        T* xiV = seg.xiV + seg.xi*seg.binN;
+        for(unsigned j=0; j<seg.binN; ++j)
+        {
+          xrV[j] = seg.ft->cplxV[j].real();
+          xiV[j] = seg.ft->cplxV[j].imag();
+        }
+
+        vop::zero(seg.yrV,seg.binN);
+        vop::zero(seg.yiV,seg.binN);
+      }
+
+      // Accumulate partitions [p0,p1) into the output spectrum.
+      template< typename T >
+        void _segment_mac( struct segment_str<T>& seg, unsigned p0, unsigned p1 )
+      {
+        for(unsigned i=p0; i<p1; ++i)
+        {
+          unsigned k = ((seg.xi + seg.pN - i) % seg.pN) * seg.binN;
+          unsigned h = i * seg.binN;
+          vop::cmac( seg.yrV, seg.yiV, (const T*)seg.hrV + h, (const T*)seg.hiV + h, (const T*)seg.xrV + k, (const T*)seg.xiV + k, seg.binN );
+        }
+      }
+
+      // Transform the output spectrum and copy the valid (second) half of the result to yV[partN].
+      template< typename T >
+        void _segment_output( struct segment_str<T>& seg, T* yV )
+      {
+        for(unsigned j=0; j<seg.binN; ++j)
+          seg.ift->cplxV[j] = std::complex<T>(seg.yrV[j],seg.yiV[j]);
+
+        IFFT::exec_polar<T>(seg.ift,nullptr,nullptr);
+
+        vop::copy( yV, seg.ift->outV + seg.partN, seg.partN );
+      }
+
+      template< typename T >
+        rc_t destroy( struct obj_str<T>*& pRef )
+      {
+        if( pRef == nullptr )
+          return kOkRC;
+
+        _segment_destroy(pRef->head);
+        
+        if( pRef->tail.pN > 0 )
+          _segment_destroy(pRef->tail);
+        
+        mem::release(pRef->outV);
+        mem::release(pRef);
+        return kOkRC;
+      }
+      
+      template< typename T >
+        rc_t create( struct obj_str<T>*& p, const T* hV, unsigned hN, unsigned procSmpN, T hScale=1, unsigned tailFact=0 )
+      {
+        rc_t     rc    = kOkRC;
+        unsigned headN = hN;
+        
+        p = mem::allocZ<struct obj_str<T>>(1);
+
+        if( hN == 0 || !math::isPowerOfTwo(procSmpN) )
+        {
+          rc = cwLogError(kInvalidArgRC,"The impulse response must not be empty and the block size (%i) must be a power of two.",procSmpN);
+          goto errLabel;
+        }
+
+        p->procSmpN = procSmpN;
+        p->tailFact = tailFact > 1 && math::isPowerOfTwo(tailFact) ? tailFact : 1;
+        p->outN     = procSmpN;
+        p->outV     = mem::allocZ<T>( procSmpN );
+
+        if( p->tailFact != tailFact && tailFact > 1 )
+          cwLogWarning("The convolution tail factor (%i) must be a power of two. Uniform partitioning will be used.",tailFact);
+        
+        // the head must cover the first 2*tailFact - 1 cycles to hide the latency of the tail
+        if( p->tailFact > 1 )
+          headN = std::min(hN, (2*p->tailFact - 1) * procSmpN);
+
+        if((rc = _segment_create(p->head, hV, headN, procSmpN, hScale)) != kOkRC )
+          goto errLabel;
+
+        if( headN < hN )
+          if((rc = _segment_create(p->tail, hV + headN, hN - headN, procSmpN * p->tailFact, hScale)) != kOkRC )
+            goto errLabel;
+        
+      errLabel:
+        if( rc != kOkRC )
+        {
+          destroy(p);
+          rc = cwLogError(rc,"Partitioned convolution create failed.");
+        }
+        
+        return rc;
+      }
+
+      // Convolve xV[xN] (xN <= procSmpN) with the impulse response. The result is in p->outV[p->outN].
+      template< typename T >
+        rc_t exec( struct obj_str<T>* p, const T* xV, unsigned xN )
+      {
+        unsigned B = p->procSmpN;
+
+        assert( xN <= B );
+        xN = std::min(xN,B);
+
+        // slide the head input window and append the incoming samples
+        struct segment_str<T>& h = p->head;
+        vop::copy( h.inV, (const T*)h.inV + B, B );
+        vop::copy( h.inV + B, xV, xN );
+        vop::zero( h.inV + B + xN, B - xN );
+
+        _segment_input( h );
+        _segment_mac( h, 0, h.pN );
+        _segment_output( h, p->outV );
+
+        if( p->tail.pN > 0 )
+        {
+          struct segment_str<T>& t = p->tail;
+          unsigned M  = t.partN;
+          unsigned k  = p->tailFact;
+          unsigned ci = p->cycleIdx % k;    // position of this block in the tail input window
+          unsigned wi = (ci + 1) % k;       // tail work step
+
+          // add the tail output computed during the previous tailFact cycles
+          vop::add( p->outV, (const T*)t.outV + wi*B, B );
+
+          vop::copy( t.inV + M + ci*B, h.inV + B, B );
+
+          // a tail input block is complete - transform it and slide the window
+          if( wi == 0 )
+          {
+            _segment_input( t );
+            vop::copy( t.inV, (const T*)t.inV + M, M );
+          }
+
+          _segment_mac( t, (wi * t.pN) / k, ((wi+1) * t.pN) / k );
+
+          if( wi == k-1 )
+            _segment_output( t, t.outV );
+        }
+
+        p->cycleIdx += 1;
+        
+        return kOkRC;
+      }
+
+      template< typename T >
+        unsigned out_count( struct obj_str<T>* p ) { return p->outN; }
+
+      template< typename T >
+        const T* out( struct obj_str<T>* p ) { return p->outV; }
+    }
     
     rc_t test_dsp( const test::test_args_t& args );
     
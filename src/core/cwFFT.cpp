@@ -1,20 +1,407 @@
-//| Copyright: (C) 2020-2024 Kevin Larke <contact AT larke DOT org> 
+//| Copyright: (C) 2020-2024 Kevin Larke <contact AT larke DOT org>
 //| License: GNU GPL version 3.0 or above. See the accompanying LICENSE file.
 #include "cwCommon.h"
 #include "cwLog.h"
 #include "cwCommonImpl.h"
+#include "cwMem.h"
+#include "cwMath.h"
 #include "cwFFT.h"
 
-void*      fftw_malloc(unsigned ) { return nullptr; }
-void       fftw_free(void*){}
-fftw_plan  fftw_plan_dft_r2c_1d(int bufN, double* buf, fftw_complex* cplxV, int type ){ return 0; }
-fftw_plan  fftw_plan_dft_c2r_1d(int bufN, fftw_complex* cplxV, double* outV, int flags ) { return 0; }
-void       fftw_destroy_plan(fftw_plan) {}
-void       fftw_execute( fftw_plan) {}
-
-void*       fftwf_malloc(unsigned ){ return nullptr; }
-void        fftwf_free(void*) {}
-fftwf_plan  fftwf_plan_dft_r2c_1d(int bufN, float* buf, fftwf_complex* cplxV, int type ) { return 0; }
-fftwf_plan  fftwf_plan_dft_c2r_1d(int bufN, fftwf_complex* cplxV, float* outV, int flags ) { return 0; }
-void        fftwf_destroy_plan(fftwf_plan){}
-void        fftwf_execute( fftwf_plan){}
+namespace cw
+{
+  namespace dsp
+  {
+    namespace native_fft
+    {
+      template< typename T >
+      struct plan_str
+      {
+        unsigned n;     // real transform length
+        unsigned m;     // complex transform length (n/2)
+        unsigned stageN;// count of radix-4 and radix-2 stages in the complex transform
+        unsigned batchN;// count of signals transformed per call
+        unsigned rDist; // distance between real signals
+        unsigned cDist; // distance between complex signals
+        T*       twrV;  // twrV[m],twiV[m]   exp(-2*pi*j*k/m)  complex transform twiddles
+        T*       twiV;  //
+        T*       rtwrV; // rtwrV[m],rtwiV[m] exp(-2*pi*j*k/n)  real spectrum twiddles
+        T*       rtwiV; //
+      };
+
+      // Register operations used by the butterflies.
+      // 'scalar_t' processes one element at a time and 'vect_t' processes 16 bytes at a time.
+      template< typename T >
+      struct scalar_t
+      {
+        typedef T reg_t;
+        enum { N = 1 };
+        static inline reg_t load(  const T* x )       { return *x; }
+        static inline void  store( T* y, reg_t v )    { *y = v; }
+        static inline reg_t set1(  T s )              { return s; }
+      };
+
+      template< typename T >
+      struct vect_t
+      {
+        typedef T reg_t __attribute__((vector_size(16)));
+        enum { N = 16/sizeof(T) };
+        static inline reg_t load(  const T* x )       { reg_t v; memcpy(&v,x,sizeof(v)); return v; }
+        static inline void  store( T* y, reg_t v )    { memcpy(y,&v,sizeof(v)); }
+        static inline reg_t set1(  T s )              { reg_t v = {}; return v + s; }
+      };
+
+      // Radix-4 Stockham stage: transform length 'l' with 's' interleaved sub-transforms (l*s == m).
+      // The input elements are 'xs' apart (xs is always 1 when O is vect_t).
+      template< typename O, typename T >
+      void _radix4( const plan_str<T>* p, unsigned l, unsigned s, const T* xr, const T* xi, unsigned xs, T* yr, T* yi )
+      {
+        typedef typename O::reg_t reg_t;
+
+        unsigned l4 = l/4;
+        unsigned d  = s*l4*xs;   // distance between the four butterfly inputs
+
+        for(unsigned k=0; k<l4; ++k)
+        {
+          unsigned t   = k*s;    // exp(-2*pi*j*k/l) == twV[k*s]
+          reg_t    w1r = O::set1(p->twrV[t]),   w1i = O::set1(p->twiV[t]);
+          reg_t    w2r = O::set1(p->twrV[2*t]), w2i = O::set1(p->twiV[2*t]);
+          reg_t    w3r = O::set1(p->twrV[3*t]), w3i = O::set1(p->twiV[3*t]);
+
+          const T* x0r = xr + s*k*xs;
+          const T* x0i = xi + s*k*xs;
+          T*       y0r = yr + s*4*k;
+          T*       y0i = yi + s*4*k;
+
+          for(unsigned q=0; q<s; q+=O::N)
+          {
+            unsigned i   = q*xs;
+            reg_t    a0r = O::load(x0r+i),     a0i = O::load(x0i+i);
+            reg_t    a1r = O::load(x0r+i+d),   a1i = O::load(x0i+i+d);
+            reg_t    a2r = O::load(x0r+i+2*d), a2i = O::load(x0i+i+2*d);
+            reg_t    a3r = O::load(x0r+i+3*d), a3i = O::load(x0i+i+3*d);
+
+            reg_t    b0r = a0r + a2r, b0i = a0i + a2i;
+            reg_t    b1r = a0r - a2r, b1i = a0i - a2i;
+            reg_t    b2r = a1r + a3r, b2i = a1i + a3i;
+            reg_t    b3r = a1i - a3i, b3i = a3r - a1r;  // -j*(a1-a3)
+
+            reg_t    c1r = b1r + b3r, c1i = b1i + b3i;
+            reg_t    c2r = b0r - b2r, c2i = b0i - b2i;
+            reg_t    c3r = b1r - b3r, c3i = b1i - b3i;
+
+            O::store(y0r+q,     b0r + b2r);
+            O::store(y0i+q,     b0i + b2i);
+            O::store(y0r+q+s,   c1r*w1r - c1i*w1i);
+            O::store(y0i+q+s,   c1r*w1i + c1i*w1r);
+            O::store(y0r+q+2*s, c2r*w2r - c2i*w2i);
+            O::store(y0i+q+2*s, c2r*w2i + c2i*w2r);
+            O::store(y0r+q+3*s, c3r*w3r - c3i*w3i);
+            O::store(y0i+q+3*s, c3r*w3i + c3i*w3r);
+          }
+        }
+      }
+
+      // Final radix-2 Stockham stage (l==2).
+      template< typename O, typename T >
+      void _radix2( unsigned s, const T* xr, const T* xi, unsigned xs, T* yr, T* yi )
+      {
+        typedef typename O::reg_t reg_t;
+
+        for(unsigned q=0; q<s; q+=O::N)
+        {
+          unsigned i   = q*xs;
+          reg_t    a0r = O::load(xr+i),      a0i = O::load(xi+i);
+          reg_t    a1r = O::load(xr+i+s*xs), a1i = O::load(xi+i+s*xs);
+
+          O::store(yr+q,   a0r + a1r);
+          O::store(yi+q,   a0i + a1i);
+          O::store(yr+q+s, a0r - a1r);
+          O::store(yi+q+s, a0i - a1i);
+        }
+      }
+
+      // Forward complex transform of the split array (ar,ai) using (br,bi) as work space.
+      // If 'xs' is 2 the input is interleaved (ai==ar+1) and after the first stage
+      // the input buffer is reused as the split array (ar,ar+m).
+      // Returns true if the result is in (ar,ai) and false if it is in (br,bi).
+      template< typename T >
+      bool _cfft( const plan_str<T>* p, T* ar, T* ai, unsigned xs, T* br, T* bi )
+      {
+        unsigned l     = p->m;
+        unsigned s     = 1;
+        bool     in_fl = true;
+
+        for(; l>=4; l/=4, s*=4)
+        {
+          if( s >= vect_t<T>::N && xs==1 )
+            _radix4< vect_t<T> >(p,l,s,ar,ai,xs,br,bi);
+          else
+            _radix4< scalar_t<T> >(p,l,s,ar,ai,xs,br,bi);
+
+          if( xs != 1 )
+            ai = ar + p->m;
+
+          std::swap(ar,br);
+          std::swap(ai,bi);
+          in_fl = !in_fl;
+          xs    = 1;
+        }
+
+        if( l == 2 )
+        {
+          if( s >= vect_t<T>::N && xs==1 )
+            _radix2< vect_t<T> >(s,ar,ai,xs,br,bi);
+          else
+            _radix2< scalar_t<T> >(s,ar,ai,xs,br,bi);
+
+          in_fl = !in_fl;
+        }
+
+        return in_fl;
+      }
+
+      template< typename T >
+      void _exec_r2c( const plan_str<T>* p, T* xV, std::complex<T>* yV );
+
+      template< typename T >
+      void _exec_c2r( const plan_str<T>* p, std::complex<T>* xV, T* yV );
+    }
+  }
+}
+
+template< typename T >
+struct cw::dsp::native_fft::plan_str<T>* cw::dsp::native_fft::create( unsigned n, unsigned batchN, unsigned realDist, unsigned cplxDist )
+{
+  if( n == 0 || !math::isPowerOfTwo(n) )
+  {
+    cwLogError(kInvalidArgRC,"The native FFT length must be a power of two not %i.",n);
+    return nullptr;
+  }
+
+  plan_str<T>* p = mem::allocZ< plan_str<T> >(1);
+
+  p->n      = n;
+  p->m      = n/2;
+  p->batchN = std::max(1u,batchN);
+  p->rDist  = realDist==0 ? n : realDist;
+  p->cDist  = cplxDist==0 ? n/2+1 : cplxDist;
+  p->twrV   = mem::allocZ<T>(p->m*4);
+  p->twiV   = p->twrV  + p->m;
+  p->rtwrV  = p->twiV  + p->m;
+  p->rtwiV  = p->rtwrV + p->m;
+
+  for(unsigned l=p->m; l>=2; l = l>=4 ? l/4 : l/2)
+    p->stageN += 1;
+
+  for(unsigned k=0; k<p->m; ++k)
+  {
+    p->twrV[k]  = (T)cos(-2.0*M_PI*k/p->m);
+    p->twiV[k]  = (T)sin(-2.0*M_PI*k/p->m);
+    p->rtwrV[k] = (T)cos(-2.0*M_PI*k/p->n);
+    p->rtwiV[k] = (T)sin(-2.0*M_PI*k/p->n);
+  }
+
+  return p;
+}
+
+template< typename T >
+void cw::dsp::native_fft::destroy( struct plan_str<T>*& p )
+{
+  if( p != nullptr )
+  {
+    mem::release(p->twrV);
+    mem::release(p);
+  }
+}
+
+template< typename T >
+void cw::dsp::native_fft::_exec_r2c( const struct plan_str<T>* p, T* xV, std::complex<T>* yV )
+{
+  unsigned m  = p->m;
+  T*       br = reinterpret_cast<T*>(yV);
+  T*       bi = br + m;
+  T*       zr = xV;
+  T*       zi = xV + m;
+
+  if( m == 0 )
+  {
+    yV[0] = std::complex<T>(xV[0],0);
+    return;
+  }
+
+  // The even samples form the real part and the odd samples the imaginary part of an m point complex signal.
+  // The stages ping-pong between xV[] and yV[]. When the stage count is even the first stage reads the
+  // interleaved samples directly, otherwise the samples are first split into yV[] so that the result
+  // always ends in xV[] and yV[] is free for the output spectrum.
+  if( p->stageN % 2 == 0 )
+    _cfft(p,xV,xV+1,2,br,bi);
+  else
+  {
+    for(unsigned i=0; i<m; ++i)
+    {
+      br[i] = xV[2*i];
+      bi[i] = xV[2*i+1];
+    }
+    _cfft(p,br,bi,1,zr,zi);
+  }
+
+  // Separate the spectra of the even and odd samples and combine them into the real signal spectrum.
+  T z0r = zr[0], z0i = zi[0];
+  for(unsigned k=1; k<=m/2; ++k)
+  {
+    unsigned k1  = m-k;
+    T        ar  = zr[k],  ai  = zi[k];
+    T        br_ = zr[k1], bi_ = -zi[k1];   // conj(Z[m-k])
+
+    T        er  = (ar + br_) / 2, ei = (ai + bi_) / 2;   // E[k] = (A + B)/2
+    T        or_ = (ai - bi_) / 2, oi = (br_ - ar) / 2;   // O[k] = -j(A - B)/2
+
+    T        wr  = p->rtwrV[k], wi = p->rtwiV[k];
+    T        tr  = or_*wr - oi*wi;
+    T        ti  = or_*wi + oi*wr;
+
+    yV[k]  = std::complex<T>(er + tr, ei + ti);
+    yV[k1] = std::complex<T>(er - tr, -(ei - ti));  // X[m-k] = conj(E[k] - W^k O[k])
+  }
+
+  yV[0] = std::complex<T>(z0r + z0i, 0);
+  yV[m] = std::complex<T>(z0r - z0i, 0);
+}
+
+template< typename T >
+void cw::dsp::native_fft::_exec_c2r( const struct plan_str<T>* p, std::complex<T>* xV, T* yV )
+{
+  unsigned m  = p->m;
+  T*       ar = reinterpret_cast<T*>(xV);
+  T*       ai = ar + m;
+  T*       zr = yV;
+  T*       zi = yV + m;
+
+  if( m == 0 )
+  {
+    yV[0] = xV[0].real();
+    return;
+  }
+
+  // Form the spectrum Z = E + jO of the m point complex signal whose real and imag. parts
+  // are the even and odd output samples. The imag. parts of the DC and Nyquist bins are ignored.
+  T x0r = xV[0].real(), xmr = xV[m].real();
+  zr[0] = x0r + xmr;
+  zi[0] = x0r - xmr;
+
+  for(unsigned k=1; k<=m/2; ++k)
+  {
+    unsigned k1  = m-k;
+    T        ar_ = xV[k].real(),  ai_ = xV[k].imag();
+    T        br_ = xV[k1].real(), bi_ = -xV[k1].imag();   // conj(X[m-k])
+
+    T        er  = ar_ + br_, ei = ai_ + bi_;            // 2*E[k]
+    T        dr  = ar_ - br_, di = ai_ - bi_;            // 2*W^k*O[k]
+
+    T        wr  = p->rtwrV[k], wi = -p->rtwiV[k];       // W^-k
+    T        or_ = dr*wr - di*wi;
+    T        oi  = dr*wi + di*wr;
+
+    // Z[k] = E + jO  and  Z[m-k] = conj(E) + j*conj(O)
+    zr[k]  = er - oi;
+    zi[k]  = ei + or_;
+    zr[k1] = er + oi;
+    zi[k1] = or_ - ei;
+  }
+
+  // The inverse transform is the forward transform with the real and imag. parts exchanged.
+  if( _cfft(p,zi,zr,1,ai,ar) )
+  {
+    memcpy(ar,zr,m*sizeof(T));
+    memcpy(ai,zi,m*sizeof(T));
+  }
+
+  for(unsigned i=0; i<m; ++i)
+  {
+    yV[2*i]   = ar[i];
+    yV[2*i+1] = ai[i];
+  }
+}
+
+template< typename T >
+void cw::dsp::native_fft::exec_r2c( const struct plan_str<T>* p, T* xV, std::complex<T>* yV )
+{
+  for(unsigned i=0; i<p->batchN; ++i)
+    _exec_r2c(p, xV + i*p->rDist, yV + i*p->cDist );
+}
+
+template< typename T >
+void cw::dsp::native_fft::exec_c2r( const struct plan_str<T>* p, std::complex<T>* xV, T* yV )
+{
+  for(unsigned i=0; i<p->batchN; ++i)
+    _exec_c2r(p, xV + i*p->cDist, yV + i*p->rDist );
+}
+
+namespace cw
+{
+  namespace dsp
+  {
+    namespace native_fft
+    {
+      template struct plan_str<float>*  create<float>(  unsigned n, unsigned batchN, unsigned realDist, unsigned cplxDist );
+      template struct plan_str<double>* create<double>( unsigned n, unsigned batchN, unsigned realDist, unsigned cplxDist );
+      template void destroy<float>(  struct plan_str<float>*&  p );
+      template void destroy<double>( struct plan_str<double>*& p );
+      template void exec_r2c<float>(  const struct plan_str<float>*  p, float*  xV, std::complex<float>*  yV );
+      template void exec_r2c<double>( const struct plan_str<double>* p, double* xV, std::complex<double>* yV );
+      template void exec_c2r<float>(  const struct plan_str<float>*  p, std::complex<float>*  xV, float*  yV );
+      template void exec_c2r<double>( const struct plan_str<double>* p, std::complex<double>* xV, double* yV );
+    }
+  }
+}
+
+#ifndef cwFFTW
+
+namespace
+{
+  void* _aligned_alloc( size_t byteN )
+  {
+    void* p = nullptr;
+    if( posix_memalign(&p,32,byteN==0 ? 1 : byteN) != 0 )
+      return nullptr;
+    return p;
+  }
+
+  // The real and complex layouts of a 'many' plan.
+  template< typename T >
+  cw::dsp::native_fft::plan_str<T>* _plan_many( int rank, const int* n, int howmany, const int* rembed, int rstride, int rdist, const int* cembed, int cstride, int cdist )
+  {
+    if( rank != 1 || rembed != nullptr || cembed != nullptr || rstride != 1 || cstride != 1 )
+    {
+      cwLogError(cw::kInvalidArgRC,"The native FFT only supports rank 1, unit stride, 'many' plans.");
+      return nullptr;
+    }
+    return cw::dsp::native_fft::create<T>((unsigned)n[0],(unsigned)howmany,(unsigned)rdist,(unsigned)cdist);
+  }
+}
+
+void*      fftw_malloc( size_t byteN ) { return _aligned_alloc(byteN); }
+void       fftw_free( void* p ) { free(p); }
+fftw_plan  fftw_plan_dft_r2c_1d( int bufN, double* buf, fftw_complex* cplxV, unsigned flags ) { return cw::dsp::native_fft::create<double>((unsigned)bufN); }
+fftw_plan  fftw_plan_dft_c2r_1d( int bufN, fftw_complex* cplxV, double* outV, unsigned flags ) { return cw::dsp::native_fft::create<double>((unsigned)bufN); }
+fftw_plan  fftw_plan_many_dft_r2c( int rank, const int* n, int howmany, double* inV, const int* inembed, int istride, int idist, fftw_complex* outV, const int* onembed, int ostride, int odist, unsigned flags ) { return _plan_many<double>(rank,n,howmany,inembed,istride,idist,onembed,ostride,odist); }
+fftw_plan  fftw_plan_many_dft_c2r( int rank, const int* n, int howmany, fftw_complex* inV, const int* inembed, int istride, int idist, double* outV, const int* onembed, int ostride, int odist, unsigned flags ) { return _plan_many<double>(rank,n,howmany,onembed,ostride,odist,inembed,istride,idist); }
+void       fftw_destroy_plan( fftw_plan plan ) { cw::dsp::native_fft::destroy(plan); }
+void       fftw_execute_dft_r2c( const fftw_plan plan, double* inV, fftw_complex* cplxV ) { cw::dsp::native_fft::exec_r2c(plan,inV,cplxV); }
+void       fftw_execute_dft_c2r( const fftw_plan plan, fftw_complex* cplxV, double* outV ) { cw::dsp::native_fft::exec_c2r(plan,cplxV,outV); }
+int        fftw_import_wisdom_from_string( const char* str ) { return 1; }
+char*      fftw_export_wisdom_to_string() { return nullptr; }
+
+void*       fftwf_malloc( size_t byteN ) { return _aligned_alloc(byteN); }
+void        fftwf_free( void* p ) { free(p); }
+fftwf_plan  fftwf_plan_dft_r2c_1d( int bufN, float* buf, fftwf_complex* cplxV, unsigned flags ) { return cw::dsp::native_fft::create<float>((unsigned)bufN); }
+fftwf_plan  fftwf_plan_dft_c2r_1d( int bufN, fftwf_complex* cplxV, float* outV, unsigned flags ) { return cw::dsp::native_fft::create<float>((unsigned)bufN); }
+fftwf_plan  fftwf_plan_many_dft_r2c( int rank, const int* n, int howmany, float* inV, const int* inembed, int istride, int idist, fftwf_complex* outV, const int* onembed, int ostride, int odist, unsigned flags ) { return _plan_many<float>(rank,n,howmany,inembed,istride,idist,onembed,ostride,odist); }
+fftwf_plan  fftwf_plan_many_dft_c2r( int rank, const int* n, int howmany, fftwf_complex* inV, const int* inembed, int istride, int idist, float* outV, const int* onembed, int ostride, int odist, unsigned flags ) { return _plan_many<float>(rank,n,howmany,onembed,ostride,odist,inembed,istride,idist); }
+void        fftwf_destroy_plan( fftwf_plan plan ) { cw::dsp::native_fft::destroy(plan); }
+void        fftwf_execute_dft_r2c( const fftwf_plan plan, float* inV, fftwf_complex* cplxV ) { cw::dsp::native_fft::exec_r2c(plan,inV,cplxV); }
+void        fftwf_execute_dft_c2r( const fftwf_plan plan, fftwf_complex* cplxV, float* outV ) { cw::dsp::native_fft::exec_c2r(plan,cplxV,outV); }
+int         fftwf_import_wisdom_from_string( const char* str ) { return 1; }
+char*       fftwf_export_wisdom_to_string() { return nullptr; }
+
+#endif // cwFFTW
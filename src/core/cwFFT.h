@@ -1,42 +1,97 @@
-//| Copyright: (C) 2020-2024 Kevin Larke <contact AT larke DOT org> 
+//| Copyright: (C) 2020-2024 Kevin Larke <contact AT larke DOT org>
 //| License: GNU GPL version 3.0 or above. See the accompanying LICENSE file.
 #ifndef cwFFT_H
 #define cwFFT_H
 
-#define FFTW_MEASURE (1)
-#define FFTW_BACKWARD (2)
-/*
-typedef struct fftw_plan_str
+namespace cw
 {
-  int foo;
-} fftw_plan;
-*/
-typedef int fftw_plan;
-typedef std::complex<double> fftw_complex;
-  
-void*      fftw_malloc(unsigned );
-void       fftw_free(void*);
-fftw_plan  fftw_plan_dft_r2c_1d(int bufN, double* buf, fftw_complex* cplxV, int flags );
-fftw_plan  fftw_plan_dft_c2r_1d(int bufN, fftw_complex* cplxV, double* outV, int flags );          
-void       fftw_destroy_plan(fftw_plan);
-void       fftw_execute( fftw_plan );
-
-/*
-typedef struct fftwf_plan_str
-{
-  int foo;
-} fftwf_plan;
-*/
-typedef int fftwf_plan;
-
-typedef std::complex<float>  fftwf_complex;
-
-void*       fftwf_malloc(unsigned );
-void        fftwf_free(void*);
-fftwf_plan  fftwf_plan_dft_r2c_1d(int bufN, float* buf, fftwf_complex* cplxV, int flags );
-fftwf_plan  fftwf_plan_dft_c2r_1d(int bufN, fftwf_complex* cplxV, float* outV, int flags );          
-void        fftwf_destroy_plan(fftwf_plan);
-void        fftwf_execute( fftwf_plan );
-  
+  namespace dsp
+  {
+    //---------------------------------------------------------------------------------------------------------------------------------
+    // Native FFT
+    //
+    // Real-input radix-2 Stockham FFT used when FFTW is not linked (cwFFTW is not defined).
+    // An n point real transform is computed as an n/2 point complex transform on
+    // split real/imag. arrays with precomputed twiddle factors followed by a real-spectrum
+    // post-processing pass. The butterflies are vectorized with the compiler vector extensions.
+    //
+    // The transforms are unnormalized and follow the FFTW r2c/c2r conventions:
+    //   exec_r2c():  yV[k] = sum( xV[i] * exp(-2*pi*j*i*k/n) ) for k=0:n/2
+    //   exec_c2r():  yV[i] = sum( xV[k] * exp(+2*pi*j*i*k/n) ) for k=0:n-1 where xV[n-k] = conj(xV[k])
+    //
+    // A plan is read-only during execution and may be executed concurrently on different arrays.
+    // Both transforms use their input array as work space and therefore destroy it.
+    // Arrays should be allocated with fftw_malloc() (or other 16 byte aligned memory) for best performance.
+    namespace native_fft
+    {
+      template< typename T >
+      struct plan_str;
+
+      // 'n' must be a power of two. Returns nullptr if 'n' is not valid.
+      // A plan transforms 'batchN' signals on each call. Successive signals are 'realDist' real
+      // and 'cplxDist' complex elements apart. Zero distances select n and n/2+1.
+      template< typename T >
+      struct plan_str<T>* create( unsigned n, unsigned batchN=1, unsigned realDist=0, unsigned cplxDist=0 );
+
+      template< typename T >
+      void destroy( struct plan_str<T>*& p );
+
+      // xV[n] is overwritten, yV[n/2+1] (per signal)
+      template< typename T >
+      void exec_r2c( const struct plan_str<T>* p, T* xV, std::complex<T>* yV );
+
+      // xV[n/2+1] is overwritten, yV[n] (per signal)
+      template< typename T >
+      void exec_c2r( const struct plan_str<T>* p, std::complex<T>* xV, T* yV );
+    }
+  }
+}
+
+#ifndef cwFFTW
+
+//---------------------------------------------------------------------------------------------------------------------------------
+// FFTW compatible interface
+//
+// The subset of the FFTW API used by cwDsp.h implemented with native_fft.
+// Planning flags are accepted and ignored. There is no wisdom to import or export.
+// The 'many' planners only support rank 1, unit stride and no embedding.
+
+#define FFTW_MEASURE    (0U)
+#define FFTW_EXHAUSTIVE (1U << 3)
+#define FFTW_PATIENT    (1U << 5)
+#define FFTW_ESTIMATE   (1U << 6)
+#define FFTW_BACKWARD   (+1)
+
+typedef cw::dsp::native_fft::plan_str<double>* fftw_plan;
+typedef std::complex<double>                   fftw_complex;
+
+void*      fftw_malloc( size_t byteN );
+void       fftw_free( void* p );
+fftw_plan  fftw_plan_dft_r2c_1d( int bufN, double* buf, fftw_complex* cplxV, unsigned flags );
+fftw_plan  fftw_plan_dft_c2r_1d( int bufN, fftw_complex* cplxV, double* outV, unsigned flags );
+fftw_plan  fftw_plan_many_dft_r2c( int rank, const int* n, int howmany, double* inV, const int* inembed, int istride, int idist, fftw_complex* outV, const int* onembed, int ostride, int odist, unsigned flags );
+fftw_plan  fftw_plan_many_dft_c2r( int rank, const int* n, int howmany, fftw_complex* inV, const int* inembed, int istride, int idist, double* outV, const int* onembed, int ostride, int odist, unsigned flags );
+void       fftw_destroy_plan( fftw_plan plan );
+void       fftw_execute_dft_r2c( const fftw_plan plan, double* inV, fftw_complex* cplxV );
+void       fftw_execute_dft_c2r( const fftw_plan plan, fftw_complex* cplxV, double* outV );
+int        fftw_import_wisdom_from_string( const char* str );
+char*      fftw_export_wisdom_to_string();
+
+typedef cw::dsp::native_fft::plan_str<float>* fftwf_plan;
+typedef std::complex<float>                   fftwf_complex;
+
+void*       fftwf_malloc( size_t byteN );
+void        fftwf_free( void* p );
+fftwf_plan  fftwf_plan_dft_r2c_1d( int bufN, float* buf, fftwf_complex* cplxV, unsigned flags );
+fftwf_plan  fftwf_plan_dft_c2r_1d( int bufN, fftwf_complex* cplxV, float* outV, unsigned flags );
+fftwf_plan  fftwf_plan_many_dft_r2c( int rank, const int* n, int howmany, float* inV, const int* inembed, int istride, int idist, fftwf_complex* outV, const int* onembed, int ostride, int odist, unsigned flags );
+fftwf_plan  fftwf_plan_many_dft_c2r( int rank, const int* n, int howmany, fftwf_complex* inV, const int* inembed, int istride, int idist, float* outV, const int* onembed, int ostride, int odist, unsigned flags );
+void        fftwf_destroy_plan( fftwf_plan plan );
+void        fftwf_execute_dft_r2c( const fftwf_plan plan, float* inV, fftwf_complex* cplxV );
+void        fftwf_execute_dft_c2r( const fftwf_plan plan, fftwf_complex* cplxV, float* outV );
+int         fftwf_import_wisdom_from_string( const char* str );
+char*       fftwf_export_wisdom_to_string();
+
+#endif // cwFFTW
 
 #endif
@@ -473,6 +473,7 @@ void  cw::log::clearBuffer( handle_t h )
   log_t* p = _handleToPtr(h);
   if( p->textBuf != nullptr && p->textBufCharCnt>0 )
     p->textBuf[0] = 0;
+  p->textBufCharIdx.store(0);
 }
 
 const char*  cw::log::buffer( handle_t h )
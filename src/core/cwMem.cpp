@@ -8,6 +8,7 @@
 /*
 
 ssss = count of data bytes
+oooo = offset of ssss from the base of the allocation (non-zero only for aligned blocks)
 
 ssss is always offset by 8 bytes from base of data
 
@@ -15,18 +16,25 @@ ssss is always offset by 8 bytes from base of data
 32  32  32  32
 v   v   v   v
 0123456789012345
-ssss----dddd...
+ssssoooodddd...
 
 64      64      64
 v       v       v
 01234567890123456
-ssss----dddd...
+ssssoooodddd...
 
     
 */
 
 
-bool g_warn_on_alloc_fl = false;
+// The warning is limited to the thread which enabled it (e.g. the audio thread) so that
+// allocations made by other threads while the flag is set are not reported.
+// The flow runtime owns the flag: flow::exec_cycle() sets it on the audio thread and
+// the parallel and pipeline worker threads set it before executing their tasks.
+thread_local bool g_warn_on_alloc_fl = false;
+
+thread_local long long g_thread_byte_cnt      = 0;
+thread_local long long g_thread_peak_byte_cnt = 0;
 
 void* cw::mem::_alloc( void* p0, unsigned n, unsigned flags )
   {
@@ -54,6 +62,10 @@ void* cw::mem::_alloc( void* p0, unsigned n, unsigned flags )
 
     p = malloc(n);  // allocate new memory
 
+    g_thread_byte_cnt += n;
+    if( g_thread_byte_cnt > g_thread_peak_byte_cnt )
+      g_thread_peak_byte_cnt = g_thread_byte_cnt;
+
     // if expanding then copy in data from existing block
     if( p0 != nullptr )
     {
@@ -78,6 +90,7 @@ void* cw::mem::_alloc( void* p0, unsigned n, unsigned flags )
     unsigned* p1 = static_cast<unsigned*>(p);
       
     p1[0] = n; // set size of new block
+    p1[1] = 0; // the block header is at the base of the allocation (See _allocAligned())
 
     // advance past the block size and return
     return p1+2;    
@@ -91,6 +104,35 @@ void* cw::mem::_alloc( void* p0, unsigned n, unsigned flags )
 
 
 
+void* cw::mem::_allocAligned( unsigned n, unsigned alignByteN, unsigned flags )
+{
+  assert( alignByteN >= 2*sizeof(unsigned) && (alignByteN & (alignByteN-1)) == 0 );
+  
+  n += 2*sizeof(unsigned); // add space for the block header
+    
+  if( g_warn_on_alloc_fl )
+    cwLogWarning("Memory allocation:%i",n);
+
+  // allocate enough extra space to move the header and block to an aligned address
+  char* p = static_cast<char*>(malloc(n + alignByteN));
+
+  g_thread_byte_cnt += n;
+  if( g_thread_byte_cnt > g_thread_peak_byte_cnt )
+    g_thread_peak_byte_cnt = g_thread_byte_cnt;
+
+  // 'p2' is the first aligned address which leaves room for the header
+  char*     p2 = p + alignByteN - ((uintptr_t)p % alignByteN);
+  unsigned* p1 = reinterpret_cast<unsigned*>(p2) - 2;
+
+  p1[0] = n;                                // set the size of the block
+  p1[1] = (unsigned)((char*)p1 - p);        // set the offset of the header from the base of the allocation
+
+  if( cwIsFlag(flags,kZeroAllFl) )
+    memset(p2,0,n - 2*sizeof(unsigned));
+  
+  return p2;
+}
+
 unsigned cw::mem::byteCount( const void* p )
 {
   return p==nullptr ? 0 : (static_cast<const unsigned*>(p)[-2] - 2*sizeof(unsigned));
@@ -132,7 +174,11 @@ void cw::mem::free( void* p )
     if( g_warn_on_alloc_fl )
       cwLogWarning("Memory free.");
 
-    ::free(static_cast<unsigned*>(p)-2);
+    unsigned* p1 = static_cast<unsigned*>(p)-2;
+    
+    g_thread_byte_cnt -= p1[0];
+    
+    ::free(reinterpret_cast<char*>(p1) - p1[1]);
   }
 }
 
@@ -146,3 +192,15 @@ void cw::mem::clear_warn_on_alloc()
 {
   g_warn_on_alloc_fl = false;
 }
+
+void cw::mem::reset_thread_byte_count()
+{
+  g_thread_byte_cnt      = 0;
+  g_thread_peak_byte_cnt = 0;
+}
+
+long long cw::mem::thread_byte_count()
+{ return g_thread_byte_cnt; }
+
+long long cw::mem::thread_peak_byte_count()
+{ return g_thread_peak_byte_cnt; }
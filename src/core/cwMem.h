@@ -16,13 +16,25 @@ namespace cw
       
     void* _alloc( void* p, unsigned n, unsigned flags );
     void* _allocDupl( const void* p, unsigned byteN );
+
+    // Allocate a block whose address is a multiple of 'alignByteN' (a power of two no less than 8).
+    // The block is released with free() or release(). Note that resize() does not preserve the alignment.
+    void* _allocAligned( unsigned n, unsigned alignByteN, unsigned flags );
     //void* _allocDupl( const void* p );
   
     char* allocStr( const char* );
     void  free( void* );
 
+    // Log a warning on every allocation or release made by the calling thread.
     void set_warn_on_alloc();
     void clear_warn_on_alloc();
+
+    // Per-thread allocation accounting.
+    // thread_byte_count() is the count of bytes allocated, less the count of bytes released, by the calling thread.
+    // thread_peak_byte_count() is the maximum value of thread_byte_count() since the last call to reset_thread_byte_count().
+    void      reset_thread_byte_count();
+    long long thread_byte_count();
+    long long thread_peak_byte_count();
     
     unsigned byteCount( const void* p );
   
@@ -38,6 +50,12 @@ namespace cw
     template<typename T>
       T* alloc(unsigned n=1) { return alloc<T>(n,0); }
 
+    template<typename T>
+      T* allocAligned(unsigned n, unsigned alignByteN, unsigned flags=0) { return static_cast<T*>(_allocAligned(n*sizeof(T),alignByteN,flags)); }
+
+    template<typename T>
+      T* allocAlignedZ(unsigned n, unsigned alignByteN) { return allocAligned<T>(n,alignByteN,kZeroAllFl); }
+
     template<typename T>
       T* resize(T* p, unsigned n, unsigned flags) { return static_cast<T*>(_alloc(p,n*sizeof(T),flags)); }
         
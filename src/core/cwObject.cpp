@@ -7,6 +7,7 @@
 #include "cwCommonImpl.h"
 #include "cwMem.h"
 #include "cwFile.h"
+#include "cwFileSys.h"
 #include "cwTest.h"
 #include "cwLex.h"
 #include "cwText.h"
@@ -1423,6 +1424,346 @@ cw::rc_t cw::objectToFile( const char* fn, const object_t* obj )
   return rc;
 }
 
+namespace cw
+{
+  //
+  // Binary object image
+  //
+  // The image is a header followed by a pre-order serialization of the object tree.
+  // Each node is written as a type id followed by the value of leaf nodes
+  // or the count of children of container nodes.
+  // Strings are written as a byte count followed by the characters (no terminating zero).
+  
+  enum { kObjBinVersion = 1 };
+  
+  typedef struct obj_bin_hdr_str
+  {
+    char               tag[4];    // "cwob"
+    unsigned           version;   // kObjBinVersion
+    unsigned long long src_hash;  // hash of the source text
+  } obj_bin_hdr_t;
+
+  typedef struct obj_bin_rd_str
+  {
+    const char* buf;
+    const char* end;
+  } obj_bin_rd_t;
+
+  unsigned _objBinValueByteCount( const object_t* o )
+  {
+    switch( o->type->id )
+    {
+      case kNullTId:
+      case kErrorTId:   return 0;
+      case kCharTId:    return sizeof(o->u.c);
+      case kInt8TId:    return sizeof(o->u.i8);
+      case kUInt8TId:   return sizeof(o->u.u8);
+      case kInt16TId:   return sizeof(o->u.i16);
+      case kUInt16TId:  return sizeof(o->u.u16);
+      case kInt32TId:   return sizeof(o->u.i32);
+      case kUInt32TId:  return sizeof(o->u.u32);
+      case kInt64TId:   return sizeof(o->u.i64);
+      case kUInt64TId:  return sizeof(o->u.u64);
+      case kFloatTId:   return sizeof(o->u.f);
+      case kDoubleTId:  return sizeof(o->u.d);
+      case kBoolTId:    return sizeof(o->u.b);
+    }
+    return 0;
+  }
+
+  // Returns the size of the serialized object or kInvalidCnt if the object cannot be serialized.
+  unsigned _objBinByteCount( const object_t* o )
+  {
+    unsigned n = sizeof(unsigned);
+
+    if( o->is_container() )
+    {
+      n += sizeof(unsigned);
+      for(const object_t* ch=o->u.children; ch!=nullptr; ch=ch->sibling)
+      {
+        unsigned chN;
+        if((chN = _objBinByteCount(ch)) == kInvalidCnt )
+          return kInvalidCnt;
+        n += chN;
+      }
+      return n;
+    }
+
+    if( o->is_string() )
+      return n + sizeof(unsigned) + textLength(o->u.str);
+
+    if( o->type->id == kVectTId )
+      return kInvalidCnt;
+
+    return n + _objBinValueByteCount(o);
+  }
+  
+  char* _objBinWrite( const object_t* o, char* buf )
+  {
+    unsigned tid = o->is_string() ? (unsigned)kStringTId : o->type->id;
+    
+    memcpy(buf,&tid,sizeof(tid));
+    buf += sizeof(tid);
+    
+    if( o->is_container() )
+    {
+      unsigned chN = o->child_count();
+      memcpy(buf,&chN,sizeof(chN));
+      buf += sizeof(chN);
+      
+      for(const object_t* ch=o->u.children; ch!=nullptr; ch=ch->sibling)
+        buf = _objBinWrite(ch,buf);
+    }
+    else
+    {
+      if( o->is_string() )
+      {
+        unsigned sn = o->u.str == nullptr ? kInvalidCnt : textLength(o->u.str);
+        memcpy(buf,&sn,sizeof(sn));
+        buf += sizeof(sn);
+        if( sn != kInvalidCnt )
+        {
+          memcpy(buf,o->u.str,sn);
+          buf += sn;
+        }
+      }
+      else
+      {
+        unsigned n = _objBinValueByteCount(o);
+        memcpy(buf,&o->u,n);
+        buf += n;
+      }
+    }
+
+    return buf;
+  }
+
+  bool _objBinRead( obj_bin_rd_t& r, void* dst, unsigned byteN )
+  {
+    if( r.buf + byteN > r.end )
+      return false;
+    
+    memcpy(dst,r.buf,byteN);
+    r.buf += byteN;
+    return true;
+  }
+
+  template< typename T >
+  object_t* _objBinReadLeaf( obj_bin_rd_t& r, object_t* parent )
+  {
+    T v;
+    if( !_objBinRead(r,&v,sizeof(v)) )
+      return nullptr;
+    return _objCreateValueNode<T>(parent,v);
+  }
+  
+  object_t* _objBinReadNode( obj_bin_rd_t& r, object_t* parent )
+  {
+    unsigned  tid = kInvalidTId;
+    object_t* o   = nullptr;
+
+    if( !_objBinRead(r,&tid,sizeof(tid)) )
+      return nullptr;
+
+    switch( tid )
+    {
+      case kNullTId:
+      case kErrorTId:
+        if((o = _objAllocate(tid,nullptr)) != nullptr && _objAppendRightMostNode(parent,o) != kOkRC )
+        {
+          o->free();
+          o = nullptr;
+        }
+        break;
+        
+      case kCharTId:   o = _objBinReadLeaf<char>(r,parent);     break;
+      case kInt8TId:   o = _objBinReadLeaf<int8_t>(r,parent);   break;
+      case kUInt8TId:  o = _objBinReadLeaf<uint8_t>(r,parent);  break;
+      case kInt16TId:  o = _objBinReadLeaf<int16_t>(r,parent);  break;
+      case kUInt16TId: o = _objBinReadLeaf<uint16_t>(r,parent); break;
+      case kInt32TId:  o = _objBinReadLeaf<int32_t>(r,parent);  break;
+      case kUInt32TId: o = _objBinReadLeaf<uint32_t>(r,parent); break;
+      case kInt64TId:  o = _objBinReadLeaf<int64_t>(r,parent);  break;
+      case kUInt64TId: o = _objBinReadLeaf<uint64_t>(r,parent); break;
+      case kFloatTId:  o = _objBinReadLeaf<float>(r,parent);    break;
+      case kDoubleTId: o = _objBinReadLeaf<double>(r,parent);   break;
+      case kBoolTId:   o = _objBinReadLeaf<bool>(r,parent);     break;
+        
+      case kStringTId:
+        {
+          unsigned sn = 0;
+          char*    s  = nullptr;
+          
+          if( !_objBinRead(r,&sn,sizeof(sn)) )
+            return nullptr;
+
+          if( sn != kInvalidCnt )
+          {
+            if( r.buf + sn > r.end )
+              return nullptr;
+
+            s = mem::allocZ<char>(sn+1);
+            memcpy(s,r.buf,sn);
+            r.buf += sn;
+          }
+
+          o = _objCreateValueNode<char*>(parent,s);
+          mem::release(s);
+        }
+        break;
+
+      case kPairTId:
+      case kListTId:
+      case kDictTId:
+      case kRootTId:
+        {
+          unsigned chN = 0;
+          
+          if( !_objBinRead(r,&chN,sizeof(chN)) )
+            return nullptr;
+
+          if((o = _objAllocAndAttach(tid,parent)) == nullptr )
+            return nullptr;
+
+          for(unsigned i=0; i<chN; ++i)
+            if( _objBinReadNode(r,o) == nullptr )
+            {
+              // only free the node if it was not attached to a parent
+              if( parent == nullptr )
+                o->free();
+              return nullptr;
+            }
+        }
+        break;
+    }
+
+    return o;
+  }
+
+  char* _objCacheFileName( const char* fn, const char* cache_dir )
+  {
+    char* name = mem::printf<char>(nullptr,"%016llx",objectTextHash(fn,textLength(fn)));
+    char* cfn  = filesys::makeFn(cache_dir,name,"cwob",nullptr);
+    mem::release(name);
+    return cfn;
+  }
+}
+
+unsigned long long cw::objectTextHash( const char* buf, unsigned bufByteN )
+{
+  unsigned long long h = 0xcbf29ce484222325ull;
+  
+  for(unsigned i=0; i<bufByteN; ++i)
+  {
+    h ^= (unsigned char)buf[i];
+    h *= 0x100000001b3ull;
+  }
+
+  return h;
+}
+
+cw::rc_t cw::objectToBinary( const object_t* obj, unsigned long long src_hash, char*& bufRef, unsigned& bufByteNRef )
+{
+  rc_t          rc    = kOkRC;
+  unsigned      nodeN = 0;
+  obj_bin_hdr_t hdr   = { {'c','w','o','b'}, kObjBinVersion, src_hash };
+  
+  bufRef      = nullptr;
+  bufByteNRef = 0;
+
+  if( obj == nullptr )
+    return cwLogError(kInvalidArgRC,"A null object cannot be serialized.");
+  
+  if((nodeN = _objBinByteCount(obj)) == kInvalidCnt )
+    return cwLogError(kInvalidArgRC,"The object contains a node type which cannot be serialized.");
+
+  bufByteNRef = sizeof(hdr) + nodeN;
+  bufRef      = mem::alloc<char>(bufByteNRef);
+  
+  memcpy(bufRef,&hdr,sizeof(hdr));
+  _objBinWrite(obj,bufRef + sizeof(hdr));
+
+  return rc;
+}
+
+cw::rc_t cw::objectFromBinary( const char* buf, unsigned bufByteN, unsigned long long src_hash, object_t*& objRef )
+{
+  obj_bin_hdr_t hdr;
+  obj_bin_rd_t  r = { buf + sizeof(hdr), buf + bufByteN };
+
+  objRef = nullptr;
+  
+  if( buf == nullptr || bufByteN < sizeof(hdr) )
+    return cwLogError(kInvalidArgRC,"The binary object image is too short.");
+
+  memcpy(&hdr,buf,sizeof(hdr));
+
+  if( memcmp(hdr.tag,"cwob",4) != 0 || hdr.version != kObjBinVersion || hdr.src_hash != src_hash )
+    return kInvalidStateRC;
+
+  if((objRef = _objBinReadNode(r,nullptr)) == nullptr || r.buf != r.end )
+  {
+    if( objRef != nullptr )
+      objRef->free();
+    objRef = nullptr;
+    return cwLogError(kSyntaxErrorRC,"The binary object image is corrupt.");
+  }
+
+  return kOkRC;
+}
+
+cw::rc_t cw::objectFromFileCached( const char* fn, const char* cache_dir, object_t*& objRef )
+{
+  rc_t               rc       = kOkRC;
+  unsigned           textN    = 0;
+  char*              text     = nullptr;
+  char*              cache_fn = nullptr;
+  char*              bin      = nullptr;
+  unsigned           binN     = 0;
+  unsigned long long hash     = 0;
+
+  if( cache_dir == nullptr )
+    return objectFromFile(fn,objRef);
+
+  objRef = nullptr;
+
+  if((text = file::fnToStr(fn, &textN)) == nullptr )
+  {
+    rc = cwLogError(kOpFailRC,"Object parse failed on '%s'.",cwStringNullGuard(fn));
+    goto errLabel;
+  }
+
+  hash     = objectTextHash(text,textN);
+  cache_fn = _objCacheFileName(fn,cache_dir);
+
+  // use the cached image if it was created from the current text
+  if( filesys::isFile(cache_fn) && (bin = file::fnToBuf(cache_fn,&binN)) != nullptr )
+    if( objectFromBinary(bin,binN,hash,objRef) == kOkRC )
+      goto errLabel;
+
+  mem::release(bin);
+  
+  if((rc = objectFromString(text,objRef)) != kOkRC )
+  {
+    rc = cwLogError(rc,"Object parse failed on '%s'.",cwStringNullGuard(fn));
+    goto errLabel;
+  }
+
+  // update the cache - failure to write the cache is not an error
+  if( !filesys::isDir(cache_dir) && filesys::makeDir(cache_dir) != kOkRC )
+    cwLogWarning("The object cache directory '%s' could not be created.",cwStringNullGuard(cache_dir));
+  else
+    if( objRef != nullptr && objectToBinary(objRef,hash,bin,binN) == kOkRC )
+      if( file::fnWrite(cache_fn,bin,binN) != kOkRC )
+        cwLogWarning("The object cache file '%s' could not be written.",cwStringNullGuard(cache_fn));
+  
+errLabel:
+  mem::release(bin);
+  mem::release(cache_fn);
+  mem::release(text);
+  return rc;
+}
+
 /*
 namespace cw
 {
@@ -467,6 +467,25 @@ namespace cw
 
   rc_t objectToFile( const char* fn, const object_t* obj );
 
+  // 64 bit FNV-1a hash of a buffer. Used to identify the source text of a binary object image.
+  unsigned long long objectTextHash( const char* buf, unsigned bufByteN );
+
+  // Serialize an object into a versioned binary image.
+  // 'src_hash' identifies the text the object was parsed from (see objectTextHash()).
+  // The returned buffer must be released with mem::release().
+  rc_t objectToBinary( const object_t* obj, unsigned long long src_hash, char*& bufRef, unsigned& bufByteNRef );
+
+  // Create an object from a binary image created by objectToBinary().
+  // Returns kInvalidStateRC if the image was written by a different version of the serializer
+  // or if 'src_hash' does not match the hash stored in the image.
+  rc_t objectFromBinary( const char* buf, unsigned bufByteN, unsigned long long src_hash, object_t*& objRef );
+
+  // Same as objectFromFile() but the parsed object is cached as a binary image in 'cache_dir'.
+  // The cached image is used if it was created from the current text of 'fn'
+  // otherwise the text is parsed and the image is rewritten.
+  // If 'cache_dir' is nullptr then this function is equivalent to objectFromFile().
+  rc_t objectFromFileCached( const char* fn, const char* cache_dir, object_t*& objRef );
+
   //rc_t object_test( const test::test_args_t& args );
 
 
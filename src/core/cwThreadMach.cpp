@@ -713,9 +713,6 @@ namespace cw
         
       }while(1);
 
-      // reset the task thread futex var to zero.
-      p->thread_futex_var.store(0);
-      
       t->log_idx++;
       
       
@@ -725,6 +722,7 @@ namespace cw
     {
       thread_t* t = (thread_t*)arg;
       unsigned  op_id;
+      int       run_gen = 0; // value of 'thread_futex_var' on the last wake-up
       struct sched_param sched_parm{};
       int       sysRC;
       
@@ -742,18 +740,22 @@ namespace cw
       
       do
       {
-        // Block here until 'thread_futex_var' is set to non-zero
-        // the thread is awakened by the application.
-        if( _futex_wait(&t->p->thread_futex_var, 0) == -1 )
+        // 'thread_futex_var' is a generation counter which is incremented by the application
+        // on each call to run(). Block here until it changes. Unlike resetting the var to zero
+        // from the worker this cannot miss a wake-up which occurs while a previous run()
+        // is still being completed by this thread.
+        int gen = t->p->thread_futex_var.load(std::memory_order_acquire);
+        if( gen == run_gen )
         {
-          if( errno == EAGAIN )
-          {
-            continue;
-          }
+          if( _futex_wait(&t->p->thread_futex_var, run_gen) == -1 && errno != EAGAIN && errno != EINTR )
+            cwLogSysError(kOpFailRC,errno,"Worker thread futex wait failed.");
           
-          cwLogSysError(kOpFailRC,errno,"Worker thread futex wait failed.");
+          op_id = kRunOpId;
+          continue;
         }
 
+        run_gen = gen;
+
         TRACE_TIME( t->trace_id, tracer::kBegEvtId, 0, 0 );
 
         // Get the operation id set by the app.
@@ -839,7 +841,7 @@ namespace cw
 
       // Wake-up the task threads and tell them to exit.
       p->op_id.store(kExitOpId);
-      p->thread_futex_var.store(1);
+      p->thread_futex_var.fetch_add(1);
       
       if( _futex_wake(&p->thread_futex_var, p->threadN) == -1 )
       {
@@ -853,13 +855,13 @@ namespace cw
         {
           int sysRC;
 
-          if( p->threadA[i].label == nullptr )
-            printf("%i : ", i );
-          else
-            printf("%s : ",p->threadA[i].label);
-
           if( TASK_LOG_FL )
           {
+            if( p->threadA[i].label == nullptr )
+              printf("%i : ", i );
+            else
+              printf("%s : ",p->threadA[i].label);
+
             for(unsigned j=0; j<TASK_LOG_RECD_CNT; ++j)
               printf("%2i ",p->threadA[i].logA[j].task_cnt.load());
             printf("\n");
@@ -944,15 +946,18 @@ cw::rc_t cw::thread_ftasks::run( handle_t h, task_t* taskA, unsigned taskN, unsi
   
   thread_tasks_t* p = _handleToPtr(h);
   
+  // A worker may still be returning from the previous run() therefore the
+  // task list and completion state must be set before the task index is reset.
   p->app_futex_var.store(0);
-  p->next_task_idx.store(0);
   p->done_cnt.store(0);
   
   p->taskA = taskA;
   p->taskN = taskN;
   
-  p->op_id.store(kRunOpId);      // Tell the threads that they should enter 'run' mode.
-  p->thread_futex_var.store(1);  // Change the value of the futex var to unblock the waiting threads
+  p->next_task_idx.store(0);
+  
+  p->op_id.store(kRunOpId);        // Tell the threads that they should enter 'run' mode.
+  p->thread_futex_var.fetch_add(1);// Change the value of the futex var to unblock the waiting threads
 
   TRACE_TIME( p->trace_id, tracer::kBegEvtId, 0, 0);
   
@@ -968,16 +973,12 @@ cw::rc_t cw::thread_ftasks::run( handle_t h, task_t* taskA, unsigned taskN, unsi
   // 'app_futex_var' is set to 1 and this thread is a awakened.
   
   // wait for the tasks to run
-  if( _futex_wait(&p->app_futex_var, 0) == -1 )
+  // Under no-load the tasks will finish before the app thread waits.
+  // In this case the p->app_futext_var will be 1 (not 0) and errno will be set to EAGAIN.
+  // (See futex(7) FUTEX_WAIT). Spurious wake-ups are handled by re-checking 'app_futex_var'.
+  while( p->app_futex_var.load() == 0 )
   {
-    // Under no-load the tasks will finish before the app thread waits.
-    // In this case the p->app_futext_var will be 1 (not 0) and errno will be set to EAGAIN.
-    // (See futex(7) FUTEX_WAIT).
-    if( errno == EAGAIN && p->done_cnt.load() == p->taskN )
-    {
-      // All tasks finished before call to _futex_wait()
-    }
-    else
+    if( _futex_wait(&p->app_futex_var, 0) == -1 && errno != EAGAIN && errno != EINTR )
     {
       rc = cwLogSysError(kOpFailRC,errno,"App thread futex wait failed.");
       goto errLabel;
@@ -1459,8 +1460,7 @@ namespace cw
       char*                          label;
       bool                           created_fl;
       unsigned                       trace_id;
-      std::atomic_flag               lock_fl;
-      volatile std::atomic<unsigned> state_id;
+      volatile std::atomic<unsigned> state_id;  // kWaitOpId, kRunOpId or kExitOpId
     } thread_t;
 
     
@@ -1509,28 +1509,12 @@ namespace cw
       return true;      
     }
 
+    // 'state_id' is the only synchronization between the main thread and a worker.
+    // The main thread sets 'run' or 'exit' and the worker only ever changes 'run' to 'wait'
+    // (with a compare-exchange) so that an 'exit' request is never overwritten.
     void _set_worker_state( thread_t* t, unsigned state )
     {
-      
-      // Set lock_fl with memory_order_relaxed because the memory_order_release at the end of the function will guarantee the order of operations
-      switch( state )
-      {
-        case kWaitOpId:
-          std::atomic_flag_test_and_set_explicit(&t->lock_fl,std::memory_order_relaxed);
-          break;
-          
-        case kRunOpId:
-          std::atomic_flag_clear_explicit(&t->lock_fl,std::memory_order_relaxed);
-          break;
-
-        case kExitOpId:
-          std::atomic_flag_clear_explicit(&t->lock_fl,std::memory_order_relaxed);
-          break;
-
-      }
-      
       t->state_id.store(state, std::memory_order_release );
-      
     }
 
     unsigned _get_worker_state( thread_t* t )
@@ -1542,27 +1526,41 @@ namespace cw
     {
       unsigned cnt = 0; // 'cnt' is used for tracing purposes only
 
-      // run until there are no more available taskes
-      while( _run_one_task(t->p,t->trace_id,cnt) )
-        ++cnt;
+      while(1)
+      {
+        // run until there are no more available taskes
+        while( _run_one_task(t->p,t->trace_id,cnt) )
+          ++cnt;
+
+        // Return to the wait state - unless an exit was requested while the tasks were running.
+        // (run() may return, and destroy() may be called, before this worker has noticed that there are no more tasks)
+        unsigned run_id = kRunOpId;
+        if( !t->state_id.compare_exchange_strong(run_id, kWaitOpId, std::memory_order_acq_rel ) )
+          break;
 
-      // return to the wait state
-      _set_worker_state(t,kWaitOpId);
+        // A run() which started after the last task was taken may have set 'run' before the
+        // state was returned to 'wait' - in which case the new tasks are visible here.
+        if( t->p->next_task_idx.load(std::memory_order_acquire) >= t->p->taskN.load(std::memory_order_acquire) )
+          break;
 
+        unsigned wait_id = kWaitOpId;
+        if( !t->state_id.compare_exchange_strong(wait_id, kRunOpId, std::memory_order_acq_rel ) )
+          break;
+      }
     }
 
     
     // Returns kRunOpId or kExitOpId
     unsigned _worker_wait( thread_t* t )
     {
-      // atomic_test_and_set() sets 'lock_fl' and returns it's previous state
-      while (std::atomic_flag_test_and_set_explicit(&t->lock_fl, std::memory_order_acquire))
+      unsigned op_id;
+      
+      while((op_id = _get_worker_state(t)) == kWaitOpId )
       {
         _mm_pause();
       }      
       
-      
-      return _get_worker_state(t);
+      return op_id;
     }
 
     
@@ -1571,13 +1569,12 @@ namespace cw
       thread_t* t = (thread_t*)arg;
       unsigned op_id;
       
-      t->created_fl = true;
-      
       if( t->label != nullptr )
         pthread_setname_np(t->pthreadH, t->label);
 
-      // the thread is initially in 'wait' mode
-      _set_worker_state( t, kWaitOpId );
+      // Note that the thread is placed in 'wait' mode by _create_worker_thread() prior to
+      // the thread starting. Setting the state here would overwrite a 'exit' request
+      // made by a destroy() which follows immediately after create().
 
       do
       {
@@ -1642,12 +1639,17 @@ namespace cw
         }
       }
 
+      // the thread is initially in 'wait' mode
+      _set_worker_state( t, kWaitOpId );
+
       // create the thread
       if((sysRC = pthread_create(&t->pthreadH, &t->attr, _worker_thread_func, (void*)t )) != 0 )
       {
         rc = cwLogSysError(kOpFailRC,sysRC,"Thread create failed.");
         goto errLabel;
       }
+
+      t->created_fl = true;
       
       TRACE_REG(thread_prefix_label,thread_idx,t->trace_id);
 
@@ -131,6 +131,14 @@ double cw::time::seconds( const spec_t& t )
   return sec + ((double)t.tv_nsec)/NS_PER_SEC_ll;
 }
 
+unsigned long long cw::time::elapsedNanos( const spec_t& t0, const spec_t& t1 )
+{
+  const long long ns_per_sec = 1000000000;
+  long long       ns         = (long long)(t1.tv_sec - t0.tv_sec) * ns_per_sec + (t1.tv_nsec - t0.tv_nsec);
+  
+  return ns < 0 ? 0 : (unsigned long long)ns;
+}
+
 unsigned long long cw::time::elapsedMicros( const spec_t& t0, const spec_t& t1 )
 {  
   const unsigned long long ns_per_sec = 1000000000;
@@ -41,6 +41,9 @@ namespace cw
     // Return the elapsed time from t0 to now in microseconds.
     unsigned long long elapsedMicros( const spec_t&  t0 );
 
+    // Return the elapsed time (t1 - t0) in nanoseconds or 0 if t1 is before t0.
+    unsigned long long elapsedNanos( const spec_t& t0, const spec_t& t1 );
+
     // Wrapper for elapsedMicros()
     unsigned elapsedMs( const spec_t&  t0, const spec_t& t1 );
     unsigned elapsedMs( const spec_t&  t0 );
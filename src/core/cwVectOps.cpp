@@ -6,11 +6,465 @@
 #include "cwTest.h"
 #include "cwVectOps.h"
 
+// The kernels are compiled with '#pragma GCC target' which clang does not support.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && !defined(__clang__)
+#define cwVOP_X86_FL 1
+#include <immintrin.h>
+#else
+#define cwVOP_X86_FL 0
+#endif
+
+namespace cw
+{
+  namespace vop
+  {
+    namespace simd
+    {
+      namespace
+      {
+        template< typename T >
+        struct simd_tbl_t
+        {
+          void (*mul)(           T* y, const T* x0, const T* x1, unsigned n );
+          void (*mul_s)(         T* y, const T* x,  T s,         unsigned n );
+          void (*add)(           T* y, const T* x0, const T* x1, unsigned n );
+          void (*add_s)(         T* y, const T* x,  T s,         unsigned n );
+          void (*scale_add)(     T* y, const T* x0, T s0, const T* x1, T s1, unsigned n );
+          T    (*mac)(           const T* x0, const T* x1, unsigned n );
+          T    (*sum)(           const T* x, unsigned n );
+          T    (*sum_sq)(        const T* x, unsigned n );
+          void (*cmac)(          T* yr, T* yi, const T* ar, const T* ai, const T* br, const T* bi, unsigned n );
+          void (*interleave2)(   T* y, const T* x, unsigned frameN );
+          void (*deinterleave2)( T* y, const T* x, unsigned frameN );
+        };
+
+        //----------------------------------------------------------------------------------------------------------
+        // Scalar fallback
+        //
+        namespace scalar
+        {
+          template< typename T > void _mul(   T* y, const T* x0, const T* x1, unsigned n ) { for(unsigned i=0; i<n; ++i) y[i] = x0[i] * x1[i]; }
+          template< typename T > void _mul_s( T* y, const T* x,  T s,         unsigned n ) { for(unsigned i=0; i<n; ++i) y[i] = x[i] * s;  }
+          template< typename T > void _add(   T* y, const T* x0, const T* x1, unsigned n ) { for(unsigned i=0; i<n; ++i) y[i] = x0[i] + x1[i]; }
+          template< typename T > void _add_s( T* y, const T* x,  T s,         unsigned n ) { for(unsigned i=0; i<n; ++i) y[i] = x[i] + s;  }
+
+          template< typename T >
+          void _scale_add( T* y, const T* x0, T s0, const T* x1, T s1, unsigned n )
+          {
+            for(unsigned i=0; i<n; ++i)
+              y[i] = (x0[i] * s0) + (x1[i] * s1);
+          }
+
+          template< typename T >
+          T _mac( const T* x0, const T* x1, unsigned n )
+          {
+            T acc = 0;
+            for(unsigned i=0; i<n; ++i)
+              acc += x0[i] * x1[i];
+            return acc;
+          }
+
+          template< typename T >
+          T _sum( const T* x, unsigned n )
+          {
+            T acc = 0;
+            for(unsigned i=0; i<n; ++i)
+              acc += x[i];
+            return acc;
+          }
+
+          template< typename T >
+          T _sum_sq( const T* x, unsigned n )
+          {
+            T acc = 0;
+            for(unsigned i=0; i<n; ++i)
+              acc += x[i] * x[i];
+            return acc;
+          }
+
+          template< typename T >
+          void _cmac( T* yr, T* yi, const T* ar, const T* ai, const T* br, const T* bi, unsigned n )
+          {
+            for(unsigned i=0; i<n; ++i)
+            {
+              yr[i] += ar[i]*br[i] - ai[i]*bi[i];
+              yi[i] += ar[i]*bi[i] + ai[i]*br[i];
+            }
+          }
+
+          template< typename T >
+          void _interleave2( T* y, const T* x, unsigned frameN )
+          {
+            for(unsigned i=0; i<frameN; ++i)
+            {
+              y[2*i]   = x[i];
+              y[2*i+1] = x[frameN+i];
+            }
+          }
+
+          template< typename T >
+          void _deinterleave2( T* y, const T* x, unsigned frameN )
+          {
+            for(unsigned i=0; i<frameN; ++i)
+            {
+              y[i]        = x[2*i];
+              y[frameN+i] = x[2*i+1];
+            }
+          }
+
+          template< typename T >
+          constexpr simd_tbl_t<T> _tbl()
+          {
+            return { _mul<T>, _mul_s<T>, _add<T>, _add_s<T>, _scale_add<T>, _mac<T>, _sum<T>, _sum_sq<T>, _cmac<T>, _interleave2<T>, _deinterleave2<T> };
+          }
+
+          constexpr simd_tbl_t<float>  f_tbl = _tbl<float>();
+          constexpr simd_tbl_t<double> d_tbl = _tbl<double>();
+        }
+
+#if cwVOP_X86_FL
+
+        //----------------------------------------------------------------------------------------------------------
+        // SSE2
+        //
+#pragma GCC push_options
+#pragma GCC target("sse2")
+        namespace sse2
+        {
+          struct vf_t
+          {
+            typedef float  elem_t;
+            typedef __m128 reg_t;
+            static const unsigned N = 4;
+            static inline reg_t  load( const float* p )            { return _mm_loadu_ps(p); }
+            static inline void   store( float* p, reg_t v )        { _mm_storeu_ps(p,v); }
+            static inline reg_t  set1( float s )                   { return _mm_set1_ps(s); }
+            static inline reg_t  zero()                            { return _mm_setzero_ps(); }
+            static inline reg_t  add( reg_t a, reg_t b )           { return _mm_add_ps(a,b); }
+            static inline reg_t  sub( reg_t a, reg_t b )           { return _mm_sub_ps(a,b); }
+            static inline reg_t  mul( reg_t a, reg_t b )           { return _mm_mul_ps(a,b); }
+            static inline reg_t  fmadd( reg_t a, reg_t b, reg_t c ){ return _mm_add_ps(_mm_mul_ps(a,b),c); }
+            static inline float  hsum( reg_t v )
+            {
+              v = _mm_add_ps(v,_mm_movehl_ps(v,v));
+              v = _mm_add_ss(v,_mm_shuffle_ps(v,v,0x55));
+              return _mm_cvtss_f32(v);
+            }
+            static inline void zip( reg_t a, reg_t b, reg_t& lo, reg_t& hi )
+            {
+              lo = _mm_unpacklo_ps(a,b);
+              hi = _mm_unpackhi_ps(a,b);
+            }
+            static inline void unzip( reg_t x, reg_t y, reg_t& a, reg_t& b )
+            {
+              a = _mm_shuffle_ps(x,y,_MM_SHUFFLE(2,0,2,0));
+              b = _mm_shuffle_ps(x,y,_MM_SHUFFLE(3,1,3,1));
+            }
+          };
+
+          struct vd_t
+          {
+            typedef double  elem_t;
+            typedef __m128d reg_t;
+            static const unsigned N = 2;
+            static inline reg_t  load( const double* p )           { return _mm_loadu_pd(p); }
+            static inline void   store( double* p, reg_t v )       { _mm_storeu_pd(p,v); }
+            static inline reg_t  set1( double s )                  { return _mm_set1_pd(s); }
+            static inline reg_t  zero()                            { return _mm_setzero_pd(); }
+            static inline reg_t  add( reg_t a, reg_t b )           { return _mm_add_pd(a,b); }
+            static inline reg_t  sub( reg_t a, reg_t b )           { return _mm_sub_pd(a,b); }
+            static inline reg_t  mul( reg_t a, reg_t b )           { return _mm_mul_pd(a,b); }
+            static inline reg_t  fmadd( reg_t a, reg_t b, reg_t c ){ return _mm_add_pd(_mm_mul_pd(a,b),c); }
+            static inline double hsum( reg_t v )                   { return _mm_cvtsd_f64(_mm_add_sd(v,_mm_unpackhi_pd(v,v))); }
+            static inline void zip( reg_t a, reg_t b, reg_t& lo, reg_t& hi )
+            {
+              lo = _mm_unpacklo_pd(a,b);
+              hi = _mm_unpackhi_pd(a,b);
+            }
+            static inline void unzip( reg_t x, reg_t y, reg_t& a, reg_t& b )
+            {
+              a = _mm_unpacklo_pd(x,y);
+              b = _mm_unpackhi_pd(x,y);
+            }
+          };
+
+#include "cwVectOpsKernels.h"
+
+          constexpr simd_tbl_t<float>  f_tbl = k_tbl<vf_t>();
+          constexpr simd_tbl_t<double> d_tbl = k_tbl<vd_t>();
+        }
+#pragma GCC pop_options
+
+        //----------------------------------------------------------------------------------------------------------
+        // AVX2 + FMA
+        //
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+        namespace avx2
+        {
+          struct vf_t
+          {
+            typedef float  elem_t;
+            typedef __m256 reg_t;
+            static const unsigned N = 8;
+            static inline reg_t  load( const float* p )            { return _mm256_loadu_ps(p); }
+            static inline void   store( float* p, reg_t v )        { _mm256_storeu_ps(p,v); }
+            static inline reg_t  set1( float s )                   { return _mm256_set1_ps(s); }
+            static inline reg_t  zero()                            { return _mm256_setzero_ps(); }
+            static inline reg_t  add( reg_t a, reg_t b )           { return _mm256_add_ps(a,b); }
+            static inline reg_t  sub( reg_t a, reg_t b )           { return _mm256_sub_ps(a,b); }
+            static inline reg_t  mul( reg_t a, reg_t b )           { return _mm256_mul_ps(a,b); }
+            static inline reg_t  fmadd( reg_t a, reg_t b, reg_t c ){ return _mm256_fmadd_ps(a,b,c); }
+            static inline float  hsum( reg_t v )
+            {
+              __m128 s = _mm_add_ps(_mm256_castps256_ps128(v),_mm256_extractf128_ps(v,1));
+              s = _mm_add_ps(s,_mm_movehl_ps(s,s));
+              s = _mm_add_ss(s,_mm_shuffle_ps(s,s,0x55));
+              return _mm_cvtss_f32(s);
+            }
+            static inline void zip( reg_t a, reg_t b, reg_t& lo, reg_t& hi )
+            {
+              reg_t t0 = _mm256_unpacklo_ps(a,b); // a0 b0 a1 b1 | a4 b4 a5 b5
+              reg_t t1 = _mm256_unpackhi_ps(a,b); // a2 b2 a3 b3 | a6 b6 a7 b7
+              lo = _mm256_permute2f128_ps(t0,t1,0x20);
+              hi = _mm256_permute2f128_ps(t0,t1,0x31);
+            }
+            static inline void unzip( reg_t x, reg_t y, reg_t& a, reg_t& b )
+            {
+              // the shuffle leaves the 64 bit pairs in the order 0 2 1 3
+              a = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(x,y,_MM_SHUFFLE(2,0,2,0))),_MM_SHUFFLE(3,1,2,0)));
+              b = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(x,y,_MM_SHUFFLE(3,1,3,1))),_MM_SHUFFLE(3,1,2,0)));
+            }
+          };
+
+          struct vd_t
+          {
+            typedef double  elem_t;
+            typedef __m256d reg_t;
+            static const unsigned N = 4;
+            static inline reg_t  load( const double* p )           { return _mm256_loadu_pd(p); }
+            static inline void   store( double* p, reg_t v )       { _mm256_storeu_pd(p,v); }
+            static inline reg_t  set1( double s )                  { return _mm256_set1_pd(s); }
+            static inline reg_t  zero()                            { return _mm256_setzero_pd(); }
+            static inline reg_t  add( reg_t a, reg_t b )           { return _mm256_add_pd(a,b); }
+            static inline reg_t  sub( reg_t a, reg_t b )           { return _mm256_sub_pd(a,b); }
+            static inline reg_t  mul( reg_t a, reg_t b )           { return _mm256_mul_pd(a,b); }
+            static inline reg_t  fmadd( reg_t a, reg_t b, reg_t c ){ return _mm256_fmadd_pd(a,b,c); }
+            static inline double hsum( reg_t v )
+            {
+              __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v),_mm256_extractf128_pd(v,1));
+              return _mm_cvtsd_f64(_mm_add_sd(s,_mm_unpackhi_pd(s,s)));
+            }
+            static inline void zip( reg_t a, reg_t b, reg_t& lo, reg_t& hi )
+            {
+              reg_t t0 = _mm256_unpacklo_pd(a,b); // a0 b0 | a2 b2
+              reg_t t1 = _mm256_unpackhi_pd(a,b); // a1 b1 | a3 b3
+              lo = _mm256_permute2f128_pd(t0,t1,0x20);
+              hi = _mm256_permute2f128_pd(t0,t1,0x31);
+            }
+            static inline void unzip( reg_t x, reg_t y, reg_t& a, reg_t& b )
+            {
+              a = _mm256_permute4x64_pd(_mm256_unpacklo_pd(x,y),_MM_SHUFFLE(3,1,2,0));
+              b = _mm256_permute4x64_pd(_mm256_unpackhi_pd(x,y),_MM_SHUFFLE(3,1,2,0));
+            }
+          };
+
+#include "cwVectOpsKernels.h"
+
+          constexpr simd_tbl_t<float>  f_tbl = k_tbl<vf_t>();
+          constexpr simd_tbl_t<double> d_tbl = k_tbl<vd_t>();
+        }
+#pragma GCC pop_options
+
+        //----------------------------------------------------------------------------------------------------------
+        // AVX-512F
+        //
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+        namespace avx512
+        {
+          struct vf_t
+          {
+            typedef float  elem_t;
+            typedef __m512 reg_t;
+            static const unsigned N = 16;
+            static inline reg_t  load( const float* p )            { return _mm512_loadu_ps(p); }
+            static inline void   store( float* p, reg_t v )        { _mm512_storeu_ps(p,v); }
+            static inline reg_t  set1( float s )                   { return _mm512_set1_ps(s); }
+            static inline reg_t  zero()                            { return _mm512_setzero_ps(); }
+            static inline reg_t  add( reg_t a, reg_t b )           { return _mm512_add_ps(a,b); }
+            static inline reg_t  sub( reg_t a, reg_t b )           { return _mm512_sub_ps(a,b); }
+            static inline reg_t  mul( reg_t a, reg_t b )           { return _mm512_mul_ps(a,b); }
+            static inline reg_t  fmadd( reg_t a, reg_t b, reg_t c ){ return _mm512_fmadd_ps(a,b,c); }
+            static inline float  hsum( reg_t v )
+            {
+              // Reduce to 256 bits and finish as in avx2::vf_t::hsum(). _mm512_reduce_add_ps(), the 512->256 casts and
+              // the unmasked _mm512_extractf64x4_pd() use an undefined register which raises -Wuninitialized.
+              __m512d d = _mm512_castps_pd(v);
+              __m256  lo = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xff,d,0));
+              __m256  hi = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xff,d,1));
+              return avx2::vf_t::hsum(_mm256_add_ps(lo,hi));
+            }
+            static inline void zip( reg_t a, reg_t b, reg_t& lo, reg_t& hi )
+            {
+              lo = _mm512_permutex2var_ps(a,_mm512_setr_epi32(0,16,1,17,2,18,3,19,4,20,5,21,6,22,7,23),b);
+              hi = _mm512_permutex2var_ps(a,_mm512_setr_epi32(8,24,9,25,10,26,11,27,12,28,13,29,14,30,15,31),b);
+            }
+            static inline void unzip( reg_t x, reg_t y, reg_t& a, reg_t& b )
+            {
+              a = _mm512_permutex2var_ps(x,_mm512_setr_epi32(0,2,4,6,8,10,12,14,16,18,20,22,24,26,28,30),y);
+              b = _mm512_permutex2var_ps(x,_mm512_setr_epi32(1,3,5,7,9,11,13,15,17,19,21,23,25,27,29,31),y);
+            }
+          };
+
+          struct vd_t
+          {
+            typedef double  elem_t;
+            typedef __m512d reg_t;
+            static const unsigned N = 8;
+            static inline reg_t  load( const double* p )           { return _mm512_loadu_pd(p); }
+            static inline void   store( double* p, reg_t v )       { _mm512_storeu_pd(p,v); }
+            static inline reg_t  set1( double s )                  { return _mm512_set1_pd(s); }
+            static inline reg_t  zero()                            { return _mm512_setzero_pd(); }
+            static inline reg_t  add( reg_t a, reg_t b )           { return _mm512_add_pd(a,b); }
+            static inline reg_t  sub( reg_t a, reg_t b )           { return _mm512_sub_pd(a,b); }
+            static inline reg_t  mul( reg_t a, reg_t b )           { return _mm512_mul_pd(a,b); }
+            static inline reg_t  fmadd( reg_t a, reg_t b, reg_t c ){ return _mm512_fmadd_pd(a,b,c); }
+            static inline double hsum( reg_t v )
+            {
+              // reduce to 256 bits and finish as in avx2::vd_t::hsum()
+              return avx2::vd_t::hsum(_mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xff,v,0),_mm512_maskz_extractf64x4_pd(0xff,v,1)));
+            }
+            static inline void zip( reg_t a, reg_t b, reg_t& lo, reg_t& hi )
+            {
+              lo = _mm512_permutex2var_pd(a,_mm512_setr_epi64(0,8,1,9,2,10,3,11),b);
+              hi = _mm512_permutex2var_pd(a,_mm512_setr_epi64(4,12,5,13,6,14,7,15),b);
+            }
+            static inline void unzip( reg_t x, reg_t y, reg_t& a, reg_t& b )
+            {
+              a = _mm512_permutex2var_pd(x,_mm512_setr_epi64(0,2,4,6,8,10,12,14),y);
+              b = _mm512_permutex2var_pd(x,_mm512_setr_epi64(1,3,5,7,9,11,13,15),y);
+            }
+          };
+
+#include "cwVectOpsKernels.h"
+
+          constexpr simd_tbl_t<float>  f_tbl = k_tbl<vf_t>();
+          constexpr simd_tbl_t<double> d_tbl = k_tbl<vd_t>();
+        }
+#pragma GCC pop_options
+
+#endif
+
+        //----------------------------------------------------------------------------------------------------------
+        // Dispatch
+        //
+
+        typedef struct dispatch_str
+        {
+          isa_id_t                    isa_id;
+          const simd_tbl_t<float>*  f;
+          const simd_tbl_t<double>* d;
+        } dispatch_t;
+
+        const char* _isa_labels[] = { "scalar", "sse2", "avx2", "avx512" };
+
+        void _dispatch_set( dispatch_t& d, isa_id_t isa_id )
+        {
+          d.isa_id = isa_id;
+
+          switch( isa_id )
+          {
+#if cwVOP_X86_FL
+            case kSse2IsaId:   d.f = &sse2::f_tbl;   d.d = &sse2::d_tbl;   break;
+            case kAvx2IsaId:   d.f = &avx2::f_tbl;   d.d = &avx2::d_tbl;   break;
+            case kAvx512IsaId: d.f = &avx512::f_tbl; d.d = &avx512::d_tbl; break;
+#endif
+            default:
+              d.isa_id = kScalarIsaId;
+              d.f      = &scalar::f_tbl;
+              d.d      = &scalar::d_tbl;
+          }
+        }
+
+        dispatch_t& _dispatch()
+        {
+          static dispatch_t d = [](){ dispatch_t d0; _dispatch_set(d0,detect_isa()); return d0; }();
+          return d;
+        }
+
+        inline const simd_tbl_t<float>&  _tbl( float )  { return *_dispatch().f; }
+        inline const simd_tbl_t<double>& _tbl( double ) { return *_dispatch().d; }
+      }
+    }
+  }
+}
+
+cw::vop::simd::isa_id_t cw::vop::simd::detect_isa()
+{
+#if cwVOP_X86_FL
+  __builtin_cpu_init();
+
+  if( __builtin_cpu_supports("avx512f") )
+    return kAvx512IsaId;
+
+  if( __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") )
+    return kAvx2IsaId;
+
+  if( __builtin_cpu_supports("sse2") )
+    return kSse2IsaId;
+#endif
+
+  return kScalarIsaId;
+}
+
+cw::vop::simd::isa_id_t cw::vop::simd::isa()
+{ return _dispatch().isa_id; }
+
+cw::vop::simd::isa_id_t cw::vop::simd::set_isa( isa_id_t isa_id )
+{
+  isa_id_t max_isa_id = detect_isa();
+
+  _dispatch_set( _dispatch(), isa_id > max_isa_id ? max_isa_id : isa_id );
+
+  return isa();
+}
+
+const char* cw::vop::simd::isa_label( isa_id_t isa_id )
+{ return isa_id < kIsaCnt ? _isa_labels[ isa_id ] : "<unknown>"; }
+
+void   cw::vop::simd::mul( float*  y, const float*  x0, const float*  x1, unsigned n ) { _tbl(float()).mul(y,x0,x1,n); }
+void   cw::vop::simd::mul( double* y, const double* x0, const double* x1, unsigned n ) { _tbl(double()).mul(y,x0,x1,n); }
+void   cw::vop::simd::mul( float*  y, const float*  x,  float  s,         unsigned n ) { _tbl(float()).mul_s(y,x,s,n); }
+void   cw::vop::simd::mul( double* y, const double* x,  double s,         unsigned n ) { _tbl(double()).mul_s(y,x,s,n); }
+void   cw::vop::simd::add( float*  y, const float*  x0, const float*  x1, unsigned n ) { _tbl(float()).add(y,x0,x1,n); }
+void   cw::vop::simd::add( double* y, const double* x0, const double* x1, unsigned n ) { _tbl(double()).add(y,x0,x1,n); }
+void   cw::vop::simd::add( float*  y, const float*  x,  float  s,         unsigned n ) { _tbl(float()).add_s(y,x,s,n); }
+void   cw::vop::simd::add( double* y, const double* x,  double s,         unsigned n ) { _tbl(double()).add_s(y,x,s,n); }
+
+void   cw::vop::simd::scale_add( float*  y, const float*  x0, float  s0, const float*  x1, float  s1, unsigned n ) { _tbl(float()).scale_add(y,x0,s0,x1,s1,n); }
+void   cw::vop::simd::scale_add( double* y, const double* x0, double s0, const double* x1, double s1, unsigned n ) { _tbl(double()).scale_add(y,x0,s0,x1,s1,n); }
+
+float  cw::vop::simd::mac(    const float*  x0, const float*  x1, unsigned n ) { return _tbl(float()).mac(x0,x1,n); }
+double cw::vop::simd::mac(    const double* x0, const double* x1, unsigned n ) { return _tbl(double()).mac(x0,x1,n); }
+float  cw::vop::simd::sum(    const float*  x, unsigned n )  { return _tbl(float()).sum(x,n); }
+double cw::vop::simd::sum(    const double* x, unsigned n )  { return _tbl(double()).sum(x,n); }
+float  cw::vop::simd::sum_sq( const float*  x, unsigned n )  { return _tbl(float()).sum_sq(x,n); }
+double cw::vop::simd::sum_sq( const double* x, unsigned n )  { return _tbl(double()).sum_sq(x,n); }
+
+void   cw::vop::simd::cmac( float*  yr, float*  yi, const float*  ar, const float*  ai, const float*  br, const float*  bi, unsigned n ) { _tbl(float()).cmac(yr,yi,ar,ai,br,bi,n); }
+void   cw::vop::simd::cmac( double* yr, double* yi, const double* ar, const double* ai, const double* br, const double* bi, unsigned n ) { _tbl(double()).cmac(yr,yi,ar,ai,br,bi,n); }
+
+void   cw::vop::simd::interleave2(   float*  y, const float*  x, unsigned frameN ) { _tbl(float()).interleave2(y,x,frameN); }
+void   cw::vop::simd::interleave2(   double* y, const double* x, unsigned frameN ) { _tbl(double()).interleave2(y,x,frameN); }
+void   cw::vop::simd::deinterleave2( float*  y, const float*  x, unsigned frameN ) { _tbl(float()).deinterleave2(y,x,frameN); }
+void   cw::vop::simd::deinterleave2( double* y, const double* x, unsigned frameN ) { _tbl(double()).deinterleave2(y,x,frameN); }
+
 cw::rc_t cw::vop::test( const test::test_args_t& args )
 {
   int v1[] = { 1,2,1,2,1,2,1,2,1,2 };
   int v0[ 10 ];
-  
+
   cw::vop::deinterleave( v0, v1, 5, 2 );
   cw::vop::print(v0,10,"%i ");
   return cw::kOkRC;
@@ -8,6 +8,64 @@ namespace cw
 {
   namespace vop
   {
+    //==================================================================================================================
+    // SIMD kernels
+    //
+    // The float and double versions of the arithmetic, reduction and interleave functions below
+    // are routed to SSE2, AVX2 or AVX-512 kernels. The kernel set is selected at runtime from the
+    // capabilities of the CPU and falls back to scalar loops on other architectures.
+    //
+    namespace simd
+    {
+      typedef enum
+      {
+        kScalarIsaId,
+        kSse2IsaId,
+        kAvx2IsaId,   // AVX2 + FMA
+        kAvx512IsaId, // AVX-512F
+        kIsaCnt
+      } isa_id_t;
+
+      // Return the most capable instruction set supported by this CPU.
+      isa_id_t    detect_isa();
+
+      // Return the instruction set currently in use.
+      isa_id_t    isa();
+
+      // Select the instruction set (limited to detect_isa()) and return the selected id.
+      // This function is intended for testing and benchmarking and is not thread safe.
+      isa_id_t    set_isa( isa_id_t id );
+
+      const char* isa_label( isa_id_t id );
+
+      // True if vop functions on T0 and T1 are routed to the kernels.
+      template< typename T0, typename T1 >
+      constexpr bool is_accel_v = std::is_same_v<T0,T1> && (std::is_same_v<T0,float> || std::is_same_v<T0,double>);
+
+      void   mul(         float*  y, const float*  x0, const float*  x1, unsigned n );
+      void   mul(         double* y, const double* x0, const double* x1, unsigned n );
+      void   mul(         float*  y, const float*  x,  float         s,  unsigned n );
+      void   mul(         double* y, const double* x,  double        s,  unsigned n );
+      void   add(         float*  y, const float*  x0, const float*  x1, unsigned n );
+      void   add(         double* y, const double* x0, const double* x1, unsigned n );
+      void   add(         float*  y, const float*  x,  float         s,  unsigned n );
+      void   add(         double* y, const double* x,  double        s,  unsigned n );
+      void   scale_add(   float*  y, const float*  x0, float  s0, const float*  x1, float  s1, unsigned n );
+      void   scale_add(   double* y, const double* x0, double s0, const double* x1, double s1, unsigned n );
+      float  mac(         const float*  x0, const float*  x1, unsigned n );
+      double mac(         const double* x0, const double* x1, unsigned n );
+      float  sum(         const float*  x, unsigned n );
+      double sum(         const double* x, unsigned n );
+      float  sum_sq(      const float*  x, unsigned n );
+      double sum_sq(      const double* x, unsigned n );
+      void   cmac(        float*  yr, float*  yi, const float*  ar, const float*  ai, const float*  br, const float*  bi, unsigned n );
+      void   cmac(        double* yr, double* yi, const double* ar, const double* ai, const double* br, const double* bi, unsigned n );
+      void   interleave2(   float*  y, const float*  x, unsigned frameN );
+      void   interleave2(   double* y, const double* x, unsigned frameN );
+      void   deinterleave2( float*  y, const float*  x, unsigned frameN );
+      void   deinterleave2( double* y, const double* x, unsigned frameN );
+    }
+
     //==================================================================================================================
     // Input / Output
     //
@@ -151,6 +209,9 @@ namespace cw
     template< typename T0, typename T1 >
       T0 mac( const T0* v0, const T1* v1, unsigned n )
     {
+      if constexpr( simd::is_accel_v<T0,T1> )
+        return simd::mac(v0,v1,n);
+        
       T0 acc = 0;
       for(unsigned i=0; i<n; ++i)
         acc += v0[i] * v1[i];
@@ -160,6 +221,12 @@ namespace cw
     template< typename T0, typename T1 >
     T0* scale_add( T0* v0, T0 scale_0, const T1* v1, T1 scale_1, unsigned n )
     {
+      if constexpr( simd::is_accel_v<T0,T1> )
+      {
+        simd::scale_add(v0,v0,scale_0,v1,scale_1,n);
+        return v0;
+      }
+      
       for(unsigned i=0; i<n; ++i)
         v0[i] = (v0[i] * scale_0) +  (v1[i] * scale_1);
       
@@ -169,6 +236,12 @@ namespace cw
     template< typename T0, typename T1, typename T2 >
       T0* scale_add( T0* v0, const T1* v1, T1 scale_1, const T2* v2, T2 scale_2, unsigned n )
     {
+      if constexpr( simd::is_accel_v<T0,T1> && simd::is_accel_v<T1,T2> )
+      {
+        simd::scale_add(v0,v1,scale_1,v2,scale_2,n);
+        return v0;
+      }
+      
       for(unsigned i=0; i<n; ++i)
         v0[i] = (v1[i] * scale_1) +  (v2[i] * scale_2);
       
@@ -176,6 +249,21 @@ namespace cw
     }
 
 
+    // Complex multiply-accumulate on split real/imaginary vectors: y += a * b
+    template< typename T >
+    void cmac( T* yr, T* yi, const T* ar, const T* ai, const T* br, const T* bi, unsigned n )
+    {
+      if constexpr( simd::is_accel_v<T,T> )
+        return simd::cmac(yr,yi,ar,ai,br,bi,n);
+
+      for(unsigned i=0; i<n; ++i)
+      {
+        yr[i] += ar[i]*br[i] - ai[i]*bi[i];
+        yi[i] += ar[i]*bi[i] + ai[i]*br[i];
+      }
+    }
+
+
     //==================================================================================================================
     // find, count
     //
@@ -226,6 +314,9 @@ namespace cw
     template< typename T0, typename T1 >
       void mul( T0* v0, const T1* v1, unsigned n )
     {
+      if constexpr( simd::is_accel_v<T0,T1> )
+        return simd::mul(v0,v0,v1,n);
+      
       for(unsigned i=0; i<n; ++i)
         v0[i] = v0[i] * (T1)v1[i];
     }
@@ -233,6 +324,9 @@ namespace cw
     template< typename T0, typename T1 >
       void mul( T0* y0, const T0* v0, const T1* v1, unsigned n )
     {
+      if constexpr( simd::is_accel_v<T0,T1> )
+        return simd::mul(y0,v0,v1,n);
+      
       for(unsigned i=0; i<n; ++i)
         y0[i] = v0[i] * v1[i];
     }
@@ -241,6 +335,9 @@ namespace cw
     template< typename T0, typename T1 >
       void mul( T0* v0, const T1& scalar, unsigned n )
     {
+      if constexpr( simd::is_accel_v<T0,T1> )
+        return simd::mul(v0,v0,scalar,n);
+      
       for(unsigned i=0; i<n; ++i)
         v0[i] *= scalar;
     }
@@ -248,6 +345,9 @@ namespace cw
     template< typename T0, typename T1, typename T2 >
       void mul( T0* y0, const T1* v0, const T2& scalar, unsigned n )
     {
+      if constexpr( simd::is_accel_v<T0,T1> && simd::is_accel_v<T1,T2> )
+        return simd::mul(y0,v0,scalar,n);
+      
       for(unsigned i=0; i<n; ++i)
         y0[i] = v0[i] * scalar;
     }
@@ -255,6 +355,9 @@ namespace cw
     template< typename T0, typename T1 >
       void add( T0* v0, const T1* v1, unsigned n )
     {
+      if constexpr( simd::is_accel_v<T0,T1> )
+        return simd::add(v0,v0,v1,n);
+      
       for(unsigned i=0; i<n; ++i)
         v0[i] += v1[i];
     }
@@ -262,6 +365,9 @@ namespace cw
     template< typename T0, typename T1 >
       void add( T0* y0, const T0* v0, const T1* v1, unsigned n )
     {
+      if constexpr( simd::is_accel_v<T0,T1> )
+        return simd::add(y0,v0,v1,n);
+      
       for(unsigned i=0; i<n; ++i)
         y0[i] = v0[i] + v1[i];
     }
@@ -269,6 +375,9 @@ namespace cw
     template< typename T0, typename T1 >
       void add( T0* v0, const T1& scalar, unsigned n )
     {
+      if constexpr( simd::is_accel_v<T0,T1> )
+        return simd::add(v0,v0,scalar,n);
+      
       for(unsigned i=0; i<n; ++i)
         v0[i] += scalar;
     }
@@ -276,6 +385,9 @@ namespace cw
     template< typename T0, typename T1 >
       void add( T0* y0, const T0* v0, const T1& scalar, unsigned n )
     {
+      if constexpr( simd::is_accel_v<T0,T1> )
+        return simd::add(y0,v0,scalar,n);
+      
       for(unsigned i=0; i<n; ++i)
         y0[i] = v0[i] + scalar;
     }
@@ -393,6 +505,9 @@ namespace cw
     template< typename T >
       T sum( const T* v, unsigned n )
     {
+      if constexpr( simd::is_accel_v<T,T> )
+        return simd::sum(v,n);
+      
       T y = 0;
       for(unsigned i=0; i<n; ++i)
         y += v[i];
@@ -433,6 +548,9 @@ namespace cw
     template< typename T0 >
     T0 sum_sq( const T0* v, unsigned n )
     {
+      if constexpr( simd::is_accel_v<T0,T0> )
+        return simd::sum_sq(v,n);
+      
       T0 sum = 0;
       for(unsigned i=0; i<n; ++i)
         sum += v[i] * v[i];
@@ -477,6 +595,10 @@ namespace cw
     void interleave( T0* v0, const T1* v1, unsigned frameN, unsigned dstChCnt )
     {
       // v0[] = { LRLRLRLR ], v1[] = [ LLLLRRRR ]
+      if constexpr( simd::is_accel_v<T0,T1> )
+        if( dstChCnt == 2 )
+          return simd::interleave2(v0,v1,frameN);
+      
       for(unsigned k=0; k<dstChCnt; ++k)
       {
         unsigned n = k*frameN;
@@ -489,6 +611,10 @@ namespace cw
     void deinterleave( T0* v0, const T1* v1, unsigned frameN, unsigned srcChCnt )
     {
       // v0[] = [ LLLLRRRR ], v1[] = { LRLRLRLR ]
+      if constexpr( simd::is_accel_v<T0,T1> )
+        if( srcChCnt == 2 )
+          return simd::deinterleave2(v0,v1,frameN);
+      
       for(unsigned k=0; k<srcChCnt; ++k)
       {
         unsigned n = k*frameN;
@@ -549,12 +675,8 @@ namespace cw
     {
       T rms = 0;
       if( xN > 0 )
-      {
-        T x0[ xN ];
-        mul(x0,x,x,xN);
-        rms = std::sqrt(sum(x0,xN)/(T)xN);
-        
-      }
+        rms = std::sqrt(sum_sq(x,xN)/(T)xN);
+      
       return rms;  
         
     }
@@ -0,0 +1,233 @@
+//| Copyright: (C) 2020-2024 Kevin Larke <contact AT larke DOT org>
+//| License: GNU GPL version 3.0 or above. See the accompanying LICENSE file.
+
+// Generic SIMD kernels used by cwVectOps.cpp.
+//
+// This file is intentionally not guarded against multiple inclusion.
+// It is included once for each instruction set inside a '#pragma GCC target' region
+// and a namespace which defines the register traits 'vf_t' (float) and 'vd_t' (double).
+//
+// A traits type 'V' provides:
+//   elem_t, reg_t, N (elements per register),
+//   load(), store(), set1(), zero(), add(), sub(), mul(), fmadd(a,b,c) (a*b+c), hsum(),
+//   zip(a,b,lo,hi)   - lo,hi = a0 b0 a1 b1 ...
+//   unzip(x,y,a,b)   - inverse of zip()
+//
+// Element-wise kernels use only mul(), add() and sub() in the operation order of the scalar code.
+// cwVectOps.cpp is compiled with -ffp-contract=off (See src/CMakeLists.txt) so that neither these
+// kernels nor the scalar code are contracted to fused multiply-adds and the results are identical.
+// Reductions (mac, sum, sum_sq) use fmadd() and two accumulators and so may differ from the scalar code by rounding.
+
+template< typename V >
+void k_mul( typename V::elem_t* y, const typename V::elem_t* x0, const typename V::elem_t* x1, unsigned n )
+{
+  unsigned i = 0;
+  for(; i+V::N<=n; i+=V::N)
+    V::store(y+i, V::mul(V::load(x0+i),V::load(x1+i)));
+
+  for(; i<n; ++i)
+    y[i] = x0[i] * x1[i];
+}
+
+template< typename V >
+void k_mul_s( typename V::elem_t* y, const typename V::elem_t* x, typename V::elem_t s, unsigned n )
+{
+  typename V::reg_t sv = V::set1(s);
+  unsigned          i  = 0;
+  for(; i+V::N<=n; i+=V::N)
+    V::store(y+i, V::mul(V::load(x+i),sv));
+
+  for(; i<n; ++i)
+    y[i] = x[i] * s;
+}
+
+template< typename V >
+void k_add( typename V::elem_t* y, const typename V::elem_t* x0, const typename V::elem_t* x1, unsigned n )
+{
+  unsigned i = 0;
+  for(; i+V::N<=n; i+=V::N)
+    V::store(y+i, V::add(V::load(x0+i),V::load(x1+i)));
+
+  for(; i<n; ++i)
+    y[i] = x0[i] + x1[i];
+}
+
+template< typename V >
+void k_add_s( typename V::elem_t* y, const typename V::elem_t* x, typename V::elem_t s, unsigned n )
+{
+  typename V::reg_t sv = V::set1(s);
+  unsigned          i  = 0;
+  for(; i+V::N<=n; i+=V::N)
+    V::store(y+i, V::add(V::load(x+i),sv));
+
+  for(; i<n; ++i)
+    y[i] = x[i] + s;
+}
+
+// y = x0*s0 + x1*s1 (the products are not fused so that the result matches the scalar code)
+template< typename V >
+void k_scale_add( typename V::elem_t* y, const typename V::elem_t* x0, typename V::elem_t s0, const typename V::elem_t* x1, typename V::elem_t s1, unsigned n )
+{
+  typename V::reg_t s0v = V::set1(s0);
+  typename V::reg_t s1v = V::set1(s1);
+  unsigned          i   = 0;
+  for(; i+V::N<=n; i+=V::N)
+    V::store(y+i, V::add(V::mul(V::load(x0+i),s0v),V::mul(V::load(x1+i),s1v)));
+
+  for(; i<n; ++i)
+    y[i] = (x0[i] * s0) + (x1[i] * s1);
+}
+
+template< typename V >
+typename V::elem_t k_mac( const typename V::elem_t* x0, const typename V::elem_t* x1, unsigned n )
+{
+  typename V::reg_t a0 = V::zero();
+  typename V::reg_t a1 = V::zero();
+  unsigned          i  = 0;
+
+  for(; i+2*V::N<=n; i+=2*V::N)
+  {
+    a0 = V::fmadd(V::load(x0+i),      V::load(x1+i),      a0);
+    a1 = V::fmadd(V::load(x0+i+V::N), V::load(x1+i+V::N), a1);
+  }
+
+  for(; i+V::N<=n; i+=V::N)
+    a0 = V::fmadd(V::load(x0+i), V::load(x1+i), a0);
+
+  typename V::elem_t acc = V::hsum(V::add(a0,a1));
+
+  for(; i<n; ++i)
+    acc += x0[i] * x1[i];
+
+  return acc;
+}
+
+template< typename V >
+typename V::elem_t k_sum( const typename V::elem_t* x, unsigned n )
+{
+  typename V::reg_t a0 = V::zero();
+  typename V::reg_t a1 = V::zero();
+  unsigned          i  = 0;
+
+  for(; i+2*V::N<=n; i+=2*V::N)
+  {
+    a0 = V::add(V::load(x+i),      a0);
+    a1 = V::add(V::load(x+i+V::N), a1);
+  }
+
+  for(; i+V::N<=n; i+=V::N)
+    a0 = V::add(V::load(x+i), a0);
+
+  typename V::elem_t acc = V::hsum(V::add(a0,a1));
+
+  for(; i<n; ++i)
+    acc += x[i];
+
+  return acc;
+}
+
+template< typename V >
+typename V::elem_t k_sum_sq( const typename V::elem_t* x, unsigned n )
+{
+  typename V::reg_t a0 = V::zero();
+  typename V::reg_t a1 = V::zero();
+  unsigned          i  = 0;
+
+  for(; i+2*V::N<=n; i+=2*V::N)
+  {
+    typename V::reg_t r0 = V::load(x+i);
+    typename V::reg_t r1 = V::load(x+i+V::N);
+    a0 = V::fmadd(r0,r0,a0);
+    a1 = V::fmadd(r1,r1,a1);
+  }
+
+  for(; i+V::N<=n; i+=V::N)
+  {
+    typename V::reg_t r0 = V::load(x+i);
+    a0 = V::fmadd(r0,r0,a0);
+  }
+
+  typename V::elem_t acc = V::hsum(V::add(a0,a1));
+
+  for(; i<n; ++i)
+    acc += x[i] * x[i];
+
+  return acc;
+}
+
+// Split complex multiply-accumulate: y += a * b
+// (the products are not fused so that the result matches the scalar code)
+template< typename V >
+void k_cmac( typename V::elem_t* yr, typename V::elem_t* yi, const typename V::elem_t* ar, const typename V::elem_t* ai, const typename V::elem_t* br, const typename V::elem_t* bi, unsigned n )
+{
+  unsigned i = 0;
+  for(; i+V::N<=n; i+=V::N)
+  {
+    typename V::reg_t arv = V::load(ar+i);
+    typename V::reg_t aiv = V::load(ai+i);
+    typename V::reg_t brv = V::load(br+i);
+    typename V::reg_t biv = V::load(bi+i);
+    V::store(yr+i, V::add(V::load(yr+i),V::sub(V::mul(arv,brv),V::mul(aiv,biv))));
+    V::store(yi+i, V::add(V::load(yi+i),V::add(V::mul(arv,biv),V::mul(aiv,brv))));
+  }
+
+  for(; i<n; ++i)
+  {
+    yr[i] += ar[i]*br[i] - ai[i]*bi[i];
+    yi[i] += ar[i]*bi[i] + ai[i]*br[i];
+  }
+}
+
+// y[ LRLRLR... ] = x[ LLL...RRR... ]
+template< typename V >
+void k_interleave2( typename V::elem_t* y, const typename V::elem_t* x, unsigned frameN )
+{
+  const typename V::elem_t* l = x;
+  const typename V::elem_t* r = x + frameN;
+  unsigned                  i = 0;
+
+  for(; i+V::N<=frameN; i+=V::N)
+  {
+    typename V::reg_t lo,hi;
+    V::zip(V::load(l+i),V::load(r+i),lo,hi);
+    V::store(y+2*i,     lo);
+    V::store(y+2*i+V::N,hi);
+  }
+
+  for(; i<frameN; ++i)
+  {
+    y[2*i]   = l[i];
+    y[2*i+1] = r[i];
+  }
+}
+
+// y[ LLL...RRR... ] = x[ LRLRLR... ]
+template< typename V >
+void k_deinterleave2( typename V::elem_t* y, const typename V::elem_t* x, unsigned frameN )
+{
+  typename V::elem_t* l = y;
+  typename V::elem_t* r = y + frameN;
+  unsigned            i = 0;
+
+  for(; i+V::N<=frameN; i+=V::N)
+  {
+    typename V::reg_t lv,rv;
+    V::unzip(V::load(x+2*i),V::load(x+2*i+V::N),lv,rv);
+    V::store(l+i,lv);
+    V::store(r+i,rv);
+  }
+
+  for(; i<frameN; ++i)
+  {
+    l[i] = x[2*i];
+    r[i] = x[2*i+1];
+  }
+}
+
+// The table is built at compile time so that no code compiled for the target instruction set
+// is executed before the CPU has been checked.
+template< typename V >
+constexpr simd_tbl_t<typename V::elem_t> k_tbl()
+{
+  return { k_mul<V>, k_mul_s<V>, k_add<V>, k_add_s<V>, k_scale_add<V>, k_mac<V>, k_sum<V>, k_sum_sq<V>, k_cmac<V>, k_interleave2<V>, k_deinterleave2<V> };
+}
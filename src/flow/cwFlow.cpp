@@ -8,12 +8,16 @@
 #include "cwText.h"
 #include "cwNumericConvert.h"
 #include "cwObject.h"
+#include "cwNbMpScQueue.h"
+#include "cwFileSys.h"
 #include "cwTracer.h"
 
 #include "cwAudioFile.h"
 #include "cwVectOps.h"
 #include "cwMtx.h"
 #include "cwDspTypes.h" // coeff_t, sample_t, srate_t ...
+#include "cwMath.h"
+#include "cwDsp.h"
 #include "cwTime.h"
 #include "cwMidiDecls.h"
 #include "cwFlowDecl.h"
@@ -61,6 +65,7 @@ namespace cw
       { "limiter",         &limiter::members },
       { "audio_delay",     &audio_delay::members },
       { "dc_filter",       &dc_filter::members },
+      { "convolve",        &convolve::members },
       { "balance",         &balance::members },
       { "audio_meter",     &audio_meter::members },
       { "audio_marker",    &audio_marker::members },
@@ -377,6 +382,48 @@ namespace cw
       return rc;
     }
     
+    rc_t _parse_class_bypass( bypass_desc_t& bypass, const object_t* bypassCfg )
+    {
+      rc_t        rc    = kOkRC;
+      const char* mode  = nullptr;
+
+      bypass = {};
+      
+      if( bypassCfg == nullptr )
+        return rc;
+
+      if((rc = bypassCfg->readv("in",         0,      bypass.in_label,
+                                "out",        0,      bypass.out_label,
+                                "ctl",        kOptFl, bypass.ctl_label,
+                                "gain",       kOptFl, bypass.gain_label,
+                                "mode",       kOptFl, mode,
+                                "silence_fl", kOptFl, bypass.silenceFl)) != kOkRC )
+      {
+        rc = cwLogError(rc,"The 'bypass' field parse failed.");
+        goto errLabel;
+      }
+
+      bypass.modeId = kCopyBypassModeId;
+      
+      if( mode != nullptr )
+      {
+        if( textIsEqual(mode,"zero") )
+          bypass.modeId = kZeroBypassModeId;
+        else
+          if( !textIsEqual(mode,"copy") )
+          {
+            rc = cwLogError(kSyntaxErrorRC,"The bypass mode '%s' is not valid. Use 'copy' or 'zero'.",mode);
+            goto errLabel;
+          }
+      }
+      
+    errLabel:
+      if( rc != kOkRC )
+        bypass = {};
+      
+      return rc;
+    }
+    
     rc_t  _parse_class_cfg(flow_t* p, const object_t* classCfg)
     {
       rc_t rc = kOkRC;
@@ -393,25 +440,49 @@ namespace cw
         const object_t* class_obj = classCfg->child_ele(i);
         const object_t* varD      = nullptr;
         const object_t* presetD   = nullptr;
+        const object_t* rateCfg   = nullptr;
+        const object_t* bypassCfg = nullptr;
         class_desc_t*   cd        = p->classDescA + i;
 
         cd->cfg    = class_obj->pair_value();
         cd->label  = class_obj->pair_label();
+        cd->symTbl = &p->symTbl;
+
+        hash_index_insert(p->classDescIdx, sym_intern(p->symTbl,cd->label), 0, 0, cd );
         
         // get the variable description 
         if((rc = cd->cfg->getv_opt("vars",  varD,
                                    "presets", presetD,
-                                   "poly_limit_cnt", cd->polyLimitN)) != kOkRC )
+                                   "poly_limit_cnt", cd->polyLimitN,
+                                   "parallel_fl",    cd->parallelFl,
+                                   "abuf_pool_fl",   cd->abufPoolFl,
+                                   "rate",           rateCfg,
+                                   "bypass",         bypassCfg)) != kOkRC )
         {
           rc = cwLogError(rc,"Parsing failed while parsing class desc:'%s'", cwStringNullGuard(cd->label) );
           goto errLabel;                      
         }
 
+        if((rc = exec_rate_parse( rateCfg, cd->execRate )) != kOkRC )
+        {
+          rc = cwLogError(rc,"The execution rate for the class desc: '%s' could not be parsed.",cwStringNullGuard(cd->label));
+          goto errLabel;
+        }
+
+        if((rc = _parse_class_bypass( cd->bypass, bypassCfg )) != kOkRC )
+        {
+          rc = cwLogError(rc,"The bypass for the class desc: '%s' could not be parsed.",cwStringNullGuard(cd->label));
+          goto errLabel;
+        }
+
         if((rc = _create_preset_list( cd->presetL, presetD )) != kOkRC )
         {
           rc = cwLogError(rc,"The presets for the class desc: '%s' could not be parsed.",cwStringNullGuard(cd->label));
           goto errLabel;
         }
+
+        for(class_preset_t* pr=cd->presetL; pr!=nullptr; pr=pr->link)
+          hash_index_insert(cd->presetIdx, sym_intern(p->symTbl,pr->label), 0, 0, pr );
         
 
         // create the class descripiton
@@ -635,6 +706,7 @@ namespace cw
 
       class_desc->cfg    = class_obj->pair_value();
       class_desc->label  = class_obj->pair_label();
+      class_desc->symTbl = &p->symTbl;
 
       // get the 'UDP' members record
       if((class_desc->members = _find_library_record("user_def_proc")) == nullptr )
@@ -700,6 +772,8 @@ namespace cw
         // as we go because we may want be able to search p->udpDescA[]
         // aand to do that we must now the current length.
         p->udpDescN += 1;
+
+        hash_index_insert(p->classDescIdx, sym_intern(p->symTbl,p->udpDescA[i].label), 0, 0, p->udpDescA + i );
       }
 
       assert( udpDescN == p->udpDescN );
@@ -798,6 +872,156 @@ namespace cw
       mem::release(classDescA);      
     }
     
+    // Record a deadline miss if the root network execution time on the last cycle exceeded the deadline.
+    void _deadline_check( flow_t* p )
+    {
+      network_t* net = p->net;
+      
+      if( net->prof_cycle_ns <= p->deadline_ns )
+        return;
+      
+      deadline_miss_recd_t* r = p->deadline_missA + (p->deadline_miss_cnt % kDeadlineMissRecdN);
+
+      r->cycle_idx = p->cycleIndex;
+      r->dur_ns    = net->prof_cycle_ns;
+      r->proc      = nullptr;
+      r->proc_ns   = 0;
+
+      // locate the proc with the longest execution time on this cycle
+      for(unsigned i=0; i<net->procN; ++i)
+      {
+        proc_t* proc = net->procA[i];
+        if( proc->prof_cycle_idx == p->cycleIndex && (r->proc == nullptr || proc->prof_cycle_ns > r->proc_ns) )
+        {
+          r->proc    = proc;
+          r->proc_ns = proc->prof_cycle_ns;
+        }
+      }
+
+      if( r->proc != nullptr )
+        r->proc->deadline_miss_cnt += 1;
+      
+      p->deadline_miss_cnt += 1;
+    }
+    
+    //
+    // Variable Control Queue
+    //
+    // Values posted to a var_ctl_t by non-audio threads are pushed onto a lock-free
+    // multi-producer/single-consumer queue which is drained at the start of each cycle.
+    
+    typedef struct var_ctl_str
+    {
+      proc_t*             proc;  // target proc
+      unsigned            vid;   // target variable id
+      unsigned            chIdx; // target channel
+      struct var_ctl_str* link;
+    } var_ctl_t;
+
+    typedef struct var_ctl_msg_str
+    {
+      var_ctl_t* ctl;
+      value_t    value;
+    } var_ctl_msg_t;
+
+    typedef struct var_ctl_queue_str
+    {
+      nbmpscq::handle_t       qH;
+      std::atomic<var_ctl_t*> ctlL; // resolved control records
+    } var_ctl_queue_t;
+
+    rc_t _var_ctl_queue_destroy( var_ctl_queue_t*& q )
+    {
+      rc_t rc = kOkRC;
+      
+      if( q == nullptr )
+        return rc;
+
+      if((rc = nbmpscq::destroy(q->qH)) != kOkRC )
+        rc = cwLogError(rc,"The variable control queue destroy failed.");
+
+      var_ctl_t* c = q->ctlL.load();
+      while( c != nullptr )
+      {
+        var_ctl_t* c0 = c->link;
+        mem::release(c);
+        c = c0;
+      }
+
+      mem::release(q);
+      return rc;
+    }
+    
+    rc_t _var_ctl_queue_create( flow_t* p )
+    {
+      rc_t             rc = kOkRC;
+      var_ctl_queue_t* q  = mem::allocZ<var_ctl_queue_t>();
+
+      if((rc = nbmpscq::create(q->qH,p->ctl_queue_blk_cnt,p->ctl_queue_blk_byte_cnt)) != kOkRC )
+      {
+        rc = cwLogError(rc,"The variable control queue create failed.");
+        goto errLabel;
+      }
+
+      p->ctl_queue = q;
+      
+    errLabel:
+      if( rc != kOkRC )
+        _var_ctl_queue_destroy(q);
+      return rc;
+    }
+
+    // Apply the posted variable values. Called by the audio thread at the start of each cycle.
+    rc_t _var_ctl_queue_drain( flow_t* p )
+    {
+      rc_t rc = kOkRC;
+      
+      while( !nbmpscq::is_empty(p->ctl_queue->qH) )
+      {
+        nbmpscq::blob_t b = nbmpscq::get(p->ctl_queue->qH);
+
+        if( b.rc != kOkRC )
+        {
+          rc = cwLogError(b.rc,"The variable control queue read failed.");
+          break;
+        }
+
+        const var_ctl_msg_t* m = (const var_ctl_msg_t*)b.blob;
+
+        // a failed set is reported but does not prevent the remaining values from being applied
+        if( var_set( m->ctl->proc, m->ctl->vid, m->ctl->chIdx, &m->value ) != kOkRC )
+          proc_error(m->ctl->proc,kOpFailRC,"The posted value could not be applied.");
+
+        nbmpscq::advance(p->ctl_queue->qH);
+      }
+
+      return rc;
+    }
+
+    template< typename T >
+    rc_t _post_variable_value( flow_t* p, var_ctl_handle_t ctlH, unsigned tflag, T value )
+    {
+      var_ctl_msg_t m;
+      
+      if( !ctlH.isValid() )
+        return cwLogError(kInvalidArgRC,"An invalid variable control handle was given.");
+      
+      m.ctl         = ctlH.p;
+      m.value.tflag = tflag;
+      m.value.link  = nullptr;
+
+      switch( tflag )
+      {
+        case kBoolTFl:   m.value.u.b = value; break;
+        case kIntTFl:    m.value.u.i = value; break;
+        case kUIntTFl:   m.value.u.u = value; break;
+        case kFloatTFl:  m.value.u.f = value; break;
+        case kDoubleTFl: m.value.u.d = value; break;
+      }
+
+      return nbmpscq::push(p->ctl_queue->qH,&m,sizeof(m));
+    }
+    
     rc_t _destroy( flow_t*& p)
     {
       rc_t rc = kOkRC;
@@ -807,6 +1031,8 @@ namespace cw
 
       network_destroy(p->net);
 
+      _var_ctl_queue_destroy(p->ctl_queue);
+
       global_var_t* gv=p->globalVarL;
       while( gv != nullptr )
       {
@@ -821,7 +1047,11 @@ namespace cw
       
       _release_class_desc_array(p->classDescA,p->classDescN);
       _release_class_desc_array(p->udpDescA,p->udpDescN);
+      hash_index_destroy(p->classDescIdx);
+      sym_tbl_destroy(p->symTbl);
       mem::release(p->presetA);
+      mem::release(p->cfg_cache_dir);
+      mem::release(p->fft_wisdom_fname);
       p->presetN = 0;
       p->classDescN = 0;
       p->udpDescN = 0;
@@ -831,6 +1061,46 @@ namespace cw
       return rc;
     }
 
+    enum { kHighUiPriId, kNormalUiPriId, kLowUiPriId };
+
+    unsigned _ui_var_priority( const variable_t* var )
+    {
+      if( var->ui_var->msgId_idx > 0 )
+        return kHighUiPriId;
+      
+      return cwIsFlag(var->varDesc->flags,kUiLowPriVarDescFl) ? kLowUiPriId : kNormalUiPriId;
+    }
+
+    // Add the updates accumulated since the last refill to the budget.
+    void _ui_budget_refill( flow_t* p )
+    {
+      double cycle_sec  = p->framesPerCycle / p->sample_rate;
+      double max_tokens = 1.0 + p->ui_update_budget * p->uiUpdateCycleCount * cycle_sec; // allow one update to carry over to the next UI update
+
+      p->ui_budget_tokens    = std::min(max_tokens, p->ui_budget_tokens + p->ui_update_budget * (p->cycleIndex - p->ui_budget_cycle_idx) * cycle_sec );
+      p->ui_budget_cycle_idx = p->cycleIndex;
+    }
+
+    // Returns false if the budget is exhausted and the var was not sent.
+    bool _ui_send_var( flow_t* p, variable_t* var, unsigned priId )
+    {
+      if( p->ui_update_budget > 0 )
+      {
+        // high priority updates are always sent but still count against the budget
+        if( priId != kHighUiPriId && p->ui_budget_tokens < 1.0 )
+          return false;
+        
+        p->ui_budget_tokens -= 1.0;
+      }
+      
+      if( p->ui_callback != nullptr )
+        p->ui_callback( p->ui_callback_arg, var->ui_var );
+
+      p->ui_stats.sent_cnt += 1;
+      
+      return true;
+    }
+    
     void _make_flow_to_ui_callback( flow_t* p )
     {
       
@@ -838,20 +1108,59 @@ namespace cw
       // this function is called and so all accesses use relaxed memory order.
 
       // Get the first variable to send to the UI
-      variable_t* var = p->ui_var_tail->ui_var_link.load(std::memory_order_relaxed);
+      variable_t* var      = p->ui_var_tail->ui_var_link.load(std::memory_order_relaxed);
+      variable_t* low_head = nullptr; // low priority vars which are sent after all other vars
+      variable_t* def_head = nullptr; // vars which are deferred to the next UI update
+
+      if( var == nullptr )
+        return;
+
+      p->ui_stats.flush_cnt += 1;
+      
+      if( p->ui_update_budget > 0 )
+        _ui_budget_refill(p);
 
       while( var!=nullptr)
       {
-        // Send the var to the UI
-        if( p->ui_callback != nullptr )
-          p->ui_callback( p->ui_callback_arg, var->ui_var );
-
         // Get the next var to send to the UI
         variable_t* var0 = var->ui_var_link.load(std::memory_order_relaxed);
+        unsigned    priId;
 
+        // ui_var_link_fl counts the updates to this var since it was added to the list
+        p->ui_stats.coalesced_cnt += var->ui_var_link_fl.load(std::memory_order_relaxed) - 1;
+        
         // Nullify the list links as they are used and zero the ui_var_link_fl guard counter
         var->ui_var_link.store(nullptr,std::memory_order_relaxed);
         var->ui_var_link_fl.store(0,std::memory_order_relaxed);
+
+        // Send the var to the UI
+        if((priId = _ui_var_priority(var)) == kLowUiPriId )
+        {
+          var->ui_var_link.store(low_head,std::memory_order_relaxed);
+          low_head = var;
+        }
+        else
+        {
+          if( !_ui_send_var(p,var,priId) )
+          {
+            var->ui_var_link.store(def_head,std::memory_order_relaxed);
+            def_head = var;
+            p->ui_stats.deferred_cnt += 1;
+          }
+        }
+        
+        var = var0;
+      }
+
+      // send the low priority vars with the remaining budget
+      for(var=low_head; var!=nullptr; )
+      {
+        variable_t* var0 = var->ui_var_link.load(std::memory_order_relaxed);
+        var->ui_var_link.store(nullptr,std::memory_order_relaxed);
+        
+        if( !_ui_send_var(p,var,kLowUiPriId) )
+          p->ui_stats.dropped_cnt += 1;
+        
         var = var0;
       }
 
@@ -860,6 +1169,15 @@ namespace cw
       p->ui_var_tail    = &p->ui_var_stub;
       p->ui_var_stub.ui_var_link.store(nullptr,std::memory_order_relaxed);
 
+      // Put the deferred vars back on the list. Their latest value will be sent on the next update.
+      for(var=def_head; var!=nullptr; )
+      {
+        variable_t* var0 = var->ui_var_link.load(std::memory_order_relaxed);
+        var->ui_var_link.store(nullptr,std::memory_order_relaxed);
+        var_send_to_ui(var);
+        var = var0;
+      }
+
     }
 
     void _print_abuf( const abuf_t* abuf )
@@ -893,6 +1211,9 @@ cw::rc_t cw::flow::create( handle_t&          hRef,
   unsigned        maxCycleCount    = kInvalidCnt;
   double          durLimitSecs     = 0;
   unsigned        uiUpdateMs       = 50;
+  const char*     cfgCacheDir      = nullptr;
+  const char*     fftWisdomFname   = nullptr;
+  const char*     fftPlanEffort    = nullptr;
   
   if(( rc = destroy(hRef)) != kOkRC )
     return rc;
@@ -924,7 +1245,16 @@ cw::rc_t cw::flow::create( handle_t&          hRef,
   p->warn_on_rt_alloc_fl= true;
   p->printLogHdrFl      = true;
   p->ui_create_fl       = false;
+  p->ui_update_budget   = 0;
   p->prof_fl            = false;
+  p->parallel_fl        = false;
+  p->thread_cnt         = 2;
+  p->abuf_pool_fl       = false;
+  p->fuse_fl            = false;
+  p->bypass_fl          = true;
+  p->ctl_queue_blk_cnt  = 4;
+  p->ctl_queue_blk_byte_cnt = 16384;
+  p->pipeline_stage_cnt = 0;
   p->ui_callback        = ui_callback;
   p->ui_callback_arg    = ui_callback_arg;
   p->ui_var_head.store(&p->ui_var_stub);
@@ -940,7 +1270,21 @@ cw::rc_t cw::flow::create( handle_t&          hRef,
                          "dur_limit_secs",       kOptFl, durLimitSecs,
                          "ui_update_ms",         kOptFl, uiUpdateMs,
                          "ui_create_fl",         kOptFl, p->ui_create_fl,
+                         "ui_update_budget",     kOptFl, p->ui_update_budget,
                          "profile_fl",           kOptFl, p->prof_fl,
+                         "parallel_fl",          kOptFl, p->parallel_fl,
+                         "thread_cnt",           kOptFl, p->thread_cnt,
+                         "cpu_affinityL",        kOptFl, p->cpu_affinityL,
+                         "abuf_pool_fl",         kOptFl, p->abuf_pool_fl,
+                         "fuse_fl",              kOptFl, p->fuse_fl,
+                         "bypass_fl",            kOptFl, p->bypass_fl,
+                         "ctl_queue_blk_cnt",    kOptFl, p->ctl_queue_blk_cnt,
+                         "ctl_queue_blk_byte_cnt",kOptFl, p->ctl_queue_blk_byte_cnt,
+                         "pipeline_stage_cnt",   kOptFl, p->pipeline_stage_cnt,
+                         "pipeline_stageL",      kOptFl, p->pipeline_stageL,
+                         "cfg_cache_dir",        kOptFl, cfgCacheDir,
+                         "fft_wisdom_fname",     kOptFl, fftWisdomFname,
+                         "fft_plan_effort",      kOptFl, fftPlanEffort,
                          "preset",               kOptFl, p->init_net_preset_label,
                          "print_class_dict_fl",  kOptFl, printClassDictFl,
                          "print_network_fl",     kOptFl, p->printNetworkFl,
@@ -952,6 +1296,9 @@ cw::rc_t cw::flow::create( handle_t&          hRef,
     goto errLabel;
   }
 
+  if((rc = _var_ctl_queue_create(p)) != kOkRC )
+    goto errLabel;
+
   if((rc = _parse_preset_array(p, p->networkCfg )) != kOkRC )
   {
     rc = cwLogError(rc,"Preset dictionary parsing failed.");
@@ -970,6 +1317,31 @@ cw::rc_t cw::flow::create( handle_t&          hRef,
     cwLogInfo("An invalid frames/cycle:%i was encountered. Setting frames/cycle to %i.",p->framesPerCycle,kDefaultFramesPerCycle);
     p->framesPerCycle = kDefaultFramesPerCycle;
   }
+
+  p->deadline_ns = (unsigned long long)(1e9 * p->framesPerCycle / p->sample_rate);
+
+  // A '$' prefix on the cfg cache directory refers to the project directory.
+  if( cfgCacheDir != nullptr )
+  {
+    char* dir = cfgCacheDir[0]=='$' && p->proj_dir != nullptr ? filesys::makeFn(p->proj_dir,cfgCacheDir+1,nullptr,nullptr) : nullptr;
+    p->cfg_cache_dir = filesys::expandPath( dir==nullptr ? cfgCacheDir : dir );
+    mem::release(dir);
+  }
+
+  // A '$' prefix on the FFTW wisdom file name refers to the project directory.
+  if( fftWisdomFname != nullptr )
+  {
+    char* fn = fftWisdomFname[0]=='$' && p->proj_dir != nullptr ? filesys::makeFn(p->proj_dir,fftWisdomFname+1,nullptr,nullptr) : nullptr;
+    p->fft_wisdom_fname = filesys::expandPath( fn==nullptr ? fftWisdomFname : fn );
+    mem::release(fn);
+  }
+
+  p->fft_plan_effort_id = dsp::fft_plan::effort();
+  if( fftPlanEffort != nullptr && (p->fft_plan_effort_id = dsp::fft_plan::effort_from_label(fftPlanEffort)) == dsp::fft_plan::kInvalidEffortId )
+  {
+    rc = cwLogError(kSyntaxErrorRC,"The FFT plan effort '%s' is not valid. Valid values are 'estimate','measure','patient' or 'exhaustive'.",fftPlanEffort);
+    goto errLabel;
+  }
   
   // if a maxCycle count was given
   if( maxCycleCount != kInvalidCnt )
@@ -1019,6 +1391,12 @@ unsigned cw::flow::frames_per_cycle( handle_t h )
   return p->framesPerCycle;  
 }
 
+unsigned cw::flow::cycle_count( handle_t h )
+{
+  flow_t* p = _handleToPtr(h);
+  return p->cycleIndex;  
+}
+
 unsigned cw::flow::preset_count( handle_t h )
 {
   flow_t* p = _handleToPtr(h);
@@ -1065,6 +1443,7 @@ cw::rc_t cw::flow::initialize( handle_t h,
   variable_t* proxyVarL = nullptr;
   flow_t*     p         = _handleToPtr(h);
   const char* root_label = "root";
+  unsigned    fft_plan_effort_id = 0;
   
   p->deviceA    = deviceA;
   p->deviceN    = deviceN;
@@ -1096,8 +1475,17 @@ cw::rc_t cw::flow::initialize( handle_t h,
     p->init_net_preset_label = preset_label_str;
   }
   
+  // Load the FFTW wisdom so that the procs FFT plans are not re-measured.
+  dsp::fft_plan::load_wisdom(p->fft_wisdom_fname);
+  fft_plan_effort_id = dsp::fft_plan::set_effort((dsp::fft_plan::effort_t)p->fft_plan_effort_id);
+  
   // instantiate the network
-  if((rc = network_create(p,&root_label,&p->networkCfg,1,proxyVarL,1,p->net)) != kOkRC )
+  rc = network_create(p,&root_label,&p->networkCfg,1,proxyVarL,1,p->net);
+
+  dsp::fft_plan::set_effort((dsp::fft_plan::effort_t)fft_plan_effort_id);
+  dsp::fft_plan::save_wisdom(p->fft_wisdom_fname);
+  
+  if( rc != kOkRC )
   {
     rc = cwLogError(rc,"Network creation failed.");
     goto errLabel;
@@ -1145,6 +1533,9 @@ cw::rc_t cw::flow::destroy( handle_t& hRef )
 
   p = _handleToPtr(hRef);
 
+  // the runtime ends when the flow object is destroyed
+  mem::clear_warn_on_alloc();
+
   if( p->prof_fl )
     profile_report(hRef);
 
@@ -1190,8 +1581,13 @@ cw::rc_t cw::flow::exec_cycle( handle_t h )
   }
   else
   {
+    // apply the values posted by other threads
+    _var_ctl_queue_drain(p);
     
     rc = exec_cycle(*p->net);
+
+    if( p->prof_fl )
+      _deadline_check(p);
     
     // Execute one cycle of the network
     if(rc == kOkRC )
@@ -1256,6 +1652,16 @@ cw::rc_t cw::flow::send_ui_updates( handle_t h )
   return rc;
 }
 
+cw::rc_t cw::flow::prewarm( handle_t h )
+{
+  flow_t* p  = _handleToPtr(h);
+  
+  if( p->net == nullptr )
+    return cwLogError(kInvalidStateRC,"The network must be initialized before it can be pre-warmed.");
+  
+  return network_prewarm(*p->net);
+}
+
 cw::rc_t cw::flow::apply_preset( handle_t h, const char* presetLabel )
 {
   flow_t* p  = _handleToPtr(h);
@@ -1274,6 +1680,24 @@ cw::rc_t cw::flow::apply_preset( handle_t h, const multi_preset_selector_t& mps
   return network_apply_preset(*p->net,mps);
 }
 
+cw::rc_t cw::flow::begin_preset_apply( handle_t h, const char* presetLabel, unsigned max_cycle_cnt, double cycle_budget_us )
+{
+  flow_t* p  = _handleToPtr(h);
+  return network_begin_preset_apply(*p->net,presetLabel,max_cycle_cnt,cycle_budget_us);
+}
+
+cw::rc_t cw::flow::begin_dual_preset_apply( handle_t h, const char* presetLabel_0, const char* presetLabel_1, double coeff, unsigned max_cycle_cnt, double cycle_budget_us )
+{
+  flow_t* p  = _handleToPtr(h);
+  return network_begin_dual_preset_apply(*p->net,presetLabel_0,presetLabel_1,coeff,max_cycle_cnt,cycle_budget_us);
+}
+
+bool cw::flow::preset_apply_status( handle_t h, unsigned& applied_cnt_ref, unsigned& total_cnt_ref, rc_t& rc_ref )
+{
+  flow_t* p  = _handleToPtr(h);
+  return network_preset_apply_status(*p->net,applied_cnt_ref,total_cnt_ref,rc_ref);
+}
+
 cw::rc_t cw::flow::set_variable_user_arg( handle_t h, const ui_var_t* ui_var, void* arg )
 { return set_variable_user_arg( *_handleToPtr(h)->net, ui_var, arg );  }
 
@@ -1308,6 +1732,49 @@ cw::rc_t cw::flow::get_variable_value( handle_t h, const char* inst_label, const
 cw::rc_t cw::flow::get_variable_value( handle_t h, const char* inst_label, const char* var_label, unsigned chIdx, double& valueRef )
 { return get_variable_value( *_handleToPtr(h)->net, inst_label, var_label, chIdx, valueRef ); }
 
+cw::rc_t cw::flow::var_control( handle_t h, const char* inst_label, const char* var_label, unsigned chIdx, var_ctl_handle_t& ctlH_ref )
+{
+  rc_t        rc   = kOkRC;
+  flow_t*     p    = _handleToPtr(h);
+  proc_t*     proc = nullptr;
+  variable_t* var  = nullptr;
+  var_ctl_t*  ctl  = nullptr;
+
+  ctlH_ref.clear();
+
+  if((rc = get_variable(*p->net,inst_label,var_label,chIdx,proc,var)) != kOkRC )
+    goto errLabel;
+
+  ctl        = mem::allocZ<var_ctl_t>();
+  ctl->proc  = proc;
+  ctl->vid   = var->vid;
+  ctl->chIdx = chIdx;
+  ctl->link  = p->ctl_queue->ctlL.load();
+
+  // control handles may be resolved concurrently by multiple threads
+  while( !p->ctl_queue->ctlL.compare_exchange_weak(ctl->link,ctl) )
+  {}
+
+  ctlH_ref.set(ctl);
+  
+errLabel:
+  if( rc != kOkRC )
+    rc = cwLogError(rc,"The variable control for '%s:%s' could not be resolved.",cwStringNullGuard(inst_label),cwStringNullGuard(var_label));
+  
+  return rc;
+}
+
+cw::rc_t cw::flow::post_variable_value( handle_t h, var_ctl_handle_t ctlH, bool value )
+{ return _post_variable_value( _handleToPtr(h), ctlH, kBoolTFl, value ); }
+cw::rc_t cw::flow::post_variable_value( handle_t h, var_ctl_handle_t ctlH, int value )
+{ return _post_variable_value( _handleToPtr(h), ctlH, kIntTFl, value ); }
+cw::rc_t cw::flow::post_variable_value( handle_t h, var_ctl_handle_t ctlH, unsigned value )
+{ return _post_variable_value( _handleToPtr(h), ctlH, kUIntTFl, value ); }
+cw::rc_t cw::flow::post_variable_value( handle_t h, var_ctl_handle_t ctlH, float value )
+{ return _post_variable_value( _handleToPtr(h), ctlH, kFloatTFl, value ); }
+cw::rc_t cw::flow::post_variable_value( handle_t h, var_ctl_handle_t ctlH, double value )
+{ return _post_variable_value( _handleToPtr(h), ctlH, kDoubleTFl, value ); }
+
 cw::rc_t cw::flow::set_variable_value( handle_t h, const ui_var_t* ui_var, bool value     )
 { return set_variable_value( *_handleToPtr(h)->net, ui_var, value );  }
 cw::rc_t cw::flow::set_variable_value( handle_t h, const ui_var_t* ui_var, int value      )
@@ -1363,7 +1830,123 @@ void cw::flow::profile_report( handle_t h )
       printf("%8.5fs UI:%8.5fs\n",dur,ui_dur);
     
       network_profile_report(*p->net);
+
+      printf("deadline:%.1f us cycles:%i missed:%i\n",p->deadline_ns/1000.0,p->net->prof_cnt,p->deadline_miss_cnt);
+
+      for(unsigned i=0; i<std::min(p->deadline_miss_cnt,(unsigned)kDeadlineMissRecdN); ++i)
+      {
+        deadline_miss_t m;
+        deadline_miss(h,i,m);
+        printf("  cycle:%i %.1f us %s:%i %.1f us\n",m.cycle_idx,m.dur_us,cwStringNullGuard(m.proc_label),m.proc_sfx_id,m.proc_dur_us);
+      }
+    }
+  }
+}
+
+cw::rc_t cw::flow::latency_stats( handle_t h, const char* proc_label, unsigned sfx_id, latency_stats_t& stats_ref )
+{
+  flow_t* p    = _handleToPtr(h);
+  proc_t* proc = nullptr;
+
+  stats_ref = {};
+  
+  if( p->net == nullptr )
+    return cwLogError(kInvalidStateRC,"Latency statistics are not available because the network does not exist.");
+  
+  if( proc_label == nullptr )
+  {
+    latency_hist_stats(p->net->prof_hist,stats_ref);
+    return kOkRC;
+  }
+
+  if((proc = proc_find(*p->net,proc_label,sfx_id)) == nullptr )
+    return cwLogError(kInvalidArgRC,"The proc '%s:%i' was not found.",cwStringNullGuard(proc_label),sfx_id);
+
+  latency_hist_stats(proc->prof_hist,stats_ref);
+  stats_ref.bypass_cnt = proc->bypass_cnt;
+  
+  return kOkRC;
+}
+
+namespace cw
+{
+  namespace flow
+  {
+    void _class_profile( const network_t& net, class_profile_t* profA, unsigned profN, unsigned& classN_ref )
+    {
+      for(unsigned i=0; i<net.procN; ++i)
+      {
+        const proc_t* proc = net.procA[i];
+        unsigned      j    = 0;
+
+        // locate the class record for this proc
+        for(; j<classN_ref; ++j)
+          if( textIsEqual(profA[j].class_label,proc->class_desc->label) )
+            break;
+
+        // create a new class record
+        if( j == classN_ref && j < profN )
+          profA[ classN_ref++ ] = { .class_label=proc->class_desc->label, .proc_cnt=0, .exec_cnt=0, .total_sec=0 };
+
+        if( j < profN )
+        {
+          profA[j].proc_cnt  += 1;
+          profA[j].exec_cnt  += proc->prof_cnt;
+          profA[j].total_sec += time::seconds(proc->prof_dur);
+        }
+        
+        for(const network_t* n = proc->internal_net; n!=nullptr; n=n->poly_link)
+          _class_profile(*n,profA,profN,classN_ref);
+      }
     }
   }
 }
 
+unsigned cw::flow::class_profile( handle_t h, class_profile_t* profA, unsigned profN )
+{
+  flow_t*  p      = _handleToPtr(h);
+  unsigned classN = 0;
+  
+  if( p->net != nullptr )
+    _class_profile(*p->net,profA,profN,classN);
+  
+  return classN;
+}
+
+void cw::flow::ui_update_stats( handle_t h, ui_update_stats_t& stats_ref )
+{
+  flow_t* p = _handleToPtr(h);
+  stats_ref = p->ui_stats;
+}
+
+double cw::flow::deadline_us( handle_t h )
+{
+  flow_t* p = _handleToPtr(h);
+  return p->deadline_ns / 1000.0;
+}
+
+unsigned cw::flow::deadline_miss_count( handle_t h )
+{
+  flow_t* p = _handleToPtr(h);
+  return p->deadline_miss_cnt;
+}
+
+cw::rc_t cw::flow::deadline_miss( handle_t h, unsigned idx, deadline_miss_t& miss_ref )
+{
+  flow_t* p = _handleToPtr(h);
+
+  miss_ref = {};
+  
+  if( idx >= std::min(p->deadline_miss_cnt,(unsigned)kDeadlineMissRecdN) )
+    return cwLogError(kInvalidArgRC,"The deadline miss index %i is not available.",idx);
+
+  const deadline_miss_recd_t* r = p->deadline_missA + ((p->deadline_miss_cnt - 1 - idx) % kDeadlineMissRecdN);
+
+  miss_ref.cycle_idx   = r->cycle_idx;
+  miss_ref.dur_us      = r->dur_ns / 1000.0;
+  miss_ref.proc_label  = r->proc == nullptr ? nullptr : r->proc->label;
+  miss_ref.proc_sfx_id = r->proc == nullptr ? kInvalidId : r->proc->label_sfx_id;
+  miss_ref.proc_dur_us = r->proc_ns / 1000.0;
+
+  return kOkRC;
+}
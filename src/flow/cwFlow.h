@@ -9,6 +9,7 @@ namespace cw
   {
 
     typedef handle<struct flow_str> handle_t;
+    typedef handle<struct var_ctl_str> var_ctl_handle_t;
 
     // Parse the cfg's but don't yet instantiate the network.
     // Upon completion of this function the caller can 
@@ -26,6 +27,7 @@ namespace cw
     bool     is_non_real_time( handle_t h );
     double   sample_rate(      handle_t h );
     unsigned frames_per_cycle( handle_t h );
+    unsigned cycle_count(      handle_t h ); // count of cycles executed
     unsigned preset_cfg_flags( handle_t h );
 
     // Get the count and labels of the top level presets
@@ -58,10 +60,22 @@ namespace cw
     // network is changed outside of runtime.
     rc_t send_ui_updates( handle_t h );
 
+    // Touch the network's audio and spectral buffers so that their memory is
+    // resident before the network enters runtime. Call after initialize().
+    rc_t prewarm( handle_t h );
+
     rc_t apply_preset( handle_t h, const char* presetLabel );
     rc_t apply_dual_preset( handle_t h, const char* presetLabel_0, const char* presetLabel_1, double coeff );
     rc_t apply_preset( handle_t h, const multi_preset_selector_t& multi_preset_sel );
 
+    // Apply a preset over multiple cycles. See network_begin_preset_apply().
+    rc_t begin_preset_apply( handle_t h, const char* presetLabel, unsigned max_cycle_cnt, double cycle_budget_us );
+    rc_t begin_dual_preset_apply( handle_t h, const char* presetLabel_0, const char* presetLabel_1, double coeff, unsigned max_cycle_cnt, double cycle_budget_us );
+
+    // Returns true when the last incremental preset application has completed.
+    // 'rc_ref' is set to the result of the application.
+    bool preset_apply_status( handle_t h, unsigned& applied_cnt_ref, unsigned& total_cnt_ref, rc_t& rc_ref );
+
         
     rc_t set_variable_value( handle_t h, const char* inst_label, const char* var_label, unsigned chIdx, bool value     );
     rc_t set_variable_value( handle_t h, const char* inst_label, const char* var_label, unsigned chIdx, int value      );
@@ -76,6 +90,20 @@ namespace cw
     rc_t get_variable_value( handle_t h, const char* inst_label, const char* var_label, unsigned chIdx, double& valueRef   );
 
 
+    // Resolve the target of a variable control once and return a handle to it.
+    // The handle remains valid for the life of the flow object.
+    rc_t var_control( handle_t h, const char* inst_label, const char* var_label, unsigned chIdx, var_ctl_handle_t& ctlH_ref );
+
+    // Post a value to a variable via a control handle. These functions are lock-free
+    // and may be called concurrently from any number of non-audio threads.
+    // The value is applied at the start of the next exec_cycle().
+    // Returns kBufTooSmallRC if the queue is full (See 'ctl_queue_blk_cnt' and 'ctl_queue_blk_byte_cnt').
+    rc_t post_variable_value( handle_t h, var_ctl_handle_t ctlH, bool value     );
+    rc_t post_variable_value( handle_t h, var_ctl_handle_t ctlH, int value      );
+    rc_t post_variable_value( handle_t h, var_ctl_handle_t ctlH, unsigned value );
+    rc_t post_variable_value( handle_t h, var_ctl_handle_t ctlH, float value    );
+    rc_t post_variable_value( handle_t h, var_ctl_handle_t ctlH, double value   );
+
     // The 'user_id' shows up as the 'user_id' in the ui_var field.
     rc_t set_variable_user_arg( handle_t h, const ui_var_t* ui_var, void* arg );
     
@@ -94,6 +122,34 @@ namespace cw
     rc_t get_variable_value( handle_t h, const ui_var_t* ui_var, const char*& value_ref );
 
     
+    // Get the execution time statistics of a proc in the root network.
+    // Set 'proc_label' to nullptr to get the statistics of the root network.
+    // Statistics are only collected when the 'profile_fl' program option is set.
+    rc_t latency_stats( handle_t h, const char* proc_label, unsigned sfx_id, latency_stats_t& stats_ref );
+
+    // Fill profA[profN] with the execution statistics of each proc class used by the program.
+    // Returns the count of records filled. Classes beyond the first profN are not reported.
+    // Execution times are only collected when the 'profile_fl' program option is set.
+    unsigned class_profile( handle_t h, class_profile_t* profA, unsigned profN );
+
+    // Cycle deadline (frames_per_cycle/sample_rate) in microseconds.
+    double   deadline_us( handle_t h );
+
+    // Count of cycles where the root network execution time exceeded the deadline.
+    unsigned deadline_miss_count( handle_t h );
+
+    // Get one of the most recent deadline misses. idx 0 is the most recent miss.
+    // Returns kInvalidArgRC if idx is beyond the count of retained misses.
+    rc_t     deadline_miss( handle_t h, unsigned idx, deadline_miss_t& miss_ref );
+    
+    // Get the UI update counters.
+    // Updates which arrive while a var is already waiting to be sent are coalesced (the UI receives the latest value).
+    // The 'ui_update_budget' program option limits the count of var updates per second:
+    // vars with pending UI messages (enable, show, list reload, ...) are always sent,
+    // 'ui_low' vars (e.g. meters) are only sent if budget remains and are otherwise dropped,
+    // and all other vars are deferred to the next UI update.
+    void ui_update_stats( handle_t h, ui_update_stats_t& stats_ref );
+    
     void print_class_list( handle_t h );
     void print_network( handle_t h );
     void profile_report( handle_t h );
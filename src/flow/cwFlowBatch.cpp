@@ -0,0 +1,399 @@
+//| Copyright: (C) 2020-2024 Kevin Larke <contact AT larke DOT org>
+//| License: GNU GPL version 3.0 or above. See the accompanying LICENSE file.
+#include "cwCommon.h"
+#include "cwLog.h"
+#include "cwCommonImpl.h"
+#include "cwTest.h"
+#include "cwMem.h"
+#include "cwText.h"
+#include "cwObject.h"
+#include "cwTime.h"
+#include "cwThread.h"
+#include "cwMutex.h"
+#include "cwMidiDecls.h"
+#include "cwFlowDecl.h"
+#include "cwFlow.h"
+#include "cwFlowBatch.h"
+
+namespace cw
+{
+  namespace flow
+  {
+    namespace batch
+    {
+      typedef struct batch_str
+      {
+        const object_t*   proc_class_cfg;
+        const object_t*   subnet_cfg;
+        job_t*            jobA;
+        unsigned          jobN;
+
+        std::atomic<unsigned> next_job_idx; // index of the next job to run
+
+        // The following fields are protected by 'mutexH'.
+        mutex::handle_t   mutexH;
+        long long         mem_budget_byte_cnt;
+        long long         est_byte_cnt;      // memory estimate for a job
+        long long         reserved_byte_cnt; // sum of the memory estimates of the running jobs
+        unsigned          running_cnt;       // count of running jobs
+      } batch_t;
+
+      // Replace the 'args' of the procs in 'pgm_cfg' with the values in 'arg_cfg'.
+      rc_t _apply_arg_overrides( object_t* pgm_cfg, const object_t* arg_cfg )
+      {
+        rc_t      rc        = kOkRC;
+        object_t* procs_cfg = nullptr;
+        object_t* net_cfg   = nullptr;
+
+        if((net_cfg = pgm_cfg->find("network")) == nullptr || (procs_cfg = net_cfg->find("procs")) == nullptr )
+        {
+          rc = cwLogError(kSyntaxErrorRC,"The program 'network.procs' dictionary was not found.");
+          goto errLabel;
+        }
+
+        // for each proc with overrides
+        for(unsigned i=0; i<arg_cfg->child_count(); ++i)
+        {
+          const object_t* proc_pair = arg_cfg->child_ele(i);
+          object_t*       proc_cfg  = nullptr;
+          object_t*       args_cfg  = nullptr;
+
+          if((proc_cfg = procs_cfg->find(proc_pair->pair_label())) == nullptr )
+          {
+            rc = cwLogError(kEleNotFoundRC,"The proc '%s' was not found.",cwStringNullGuard(proc_pair->pair_label()));
+            goto errLabel;
+          }
+
+          // create the 'args' dictionary if it does not exist
+          if((args_cfg = proc_cfg->find("args")) == nullptr )
+            args_cfg = newPairObject("args",newDictObject(),proc_cfg);
+
+          // for each overridden arg
+          for(unsigned j=0; j<proc_pair->pair_value()->child_count(); ++j)
+          {
+            const object_t* var_pair = proc_pair->pair_value()->child_ele(j);
+            object_t*       val      = nullptr;
+
+            // remove the existing value
+            if((val = args_cfg->find(var_pair->pair_label())) != nullptr )
+            {
+              object_t* pair = val->parent;
+              pair->unlink();
+              pair->free();
+            }
+
+            newPairObject(var_pair->pair_label(),var_pair->pair_value()->duplicate(),args_cfg);
+          }
+        }
+
+      errLabel:
+        return rc;
+      }
+
+      unsigned _preset_index( handle_t flowH, const char* preset_label )
+      {
+        for(unsigned i=0; i<preset_count(flowH); ++i)
+          if( textIsEqual(flow::preset_label(flowH,i),preset_label) )
+            return i;
+        return kInvalidIdx;
+      }
+
+      rc_t _render_job( batch_t* b, job_t* job )
+      {
+        rc_t         rc         = kOkRC;
+        object_t*    pgm_cfg    = nullptr;
+        unsigned     preset_idx = kInvalidIdx;
+        time::spec_t t0         = time::current_time();
+        handle_t     flowH;
+
+        // only the cw::mem allocations made by this thread are counted (See run())
+        mem::reset_thread_byte_count();
+
+        pgm_cfg = job->pgm_cfg->duplicate();
+
+        if( job->arg_cfg != nullptr )
+          if((rc = _apply_arg_overrides(pgm_cfg,job->arg_cfg)) != kOkRC )
+            goto errLabel;
+
+        if((rc = create(flowH, b->proc_class_cfg, pgm_cfg, b->subnet_cfg, job->proj_dir)) != kOkRC )
+          goto errLabel;
+
+        if( !is_non_real_time(flowH) )
+        {
+          rc = cwLogError(kInvalidArgRC,"Batch programs must be non-real-time.");
+          goto errLabel;
+        }
+
+        if( job->preset_label != nullptr )
+          if((preset_idx = _preset_index(flowH,job->preset_label)) == kInvalidIdx )
+          {
+            rc = cwLogError(kInvalidArgRC,"The preset '%s' was not found.",job->preset_label);
+            goto errLabel;
+          }
+
+        if((rc = initialize(flowH, nullptr, 0, preset_idx)) != kOkRC )
+          goto errLabel;
+
+        if((rc = exec(flowH)) == kEofRC )
+          rc = kOkRC;
+
+        job->cycle_cnt = cycle_count(flowH);
+        job->audio_sec = (double)job->cycle_cnt * frames_per_cycle(flowH) / sample_rate(flowH);
+
+      errLabel:
+        destroy(flowH);
+
+        // a job which failed during runtime may have left the thread in 'warn on alloc' mode
+        mem::clear_warn_on_alloc();
+
+        if( pgm_cfg != nullptr )
+          pgm_cfg->free();
+
+        job->wall_sec      = time::elapsedSecs(t0);
+        job->rt_factor     = job->wall_sec > 0 ? job->audio_sec / job->wall_sec : 0;
+        job->peak_byte_cnt = mem::thread_peak_byte_count();
+        job->rc            = rc;
+
+        if( rc != kOkRC )
+          rc = cwLogError(rc,"Batch job '%s' failed.",cwStringNullGuard(job->label));
+
+        return rc;
+      }
+
+      // Wait until the memory budget allows another job to start.
+      // The budget only limits the cw::mem allocations of the job threads (See run()).
+      void _reserve( batch_t* b, long long& est_byte_cnt_ref )
+      {
+        for(bool admit_fl=false; !admit_fl; )
+        {
+          mutex::lock(b->mutexH);
+
+          admit_fl = b->mem_budget_byte_cnt==0 || b->running_cnt==0 || b->reserved_byte_cnt + b->est_byte_cnt <= b->mem_budget_byte_cnt;
+
+          if( admit_fl )
+          {
+            est_byte_cnt_ref      = b->est_byte_cnt;
+            b->reserved_byte_cnt += est_byte_cnt_ref;
+            b->running_cnt       += 1;
+          }
+
+          mutex::unlock(b->mutexH);
+
+          if( !admit_fl )
+            sleepMs(10);
+        }
+      }
+
+      void _release( batch_t* b, long long est_byte_cnt, long long peak_byte_cnt )
+      {
+        mutex::lock(b->mutexH);
+        b->reserved_byte_cnt -= est_byte_cnt;
+        b->running_cnt       -= 1;
+        b->est_byte_cnt       = std::max(b->est_byte_cnt,peak_byte_cnt);
+        mutex::unlock(b->mutexH);
+      }
+
+      // Render one job per call.
+      bool _thread_func( void* arg )
+      {
+        batch_t*  b            = (batch_t*)arg;
+        unsigned  job_idx      = b->next_job_idx.fetch_add(1,std::memory_order_acq_rel);
+        long long est_byte_cnt = 0;
+
+        if( job_idx >= b->jobN )
+          return false;
+
+        _reserve(b,est_byte_cnt);
+
+        _render_job(b, b->jobA + job_idx);
+
+        _release(b,est_byte_cnt,b->jobA[job_idx].peak_byte_cnt);
+
+        return true;
+      }
+    }
+  }
+}
+
+cw::rc_t cw::flow::batch::run( const object_t* proc_class_cfg, job_t* jobA, unsigned jobN, unsigned thread_cnt, long long mem_budget_byte_cnt, const object_t* subnet_cfg )
+{
+  rc_t              rc      = kOkRC;
+  batch_t           b;
+  thread::handle_t* threadA = nullptr;
+  time::spec_t      t0      = time::current_time();
+
+  thread_cnt = std::max(1u,std::min(thread_cnt,jobN));
+
+  b.proc_class_cfg      = proc_class_cfg;
+  b.subnet_cfg          = subnet_cfg;
+  b.jobA                = jobA;
+  b.jobN                = jobN;
+  b.mem_budget_byte_cnt = mem_budget_byte_cnt;
+  b.est_byte_cnt        = mem_budget_byte_cnt / thread_cnt;
+  b.reserved_byte_cnt   = 0;
+  b.running_cnt         = 0;
+  b.next_job_idx.store(0,std::memory_order_release);
+
+  for(unsigned i=0; i<jobN; ++i)
+    jobA[i].rc = kInvalidStateRC; // the job has not been run
+
+  if((rc = mutex::create(b.mutexH)) != kOkRC )
+  {
+    rc = cwLogError(rc,"The batch mutex create failed.");
+    goto errLabel;
+  }
+
+  threadA = mem::allocZ<thread::handle_t>(thread_cnt);
+
+  for(unsigned i=0; i<thread_cnt; ++i)
+  {
+    if((rc = thread::create(threadA[i],_thread_func,&b,"flow_batch")) != kOkRC )
+    {
+      rc = cwLogError(rc,"The batch thread create failed.");
+      goto errLabel;
+    }
+
+    // don't wait for the 'running' state because the thread exits as soon as the jobs are exhausted
+    if((rc = thread::pause(threadA[i],0)) != kOkRC )
+    {
+      rc = cwLogError(rc,"The batch thread start failed.");
+      goto errLabel;
+    }
+  }
+
+  // wait for the threads to run out of jobs
+  for(unsigned i=0; i<thread_cnt; ++i)
+    while( thread::state(threadA[i]) != thread::kExitedThId )
+      sleepMs(20);
+
+  cwLogInfo("Batch of %i jobs on %i threads complete in %f seconds.",jobN,thread_cnt,time::elapsedSecs(t0));
+
+  for(unsigned i=0; i<jobN; ++i)
+    if( jobA[i].rc != kOkRC )
+    {
+      rc = jobA[i].rc;
+      break;
+    }
+
+errLabel:
+  if( threadA != nullptr )
+    for(unsigned i=0; i<thread_cnt; ++i)
+      thread::destroy(threadA[i]);
+
+  mem::release(threadA);
+  mutex::destroy(b.mutexH);
+
+  if( rc != kOkRC )
+    rc = cwLogError(rc,"Batch render failed.");
+
+  return rc;
+}
+
+void cw::flow::batch::report( const job_t* jobA, unsigned jobN )
+{
+  double audio_sec = 0;
+  double wall_sec  = 0;
+
+  for(unsigned i=0; i<jobN; ++i)
+  {
+    const job_t* j = jobA + i;
+
+    cwLogPrint("%3i rc:%i audio:%9.3fs wall:%8.3fs rtf:%8.2f mem:%8.2fMB %s\n",i,j->rc,j->audio_sec,j->wall_sec,j->rt_factor,j->peak_byte_cnt/(1024.0*1024.0),cwStringNullGuard(j->label));
+
+    audio_sec += j->audio_sec;
+    wall_sec  += j->wall_sec;
+  }
+
+  cwLogPrint("total audio:%9.3fs job time:%8.3fs rtf:%8.2f\n",audio_sec,wall_sec,wall_sec > 0 ? audio_sec/wall_sec : 0);
+  cwLogPrint("mem: peak cw::mem allocation of the job thread - excludes FFTW buffers and proc worker thread allocations.\n");
+}
+
+cw::rc_t cw::flow::batch::run( const object_t* cfg )
+{
+  rc_t            rc               = kOkRC;
+  const char*     proc_cfg_fname   = nullptr;
+  const char*     subnet_cfg_fname = nullptr;
+  unsigned        thread_cnt       = 1;
+  unsigned        mem_budget_mb    = 0;
+  const object_t* pgms_cfg         = nullptr;
+  const object_t* jobs_cfg         = nullptr;
+  object_t*       class_cfg        = nullptr;
+  object_t*       subnet_cfg       = nullptr;
+  job_t*          jobA             = nullptr;
+  unsigned        jobN             = 0;
+
+  if((rc = cfg->getv("proc_cfg_fname",proc_cfg_fname,
+                     "thread_cnt",thread_cnt,
+                     "programs",pgms_cfg,
+                     "jobs",jobs_cfg)) != kOkRC )
+  {
+    rc = cwLogError(rc,"Batch cfg. parse failed.");
+    goto errLabel;
+  }
+
+  if((rc = cfg->getv_opt("subnet_cfg_fname",subnet_cfg_fname,
+                         "mem_budget_mb",mem_budget_mb)) != kOkRC )
+  {
+    rc = cwLogError(rc,"Batch cfg. optional arg. parse failed.");
+    goto errLabel;
+  }
+
+  if((rc = objectFromFile(proc_cfg_fname,class_cfg)) != kOkRC )
+  {
+    rc = cwLogError(rc,"The flow proc dictionary could not be read from '%s'.",cwStringNullGuard(proc_cfg_fname));
+    goto errLabel;
+  }
+
+  if( subnet_cfg_fname != nullptr )
+    if((rc = objectFromFile(subnet_cfg_fname,subnet_cfg)) != kOkRC )
+    {
+      rc = cwLogError(rc,"The flow subnet dictionary could not be read from '%s'.",cwStringNullGuard(subnet_cfg_fname));
+      goto errLabel;
+    }
+
+  jobN = jobs_cfg->child_count();
+  jobA = mem::allocZ<job_t>(jobN);
+
+  for(unsigned i=0; i<jobN; ++i)
+  {
+    const char* pgm_label = nullptr;
+    job_t*      j         = jobA + i;
+
+    if((rc = jobs_cfg->child_ele(i)->getv("pgm",pgm_label)) != kOkRC )
+    {
+      rc = cwLogError(rc,"Batch job %i parse failed.",i);
+      goto errLabel;
+    }
+
+    if((rc = jobs_cfg->child_ele(i)->getv_opt("preset",j->preset_label,
+                                              "args",j->arg_cfg,
+                                              "proj_dir",j->proj_dir)) != kOkRC )
+    {
+      rc = cwLogError(rc,"Batch job %i optional arg. parse failed.",i);
+      goto errLabel;
+    }
+
+    if((j->pgm_cfg = pgms_cfg->find(pgm_label)) == nullptr )
+    {
+      rc = cwLogError(kEleNotFoundRC,"The batch job %i program '%s' was not found.",i,cwStringNullGuard(pgm_label));
+      goto errLabel;
+    }
+
+    j->label = pgm_label;
+  }
+
+  rc = run(class_cfg, jobA, jobN, thread_cnt, (long long)mem_budget_mb*1024*1024, subnet_cfg);
+
+  report(jobA,jobN);
+
+errLabel:
+  mem::release(jobA);
+
+  if( class_cfg != nullptr )
+    class_cfg->free();
+
+  if( subnet_cfg != nullptr )
+    subnet_cfg->free();
+
+  return rc;
+}
@@ -0,0 +1,62 @@
+//| Copyright: (C) 2020-2024 Kevin Larke <contact AT larke DOT org>
+//| License: GNU GPL version 3.0 or above. See the accompanying LICENSE file.
+#ifndef cwFlowBatch_h
+#define cwFlowBatch_h
+
+namespace cw
+{
+  namespace flow
+  {
+    namespace batch
+    {
+      // A batch job renders one non-real-time program to completion.
+      // Each job runs in its own flow instance and so the output of a job does not
+      // depend on the count of concurrent jobs or the order in which they are run.
+      typedef struct job_str
+      {
+        const char*     label;        // job label used in reports (optional)
+        const object_t* pgm_cfg;      // program cfg. as passed to flow::create() - must have 'non_real_time_fl:true'
+        const char*     preset_label; // network preset applied prior to runtime (optional)
+        const object_t* arg_cfg;      // proc arg overrides (optional) { <proc_label>:{ <var_label>:<value> ... } ... }
+                                      // (e.g. { afin:{ fname:"in.wav" }, afout:{ fname:"out.wav" } })
+        const char*     proj_dir;     // project directory (optional)
+
+        // Set by run().
+        rc_t            rc;            // job result
+        unsigned        cycle_cnt;     // count of cycles executed
+        double          audio_sec;     // duration of the rendered audio in seconds
+        double          wall_sec;      // time to create, render and destroy the program in seconds
+        double          rt_factor;     // audio_sec/wall_sec
+        long long       peak_byte_cnt; // peak cw::mem allocation made by the job thread (See run())
+      } job_t;
+
+      // Render jobA[jobN] using 'thread_cnt' concurrent threads.
+      // If 'mem_budget_byte_cnt' is non-zero then a job is not started unless the estimated memory
+      // of the running jobs plus the estimate for the new job is within the budget.
+      // The per-job estimate is the largest peak memory of the jobs which have completed
+      // (or mem_budget_byte_cnt/thread_cnt prior to the first job completing).
+      // The budget is a heuristic. The peak memory of a job only counts the cw::mem allocations
+      // made by the job thread. FFTW buffers (fftw_malloc()), allocations made by the proc
+      // worker threads and blocks released on other threads are not counted.
+      // At least one job is always running.
+      // Returns the rc of the first job which failed, or kOkRC if all jobs succeeded.
+      rc_t run( const object_t* proc_class_cfg,
+                job_t*          jobA,
+                unsigned        jobN,
+                unsigned        thread_cnt,
+                long long       mem_budget_byte_cnt = 0,
+                const object_t* subnet_cfg          = nullptr );
+
+      // Print the per-job and total throughput. The 'mem' column is job_t.peak_byte_cnt.
+      void report( const job_t* jobA, unsigned jobN );
+
+      // Run a batch described by a cfg.
+      // { proc_cfg_fname:<>, subnet_cfg_fname:<> (optional), thread_cnt:<>, mem_budget_mb:<> (optional),
+      //   programs:{ <pgm_label>:{ <program cfg> } ... },
+      //   jobs:[ { pgm:<pgm_label>, preset:<> (optional), args:{ ... } (optional), proj_dir:<> (optional) } ... ] }
+      rc_t run( const object_t* cfg );
+    }
+  }
+}
+
+#endif
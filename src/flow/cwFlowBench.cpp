@@ -0,0 +1,447 @@
+//| Copyright: (C) 2020-2024 Kevin Larke <contact AT larke DOT org>
+//| License: GNU GPL version 3.0 or above. See the accompanying LICENSE file.
+#include "cwCommon.h"
+#include "cwLog.h"
+#include "cwCommonImpl.h"
+#include "cwTest.h"
+#include "cwMem.h"
+#include "cwText.h"
+#include "cwObject.h"
+#include "cwFile.h"
+#include "cwTime.h"
+#include "cwMidiDecls.h"
+#include "cwFlowDecl.h"
+#include "cwFlow.h"
+#include "cwFlowBench.h"
+
+namespace cw
+{
+  namespace flow
+  {
+    namespace bench
+    {
+      enum { kMaxClassN = 32 };
+
+      typedef struct network_str
+      {
+        const char*     label;
+        unsigned        width;
+        unsigned        depth;
+        unsigned        ch_cnt;
+        unsigned        fan_out;
+        unsigned        voice_cnt;
+        const object_t* procs_cfg;
+        const object_t* proc_args_cfg;
+        const object_t* options_cfg;
+      } network_t;
+
+      typedef struct result_str
+      {
+        const char* label;
+        double      cycles_per_sec;
+      } result_t;
+
+      typedef struct bench_str
+      {
+        const object_t* proc_class_cfg;
+        unsigned        cycle_cnt;
+        unsigned        frames_per_cycle;
+        double          sample_rate;
+        bool            class_profile_fl;
+        char*           json;  // JSON output
+      } bench_t;
+
+      // Generate the proc's of a network as a list of 'procs' dictionary elements.
+      char* _gen_procs( char* s, const network_t& n, const char* mix_label )
+      {
+        unsigned procN = n.procs_cfg->child_count();
+
+        // the label suffix 'x' prevents the trailing column index from being parsed as a label sfx id
+        for(unsigned w=0; w<n.width; ++w)
+          s = mem::printp(s,"osc%ix: { class:sine_tone, args:{ ch_cnt:%i, hz:%f, gain:0.5 } }\n",w,n.ch_cnt,110.0 + 10.0*w);
+
+        for(unsigned d=0; d<n.depth; ++d)
+          for(unsigned w=0; w<n.width; ++w)
+          {
+            const char* class_label = nullptr;
+            unsigned    src_w       = w - (w % n.fan_out);  // each output is read by up to 'fan_out' proc's in the next layer
+
+            n.procs_cfg->child_ele((d*n.width + w) % procN)->value(class_label);
+
+            if( d == 0 )
+              s = mem::printp(s,"p%ic%ix: { class:%s, in:{ in:osc%ix.out } }\n",d,w,class_label,src_w);
+            else
+              s = mem::printp(s,"p%ic%ix: { class:%s, in:{ in:p%ic%ix.out } }\n",d,w,class_label,d-1,src_w);
+          }
+
+        s = mem::printp(s,"%s: { class:audio_mix, in:{ ",mix_label);
+        for(unsigned w=0; w<n.width; ++w)
+          if( n.depth == 0 )
+            s = mem::printp(s,"in%i:osc%ix.out, ",w,w);
+          else
+            s = mem::printp(s,"in%i:p%ic%ix.out, ",w,n.depth-1,w);
+
+        return mem::printp(s,"} }\n");
+      }
+
+      // Add the 'proc_args' to each proc of the matching class.
+      void _apply_proc_args( object_t* procs_cfg, const object_t* proc_args_cfg )
+      {
+        for(unsigned i=0; i<procs_cfg->child_count(); ++i)
+        {
+          object_t*       proc_cfg    = procs_cfg->child_ele(i)->pair_value();
+          const char*     class_label = nullptr;
+          const object_t* args_cfg    = nullptr;
+
+          if( proc_cfg->getv("class",class_label) != kOkRC )
+            continue;
+
+          if((args_cfg = proc_args_cfg->find(class_label)) != nullptr && proc_cfg->find("args") == nullptr )
+            newPairObject("args",args_cfg->duplicate(),proc_cfg);
+
+          // recurse into the poly network
+          object_t* net_cfg = nullptr;
+          object_t* sub_procs_cfg = nullptr;
+          if((net_cfg = proc_cfg->find("network")) != nullptr && (sub_procs_cfg = net_cfg->find("procs")) != nullptr )
+            _apply_proc_args(sub_procs_cfg,proc_args_cfg);
+        }
+      }
+
+      // Set (or replace) the top level program option 'label'.
+      void _set_option( object_t* pgm_cfg, const char* label, object_t* value )
+      {
+        object_t* val = nullptr;
+        if((val = pgm_cfg->find(label)) != nullptr )
+        {
+          object_t* pair = val->parent;
+          pair->unlink();
+          pair->free();
+        }
+
+        newPairObject(label,value,pgm_cfg);
+      }
+
+      rc_t _gen_program( const bench_t* b, const network_t& n, object_t*& pgm_cfg_ref )
+      {
+        rc_t      rc        = kOkRC;
+        char*     s         = nullptr;
+        object_t* procs_cfg = nullptr;
+
+        pgm_cfg_ref = nullptr;
+
+        s = mem::printp(s,"{ non_real_time_fl:true, max_cycle_count:%i, frames_per_cycle:%i, sample_rate:%f,\n network: { procs: {\n",b->cycle_cnt,b->frames_per_cycle,b->sample_rate);
+
+        if( n.voice_cnt == 0 )
+          s = _gen_procs(s,n,"mx");
+        else
+        {
+          s = mem::printp(s,"vp: { class:poly, args:{ count:%i }, network: { procs: {\n",n.voice_cnt);
+          s = _gen_procs(s,n,"vmx");
+          s = mem::printp(s,"} } }\n mx: { class:audio_mix, in:{ in_:vp.vmx_.out } }\n");
+        }
+
+        s = mem::printp(s,"} } }\n");
+
+        if((rc = objectFromString(s,pgm_cfg_ref)) != kOkRC )
+        {
+          rc = cwLogError(rc,"The generated program for '%s' could not be parsed.",cwStringNullGuard(n.label));
+          goto errLabel;
+        }
+
+        if( n.proc_args_cfg != nullptr && (procs_cfg = pgm_cfg_ref->find("network")->find("procs")) != nullptr )
+          _apply_proc_args(procs_cfg,n.proc_args_cfg);
+
+        if( n.options_cfg != nullptr )
+          for(unsigned i=0; i<n.options_cfg->child_count(); ++i)
+          {
+            const object_t* pair = n.options_cfg->child_ele(i);
+            _set_option(pgm_cfg_ref,pair->pair_label(),pair->pair_value()->duplicate());
+          }
+
+      errLabel:
+        mem::release(s);
+        return rc;
+      }
+
+      // Execute the program. If 'profA' is non-null then the per-class execution times are returned.
+      rc_t _run_program( const bench_t* b, const object_t* pgm_cfg, double& wall_sec_ref, unsigned& cycle_cnt_ref, long long& mem_bytes_ref, class_profile_t* profA, unsigned& profN_ref )
+      {
+        rc_t         rc = kOkRC;
+        time::spec_t t0;
+        handle_t     flowH;
+
+        mem::reset_thread_byte_count();
+
+        if((rc = create(flowH, b->proc_class_cfg, pgm_cfg)) != kOkRC )
+          goto errLabel;
+
+        if((rc = initialize(flowH)) != kOkRC )
+          goto errLabel;
+
+        mem_bytes_ref = mem::thread_byte_count();
+
+        t0 = time::current_time();
+
+        if((rc = exec(flowH)) == kEofRC )
+          rc = kOkRC;
+
+        wall_sec_ref  = time::elapsedSecs(t0);
+        cycle_cnt_ref = cycle_count(flowH);
+
+        if( profA != nullptr )
+          profN_ref = class_profile(flowH,profA,profN_ref);
+
+      errLabel:
+        destroy(flowH);
+        mem::clear_warn_on_alloc();
+        return rc;
+      }
+
+      rc_t _run_network( bench_t* b, const object_t* net_cfg, bool first_fl, result_t& result_ref )
+      {
+        rc_t            rc           = kOkRC;
+        object_t*       pgm_cfg      = nullptr;
+        double          wall_sec     = 0;
+        unsigned        cycle_cnt    = 0;
+        long long       mem_bytes    = 0;
+        long long       peak_bytes   = 0;
+        double          cycles_per_sec = 0;
+        unsigned        proc_cnt     = 0;
+        class_profile_t profA[ kMaxClassN ];
+        unsigned        profN        = 0;
+        network_t       n;
+
+        memset(&n,0,sizeof(n));
+        n.width   = 1;
+        n.depth   = 1;
+        n.ch_cnt  = 2;
+        n.fan_out = 1;
+
+        if((rc = net_cfg->getv("label",n.label,
+                               "procs",n.procs_cfg)) != kOkRC )
+        {
+          rc = cwLogError(rc,"Benchmark network parse failed.");
+          goto errLabel;
+        }
+
+        if((rc = net_cfg->getv_opt("width",n.width,
+                                   "depth",n.depth,
+                                   "ch_cnt",n.ch_cnt,
+                                   "fan_out",n.fan_out,
+                                   "voice_cnt",n.voice_cnt,
+                                   "proc_args",n.proc_args_cfg,
+                                   "options",n.options_cfg)) != kOkRC )
+        {
+          rc = cwLogError(rc,"Benchmark network '%s' optional arg. parse failed.",cwStringNullGuard(n.label));
+          goto errLabel;
+        }
+
+        if( n.width == 0 || n.fan_out == 0 || n.procs_cfg->child_count() == 0 )
+        {
+          rc = cwLogError(kInvalidArgRC,"The benchmark network '%s' must have a non-zero width, fan_out, and proc list.",cwStringNullGuard(n.label));
+          goto errLabel;
+        }
+
+        if((rc = _gen_program(b,n,pgm_cfg)) != kOkRC )
+          goto errLabel;
+
+        // time the program with profiling disabled
+        if((rc = _run_program(b,pgm_cfg,wall_sec,cycle_cnt,mem_bytes,nullptr,profN)) != kOkRC )
+        {
+          rc = cwLogError(rc,"The benchmark network '%s' failed.",cwStringNullGuard(n.label));
+          goto errLabel;
+        }
+
+        peak_bytes     = mem::thread_peak_byte_count();
+        cycles_per_sec = wall_sec > 0 ? cycle_cnt / wall_sec : 0;
+        proc_cnt       = n.voice_cnt==0 ? n.width*(n.depth+1)+1 : n.voice_cnt*(n.width*(n.depth+1)+1) + 2;
+
+        b->json = mem::printp(b->json,"%s\n    { \"label\":\"%s\", \"width\":%i, \"depth\":%i, \"ch_cnt\":%i, \"fan_out\":%i, \"voice_cnt\":%i, \"proc_cnt\":%i,\n"
+                              "      \"cycle_cnt\":%i, \"wall_sec\":%f, \"cycles_per_sec\":%f, \"rt_factor\":%f, \"mem_bytes\":%lli, \"peak_mem_bytes\":%lli,\n"
+                              "      \"classes\": [",
+                              first_fl ? "" : ",",
+                              n.label,n.width,n.depth,n.ch_cnt,n.fan_out,n.voice_cnt,proc_cnt,
+                              cycle_cnt,wall_sec,cycles_per_sec,cycles_per_sec * b->frames_per_cycle / b->sample_rate,mem_bytes,peak_bytes);
+
+        // run again with profiling enabled to get the per-class execution time
+        if( b->class_profile_fl )
+        {
+          _set_option(pgm_cfg,"profile_fl",newObject(true));
+
+          profN = kMaxClassN;
+          if((rc = _run_program(b,pgm_cfg,wall_sec,cycle_cnt,mem_bytes,profA,profN)) != kOkRC )
+          {
+            rc = cwLogError(rc,"The benchmark network '%s' profile run failed.",cwStringNullGuard(n.label));
+            goto errLabel;
+          }
+
+          // class_desc labels are owned by the proc class cfg and therefore remain valid after the network is destroyed
+          for(unsigned i=0; i<profN; ++i)
+          {
+            const class_profile_t* cp = profA + i;
+            double ns = cp->proc_cnt==0 || cycle_cnt==0 ? 0 : cp->total_sec * 1e9 / ((double)cp->proc_cnt * cycle_cnt);
+            b->json = mem::printp(b->json,"%s\n        { \"class\":\"%s\", \"proc_cnt\":%i, \"exec_cnt\":%i, \"ns_per_proc_cycle\":%f }",
+                                  i==0 ? "" : ",", cp->class_label, cp->proc_cnt, cp->exec_cnt, ns );
+          }
+        }
+
+        b->json = mem::printp(b->json," ] }");
+
+        result_ref.label          = n.label;
+        result_ref.cycles_per_sec = cycles_per_sec;
+
+        cwLogInfo("bench '%s': %f cycles/sec mem:%lli bytes",n.label,cycles_per_sec,mem_bytes);
+
+      errLabel:
+        if( pgm_cfg != nullptr )
+          pgm_cfg->free();
+
+        return rc;
+      }
+
+      // Compare the results with a previous run and fail if any network is slower than the allowed margin.
+      rc_t _check_baseline( const char* baseline_fname, const result_t* resultA, unsigned resultN, double max_regression_pct )
+      {
+        rc_t            rc           = kOkRC;
+        object_t*       baseline_cfg = nullptr;
+        const object_t* nets_cfg     = nullptr;
+        rc_t            regress_rc   = kOkRC;
+
+        if((rc = objectFromFile(baseline_fname,baseline_cfg)) != kOkRC )
+        {
+          rc = cwLogError(rc,"The benchmark baseline file '%s' could not be read.",cwStringNullGuard(baseline_fname));
+          goto errLabel;
+        }
+
+        if((rc = baseline_cfg->getv("networks",nets_cfg)) != kOkRC )
+        {
+          rc = cwLogError(rc,"The benchmark baseline 'networks' list was not found.");
+          goto errLabel;
+        }
+
+        for(unsigned i=0; i<resultN; ++i)
+          for(unsigned j=0; j<nets_cfg->child_count(); ++j)
+          {
+            const char* label          = nullptr;
+            double      cycles_per_sec = 0;
+
+            if((rc = nets_cfg->child_ele(j)->getv("label",label,"cycles_per_sec",cycles_per_sec)) != kOkRC )
+            {
+              rc = cwLogError(rc,"The benchmark baseline network at index %i could not be parsed.",j);
+              goto errLabel;
+            }
+
+            if( textIsEqual(label,resultA[i].label) )
+            {
+              if( resultA[i].cycles_per_sec < cycles_per_sec * (1.0 - max_regression_pct/100.0) )
+                regress_rc = cwLogError(kOpFailRC,"The benchmark network '%s' regressed: %f cycles/sec < baseline %f cycles/sec.",label,resultA[i].cycles_per_sec,cycles_per_sec);
+              break;
+            }
+          }
+
+      errLabel:
+        if( baseline_cfg != nullptr )
+          baseline_cfg->free();
+
+        return rc != kOkRC ? rc : regress_rc;
+      }
+
+    }
+  }
+}
+
+cw::rc_t cw::flow::bench::run( const object_t* cfg )
+{
+  rc_t            rc                 = kOkRC;
+  const char*     proc_cfg_fname     = nullptr;
+  const char*     out_fname          = nullptr;
+  const char*     baseline_fname     = nullptr;
+  double          max_regression_pct = 10.0;
+  const object_t* nets_cfg           = nullptr;
+  object_t*       class_cfg          = nullptr;
+  result_t*       resultA            = nullptr;
+  unsigned        resultN            = 0;
+  file::handle_t  fH;
+  bench_t         b;
+
+  memset(&b,0,sizeof(b));
+  b.frames_per_cycle = 64;
+  b.sample_rate      = 48000;
+  b.class_profile_fl = true;
+
+  if((rc = cfg->getv("proc_cfg_fname",proc_cfg_fname,
+                     "cycle_cnt",b.cycle_cnt,
+                     "networks",nets_cfg)) != kOkRC )
+  {
+    rc = cwLogError(rc,"Benchmark cfg. parse failed.");
+    goto errLabel;
+  }
+
+  if((rc = cfg->getv_opt("out_fname",out_fname,
+                         "baseline_fname",baseline_fname,
+                         "max_regression_pct",max_regression_pct,
+                         "frames_per_cycle",b.frames_per_cycle,
+                         "sample_rate",b.sample_rate,
+                         "class_profile_fl",b.class_profile_fl)) != kOkRC )
+  {
+    rc = cwLogError(rc,"Benchmark cfg. optional arg. parse failed.");
+    goto errLabel;
+  }
+
+  if((rc = objectFromFile(proc_cfg_fname,class_cfg)) != kOkRC )
+  {
+    rc = cwLogError(rc,"The flow proc dictionary could not be read from '%s'.",cwStringNullGuard(proc_cfg_fname));
+    goto errLabel;
+  }
+
+  b.proc_class_cfg = class_cfg;
+
+  resultN = nets_cfg->child_count();
+  resultA = mem::allocZ<result_t>(resultN);
+
+  b.json = mem::printp(b.json,"{\n  \"frames_per_cycle\":%i, \"sample_rate\":%f, \"cycle_cnt\":%i,\n  \"networks\": [",b.frames_per_cycle,b.sample_rate,b.cycle_cnt);
+
+  for(unsigned i=0; i<resultN; ++i)
+  {
+    if((rc = _run_network(&b,nets_cfg->child_ele(i),i==0,resultA[i])) != kOkRC )
+      goto errLabel;
+  }
+
+  b.json = mem::printp(b.json,"\n  ]\n}\n");
+
+  if( out_fname == nullptr )
+    cwLogPrint("%s",b.json);
+  else
+  {
+    if((rc = file::open(fH,out_fname,file::kWriteFl)) != kOkRC )
+    {
+      rc = cwLogError(rc,"The benchmark output file '%s' could not be created.",out_fname);
+      goto errLabel;
+    }
+
+    rc = file::printf(fH,"%s",b.json);
+
+    file::close(fH);
+
+    if( rc != kOkRC )
+    {
+      rc = cwLogError(rc,"The benchmark output file '%s' write failed.",out_fname);
+      goto errLabel;
+    }
+  }
+
+  if( baseline_fname != nullptr )
+    rc = _check_baseline(baseline_fname,resultA,resultN,max_regression_pct);
+
+errLabel:
+  mem::release(b.json);
+  mem::release(resultA);
+
+  if( class_cfg != nullptr )
+    class_cfg->free();
+
+  if( rc != kOkRC )
+    rc = cwLogError(rc,"Flow benchmark failed.");
+
+  return rc;
+}
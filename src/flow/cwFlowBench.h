@@ -0,0 +1,46 @@
+//| Copyright: (C) 2020-2024 Kevin Larke <contact AT larke DOT org>
+//| License: GNU GPL version 3.0 or above. See the accompanying LICENSE file.
+#ifndef cwFlowBench_h
+#define cwFlowBench_h
+
+namespace cw
+{
+  namespace flow
+  {
+    namespace bench
+    {
+      // Generate and run a set of synthetic non-real-time networks and report their throughput as JSON.
+      //
+      // {
+      //   proc_cfg_fname:     <>,         // proc class dictionary
+      //   out_fname:          <>,         // (optional) JSON output file. If not given the result is printed to the log.
+      //   baseline_fname:     <>,         // (optional) JSON output file from a previous run
+      //   max_regression_pct: 10.0,       // (optional) fail if the cycles/sec of a network falls more than this below the baseline
+      //   cycle_cnt:          1000,       // count of cycles to execute per network
+      //   frames_per_cycle:   64,         // (optional)
+      //   sample_rate:        48000,      // (optional)
+      //   class_profile_fl:   true,       // (optional) run each network a second time with profiling enabled to measure the time per proc class
+      //
+      //   networks: [
+      //     {
+      //       label:     <>,
+      //       width:     4,                        // count of parallel proc chains
+      //       depth:     8,                        // count of proc's in each chain
+      //       ch_cnt:    2,                        // audio channel count
+      //       fan_out:   1,                        // count of proc's in the next layer which read each output
+      //       voice_cnt: 0,                        // if non-zero the chains are placed in a 'poly' proc with this many voices
+      //       procs:     [ audio_gain, dc_filter ], // proc classes assigned in rotation (each must have an audio 'in' and 'out')
+      //       proc_args: { audio_gain:{ gain:0.5 } } // (optional) args for each proc class
+      //       options:   { parallel_fl:true }       // (optional) program options (e.g. parallel_fl, abuf_pool_fl, fuse_fl)
+      //     }
+      //   ]
+      // }
+      //
+      // Each chain is driven by a 'sine_tone' and the last proc of every chain is summed by an 'audio_mix'.
+      // Returns kOpFailRC if the throughput of any network regressed relative to the baseline.
+      rc_t run( const object_t* cfg );
+    }
+  }
+}
+
+#endif
@@ -98,6 +98,46 @@ namespace cw
     } multi_preset_selector_t;
 
     
+    // Execution latency statistics returned by flow::latency_stats().
+    typedef struct latency_stats_str
+    {
+      unsigned cnt;      // count of recorded executions
+      double   p50_us;   // median execution time in microseconds
+      double   p99_us;   //
+      double   p999_us;  //
+      double   max_us;   // longest execution time
+      unsigned bypass_cnt; // count of cycles where the proc was bypassed (counted even if profiling is disabled)
+    } latency_stats_t;
+
+    // Accumulated execution time of all the proc's of a class as returned by flow::class_profile().
+    typedef struct class_profile_str
+    {
+      const char* class_label;
+      unsigned    proc_cnt;   // count of proc's of this class (including proc's in poly networks)
+      unsigned    exec_cnt;   // total count of calls to proc_exec() on proc's of this class
+      double      total_sec;  // total execution time of the proc's of this class
+    } class_profile_t;
+
+    // UI update counters as returned by flow::ui_update_stats().
+    typedef struct ui_update_stats_str
+    {
+      unsigned flush_cnt;     // count of non-empty UI updates
+      unsigned sent_cnt;      // count of var updates passed to the UI callback
+      unsigned coalesced_cnt; // count of var updates merged with a pending update of the same var
+      unsigned deferred_cnt;  // count of var updates which exceeded the budget and were moved to the next UI update
+      unsigned dropped_cnt;   // count of low priority ('ui_low') var updates which exceeded the budget
+    } ui_update_stats_t;
+
+    // A cycle which exceeded the deadline as returned by flow::deadline_miss().
+    typedef struct deadline_miss_str
+    {
+      unsigned    cycle_idx;     // cycle on which the deadline was missed
+      double      dur_us;        // network execution time on this cycle
+      const char* proc_label;    // label of the root network proc with the longest execution time on this cycle
+      unsigned    proc_sfx_id;   //
+      double      proc_dur_us;   // execution time of the proc on this cycle
+    } deadline_miss_t;
+    
     typedef struct ui_preset_str
     {
       const char* label;
@@ -298,7 +298,7 @@ namespace cw
           goto errLabel;
         }
           
-        if((rc = objectFromFile( fn, cfg )) != kOkRC )
+        if((rc = proc_object_from_file(proc,fn,cfg)) != kOkRC )
         {
           rc = proc_error(proc,rc,"Unable to parse cfg from '%s'.",cwStringNullGuard(fn));
           goto errLabel;
@@ -913,7 +913,7 @@ namespace cw
           goto errLabel;
         }
           
-        if((rc = objectFromFile( fn, cfg )) != kOkRC )
+        if((rc = proc_object_from_file(proc,fn,cfg)) != kOkRC )
         {
           rc = proc_error(proc,rc,"Unable to parse cfg from '%s'.",cwStringNullGuard(fn));
           goto errLabel;
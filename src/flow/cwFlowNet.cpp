@@ -8,6 +8,8 @@
 #include "cwText.h"
 #include "cwNumericConvert.h"
 #include "cwObject.h"
+#include "cwThread.h"
+#include "cwThreadMach.h"
 #undef cwTRACER
 #include "cwTracer.h"
 
@@ -92,6 +94,7 @@ namespace cw
       const object_t* presets_dict;
       const object_t* arg_cfg;           //
       const object_t* log_labels;        //
+      const object_t* rate_cfg;          // optional 'rate' field
       
       const object_t* in_dict_cfg;  // cfg. node to the in-list
       io_stmt_t*      iStmtA;
@@ -134,6 +137,7 @@ namespace cw
         _network_preset_destroy( net.presetA[i] );
       mem::release(net.presetA);
       net.presetN=0;
+      hash_index_destroy(net.presetIdx);
     }
 
     rc_t _destroy_ui_net( ui_net_t*& ui_net)
@@ -162,7 +166,1293 @@ namespace cw
       return rc;
     }
 
+
+    //==================================================================================================================
+    //
+    // Network - Parallel Schedule
+    //
+    // The proc's of a network are partitioned into execution levels. All the proc's in
+    // a given level may execute concurrently because they are not connected to one another.
+    // A proc is placed in a level which follows the level of every proc, earlier in the
+    // execution order, which it is connected to. Connections are considered in both
+    // directions (including 'out' feedback connections) and therefore every variable is
+    // read and written in the same order as when the network is executed serially.
+    // Proc's whose class is not marked 'parallel_fl' form a barrier: they execute alone
+    // in their level and are ordered relative to every other proc.
+    
+    typedef struct network_sched_str
+    {
+      thread_stasks::handle_t threadTasksH; // worker threads
+      thread_stasks::task_t*  taskA;        // taskA[ net.procN ] one task per proc in level order
+      unsigned*               levelA;       // levelA[ levelN+1 ] index into taskA[] of the first task in each level
+      unsigned                levelN;       // count of execution levels
+    } network_sched_t;
+
+    rc_t _proc_exec_and_profile( proc_t* proc )
+    {
+      rc_t         rc       = kOkRC;
+      bool         prof_fl  = proc->ctx->prof_fl;
+      unsigned     skip_cnt = proc->rate_skip_cnt + proc->bypass_cnt;
+      time::spec_t t0;
+      time::spec_t t1;
+    
+      if( prof_fl )
+        time::get(t0);
+
+      TRACE_TIME( proc->trace_id, tracer::kBegEvtId, proc->ctx->cycleIndex,0 );
+
+      // execute the proc instance
+      rc = proc_exec(proc);
+      
+      TRACE_TIME( proc->trace_id, tracer::kEndEvtId, proc->ctx->cycleIndex,0 );
+
+      if( prof_fl )
+      {
+        time::get(t1);
+        time::accumulate_elapsed(proc->prof_dur,t0,t1);
+        proc->prof_cnt += 1;
+
+        // cycles skipped because of the proc's execution rate or bypass are not included in the histogram
+        if( proc->rate_skip_cnt + proc->bypass_cnt == skip_cnt )
+        {
+          proc->prof_cycle_ns  = time::elapsedNanos(t0,t1);
+          proc->prof_cycle_idx = proc->ctx->cycleIndex;
+          latency_hist_record(proc->prof_hist,proc->prof_cycle_ns);
+        }
+      }
+
+      return rc;
+    }
+
+    rc_t _network_sched_task_func( void* arg )
+    {
+      proc_t* proc = (proc_t*)arg;
+
+      // the 'warn on alloc' flag is per-thread and must therefore be set on each worker
+      if( proc->ctx->warn_on_rt_alloc_fl )
+        mem::set_warn_on_alloc();
+      
+      return _proc_exec_and_profile(proc);
+    }
+
+    unsigned _network_proc_index( const network_t& net, const proc_t* proc )
+    {
+      if( proc->net == &net )
+        for(unsigned i=0; i<net.procN; ++i)
+          if( net.procA[i] == proc )
+            return i;
+      
+      return kInvalidIdx;
+    }
+
+    // Fill edgeA[] with (src,dst) proc index pairs where src < dst.
+    // Returns the count of edges. Set edgeA to nullptr to count the edges without storing them.
+    unsigned _network_sched_edges( const network_t& net, unsigned* edgeA )
+    {
+      unsigned edgeN = 0;
+      
+      for(unsigned i=0; i<net.procN; ++i)
+        for(variable_t* var=net.procA[i]->varL; var!=nullptr; var=var->var_link)
+          if( var->src_var != nullptr )
+          {
+            unsigned j = _network_proc_index(net,var->src_var->proc);
+
+            if( j != kInvalidIdx && j != i )
+            {
+              if( edgeA != nullptr )
+              {
+                edgeA[ edgeN*2 + 0 ] = std::min(i,j);
+                edgeA[ edgeN*2 + 1 ] = std::max(i,j);
+              }
+              
+              edgeN += 1;
+            }
+          }
+      
+      return edgeN;
+    }
+
+    void _network_sched_destroy( network_sched_t*& sched )
+    {
+      if( sched == nullptr )
+        return;
+
+      thread_stasks::destroy(sched->threadTasksH);
+      mem::release(sched->taskA);
+      mem::release(sched->levelA);
+      mem::release(sched);
+    }
+    
+    rc_t _network_sched_create( flow_t* p, network_t& net )
+    {
+      rc_t             rc           = kOkRC;
+      network_sched_t* sched        = nullptr;
+      unsigned         edgeN        = _network_sched_edges(net,nullptr);
+      unsigned*        edgeA        = mem::allocZ<unsigned>(edgeN*2);
+      unsigned*        procLevelA   = mem::allocZ<unsigned>(net.procN);
+      unsigned         cpuAffinityN = p->cpu_affinityL==nullptr ? 0 : p->cpu_affinityL->child_count();
+      unsigned         cpuAffinityA[ std::max(1u,p->thread_cnt) ];
+      unsigned         min_level    = 0;
+      unsigned         max_level    = 0;
+
+      if( p->thread_cnt == 0 )
+      {
+        rc = net_error(&net,kInvalidArgRC,"The parallel execution 'thread_cnt' must be greater than zero.");
+        goto errLabel;
+      }
+
+      // by default do not use cpu affinities
+      for(unsigned i=0; i<p->thread_cnt; ++i)
+        cpuAffinityA[i] = kInvalidIdx;
+      
+      // validate the length of the CPU affinity list
+      if( cpuAffinityN>0 && cpuAffinityN != p->thread_cnt )
+      {
+        rc = net_error(&net,kInvalidArgRC,"Count of CPU affinities (%i) does not match thread count (%i).",cpuAffinityN,p->thread_cnt);
+        goto errLabel;
+      }
+
+      for(unsigned i=0; i<cpuAffinityN; ++i)
+        if((rc = p->cpu_affinityL->child_ele(i)->value(cpuAffinityA[i])) != kOkRC )
+        {
+          rc = net_error(&net,rc,"Error parsing CPU affinities.");
+          goto errLabel;
+        }
+
+      _network_sched_edges(net,edgeA);
+      
+      // assign each proc to an execution level
+      for(unsigned i=0; i<net.procN; ++i)
+      {
+        unsigned level = min_level;
+
+        if( !net.procA[i]->class_desc->parallelFl )
+        {
+          // a barrier proc follows all previous proc's and precedes all following proc's
+          level     = i==0 ? 0 : max_level + 1;
+          min_level = level + 1;
+        }
+        else
+        {
+          // a parallel proc follows all previous proc's that it is connected to
+          for(unsigned j=0; j<edgeN; ++j)
+            if( edgeA[j*2+1] == i )
+              level = std::max(level,procLevelA[ edgeA[j*2+0] ] + 1);
+        }
+
+        procLevelA[i] = level;
+        max_level     = std::max(max_level,level);
+      }
+
+      sched         = mem::allocZ<network_sched_t>();
+      sched->levelN = net.procN==0 ? 0 : max_level + 1;
+      sched->levelA = mem::allocZ<unsigned>(sched->levelN + 1);
+      sched->taskA  = mem::allocZ<thread_stasks::task_t>(net.procN);
+
+      // count the proc's in each level ...
+      for(unsigned i=0; i<net.procN; ++i)
+        sched->levelA[ procLevelA[i] + 1 ] += 1;
+
+      // ... and convert the counts to offsets into taskA[]
+      for(unsigned i=0; i<sched->levelN; ++i)
+        sched->levelA[i+1] += sched->levelA[i];
+
+      // fill taskA[] in level order - maintaining the execution order within each level
+      for(unsigned l=0,k=0; l<sched->levelN; ++l)
+        for(unsigned i=0; i<net.procN; ++i)
+          if( procLevelA[i] == l )
+          {
+            sched->taskA[k].func = _network_sched_task_func;
+            sched->taskA[k].arg  = net.procA[i];
+            ++k;
+          }
+      
+      if((rc = thread_stasks::create( sched->threadTasksH, p->thread_cnt, cpuAffinityA, "net_thread" )) != kOkRC )
+      {
+        rc = net_error(&net,rc,"The parallel execution thread machine create failed.");
+        goto errLabel;
+      }
+
+      cwLogInfo("Network '%s' parallel schedule: %i proc's in %i levels on %i threads.",cwStringNullGuard(net.label),net.procN,sched->levelN,p->thread_cnt);
+      
+      net.sched = sched;
+      
+    errLabel:
+      if( rc != kOkRC )
+        _network_sched_destroy(sched);
+      
+      mem::release(edgeA);
+      mem::release(procLevelA);
+      return rc;
+    }
+
+    rc_t _network_exec_serial( network_t& net, bool& halt_fl_ref )
+    {
+      rc_t rc = kOkRC;
+      
+      for(unsigned i=0; i<net.procN && rc==kOkRC; ++i)
+      {
+        // execute the proc instance
+        if((rc = _proc_exec_and_profile(net.procA[i])) != kOkRC )
+        {
+          // kEofRC indicates that that the network should shutdow at the end of this cycle.
+          if( rc == kEofRC )
+          {
+            halt_fl_ref = true;
+            rc = kOkRC;
+          }      
+        }
+      }
+
+      return rc;
+    }
+
+    rc_t _network_exec_parallel( network_t& net, bool& halt_fl_ref )
+    {
+      rc_t             rc    = kOkRC;
+      network_sched_t* sched = net.sched;
+      
+      for(unsigned l=0; l<sched->levelN && rc==kOkRC; ++l)
+      {
+        thread_stasks::task_t* taskA = sched->taskA + sched->levelA[l];
+        unsigned               taskN = sched->levelA[l+1] - sched->levelA[l];
+
+        // single proc levels are executed directly on this thread
+        if( taskN == 1 )
+          taskA->rc = taskA->func(taskA->arg);
+        else
+          if((rc = thread_stasks::run(sched->threadTasksH, taskA, taskN )) != kOkRC )
+          {
+            rc = net_error(&net,rc,"Parallel execution failed on level %i.",l);
+            break;
+          }
+
+        // kEofRC indicates that that the network should shutdow at the end of this cycle.
+        for(unsigned i=0; i<taskN; ++i)
+          if( taskA[i].rc == kEofRC )
+            halt_fl_ref = true;
+          else
+            if( taskA[i].rc != kOkRC && rc == kOkRC )
+              rc = taskA[i].rc;
+      }
+
+      return rc;
+    }
+    
+
+    //==================================================================================================================
+    //
+    // Network - Audio Buffer Pool
+    //
+    // Every audio output buffer is live from the execution of the proc that writes it
+    // until the execution of the last proc that reads it. Buffers whose lifetimes do
+    // not overlap are packed into the same region of a single cache aligned arena.
+    // A buffer is only pooled if:
+    // 1. It is written by a proc whose class is marked 'abuf_pool_fl' (the proc
+    //    completely rewrites the buffer on every cycle).
+    // 2. All of the proc's which read it are in the same network and execute
+    //    after the proc which writes it (i.e. it does not carry a value across cycles).
+    
+    enum { kAbufPoolAlignByteN = kSignalAlignByteN };
+    
+    typedef struct abuf_pool_buf_str
+    {
+      abuf_t*   abuf;     // pooled buffer
+      unsigned  begPos;   // execution position of the writer
+      unsigned  endPos;   // execution position of the last reader
+      unsigned  byteN;    // size of the buffer rounded up to kAbufPoolAlignByteN
+      unsigned  slotIdx;  // index of the arena region assigned to this buffer
+    } abuf_pool_buf_t;
+
+    typedef struct abuf_pool_slot_str
+    {
+      unsigned byteN;     // size of the region (max byteN of all buffers assigned to it)
+      unsigned endPos;    // execution position of the last reader of the most recently assigned buffer
+      unsigned byteOffs;  // offset of this region into the arena
+    } abuf_pool_slot_t;
+    
+    typedef struct abuf_pool_str
+    {
+      void*            mem;          // arena allocation
+      unsigned         memByteN;     // size of the arena in bytes
+      abuf_pool_buf_t* bufA;         // bufA[ bufN ] pooled buffers
+      unsigned         bufN;         //
+      unsigned         allByteN;     // total size of all audio output buffers in the network before pooling
+      unsigned         unpooledByteN;// total size of the buffers which could not be pooled
+    } abuf_pool_t;
+
+    void _abuf_pool_destroy( abuf_pool_t*& pool )
+    {
+      if( pool == nullptr )
+        return;
+
+      // the pooled buffers are owned by the arena
+      for(unsigned i=0; i<pool->bufN; ++i)
+        pool->bufA[i].abuf->buf = nullptr;
+
+      mem::release(pool->bufA);
+      mem::release(pool->mem);
+      mem::release(pool);
+    }
+
+    // Set posA[ net.procN ] to the execution position of each proc.
+    void _abuf_pool_exec_positions( const network_t& net, unsigned* posA )
+    {
+      if( net.sched == nullptr )
+      {
+        for(unsigned i=0; i<net.procN; ++i)
+          posA[i] = i;
+        return;
+      }
+
+      // parallel proc's in the same level share the same execution position
+      for(unsigned l=0; l<net.sched->levelN; ++l)
+        for(unsigned k=net.sched->levelA[l]; k<net.sched->levelA[l+1]; ++k)
+        {
+          unsigned i = _network_proc_index(net,(const proc_t*)net.sched->taskA[k].arg);
+          assert( i != kInvalidIdx );
+          posA[i] = l;
+        }
+    }
+
+    // Returns true if 'var' owns an audio buffer.
+    bool _abuf_pool_is_audio_output( const variable_t* var )
+    {
+      return var->chIdx == kAnyChIdx && var->value == &var->my_value && (var->value->tflag & kTypeMask) == kABufTFl && var->value->u.abuf != nullptr;
+    }
+    
+    // Returns true if 'var' is an audio output of a proc in 'net'
+    // and sets 'endPosRef' to the execution position of the last reader.
+    bool _abuf_pool_is_candidate( const network_t& net, const unsigned* posA, unsigned procIdx, variable_t* var, unsigned& endPosRef )
+    {
+      endPosRef = posA[procIdx];
+
+      for(variable_t* dst=var->dst_head; dst!=nullptr; dst=dst->dst_link)
+      {
+        // a fused proc reads its inputs when the kernel of its sink proc executes
+        unsigned j = _network_proc_index(net,dst->proc->fuse_sink != nullptr ? dst->proc->fuse_sink : dst->proc);
+        
+        // the reader is in another network or it executes before the writer
+        if( j == kInvalidIdx || posA[j] <= posA[procIdx] )
+          return false;
+
+        endPosRef = std::max(endPosRef,posA[j]);
+      }
+      
+      return true;
+    }
+    
+    rc_t _abuf_pool_create( network_t& net )
+    {
+      rc_t              rc    = kOkRC;
+      abuf_pool_t*      pool  = mem::allocZ<abuf_pool_t>();
+      unsigned*         posA  = mem::allocZ<unsigned>(net.procN);
+      abuf_pool_slot_t* slotA = nullptr;
+      unsigned          slotN = 0;
+      unsigned          bufAllocN = 0;
+      char*             base  = nullptr;
+
+      _abuf_pool_exec_positions(net,posA);
+
+      // count the audio output variables
+      for(unsigned i=0; i<net.procN; ++i)
+        for(variable_t* var=net.procA[i]->varL; var!=nullptr; var=var->var_link)
+          if( _abuf_pool_is_audio_output(var) )
+            bufAllocN += 1;
+
+      pool->bufA = mem::allocZ<abuf_pool_buf_t>(bufAllocN);
+      
+      // locate the buffers that can be pooled and determine their lifetimes
+      for(unsigned i=0; i<net.procN; ++i)
+        for(variable_t* var=net.procA[i]->varL; var!=nullptr; var=var->var_link)
+          if( _abuf_pool_is_audio_output(var) )
+          {
+            abuf_t*  abuf   = var->value->u.abuf;
+            unsigned byteN  = abuf->bufAllocSmpN * sizeof(sample_t);
+            unsigned endPos = kInvalidIdx;
+
+            pool->allByteN += byteN;
+            
+            // (the outputs of fused proc's are never written and therefore are not pooled)
+            if( net.procA[i]->class_desc->abufPoolFl && net.procA[i]->fuse_sink == nullptr && _abuf_pool_is_candidate(net,posA,i,var,endPos) )
+            {
+              abuf_pool_buf_t* b = pool->bufA + pool->bufN++;
+              b->abuf   = abuf;
+              b->begPos = posA[i];
+              b->endPos = endPos;
+              b->byteN  = ((byteN + kAbufPoolAlignByteN - 1) / kAbufPoolAlignByteN) * kAbufPoolAlignByteN;
+            }
+            else
+            {
+              pool->unpooledByteN += byteN;
+            }
+          }
+
+      // order the buffers by the position of the writer
+      std::sort(pool->bufA, pool->bufA + pool->bufN, [](const abuf_pool_buf_t& a, const abuf_pool_buf_t& b){ return a.begPos < b.begPos; } );
+
+      slotA = mem::allocZ<abuf_pool_slot_t>(pool->bufN);
+      
+      // assign each buffer to a region whose previous buffer is no longer live
+      for(unsigned i=0; i<pool->bufN; ++i)
+      {
+        abuf_pool_buf_t* b       = pool->bufA + i;
+        unsigned         fitIdx  = kInvalidIdx; // smallest free region which will hold this buffer
+        unsigned         growIdx = kInvalidIdx; // largest free region
+        
+        for(unsigned j=0; j<slotN; ++j)
+          if( slotA[j].endPos < b->begPos )
+          {
+            if( slotA[j].byteN >= b->byteN && (fitIdx==kInvalidIdx || slotA[j].byteN < slotA[fitIdx].byteN) )
+              fitIdx = j;
+
+            if( growIdx==kInvalidIdx || slotA[j].byteN > slotA[growIdx].byteN )
+              growIdx = j;
+          }
+
+        b->slotIdx = fitIdx != kInvalidIdx ? fitIdx : (growIdx != kInvalidIdx ? growIdx : slotN++);
+
+        slotA[ b->slotIdx ].byteN  = std::max(slotA[ b->slotIdx ].byteN, b->byteN);
+        slotA[ b->slotIdx ].endPos = b->endPos;
+      }
+
+      // locate each region in the arena
+      for(unsigned j=0; j<slotN; ++j)
+      {
+        slotA[j].byteOffs = pool->memByteN;
+        pool->memByteN   += slotA[j].byteN;
+      }
+      
+      // allocate the arena with enough extra space to align the first region
+      pool->mem = mem::allocZ<char>(pool->memByteN + kAbufPoolAlignByteN);
+      base      = (char*)pool->mem + (kAbufPoolAlignByteN - ((uintptr_t)pool->mem % kAbufPoolAlignByteN)) % kAbufPoolAlignByteN;
+
+      // move each pooled buffer into the arena
+      for(unsigned i=0; i<pool->bufN; ++i)
+      {
+        abuf_t* abuf = pool->bufA[i].abuf;
+        mem::release(abuf->buf);
+        abuf->buf = (sample_t*)(base + slotA[ pool->bufA[i].slotIdx ].byteOffs);
+      }
+
+      cwLogInfo("Network '%s' audio buffers: %i bytes before pooling, %i bytes after pooling (%i of %i buffers pooled in %i regions).",
+                cwStringNullGuard(net.label), pool->allByteN, pool->memByteN + pool->unpooledByteN, pool->bufN, bufAllocN, slotN);
+      
+      net.abuf_pool = pool;
+      
+      mem::release(slotA);
+      mem::release(posA);
+      return rc;
+    }
+    
+    
+    //==================================================================================================================
+    //
+    // Network - Pipeline
+    //
+    // The proc's of the root network are partitioned into contiguous stages which execute
+    // concurrently. On each cycle stage 's' processes the data which stage 's-1' produced
+    // on the previous cycle and therefore the output of the last stage lags the first stage
+    // by (stage count - 1) cycles.
+    //
+    // Only audio buffers may cross a stage boundary. Each audio buffer which is read by a
+    // later stage is given a ring of (max. delay + 1) buffers. The writer always fills the
+    // ring slot for the current cycle while a reader in a stage which is 'd' stages later
+    // reads the slot written 'd' cycles earlier. The slots are rotated after all stages
+    // have completed. The writer's silence flag is recorded with each slot and so the
+    // silence bypass also applies to delayed readers.
+    //
+    // A stage boundary is not allowed to split a connection which carries any other type
+    // of value (or a feedback connection) because these values are not delayed.
+    // Requested boundaries which would split such a connection are moved to the next
+    // legal position.
+
+    typedef struct pipe_stage_str
+    {
+      network_t*   net;         //
+      unsigned     begProcIdx;  // index into net.procA[] of the first proc in this stage
+      unsigned     endProcIdx;  // index into net.procA[] of the proc following the last proc in this stage
+      bool         halt_fl;     // set if a proc in this stage returned kEofRC on the current cycle
+      time::spec_t prof_dur;    // total time spent executing this stage
+      unsigned     prof_cnt;    // total count of executions of this stage
+    } pipe_stage_t;
+
+    typedef struct pipe_buf_str
+    {
+      abuf_t*    abuf;     // writer's audio buffer
+      sample_t** ringA;    // ringA[ ringN ] ringA[0] is the writer's original buffer
+      bool*      silentA;  // silentA[ ringN ] writer's 'silentFl' at the time each slot was written
+      unsigned   ringN;    //
+      unsigned   headIdx;  // index of the ring slot being written on this cycle
+    } pipe_buf_t;
+
+    typedef struct pipe_delay_str
+    {
+      variable_t* var;     // delayed reader
+      unsigned    bufIdx;  // index into pipe.bufA[] of the buffer being read
+      unsigned    delayN;  // count of cycles of delay
+      value_t     value;   // private value assigned to var->value
+      abuf_t      abuf;    // private audio buffer referenced by 'value'
+    } pipe_delay_t;
+    
+    typedef struct network_pipe_str
+    {
+      thread_ftasks::handle_t threadTasksH; // one worker thread per stage
+      thread_ftasks::task_t*  taskA;        // taskA[ stageN ]
+      pipe_stage_t*           stageA;       // stageA[ stageN ]
+      unsigned                stageN;       //
+      pipe_buf_t*             bufA;         // bufA[ bufN ] audio buffers which are read by a later stage
+      unsigned                bufN;         //
+      pipe_delay_t*           delayA;       // delayA[ delayN ] variables which read a delayed buffer
+      unsigned                delayN;       //
+    } network_pipe_t;
+
+    // Returns true if 'proc' is contained by 'net' or one of its internal networks.
+    bool _pipe_net_contains( const network_t& net, const proc_t* proc )
+    {
+      for(unsigned i=0; i<net.procN; ++i)
+      {
+        if( net.procA[i] == proc )
+          return true;
+
+        for(const network_t* n=net.procA[i]->internal_net; n!=nullptr; n=n->poly_link)
+          if( _pipe_net_contains(*n,proc) )
+            return true;
+      }
+      return false;
+    }
+
+    // Returns the index into net.procA[] of the proc which is, or contains, 'proc'.
+    unsigned _pipe_top_proc_index( const network_t& net, const proc_t* proc )
+    {
+      unsigned idx;
+      if((idx = _network_proc_index(net,proc)) != kInvalidIdx )
+        return idx;
+      
+      for(unsigned i=0; i<net.procN; ++i)
+        for(const network_t* n=net.procA[i]->internal_net; n!=nullptr; n=n->poly_link)
+          if( _pipe_net_contains(*n,proc) )
+            return i;
+
+      return kInvalidIdx;
+    }
+
+    // Returns true if 'var' reads an audio buffer which may be delayed.
+    bool _pipe_is_delayable( const variable_t* var )
+    {
+      const variable_t* src_var = var->src_var;
+      return src_var != nullptr
+        && src_var->value == &src_var->my_value
+        && var->value == src_var->value
+        && (src_var->value->tflag & kTypeMask) == kABufTFl
+        && src_var->value->u.abuf != nullptr;
+    }
+
+    // Clear cutOkA[i] for every stage boundary, at proc index 'i', which would split a connection
+    // that cannot be delayed. 'topIdx' is the index of the top-level proc which contains 'net'.
+    void _pipe_mark_illegal_cuts( const network_t& root, const network_t& net, unsigned topIdx, bool* cutOkA )
+    {
+      for(unsigned i=0; i<net.procN; ++i)
+      {
+        unsigned dstIdx = topIdx==kInvalidIdx ? i : topIdx;
+
+        for(variable_t* var=net.procA[i]->varL; var!=nullptr; var=var->var_link)
+          if( var->src_var != nullptr )
+          {
+            unsigned srcIdx = _pipe_top_proc_index(root,var->src_var->proc);
+
+            if( srcIdx == kInvalidIdx || srcIdx == dstIdx )
+              continue;
+            
+            // forward audio connections may cross a stage boundary
+            if( srcIdx < dstIdx && _pipe_is_delayable(var) )
+              continue;
+
+            for(unsigned j=std::min(srcIdx,dstIdx)+1; j<=std::max(srcIdx,dstIdx); ++j)
+              cutOkA[j] = false;
+          }
+
+        for(const network_t* n=net.procA[i]->internal_net; n!=nullptr; n=n->poly_link)
+          _pipe_mark_illegal_cuts(root,*n,dstIdx,cutOkA);
+      }
+    }
+
+    // Create a pipe_delay_t record for each variable which reads an audio buffer written by an earlier stage.
+    // Set delayA to nullptr to count the delayed variables without creating them.
+    unsigned _pipe_locate_delays( const network_t& root, const network_t& net, unsigned topIdx, const unsigned* procStageA, pipe_delay_t* delayA )
+    {
+      unsigned delayN = 0;
+      
+      for(unsigned i=0; i<net.procN; ++i)
+      {
+        unsigned dstIdx = topIdx==kInvalidIdx ? i : topIdx;
+
+        for(variable_t* var=net.procA[i]->varL; var!=nullptr; var=var->var_link)
+          if( _pipe_is_delayable(var) )
+          {
+            unsigned srcIdx = _pipe_top_proc_index(root,var->src_var->proc);
+
+            if( srcIdx != kInvalidIdx && procStageA[srcIdx] < procStageA[dstIdx] )
+            {
+              if( delayA != nullptr )
+              {
+                delayA[delayN].var    = var;
+                delayA[delayN].delayN = procStageA[dstIdx] - procStageA[srcIdx];
+              }
+              
+              delayN += 1;
+            }
+          }
+
+        for(const network_t* n=net.procA[i]->internal_net; n!=nullptr; n=n->poly_link)
+          delayN += _pipe_locate_delays(root,*n,dstIdx,procStageA,delayA==nullptr ? nullptr : delayA + delayN);
+      }
+
+      return delayN;
+    }
+
+    void _pipe_destroy( network_pipe_t*& pipe )
+    {
+      if( pipe == nullptr )
+        return;
+
+      thread_ftasks::destroy(pipe->threadTasksH);
+
+      // reconnect the delayed readers to the writer's buffer
+      for(unsigned i=0; i<pipe->delayN; ++i)
+        pipe->delayA[i].var->value = pipe->delayA[i].var->src_var->value;
+
+      // restore the writer's original buffer
+      for(unsigned i=0; i<pipe->bufN; ++i)
+      {
+        pipe_buf_t* b = pipe->bufA + i;
+        if( b->ringA != nullptr )
+        {
+          b->abuf->buf = b->ringA[0];
+          for(unsigned j=1; j<b->ringN; ++j)
+            mem::release(b->ringA[j]);
+          mem::release(b->ringA);
+          mem::release(b->silentA);
+        }
+      }
+
+      mem::release(pipe->delayA);
+      mem::release(pipe->bufA);
+      mem::release(pipe->stageA);
+      mem::release(pipe->taskA);
+      mem::release(pipe);
+    }
+
+    rc_t _pipe_stage_task_func( void* arg )
+    {
+      rc_t          rc    = kOkRC;
+      pipe_stage_t* stage = (pipe_stage_t*)arg;
+      bool          prof_fl = stage->net->flow->prof_fl;
+      time::spec_t  t0;
+
+      if( prof_fl )
+        time::get(t0);
+
+      // the 'warn on alloc' flag is per-thread and must therefore be set on each worker
+      if( stage->net->flow->warn_on_rt_alloc_fl )
+        mem::set_warn_on_alloc();
+
+      stage->halt_fl = false;
+      
+      for(unsigned i=stage->begProcIdx; i<stage->endProcIdx && rc==kOkRC; ++i)
+        if((rc = _proc_exec_and_profile(stage->net->procA[i])) == kEofRC )
+        {
+          stage->halt_fl = true;
+          rc = kOkRC;
+        }
+
+      if( prof_fl )
+      {
+        time::accumulate_elapsed_current(stage->prof_dur,t0);
+        stage->prof_cnt += 1;
+      }
+
+      return rc;
+    }
+    
+    rc_t _pipe_create( flow_t* p, network_t& net )
+    {
+      rc_t            rc           = kOkRC;
+      network_pipe_t* pipe         = nullptr;
+      unsigned        reqStageN    = p->pipeline_stageL==nullptr ? p->pipeline_stage_cnt : p->pipeline_stageL->child_count() + 1;
+      unsigned        cpuAffinityN = p->cpu_affinityL==nullptr ? 0 : p->cpu_affinityL->child_count();
+      bool*           cutOkA       = mem::allocZ<bool>(net.procN+1);
+      unsigned*       cutA         = mem::allocZ<unsigned>(reqStageN+1);
+      unsigned*       procStageA   = mem::allocZ<unsigned>(net.procN);
+      unsigned        cutN         = 0;
+      unsigned        cpuAffinityA[ std::max(1u,reqStageN) ];
+
+      if( reqStageN < 2 || net.procN < 2 )
+        goto errLabel;
+      
+      // locate the legal stage boundaries
+      for(unsigned i=1; i<net.procN; ++i)
+        cutOkA[i] = true;
+
+      _pipe_mark_illegal_cuts(net,net,kInvalidIdx,cutOkA);
+
+      // locate the requested stage boundaries
+      cutA[cutN++] = 0;
+      for(unsigned k=1; k<reqStageN; ++k)
+      {
+        unsigned reqIdx = (k * net.procN + reqStageN/2) / reqStageN;
+        unsigned cutIdx;
+        
+        if( p->pipeline_stageL != nullptr )
+        {
+          const char* label = nullptr;
+          proc_t*     proc  = nullptr;
+          
+          if((rc = p->pipeline_stageL->child_ele(k-1)->value(label)) != kOkRC || (proc = proc_find(net,label,kBaseSfxId)) == nullptr )
+          {
+            rc = net_error(&net,kSyntaxErrorRC,"The pipeline stage proc at index %i could not be found.",k-1);
+            goto errLabel;
+          }
+          
+          reqIdx = _network_proc_index(net,proc);
+        }
+        
+        // move the boundary forward until it does not split an undelayable connection
+        for(cutIdx=std::max(reqIdx,cutA[cutN-1]+1); cutIdx<net.procN; ++cutIdx)
+          if( cutOkA[cutIdx] )
+            break;
+        
+        if( cutIdx >= net.procN )
+        {
+          cwLogWarning("Network '%s' pipeline stage %i was dropped because it has no legal starting position.",cwStringNullGuard(net.label),k);
+          continue;
+        }
+
+        if( cutIdx != reqIdx )
+          cwLogWarning("Network '%s' pipeline stage %i was moved from '%s' to '%s' to avoid splitting a non-audio or feedback connection.",
+                       cwStringNullGuard(net.label),k,net.procA[ std::min(reqIdx,net.procN-1) ]->label,net.procA[cutIdx]->label);
+        
+        cutA[cutN++] = cutIdx;
+      }
+
+      if( cutN < 2 )
+      {
+        cwLogWarning("Network '%s' cannot be pipelined. The network will be executed serially.",cwStringNullGuard(net.label));
+        goto errLabel;
+      }
+
+      // validate the length of the CPU affinity list
+      if( cpuAffinityN>0 && cpuAffinityN != reqStageN )
+      {
+        rc = net_error(&net,kInvalidArgRC,"Count of CPU affinities (%i) does not match pipeline stage count (%i).",cpuAffinityN,reqStageN);
+        goto errLabel;
+      }
+
+      for(unsigned i=0; i<reqStageN; ++i)
+        if( i >= cpuAffinityN )
+          cpuAffinityA[i] = kInvalidIdx;
+        else
+          if((rc = p->cpu_affinityL->child_ele(i)->value(cpuAffinityA[i])) != kOkRC )
+          {
+            rc = net_error(&net,rc,"Error parsing CPU affinities.");
+            goto errLabel;
+          }
+
+      pipe         = mem::allocZ<network_pipe_t>();
+      pipe->stageN = cutN;
+      pipe->stageA = mem::allocZ<pipe_stage_t>(pipe->stageN);
+      pipe->taskA  = mem::allocZ<thread_ftasks::task_t>(pipe->stageN);
+
+      cutA[cutN] = net.procN;
+      for(unsigned k=0; k<pipe->stageN; ++k)
+      {
+        pipe->stageA[k].net        = &net;
+        pipe->stageA[k].begProcIdx = cutA[k];
+        pipe->stageA[k].endProcIdx = cutA[k+1];
+        pipe->taskA[k].func        = _pipe_stage_task_func;
+        pipe->taskA[k].arg         = pipe->stageA + k;
+        
+        for(unsigned i=cutA[k]; i<cutA[k+1]; ++i)
+          procStageA[i] = k;
+      }
+
+      // locate the variables which read a buffer written by an earlier stage
+      pipe->delayN = _pipe_locate_delays(net,net,kInvalidIdx,procStageA,nullptr);
+      pipe->delayA = mem::allocZ<pipe_delay_t>(pipe->delayN);
+      pipe->bufA   = mem::allocZ<pipe_buf_t>(pipe->delayN);
+      _pipe_locate_delays(net,net,kInvalidIdx,procStageA,pipe->delayA);
+
+      // assign each delayed reader to the buffer it reads
+      for(unsigned i=0; i<pipe->delayN; ++i)
+      {
+        pipe_delay_t* d    = pipe->delayA + i;
+        abuf_t*       abuf = d->var->src_var->value->u.abuf;
+
+        for(d->bufIdx=0; d->bufIdx<pipe->bufN; ++d->bufIdx)
+          if( pipe->bufA[d->bufIdx].abuf == abuf )
+            break;
+
+        if( d->bufIdx == pipe->bufN )
+        {
+          pipe->bufA[ pipe->bufN ].abuf  = abuf;
+          pipe->bufA[ pipe->bufN ].ringN = 1;
+          pipe->bufN += 1;
+        }
+
+        pipe->bufA[ d->bufIdx ].ringN = std::max(pipe->bufA[ d->bufIdx ].ringN, d->delayN+1 );
+      }
+
+      // allocate the buffer rings
+      for(unsigned i=0; i<pipe->bufN; ++i)
+      {
+        pipe_buf_t* b = pipe->bufA + i;
+        b->ringA      = mem::allocZ<sample_t*>(b->ringN);
+        b->silentA    = mem::allocZ<bool>(b->ringN);
+        b->ringA[0]   = b->abuf->buf;
+        for(unsigned j=1; j<b->ringN; ++j)
+          b->ringA[j] = mem::allocAlignedZ<sample_t>(b->abuf->bufAllocSmpN,kSignalAlignByteN);
+      }
+
+      // point each delayed reader to a private buffer record
+      for(unsigned i=0; i<pipe->delayN; ++i)
+      {
+        pipe_delay_t* d = pipe->delayA + i;
+        pipe_buf_t*   b = pipe->bufA + d->bufIdx;
+        
+        d->abuf          = *b->abuf;
+        d->abuf.buf      = b->ringA[ (b->ringN - d->delayN) % b->ringN ];
+        d->abuf.silentFl = false;
+        d->value        = *d->var->value;
+        d->value.u.abuf = &d->abuf;
+        d->value.link   = nullptr;
+        d->var->value   = &d->value;
+      }
+      
+      if((rc = thread_ftasks::create( pipe->threadTasksH, pipe->stageN, cpuAffinityA, "net_pipe" )) != kOkRC )
+      {
+        rc = net_error(&net,rc,"The pipeline thread machine create failed.");
+        goto errLabel;
+      }
+
+      cwLogInfo("Network '%s' pipeline: %i proc's in %i stages with %i delayed audio buffers. Latency: %i cycles.",
+                cwStringNullGuard(net.label),net.procN,pipe->stageN,pipe->bufN,pipe->stageN-1);
+      
+      net.pipe = pipe;
+      
+    errLabel:
+      if( rc != kOkRC )
+        _pipe_destroy(pipe);
+
+      mem::release(cutOkA);
+      mem::release(cutA);
+      mem::release(procStageA);
+      return rc;
+    }
+
+    // Advance the buffer rings to the next cycle.
+    void _pipe_advance( network_pipe_t* pipe )
+    {
+      for(unsigned i=0; i<pipe->bufN; ++i)
+      {
+        pipe_buf_t* b = pipe->bufA + i;
+
+        // the silence flag travels with the slot so that a delayed reader sees the flag of the cycle it reads
+        b->silentA[ b->headIdx ] = b->abuf->silentFl;
+        
+        b->headIdx    = (b->headIdx + 1) % b->ringN;
+        b->abuf->buf  = b->ringA[ b->headIdx ];
+      }
+
+      for(unsigned i=0; i<pipe->delayN; ++i)
+      {
+        pipe_delay_t* d       = pipe->delayA + i;
+        pipe_buf_t*   b       = pipe->bufA + d->bufIdx;
+        unsigned      slotIdx = (b->headIdx + b->ringN - d->delayN) % b->ringN;
+        d->abuf.buf           = b->ringA[ slotIdx ];
+        d->abuf.silentFl      = b->silentA[ slotIdx ];
+      }
+    }
+    
+    rc_t _network_exec_pipeline( network_t& net, bool& halt_fl_ref )
+    {
+      rc_t            rc   = kOkRC;
+      network_pipe_t* pipe = net.pipe;
+      
+      if((rc = thread_ftasks::run(pipe->threadTasksH, pipe->taskA, pipe->stageN )) != kOkRC )
+        return net_error(&net,rc,"Pipeline execution failed.");
+      
+      for(unsigned k=0; k<pipe->stageN; ++k)
+      {
+        if( pipe->stageA[k].halt_fl )
+          halt_fl_ref = true;
+        
+        if( pipe->taskA[k].rc != kOkRC && rc == kOkRC )
+          rc = pipe->taskA[k].rc;
+      }
+
+      _pipe_advance(pipe);
+      
+      return rc;
+    }
     
+    //==================================================================================================================
+    //
+    // Network - Fused Kernels
+    //
+    // Proc's whose class is listed in fuseClassA[] compute each channel of their audio outputs
+    // as a weighted sum of the channels of their audio inputs (e.g. audio_gain, audio_mix, audio_split).
+    // When the output of such a proc is read only by another linear proc the writer is fused
+    // into the reader: the reader's kernel computes its output directly from the writer's inputs
+    // and the writer's exec() is skipped. A chain, or tree, of linear proc's therefore makes
+    // a single pass over the audio data on each cycle.
+    // The fused proc's continue to receive their notifications so that their gain state remains current.
+    // The expanded terms are only rebuilt after a variable of one of the kernel's proc's changes (See proc_t.fuse_dirty_fl).
+    // A proc is not fused if:
+    // 1. It is logged or its output is exposed to the UI.
+    // 2. It or its reader is not executed on every cycle.
+    // 3. Its reader executes before it or one of its inputs is written after it (feedback).
+
+    typedef struct fuse_class_str
+    {
+      const char*          label;  // class label
+      member_linear_func_t linear; // linear form of the proc's of this class
+    } fuse_class_t;
+
+    fuse_class_t fuseClassA[] = {
+      { "audio_gain",  audio_gain::linear  },
+      { "audio_split", audio_split::linear },
+      { "audio_mix",   audio_mix::linear   },
+      { nullptr, nullptr }
+    };
+
+    // Returns the linear form function for the class of 'proc' or nullptr if the proc cannot be fused.
+    member_linear_func_t _fuse_linear_func( const proc_t* proc )
+    {
+      for(unsigned i=0; fuseClassA[i].label != nullptr; ++i)
+        if( textIsEqual(proc->class_desc->label,fuseClassA[i].label) )
+          return fuseClassA[i].linear;
+      return nullptr;
+    }
+
+    typedef struct fuse_src_str
+    {
+      proc_t*              proc;       // linear proc
+      member_linear_func_t linear;     // linear form function of 'proc'
+      linear_term_t*       termA;      // termA[ termAllocN ] current linear form of 'proc'
+      unsigned             termAllocN; //
+      unsigned             termN;      //
+    } fuse_src_t;
+
+    typedef struct fuse_term_str
+    {
+      const abuf_t* ibuf;      // leaf input buffer
+      unsigned      in_ch;     // channel of 'ibuf'
+      abuf_t*       obuf;      // output buffer of the sink proc
+      unsigned      out_ch;    // channel of 'obuf'
+      coeff_t       coeff;     // product of the coefficients along the path from 'ibuf' to 'obuf'
+      bool          assign_fl; // true if this is the first term which targets obuf[out_ch]
+    } fuse_term_t;
+
+    typedef struct fuse_kernel_str
+    {
+      fuse_src_t*  srcA;       // srcA[ srcN ] srcA[0] is the sink proc followed by the fused proc's in execution order
+      unsigned     srcN;       //
+      fuse_term_t* termA;      // termA[ termAllocN ] expanded terms
+      unsigned     termAllocN; //
+      unsigned     termN;      // count of expanded terms (may be greater than termAllocN while sizing)
+
+      struct fuse_kernel_str* link;
+    } fuse_kernel_t;
+
+    void _fuse_kernel_destroy( fuse_kernel_t*& k )
+    {
+      for(unsigned i=0; i<k->srcN; ++i)
+      {
+        k->srcA[i].proc->fuse_kernel = nullptr;
+        k->srcA[i].proc->fuse_sink   = nullptr;
+        mem::release(k->srcA[i].termA);
+      }
+      
+      mem::release(k->srcA);
+      mem::release(k->termA);
+      mem::release(k);
+    }
+
+    void _fuse_destroy( network_t& net )
+    {
+      while( net.fuse_kernelL != nullptr )
+      {
+        fuse_kernel_t* k0 = net.fuse_kernelL->link;
+        _fuse_kernel_destroy(net.fuse_kernelL);
+        net.fuse_kernelL = k0;
+      }
+    }
+
+    // Get the linear form of 'proc' into termA_ref[] growing the array as necessary.
+    rc_t _fuse_get_terms( proc_t* proc, member_linear_func_t linear, linear_term_t*& termA_ref, unsigned& termAllocN_ref, unsigned& termN_ref )
+    {
+      rc_t rc;
+      
+      if((rc = linear(proc, termA_ref, termAllocN_ref, termN_ref )) == kBufTooSmallRC )
+      {
+        termA_ref      = mem::resize<linear_term_t>(termA_ref,termN_ref);
+        termAllocN_ref = termN_ref;
+        rc = linear(proc, termA_ref, termAllocN_ref, termN_ref );
+      }
+
+      if( rc != kOkRC )
+        rc = proc_error(proc,rc,"The linear form of the proc could not be formed.");
+
+      return rc;
+    }
+
+    // Returns true if the audio output 'var' may be computed by a fused kernel.
+    bool _fuse_is_private_output( const flow_t* p, const variable_t* var )
+    {
+      if( var->ui_var != nullptr || cwIsFlag(var->varDesc->flags,kUdpOutVarDescFl) )
+        return false;
+      
+      return !(p->ui_create_fl && cwIsFlag(var->varDesc->flags,kUiCreateVarDescFl));
+    }
+
+    // If procA[procIdx] can be fused into the proc which reads its output return that proc, otherwise return nullptr.
+    proc_t* _fuse_reader( network_t& net, unsigned procIdx, linear_term_t*& termA, unsigned& termAllocN )
+    {
+      proc_t*              proc    = net.procA[procIdx];
+      const variable_t*    dst     = nullptr;
+      unsigned             dstN    = 0;
+      unsigned             termN   = 0;
+      unsigned             readIdx = kInvalidIdx;
+      member_linear_func_t linear  = _fuse_linear_func(proc);
+
+      if( linear == nullptr || proc->logVarL != nullptr || proc->exec_rate != kEveryCycleExecRate )
+        return nullptr;
+
+      if( _fuse_get_terms(proc,linear,termA,termAllocN,termN) != kOkRC )
+        return nullptr;
+
+      for(unsigned i=0; i<termN; ++i)
+      {
+        const variable_t* in_src = termA[i].in_var->src_var;
+        
+        // an input which is written by a proc that executes after this proc is a feedback connection
+        if( in_src != nullptr && in_src->proc->net == &net && _network_proc_index(net,in_src->proc) >= procIdx )
+          return nullptr;
+
+        if( !_fuse_is_private_output(net.flow,termA[i].out_var) )
+          return nullptr;
+
+        // count the readers of each output variable
+        bool dupl_fl = false;
+        for(unsigned j=0; j<i && !dupl_fl; ++j)
+          dupl_fl = termA[j].out_var == termA[i].out_var;
+
+        if( !dupl_fl )
+          for(const variable_t* d=termA[i].out_var->dst_head; d!=nullptr; d=d->dst_link)
+          {
+            dst   = d;
+            dstN += 1;
+          }
+      }
+
+      // the output must have exactly one reader ...
+      if( dstN != 1 )
+        return nullptr;
+
+      // ... which is a linear proc in this network that executes after this proc on every cycle
+      if( _fuse_linear_func(dst->proc) == nullptr || dst->proc->exec_rate != kEveryCycleExecRate )
+        return nullptr;
+      
+      if((readIdx = _network_proc_index(net,dst->proc)) == kInvalidIdx || readIdx <= procIdx )
+        return nullptr;
+
+      return dst->proc;
+    }
+
+    // Returns the index into k->srcA[] of the fused proc which writes 'in_var' or kInvalidIdx if 'in_var' is a leaf input.
+    unsigned _fuse_src_index( const fuse_kernel_t* k, const variable_t* in_var )
+    {
+      if( in_var->src_var != nullptr )
+        for(unsigned i=1; i<k->srcN; ++i)
+          if( in_var->src_var->proc == k->srcA[i].proc )
+            return i;
+      
+      return kInvalidIdx;
+    }
+
+    // Expand 'in_var[in_ch]' through the fused proc's into terms of leaf inputs.
+    void _fuse_expand( fuse_kernel_t* k, const variable_t* in_var, unsigned in_ch, abuf_t* obuf, unsigned out_ch, coeff_t coeff )
+    {
+      unsigned srcIdx;
+      
+      if((srcIdx = _fuse_src_index(k,in_var)) == kInvalidIdx )
+      {
+        if( k->termN < k->termAllocN )
+        {
+          fuse_term_t* t = k->termA + k->termN;
+          t->ibuf   = in_var->value->u.abuf;
+          t->in_ch  = in_ch;
+          t->obuf   = obuf;
+          t->out_ch = out_ch;
+          t->coeff  = coeff;
+        }
+        
+        k->termN += 1;
+        return;
+      }
+
+      const fuse_src_t* s = k->srcA + srcIdx;
+      for(unsigned i=0; i<s->termN; ++i)
+        if( s->termA[i].out_var == in_var->src_var && s->termA[i].out_ch == in_ch )
+          _fuse_expand(k, s->termA[i].in_var, s->termA[i].in_ch, obuf, out_ch, coeff * s->termA[i].coeff );
+    }
+
+    // Update the expanded terms with the current coefficients of the fused proc's.
+    rc_t _fuse_update( fuse_kernel_t* k )
+    {
+      rc_t rc = kOkRC;
+      
+      for(unsigned i=0; i<k->srcN; ++i)
+        if((rc = _fuse_get_terms(k->srcA[i].proc, k->srcA[i].linear, k->srcA[i].termA, k->srcA[i].termAllocN, k->srcA[i].termN )) != kOkRC )
+          return rc;
+
+      k->termN = 0;
+      
+      for(unsigned i=0; i<k->srcA[0].termN; ++i)
+      {
+        const linear_term_t* t = k->srcA[0].termA + i;
+        _fuse_expand(k, t->in_var, t->in_ch, t->out_var->value->u.abuf, t->out_ch, t->coeff );
+      }
+
+      return rc;
+    }
+
+    rc_t _fuse_kernel_create( network_t& net, proc_t* sink )
+    {
+      rc_t           rc = kOkRC;
+      fuse_kernel_t* k  = mem::allocZ<fuse_kernel_t>();
+
+      for(unsigned i=0; i<net.procN; ++i)
+        if( net.procA[i] == sink || net.procA[i]->fuse_sink == sink )
+          k->srcN += 1;
+
+      k->srcA = mem::allocZ<fuse_src_t>(k->srcN);
+      k->srcA[0].proc = sink;
+      
+      for(unsigned i=0,j=1; i<net.procN; ++i)
+        if( net.procA[i]->fuse_sink == sink )
+          k->srcA[j++].proc = net.procA[i];
+
+      for(unsigned i=0; i<k->srcN; ++i)
+        k->srcA[i].linear = _fuse_linear_func(k->srcA[i].proc);
+
+      // size the expanded term array
+      if((rc = _fuse_update(k)) != kOkRC )
+        goto errLabel;
+
+      k->termA      = mem::allocZ<fuse_term_t>(k->termN);
+      k->termAllocN = k->termN;
+
+      if((rc = _fuse_update(k)) != kOkRC )
+        goto errLabel;
+
+      // the first term which targets each output channel assigns the output and the following terms accumulate
+      for(unsigned i=0; i<k->termN; ++i)
+      {
+        fuse_term_t* t = k->termA + i;
+        t->assign_fl = true;
+        for(unsigned j=0; j<i && t->assign_fl; ++j)
+          t->assign_fl = !(k->termA[j].obuf == t->obuf && k->termA[j].out_ch == t->out_ch);
+
+        if( t->ibuf == nullptr || t->ibuf->frameN != t->obuf->frameN || t->in_ch >= t->ibuf->chN || t->out_ch >= t->obuf->chN )
+        {
+          rc = proc_error(sink,kInvalidStateRC,"The fused kernel audio buffers are not compatible.");
+          goto errLabel;
+        }
+      }
+
+      // every channel of every output must be written
+      for(unsigned i=0; i<k->srcA[0].termN; ++i)
+      {
+        const abuf_t* obuf = k->srcA[0].termA[i].out_var->value->u.abuf;
+        for(unsigned ch=0; ch<obuf->chN; ++ch)
+        {
+          bool fl = false;
+          for(unsigned j=0; j<k->termN && !fl; ++j)
+            fl = k->termA[j].obuf == obuf && k->termA[j].out_ch == ch;
+          
+          if( !fl )
+          {
+            rc = proc_error(sink,kInvalidStateRC,"The fused kernel does not write channel %i of '%s:%i'.",ch,cwStringNullGuard(k->srcA[0].termA[i].out_var->label),k->srcA[0].termA[i].out_var->label_sfx_id);
+            goto errLabel;
+          }
+        }
+      }
+
+      sink->fuse_kernel = k;
+      sink->fuse_dirty_fl.store(false,std::memory_order_release);
+      k->link           = net.fuse_kernelL;
+      net.fuse_kernelL  = k;
+      
+    errLabel:
+      if( rc != kOkRC )
+        _fuse_kernel_destroy(k);
+      
+      return rc;
+    }
+
+    rc_t _fuse_create( network_t& net )
+    {
+      rc_t           rc         = kOkRC;
+      proc_t**       readerA    = mem::allocZ<proc_t*>(net.procN);
+      linear_term_t* termA      = nullptr;
+      unsigned       termAllocN = 0;
+      unsigned       fuseN      = 0;
+      unsigned       kernelN    = 0;
+
+      for(unsigned i=0; i<net.procN; ++i)
+        readerA[i] = _fuse_reader(net,i,termA,termAllocN);
+
+      // the sink of each fused proc is at the end of its chain of readers
+      for(unsigned i=0; i<net.procN; ++i)
+        if( readerA[i] != nullptr )
+        {
+          proc_t* sink = readerA[i];
+          unsigned j;
+          while((j = _network_proc_index(net,sink)) != kInvalidIdx && readerA[j] != nullptr )
+            sink = readerA[j];
+
+          net.procA[i]->fuse_sink = sink;
+        }
+
+      // create a kernel for each sink
+      for(unsigned i=0; i<net.procN; ++i)
+        if( net.procA[i]->fuse_sink == nullptr )
+        {
+          bool sink_fl = false;
+          for(unsigned j=0; j<i && !sink_fl; ++j)
+            sink_fl = net.procA[j]->fuse_sink == net.procA[i];
+
+          if( sink_fl )
+          {
+            // a kernel that cannot be formed leaves its proc's to execute normally
+            if( _fuse_kernel_create(net,net.procA[i]) == kOkRC )
+              kernelN += 1;
+          }
+        }
+
+      for(unsigned i=0; i<net.procN; ++i)
+        if( net.procA[i]->fuse_sink != nullptr )
+          fuseN += 1;
+      
+      if( kernelN > 0 )
+        cwLogInfo("Network '%s': %i proc's fused into %i kernels.",cwStringNullGuard(net.label),fuseN,kernelN);
+      
+      mem::release(termA);
+      mem::release(readerA);
+      return rc;
+    }
+
     rc_t _network_destroy_one( network_t*& net )
     {
       rc_t rc = kOkRC;
@@ -170,11 +1460,22 @@ namespace cw
       if( net == nullptr )
         return rc;
       
+      _network_sched_destroy(net->sched);
+
+      // restore the pipelined audio buffers before the proc's release them
+      _pipe_destroy(net->pipe);
+
+      // release the buffer pool before the proc's release the pooled buffers
+      _abuf_pool_destroy(net->abuf_pool);
+
+      _fuse_destroy(*net);
+      
       for(unsigned i=0; i<net->procN; ++i)
         proc_destroy(net->procA[i]);
 
       mem::release(net->procA);
       net->procN = 0;
+      hash_index_destroy(net->procIdx);
 
       _network_preset_array_destroy(*net);
 
@@ -2250,7 +3551,8 @@ namespace cw
                                                      "preset",   kOptFl, pstate.preset_labels,
                                                      "presets",  kOptFl, pstate.presets_dict,
                                                      "network",  kOptFl, network,
-                                                     "log",      kOptFl, pstate.log_labels )) != kOkRC )
+                                                     "log",      kOptFl, pstate.log_labels,
+                                                     "rate",     kOptFl, pstate.rate_cfg )) != kOkRC )
       {
         rc = net_error(&net,kSyntaxErrorRC,"The proc instance cfg. '%s:%i' parse failed.",pstate.proc_label,pstate.proc_label_sfx_id);
         goto errLabel;        
@@ -2573,6 +3875,114 @@ namespace cw
     }
     */
     
+    // Proc's which read or write buffer variables must execute on every cycle
+    // because the contents of these buffers are only valid for a single cycle.
+    // If a decimated or on-change rate was given for such a proc then revert to every cycle execution.
+    void _proc_validate_exec_rate( proc_t* proc )
+    {
+      if( proc->exec_rate == kEveryCycleExecRate )
+        return;
+
+      for(variable_t* var=proc->varL; var!=nullptr; var=var->var_link)
+        if( var->value != nullptr && (var->value->tflag & (kABufTFl | kFBufTFl | kMBufTFl | kRBufTFl)) )
+        {
+          cwLogWarning("The proc '%s:%i' will execute on every cycle because the buffer variable '%s:%i' cannot be sampled at a decimated rate.",
+                       cwStringNullGuard(proc->label),proc->label_sfx_id,cwStringNullGuard(var->label),var->label_sfx_id);
+          
+          proc->exec_rate = kEveryCycleExecRate;
+          break;
+        }
+    }
+    
+    // Return an array of all the variables (all suffix id's and channels) on 'proc' with the label 'label'.
+    variable_t** _proc_bypass_var_array( proc_t* proc, const char* label, unsigned tflag, unsigned& varN_ref )
+    {
+      variable_t** varA = nullptr;
+      
+      varN_ref = 0;
+      
+      if( label == nullptr )
+        return nullptr;
+      
+      for(variable_t* var=proc->varL; var!=nullptr; var=var->var_link)
+        if( textIsEqual(var->label,label) && var->value != nullptr && (var->value->tflag & tflag) )
+          varN_ref += 1;
+
+      if( varN_ref > 0 )
+      {
+        unsigned i = 0;
+        varA = mem::allocZ<variable_t*>(varN_ref);
+        for(variable_t* var=proc->varL; var!=nullptr; var=var->var_link)
+          if( textIsEqual(var->label,label) && var->value != nullptr && (var->value->tflag & tflag) )
+            varA[i++] = var;
+      }
+      
+      return varA;
+    }
+
+    rc_t _proc_create_bypass( proc_t* proc )
+    {
+      rc_t                 rc   = kOkRC;
+      const bypass_desc_t* desc = &proc->class_desc->bypass;
+      proc_bypass_t*       b    = nullptr;
+      unsigned             i    = 0;
+
+      // collect the audio outputs whose silence flag must be cleared prior to exec()
+      for(variable_t* var=proc->varL; var!=nullptr; var=var->var_link)
+        if( var->value != nullptr && value_is_abuf(var->value) && var->src_var==nullptr )
+          proc->audioOutVarN += 1;
+
+      proc->audioOutVarA = mem::allocZ<variable_t*>(proc->audioOutVarN);
+      
+      for(variable_t* var=proc->varL; var!=nullptr; var=var->var_link)
+        if( var->value != nullptr && value_is_abuf(var->value) && var->src_var==nullptr )
+          proc->audioOutVarA[i++] = var;
+
+      if( !proc->ctx->bypass_fl || desc->out_label == nullptr )
+        goto errLabel;
+      
+      b           = mem::allocZ<proc_bypass_t>();
+      b->desc     = desc;
+      b->inVarA   = _proc_bypass_var_array(proc,desc->in_label,  kABufTFl,      b->inVarN);
+      b->ctlVarA  = _proc_bypass_var_array(proc,desc->ctl_label, kBoolTFl,      b->ctlVarN);
+      b->gainVarA = _proc_bypass_var_array(proc,desc->gain_label,kNumericTFl,   b->gainVarN);
+
+      for(unsigned j=0; j<proc->audioOutVarN; ++j)
+        if( textIsEqual(proc->audioOutVarA[j]->label,desc->out_label) )
+        {
+          b->outVar = proc->audioOutVarA[j];
+          break;
+        }
+      
+      if( b->outVar == nullptr )
+      {
+        rc = proc_error(proc,kInvalidArgRC,"The bypass output '%s' is not an audio output.",cwStringNullGuard(desc->out_label));
+        goto errLabel;
+      }
+
+      // the bypass input must be connected and a copy requires a single input
+      if( b->inVarN == 0 || (desc->ctl_label != nullptr && desc->modeId==kCopyBypassModeId && b->inVarN != 1) )
+      {
+        rc = proc_error(proc,kInvalidArgRC,"The bypass input '%s' must be a connected audio input. (%i inputs found)",cwStringNullGuard(desc->in_label),b->inVarN);
+        goto errLabel;
+      }
+
+      if( (desc->ctl_label != nullptr && b->ctlVarN==0) || (desc->gain_label != nullptr && b->gainVarN==0) )
+      {
+        rc = proc_error(proc,kInvalidArgRC,"The bypass control variables '%s' or '%s' were not found.",cwStringNullGuard(desc->ctl_label),cwStringNullGuard(desc->gain_label));
+        goto errLabel;
+      }
+
+      proc->bypass = b;
+      b = nullptr;
+      
+    errLabel:
+      if( b != nullptr )
+        proc_bypass_destroy(b);
+      
+      return rc;
+    }
+    
     void _pstate_destroy( proc_inst_parse_state_t pstate )
     {
       _io_stmt_array_destroy(pstate.iStmtA,pstate.iStmtN);
@@ -2638,9 +4048,18 @@ namespace cw
       proc->class_desc    = class_desc;
       proc->net           = &net;
       proc->logLevel      = log::kInvalid_LogLevel;
+      proc->exec_rate     = class_desc->execRate;
 
       TRACE_REG(proc->label,proc->label_sfx_id,proc->trace_id);
 
+      // the proc inst 'rate' field overrides the class execution rate
+      if( pstate.rate_cfg != nullptr )
+        if((rc = exec_rate_parse( pstate.rate_cfg, proc->exec_rate )) != kOkRC )
+        {
+          rc = proc_error(proc,rc,"The 'rate' field could not be parsed on proc instance: '%s:%i'.",cwStringNullGuard(proc->label),pstate.proc_label_sfx_id);
+          goto errLabel;
+        }
+
       // create the proc instance preset list
       if((rc = _create_preset_list(proc->presetL, pstate.presets_dict )) != kOkRC )
       {
@@ -2771,6 +4190,13 @@ namespace cw
         goto errLabel;
       }
 
+      // verify that decimated execution is safe for this proc
+      _proc_validate_exec_rate(proc);
+
+      // create the declarative bypass
+      if((rc = _proc_create_bypass(proc)) != kOkRC )
+        goto errLabel;
+
       proc_ref = proc;
       
     errLabel:
@@ -3272,14 +4698,7 @@ namespace cw
       rc_t            rc           = kOkRC;
       preset_value_t* preset_value = nullptr;
 
-      network_preset_t* poly_net_preset = nullptr;
-      
-      for(unsigned i=0; i<poly_net->presetN; ++i)
-        if( textIsEqual(poly_net->presetA[i].label,preset_label) )
-        {
-          poly_net_preset = poly_net->presetA + i;
-          break;
-        }
+      const network_preset_t* poly_net_preset = network_preset_from_label(*poly_net,preset_label);
 
       if( poly_net_preset == nullptr )
       {
@@ -3587,6 +5006,8 @@ namespace cw
 
         
         net.presetN += 1;
+
+        hash_index_insert(net.presetIdx, sym_intern(p->symTbl,network_preset.label), 0, 0, &network_preset );
       }
       
     errLabel:
@@ -3733,61 +5154,65 @@ namespace cw
     }
 
     rc_t _network_apply_preset( network_t& net, const network_preset_t* network_preset, unsigned proc_label_sfx_id );
-    
-    rc_t _network_apply_vlist_preset( network_t& net,  const preset_value_list_t* vlist, unsigned proc_label_sfx_id )
-    {
-      rc_t                  rc  = kOkRC;
-      const preset_value_t* psv = nullptr;
 
-      for(psv=vlist->value_head; psv!=nullptr; psv=psv->link)
-      {
-        bool apply_to_all_poly_channels_fl = proc_label_sfx_id==kInvalidId;
-        bool apply_to_this_poly_channel_fl = psv->tid==kDirectPresetValueTId && psv->u.pvv.proc->label_sfx_id == proc_label_sfx_id;
-        bool psv_is_a_poly_preset_fl        = psv->tid!=kDirectPresetValueTId;
+    rc_t _network_apply_vlist_value( network_t& net, const preset_value_t* psv, unsigned proc_label_sfx_id )
+    {
+      rc_t rc                            = kOkRC;
+      bool apply_to_all_poly_channels_fl = proc_label_sfx_id==kInvalidId;
+      bool apply_to_this_poly_channel_fl = psv->tid==kDirectPresetValueTId && psv->u.pvv.proc->label_sfx_id == proc_label_sfx_id;
+      bool psv_is_a_poly_preset_fl       = psv->tid!=kDirectPresetValueTId;
         
-        // only apply the value if the proc_label_sfx_id is invalid or it matches the proc to which the value will be applied
-        if( apply_to_all_poly_channels_fl || apply_to_this_poly_channel_fl  || psv_is_a_poly_preset_fl  )
+      // only apply the value if the proc_label_sfx_id is invalid or it matches the proc to which the value will be applied
+      if( apply_to_all_poly_channels_fl || apply_to_this_poly_channel_fl  || psv_is_a_poly_preset_fl  )
+      {
+        // if this preset refers to another network preset
+        switch( psv->tid )
         {
-          // if this preset refers to another network preset
-          switch( psv->tid )
-          {
-            case kNetRefPresetValueTId:
-              if((rc = _network_apply_preset(*psv->u.npv.net_preset_net,psv->u.npv.net_preset,proc_label_sfx_id)) != kOkRC )
-              {
-                rc = net_error(&net,rc,"Application of network preset '%s' failed.",cwStringNullGuard(psv->u.npv.net_preset->label));
-                goto errLabel;
-              }
-              break;
+          case kNetRefPresetValueTId:
+            if((rc = _network_apply_preset(*psv->u.npv.net_preset_net,psv->u.npv.net_preset,proc_label_sfx_id)) != kOkRC )
+            {
+              rc = net_error(&net,rc,"Application of network preset '%s' failed.",cwStringNullGuard(psv->u.npv.net_preset->label));
+              goto errLabel;
+            }
+            break;
               
-            case kDirectPresetValueTId:
-              if((rc = var_set( psv->u.pvv.var, &psv->u.pvv.value )) != kOkRC )
-              {
-                rc = net_error(&net,rc,"Preset value apply failed on '%s:%i'-'%s:%i'.",
-                                cwStringNullGuard(psv->u.pvv.proc->label),psv->u.pvv.proc->label_sfx_id,
-                                cwStringNullGuard(psv->u.pvv.var->label),psv->u.pvv.var->label_sfx_id);
-                goto errLabel;
-              }
-              break;
+          case kDirectPresetValueTId:
+            if((rc = var_set( psv->u.pvv.var, &psv->u.pvv.value )) != kOkRC )
+            {
+              rc = net_error(&net,rc,"Preset value apply failed on '%s:%i'-'%s:%i'.",
+                             cwStringNullGuard(psv->u.pvv.proc->label),psv->u.pvv.proc->label_sfx_id,
+                             cwStringNullGuard(psv->u.pvv.var->label),psv->u.pvv.var->label_sfx_id);
+              goto errLabel;
+            }
+            break;
               
-            default:
-              rc = net_error(&net,kInvalidIdRC,"The preset value type id %i is unknown.",psv->tid);
-          }
+          default:
+            rc = net_error(&net,kInvalidIdRC,"The preset value type id %i is unknown.",psv->tid);
         }
       }
       
-    errLabel:      
+    errLabel:
       return rc;
     }
     
-    rc_t _network_apply_dual_preset( network_t& net, const network_preset_t* net_ps0, const network_preset_t* net_ps1, double coeff,  unsigned proc_label_sfx_id )
+    rc_t _network_apply_vlist_preset( network_t& net,  const preset_value_list_t* vlist, unsigned proc_label_sfx_id )
     {
       rc_t rc = kOkRC;
+
+      for(const preset_value_t* psv=vlist->value_head; psv!=nullptr; psv=psv->link)
+        if((rc = _network_apply_vlist_value(net,psv,proc_label_sfx_id)) != kOkRC )
+          break;
       
+      return rc;
+    }
+
+    // Set the value pointer in each of the preset-pair records referenced by the secondary preset of a dual preset.
+    void _network_dual_preset_setup_pairs( network_t& net, const network_preset_t* net_ps1, unsigned proc_label_sfx_id )
+    {
       // clear the value field of the preset-pair array
       for(unsigned i=0; i<net.preset_pairN; ++i)
         net.preset_pairA[i].value = nullptr;
 
-      // set the value pointer in each of the preset-pair records referenced by preset-1
       for(const preset_value_t* pv1=net_ps1->u.vlist.value_head; pv1!=nullptr; pv1=pv1->link)
       {
         if( pv1->tid!=kDirectPresetValueTId )
@@ -3808,36 +5233,51 @@ namespace cw
           }    
         }
       }
+    }
+
+    // Apply one value of the primary preset of a dual preset. _network_dual_preset_setup_pairs() must have been called first.
+    rc_t _network_apply_dual_value( network_t& net, const preset_value_t* pv0, double coeff, unsigned proc_label_sfx_id )
+    {
+      rc_t rc = kOkRC;
       
-      // 
-      for(const preset_value_t* pv0=net_ps0->u.vlist.value_head; pv0!=nullptr; pv0=pv0->link)
+      if( proc_label_sfx_id == kInvalidId || (pv0->tid!=kDirectPresetValueTId) || (pv0->tid==kDirectPresetValueTId && pv0->u.pvv.proc->label_sfx_id == proc_label_sfx_id) )
       {
-        if( proc_label_sfx_id == kInvalidId || (pv0->tid!=kDirectPresetValueTId) || (pv0->tid==kDirectPresetValueTId && pv0->u.pvv.proc->label_sfx_id == proc_label_sfx_id) )
+        if( pv0->tid!=kDirectPresetValueTId )
         {
-          if( pv0->tid!=kDirectPresetValueTId )
-          {
-          }
+        }
           
-          if( pv0->u.pvv.var->chIdx != kAnyChIdx )
-          {
-            rc = _preset_set_var_from_dual( pv0, net.preset_pairA[ pv0->u.pvv.pairTblIdx ].value, coeff );
-          }
-          else
+        if( pv0->u.pvv.var->chIdx != kAnyChIdx )
+        {
+          rc = _preset_set_var_from_dual( pv0, net.preset_pairA[ pv0->u.pvv.pairTblIdx ].value, coeff );
+        }
+        else
+        {
+          for(unsigned i=0; i<net.preset_pairA[ pv0->u.pvv.pairTblIdx ].chN; ++i)
           {
-            for(unsigned i=0; i<net.preset_pairA[ pv0->u.pvv.pairTblIdx ].chN; ++i)
-            {
-              if((rc = _preset_set_var_from_dual( pv0, net.preset_pairA[ pv0->u.pvv.pairTblIdx+i ].value, coeff )) != kOkRC )
-                goto errLabel;
+            if((rc = _preset_set_var_from_dual( pv0, net.preset_pairA[ pv0->u.pvv.pairTblIdx+i ].value, coeff )) != kOkRC )
+              goto errLabel;
 
-              assert( textIsEqual(net.preset_pairA[ pv0->u.pvv.pairTblIdx+i ].var->label,pv0->u.pvv.var->label) && net.preset_pairA[ pv0->u.pvv.pairTblIdx+i ].var->label_sfx_id == pv0->u.pvv.var->label_sfx_id );        
-            }
-          }    
-        }
+            assert( textIsEqual(net.preset_pairA[ pv0->u.pvv.pairTblIdx+i ].var->label,pv0->u.pvv.var->label) && net.preset_pairA[ pv0->u.pvv.pairTblIdx+i ].var->label_sfx_id == pv0->u.pvv.var->label_sfx_id );        
+          }
+        }    
       }
 
     errLabel:
       return rc;
     }
+    
+    rc_t _network_apply_dual_preset( network_t& net, const network_preset_t* net_ps0, const network_preset_t* net_ps1, double coeff,  unsigned proc_label_sfx_id )
+    {
+      rc_t rc = kOkRC;
+
+      _network_dual_preset_setup_pairs(net,net_ps1,proc_label_sfx_id);
+      
+      for(const preset_value_t* pv0=net_ps0->u.vlist.value_head; pv0!=nullptr; pv0=pv0->link)
+        if((rc = _network_apply_dual_value(net,pv0,coeff,proc_label_sfx_id)) != kOkRC )
+          break;
+
+      return rc;
+    }
 
     rc_t _network_apply_preset( network_t& net, const network_preset_t* network_preset, unsigned proc_label_sfx_id )
     {
@@ -3864,6 +5304,161 @@ namespace cw
       return rc;
     }
     
+    //==================================================================================================================
+    //
+    // Presets - Incremental Application
+    //
+
+    // Values are applied in groups. A group is a run of consecutive values which target the
+    // same proc, or a single reference to a poly network preset. A group is never split across
+    // cycles, so a proc never executes with only part of its preset applied.
+    const preset_value_t* _preset_apply_group_end( const preset_value_t* psv, unsigned& cnt_ref )
+    {
+      const proc_t* proc = psv->tid==kDirectPresetValueTId ? psv->u.pvv.proc : nullptr;
+
+      for(cnt_ref=1,psv=psv->link; proc!=nullptr && psv!=nullptr; psv=psv->link,++cnt_ref)
+        if( psv->tid!=kDirectPresetValueTId || psv->u.pvv.proc != proc )
+          break;
+
+      return psv;
+    }
+
+    rc_t _preset_apply_group( network_t& net, preset_apply_t& pa, const preset_value_t* end )
+    {
+      rc_t rc = kOkRC;
+      
+      for(; pa.next != end; pa.next=pa.next->link)
+      {
+        if( pa.dual_sec == nullptr )
+          rc = _network_apply_vlist_value(net,pa.next,pa.proc_label_sfx_id);
+        else
+          rc = _network_apply_dual_value(net,pa.next,pa.coeff,pa.proc_label_sfx_id);
+        
+        if( rc != kOkRC )
+          break;
+        
+        pa.applyN += 1;
+      }
+      return rc;
+    }
+
+    // Called at the start of each network cycle while an incremental preset application is in progress.
+    rc_t _preset_apply_step( network_t& net )
+    {
+      rc_t            rc      = kOkRC;
+      preset_apply_t& pa      = net.preset_apply;
+      unsigned        quotaN  = 0;
+      bool            flushFl = false;
+      time::spec_t    t0;
+
+      time::get(t0);
+      
+      pa.cycleN += 1;
+      
+      // on the last allowed cycle everything that remains is applied
+      flushFl = pa.max_cycle_cnt != 0 && pa.cycleN >= pa.max_cycle_cnt;
+
+      // without a time budget the values are spread evenly over the remaining cycles
+      if( pa.budget_ns == 0 && !flushFl )
+      {
+        unsigned cycleN = (pa.max_cycle_cnt - pa.cycleN) + 1;
+        quotaN = (pa.valueN - pa.applyN + cycleN - 1) / cycleN;
+      }
+      
+      for(unsigned applyN=0; pa.next != nullptr; )
+      {
+        unsigned              groupN = 0;
+        const preset_value_t* end    = _preset_apply_group_end(pa.next,groupN);
+
+        if((rc = _preset_apply_group(net,pa,end)) != kOkRC )
+        {
+          rc = net_error(&net,rc,"Incremental application of the preset '%s' failed.",cwStringNullGuard(pa.preset->label));
+          goto errLabel;
+        }
+
+        applyN += groupN;
+
+        if( flushFl )
+          continue;
+
+        if( pa.budget_ns != 0 && time::elapsedNanos(t0,time::current_time()) >= pa.budget_ns )
+          break;
+
+        if( pa.budget_ns == 0 && applyN >= quotaN )
+          break;
+      }
+
+    errLabel:
+      pa.rc = rc;
+      
+      if( pa.next == nullptr || rc != kOkRC )
+      {
+        if( rc == kOkRC )
+          cwLogInfo("Activated preset:%s (%i values over %i cycles)",cwStringNullGuard(pa.preset->label),pa.applyN,pa.cycleN);
+        
+        pa.preset = nullptr;
+        pa.next   = nullptr;
+      }
+
+      return rc;
+    }
+
+    // Apply the remaining values of an in-progress incremental preset application immediately.
+    rc_t _preset_apply_flush( network_t& net )
+    {
+      rc_t rc = kOkRC;
+      
+      if( net.preset_apply.preset != nullptr )
+      {
+        net.preset_apply.max_cycle_cnt = net.preset_apply.cycleN + 1;
+        rc = _preset_apply_step(net);
+      }
+      
+      return rc;
+    }
+
+    rc_t _preset_apply_begin( network_t& net, const network_preset_t* net_ps, const network_preset_t* dual_sec, double coeff, unsigned proc_label_sfx_id, unsigned max_cycle_cnt, double cycle_budget_us )
+    {
+      rc_t            rc = kOkRC;
+      preset_apply_t& pa = net.preset_apply;
+      
+      if((rc = _preset_apply_flush(net)) != kOkRC )
+        goto errLabel;
+
+      // a dual network preset is applied from its primary/secondary value lists
+      if( net_ps->tid == kPresetDualTId )
+      {
+        dual_sec = net_ps->u.dual.sec;
+        coeff    = net_ps->u.dual.coeff;
+        net_ps   = net_ps->u.dual.pri;
+      }
+
+      if( dual_sec != nullptr )
+        _network_dual_preset_setup_pairs(net,dual_sec,proc_label_sfx_id);
+
+      pa.preset            = net_ps;
+      pa.dual_sec          = dual_sec;
+      pa.coeff             = coeff;
+      pa.proc_label_sfx_id = proc_label_sfx_id;
+      pa.next              = net_ps->u.vlist.value_head;
+      pa.valueN            = 0;
+      pa.applyN            = 0;
+      pa.cycleN            = 0;
+      pa.max_cycle_cnt     = max_cycle_cnt;
+      pa.budget_ns         = cycle_budget_us <= 0 ? 0 : (unsigned long long)(cycle_budget_us * 1000.0);
+      pa.rc                = kOkRC;
+
+      for(const preset_value_t* psv=pa.next; psv!=nullptr; psv=psv->link)
+        pa.valueN += 1;
+
+      // the application is completed on the next cycle if it is not limited by a budget or cycle count
+      if( pa.budget_ns == 0 && pa.max_cycle_cnt == 0 )
+        pa.max_cycle_cnt = 1;
+
+    errLabel:
+      return rc;
+    }
+    
     //==================================================================================================================
     //
     // Presets - Probabilistic Selection
@@ -4119,6 +5714,8 @@ namespace cw
         }
 
         net->procN += 1;
+
+        hash_index_insert(net->procIdx, sym_intern(p->symTbl,net->procA[j]->label), net->procA[j]->label_sfx_id, 0, net->procA[j] );
       }
 
 
@@ -4129,6 +5726,33 @@ namespace cw
       if((rc = _network_preset_parse_dict(p, *net, net->presetsCfg )) != kOkRC )
         goto errLabel;
 
+      // Only the root network is pipelined.
+      if( (p->pipeline_stage_cnt > 1 || p->pipeline_stageL != nullptr) && p->net == net )
+      {
+        if((rc = _pipe_create(p,*net)) != kOkRC )
+          goto errLabel;
+
+        if( net->pipe != nullptr && (p->parallel_fl || p->abuf_pool_fl || p->fuse_fl) )
+          cwLogWarning("The 'parallel_fl', 'abuf_pool_fl' and 'fuse_fl' options are ignored on the pipelined network '%s'.",cwStringNullGuard(net->label));
+      }
+      
+      // Only the root network is scheduled for parallel execution.
+      // (poly networks are executed concurrently by the 'poly' proc.)
+      if( p->parallel_fl && p->net == net && net->pipe == nullptr )
+        if((rc = _network_sched_create(p,*net)) != kOkRC )
+          goto errLabel;
+
+      // fuse chains of linear proc's (this must precede buffer pooling because it extends buffer lifetimes)
+      if( p->fuse_fl && net->pipe == nullptr )
+        if((rc = _fuse_create(*net)) != kOkRC )
+          goto errLabel;
+
+      // pack the audio output buffers into a shared arena
+      // (the buffer lifetimes of a pipelined network overlap across stages)
+      if( p->abuf_pool_fl && net->pipe == nullptr )
+        if((rc = _abuf_pool_create(*net)) != kOkRC )
+          goto errLabel;
+
     errLabel:
 
       return rc;
@@ -4235,6 +5859,13 @@ namespace cw
         time::accumulate(acc,net.procA[i]->prof_dur);
     }
     
+    void _network_profile_hist_report( const latency_hist_t& h )
+    {
+      latency_stats_t st;
+      latency_hist_stats(h,st);
+      printf(" p50:%.1f p99:%.1f p99.9:%.1f max:%.1f us",st.p50_us,st.p99_us,st.p999_us,st.max_us);
+    }
+    
     void _network_profile_report(const network_t& net, unsigned level)
     {
       time::spec_t acc;
@@ -4242,18 +5873,64 @@ namespace cw
       _network_profile_proc_total(net,acc);
       acc_sec = time::seconds(acc);
 
-      printf("%s : net:%8.5fs accum:%8.5fs\n",net.label==nullptr ? "<none>" : net.label,time::seconds(net.prof_dur),acc_sec);
+      printf("%s : net:%8.5fs accum:%8.5fs",net.label==nullptr ? "<none>" : net.label,time::seconds(net.prof_dur),acc_sec);
+      _network_profile_hist_report(net.prof_hist);
+      printf("\n");
+
+      if( net.pipe != nullptr )
+        for(unsigned k=0; k<net.pipe->stageN; ++k)
+        {
+          const pipe_stage_t* s = net.pipe->stageA + k;
+          printf("stage:%i %8.5fs procs:%i-%i\n",k,time::seconds(s->prof_dur),s->begProcIdx,s->endProcIdx-1);
+        }
 
       for(unsigned i=0; i<net.procN; ++i)
       {
         double dur_sec = time::seconds(net.procA[i]->prof_dur);
         
-        printf("%2i %6.2f  %8.5fs %s::%i\n",level,dur_sec/acc_sec,dur_sec,net.procA[i]->label,net.procA[i]->label_sfx_id);
+        printf("%2i %6.2f  %8.5fs %s::%i",level,dur_sec/acc_sec,dur_sec,net.procA[i]->label,net.procA[i]->label_sfx_id);
+
+        if( net.procA[i]->exec_rate != kEveryCycleExecRate )
+          printf(" skip:%i",net.procA[i]->rate_skip_cnt);
+
+        if( net.procA[i]->bypass_cnt > 0 )
+          printf(" bypass:%i",net.procA[i]->bypass_cnt);
+
+        _network_profile_hist_report(net.procA[i]->prof_hist);
+
+        if( net.procA[i]->deadline_miss_cnt > 0 )
+          printf(" miss:%i",net.procA[i]->deadline_miss_cnt);
+        
+        printf("\n");
 
         for(const network_t* n = net.procA[i]->internal_net; n!=nullptr; n=n->poly_link)
           _network_profile_report(*n,level+1);        
       }
     }
+
+    void _network_prewarm( network_t& net )
+    {
+      for(unsigned i=0; i<net.procN; ++i)
+      {
+        for(variable_t* var=net.procA[i]->varL; var!=nullptr; var=var->var_link)
+          if( var->value != nullptr )
+            switch( var->value->tflag & kTypeMask )
+            {
+              case kABufTFl:
+                if( var->value->u.abuf != nullptr )
+                  abuf_zero(var->value->u.abuf);
+                break;
+                
+              case kFBufTFl:
+                if( var->value->u.fbuf != nullptr )
+                  fbuf_zero(var->value->u.fbuf);
+                break;
+            }
+
+        for(network_t* n = net.procA[i]->internal_net; n!=nullptr; n=n->poly_link)
+          _network_prewarm(*n);
+      }
+    }
     
   }
 }
@@ -4380,47 +6057,74 @@ cw::rc_t cw::flow::exec_cycle( network_t& net )
   rc_t rc = kOkRC;
   bool halt_fl = false;
   time::spec_t net_t0;
+  time::spec_t net_t1;
   
   if( net.flow->prof_fl )
     time::get(net_t0);
 
-  for(unsigned i=0; i<net.procN && rc==kOkRC; ++i)
+  // a failed preset application is reported via network_preset_apply_status() and does not halt the network
+  if( net.preset_apply.preset != nullptr )
+    _preset_apply_step(net);
+
+  if( net.pipe != nullptr )
+    rc = _network_exec_pipeline(net,halt_fl);
+  else
+    if( net.sched == nullptr )
+      rc = _network_exec_serial(net,halt_fl);
+    else
+      rc = _network_exec_parallel(net,halt_fl);
+
+  if( net.flow->prof_fl )
   {
-    time::spec_t t0;
-    proc_t* proc = net.procA[i];
-    
-    if( net.flow->prof_fl)
-      time::get(t0);
+    time::get(net_t1);
+    time::accumulate_elapsed(net.prof_dur,net_t0,net_t1);
+    net.prof_cnt     += 1;
+    net.prof_cycle_ns = time::elapsedNanos(net_t0,net_t1);
+    latency_hist_record(net.prof_hist,net.prof_cycle_ns);
+  }
 
-    TRACE_TIME( proc->trace_id, tracer::kBegEvtId, net.flow->cycleIndex,0 );
+  return halt_fl ? ((unsigned)kEofRC) : rc;
+}
 
-    // execute the proc instance
-    if((rc = proc_exec(proc)) != kOkRC )
-    {
-      // kEofRC indicates that that the network should shutdow at the end of this cycle.
-      if( rc == kEofRC )
-      {
-        halt_fl = true;
-        rc = kOkRC;
-      }      
-    }
-    
-    TRACE_TIME( proc->trace_id, tracer::kEndEvtId, net.flow->cycleIndex,0 );
+cw::rc_t cw::flow::fuse_kernel_exec( proc_t* proc )
+{
+  rc_t           rc = kOkRC;
+  fuse_kernel_t* k  = proc->fuse_kernel;
+  unsigned       termN;
+
+  // rebuild the expanded terms only when a coefficient may have changed
+  if( proc->fuse_dirty_fl.exchange(false,std::memory_order_acq_rel) )
+  {
+    if((rc = _fuse_update(k)) != kOkRC )
+      goto errLabel;
 
-    if( net.flow->prof_fl )
+    if( k->termN != k->termAllocN )
     {
-      time::accumulate_elapsed_current(proc->prof_dur,t0);
-      proc->prof_cnt += 1;
+      rc = proc_error(proc,kInvalidStateRC,"The fused kernel term count changed from %i to %i.",k->termAllocN,k->termN);
+      goto errLabel;
     }
   }
 
-  if( net.flow->prof_fl )
+  termN = k->termN;
+  
+  for(unsigned i=0; i<termN; ++i)
   {
-    time::accumulate_elapsed_current(net.prof_dur,net_t0);
-    net.prof_cnt += 1;
+    const fuse_term_t* t      = k->termA + i;
+    const sample_t*    isig   = t->ibuf->buf + t->in_ch  * t->ibuf->frameN;
+    sample_t*          osig   = t->obuf->buf + t->out_ch * t->obuf->frameN;
+    unsigned           frameN = t->obuf->frameN;
+    coeff_t            gain   = t->coeff;
+
+    if( t->assign_fl )
+      for(unsigned j=0; j<frameN; ++j)
+        osig[j] = gain * isig[j];
+    else
+      for(unsigned j=0; j<frameN; ++j)
+        osig[j] += gain * isig[j];
   }
 
-  return halt_fl ? ((unsigned)kEofRC) : rc;
+errLabel:
+  return rc;
 }
 
 cw::rc_t cw::flow::network_profile_report( const network_t& net )
@@ -4429,6 +6133,12 @@ cw::rc_t cw::flow::network_profile_report( const network_t& net )
    return kOkRC;
 }
 
+cw::rc_t cw::flow::network_prewarm( network_t& net )
+{
+  _network_prewarm(net);
+  return kOkRC;
+}
+
 
 cw::rc_t cw::flow::get_variable( network_t& net, const char* proc_label, const char* var_label, unsigned chIdx, proc_t*& procPtrRef, variable_t*& varPtrRef )
 {
@@ -4489,6 +6199,10 @@ cw::rc_t cw::flow::network_apply_preset( network_t& net, const char* preset_labe
     goto errLabel;
   }
 
+  // complete any in-progress incremental application so that presets take effect in the order they were applied
+  if((rc = _preset_apply_flush(net)) != kOkRC )
+    goto errLabel;
+  
   if((rc = _network_apply_preset(net,network_preset,proc_label_sfx_id)) != kOkRC )
     goto errLabel;
   
@@ -4521,6 +6235,9 @@ cw::rc_t cw::flow::network_apply_dual_preset( network_t& net, const char* preset
     goto errLabel;
   }
 
+  if((rc = _preset_apply_flush(net)) != kOkRC )
+    goto errLabel;
+
   if((rc = _network_apply_dual_preset(net, net_ps0, net_ps1, coeff,  proc_label_sfx_id )) != kOkRC )
     goto errLabel;
 
@@ -4531,6 +6248,63 @@ errLabel:
   return rc;
 }
 
+cw::rc_t cw::flow::network_begin_preset_apply( network_t& net, const char* preset_label, unsigned max_cycle_cnt, double cycle_budget_us, unsigned proc_label_sfx_id )
+{
+  rc_t                    rc             = kOkRC;
+  const network_preset_t* network_preset = nullptr;
+
+  if((network_preset = network_preset_from_label(net, preset_label )) == nullptr )
+  {
+    rc = cwLogError(kInvalidIdRC,"The network preset '%s' could not be found.", cwStringNullGuard(preset_label) );
+    goto errLabel;
+  }
+
+  if((rc = _preset_apply_begin(net,network_preset,nullptr,0,proc_label_sfx_id,max_cycle_cnt,cycle_budget_us)) != kOkRC )
+    goto errLabel;
+  
+errLabel:
+  if(rc != kOkRC )
+    rc = net_error(&net,rc,"The incremental network application '%s' with sfx_id '%i' failed.", cwStringNullGuard(preset_label), proc_label_sfx_id );
+     
+  return rc;
+}
+
+cw::rc_t cw::flow::network_begin_dual_preset_apply( network_t& net, const char* preset_label_0, const char* preset_label_1, double coeff, unsigned max_cycle_cnt, double cycle_budget_us, unsigned proc_label_sfx_id )
+{
+  rc_t                    rc      = kOkRC;
+  const network_preset_t* net_ps0 = nullptr;
+  const network_preset_t* net_ps1 = nullptr;
+  
+  if((net_ps0 = network_preset_from_label(net, preset_label_0 )) == nullptr )
+  {
+    rc = net_error(&net,kInvalidIdRC,"The network preset '%s' could not be found.", preset_label_0 );
+    goto errLabel;
+  }
+
+  if((net_ps1 = network_preset_from_label(net, preset_label_1 )) == nullptr )
+  {
+    rc = net_error(&net,kInvalidIdRC,"The network preset '%s' could not be found.", preset_label_1 );
+    goto errLabel;
+  }
+
+  if((rc = _preset_apply_begin(net,net_ps0,net_ps1,coeff,proc_label_sfx_id,max_cycle_cnt,cycle_budget_us)) != kOkRC )
+    goto errLabel;
+
+errLabel:
+  if( rc != kOkRC )
+    rc = net_error(&net,rc,"Incremental dual-preset application failed.");  
+  
+  return rc;
+}
+
+bool cw::flow::network_preset_apply_status( const network_t& net, unsigned& applied_cnt_ref, unsigned& total_cnt_ref, rc_t& rc_ref )
+{
+  applied_cnt_ref = net.preset_apply.applyN;
+  total_cnt_ref   = net.preset_apply.valueN;
+  rc_ref          = net.preset_apply.rc;
+  return net.preset_apply.preset == nullptr;
+}
+
 
 cw::rc_t cw::flow::network_apply_preset( network_t& net, const multi_preset_selector_t& mps, unsigned proc_label_sfx_id )
 {
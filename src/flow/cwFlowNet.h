@@ -29,8 +29,14 @@ namespace cw
     
     rc_t exec_cycle( network_t& net );
 
+    // Execute the fused kernel which replaces the exec() of 'proc'. Called by proc_exec() when proc->fuse_kernel is set.
+    rc_t fuse_kernel_exec( proc_t* proc );
+
     rc_t network_profile_report( const network_t& net );
 
+    // Write to all audio and spectral buffers so that their memory is resident before runtime.
+    rc_t network_prewarm( network_t& net );
+
 
     rc_t get_variable( network_t& net, const char* inst_label, const char* var_label, unsigned chIdx, proc_t*& instPtrRef, variable_t*& varPtrRef );
 
@@ -137,6 +143,20 @@ namespace cw
     rc_t network_apply_preset( network_t& net, const char* presetLabel, unsigned proc_label_sfx_id=kInvalidId );
     rc_t network_apply_dual_preset( network_t& net, const char* presetLabel_0, const char* presetLabel_1, double coeff, unsigned proc_label_sfx_id=kInvalidId );      
     rc_t network_apply_preset( network_t& net, const multi_preset_selector_t& mps, unsigned proc_label_sfx_id=kInvalidId );
+
+    // Apply a preset incrementally over multiple network cycles.
+    // The values are applied at the start of each call to exec_cycle() until 'cycle_budget_us'
+    // is exhausted. All values which target the same proc are applied on the same cycle.
+    // All remaining values are applied on cycle 'max_cycle_cnt'.
+    // If 'cycle_budget_us' is 0 then the values are spread evenly over 'max_cycle_cnt' cycles.
+    // If both are 0 the preset is applied in full on the next cycle.
+    // Starting a new application, or applying a preset directly, first completes an in-progress application.
+    rc_t network_begin_preset_apply( network_t& net, const char* presetLabel, unsigned max_cycle_cnt, double cycle_budget_us, unsigned proc_label_sfx_id=kInvalidId );
+    rc_t network_begin_dual_preset_apply( network_t& net, const char* presetLabel_0, const char* presetLabel_1, double coeff, unsigned max_cycle_cnt, double cycle_budget_us, unsigned proc_label_sfx_id=kInvalidId );
+
+    // Returns true if no incremental preset application is in progress.
+    // 'rc_ref' is set to the result of the most recent application step.
+    bool network_preset_apply_status( const network_t& net, unsigned& applied_cnt_ref, unsigned& total_cnt_ref, rc_t& rc_ref );
     
   }
 }
@@ -978,7 +978,7 @@ namespace cw
           goto errLabel;
         }
           
-        if((rc = objectFromFile( fn, cfg )) != kOkRC )
+        if((rc = proc_object_from_file(proc,fn,cfg)) != kOkRC )
         {
           rc = proc_error(proc,rc,"Unable to parse cfg from '%s'.",cwStringNullGuard(fn));
           goto errLabel;
@@ -1602,7 +1602,7 @@ namespace cw
           goto errLabel;
         }
         
-        if((rc = objectFromFile(fname,cfg)) != kOkRC )
+        if((rc = proc_object_from_file(proc,fname,cfg)) != kOkRC )
         {
           rc = proc_error(proc,rc,"Velocity table file parse failed.");
           goto errLabel;
@@ -2937,7 +2937,7 @@ namespace cw
 
           for(unsigned j=0; j<mbuf->msgN; ++j)
           {
-            const midi::ch_msg_t* m = mbuf->msgA + j;
+            const midi::ch_msg_t* m = mbuf_msg(mbuf,j);
             
             // if this is a note-on msg
             if( m->status == midi::kNoteOnMdId && m->d1 > 0 )
@@ -3914,7 +3914,7 @@ namespace cw
           goto errLabel;
         }
           
-        if((rc = objectFromFile( fn, cfg )) != kOkRC )
+        if((rc = proc_object_from_file(proc,fn,cfg)) != kOkRC )
         {
           rc = proc_error(proc,rc,"Unable to parse gutim_ctl cfg from '%s'.",cwStringNullGuard(fn));
           goto errLabel;
@@ -4428,7 +4428,7 @@ namespace cw
           goto errLabel;
         }
           
-        if((rc = objectFromFile( fn, cfg )) != kOkRC )
+        if((rc = proc_object_from_file(proc,fn,cfg)) != kOkRC )
         {
           rc = proc_error(proc,rc,"Unable to parse gutim_ctl cfg from '%s'.",cwStringNullGuard(fn));
           goto errLabel;
@@ -5181,7 +5181,7 @@ namespace cw
           goto errLabel;
         }
           
-        if((rc = objectFromFile( fn, cfg )) != kOkRC )
+        if((rc = proc_object_from_file(proc,fn,cfg)) != kOkRC )
         {
           rc = proc_error(proc,rc,"Unable to parse cfg from '%s'.",cwStringNullGuard(fn));
           goto errLabel;
@@ -5913,7 +5913,7 @@ namespace cw
           goto errLabel;
         }
           
-        if((rc = objectFromFile( fn, cfg )) != kOkRC )
+        if((rc = proc_object_from_file(proc,fn,cfg)) != kOkRC )
         {
           rc = proc_error(proc,rc,"Unable to parse cfg from '%s'.",cwStringNullGuard(fn));
           goto errLabel;
@@ -6486,7 +6486,7 @@ namespace cw
           goto errLabel;
         }
           
-        if((rc = objectFromFile( fn, cfg )) != kOkRC )
+        if((rc = proc_object_from_file(proc,fn,cfg)) != kOkRC )
         {
           rc = proc_error(proc,rc,"Unable to parse cfg from '%s'.",cwStringNullGuard(fn));
           goto errLabel;
@@ -7629,7 +7629,7 @@ namespace cw
         variable_t*         var         = nullptr;
 
         // parse the cfg file into an object format
-        if((rc = objectFromFile( fn, cfg )) != kOkRC )
+        if((rc = proc_object_from_file(proc,fn,cfg)) != kOkRC )
         {
           rc = proc_error(proc,rc,"Cfg. file parse failed.");
           goto errLabel;
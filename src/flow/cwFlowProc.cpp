@@ -374,7 +374,7 @@ namespace cw
           goto errLabel;
         }
           
-        if((rc = objectFromFile( fn, cfg )) != kOkRC )
+        if((rc = proc_object_from_file(p->proc,fn,cfg)) != kOkRC )
         {
           rc = proc_error(p->proc,rc,"Unable to parse msg table from '%s'.",cwStringNullGuard(fn));
           goto errLabel;
@@ -630,12 +630,19 @@ namespace cw
         kPresetLabelPId,
         kThreadCntPId,
         kCpuAffinityPId,
+        kIdleSkipFlPId,
+        kIdleTailMsPId,
       };
 
       typedef struct voice_str
       {
         unsigned            voice_idx;
         struct network_str* net;
+        bool                active_fl; // true if this voice was executed on the previous cycle
+        variable_t**        inVarA;    // inVarA[ inVarN ] event (MIDI,record) and notifying var's which are connected to sources outside of the voice
+        unsigned            inVarN;    //
+        variable_t**        outVarA;   // outVarA[ outVarN ] buffer var's which are sources for var's outside of the voice
+        unsigned            outVarN;   //
       } voice_t;
 
       typedef struct
@@ -647,6 +654,10 @@ namespace cw
         unsigned               voiceN;
         unsigned               preset_sfx_id;
         unsigned               thread_cnt;
+        
+        bool                   idle_skip_fl;     // true if voices which are not sounding are not executed
+        bool                   io_var_fill_fl;   // true if the voice in/out var arrays have been filled
+        unsigned               idle_tail_cycleN; // count of cycles a voice continues to execute after it stops reporting activity
       } inst_t;
 
       rc_t _poly_thread_func( void* arg )
@@ -689,7 +700,118 @@ namespace cw
             
       }
 
+      // Returns true if 'net' is 'voice_net' or is contained by a proc inside of 'voice_net'.
+      bool _is_voice_net( const network_t* voice_net, const network_t* net )
+      {
+        if( voice_net == net )
+          return true;
+        
+        for(unsigned i=0; i<voice_net->procN; ++i)
+          for(const network_t* n=voice_net->procA[i]->internal_net; n!=nullptr; n=n->poly_link)
+            if( _is_voice_net(n,net) )
+              return true;
+        
+        return false;
+      }
+
+      bool _is_voice_input_var( const voice_t* v, const variable_t* var )
+      {
+        if( var->src_var == nullptr || _is_voice_net(v->net,var->src_var->proc->net) )
+          return false;
+
+        // audio and spectral inputs are continuous and therefore they cannot be used to wake the voice
+        return cwIsFlag(var->varDesc->flags,kNotifyVarDescFl) || (var->value != nullptr && (var->value->tflag & (kMBufTFl | kRBufTFl)));
+      }
+
+      bool _is_voice_output_var( const voice_t* v, const variable_t* var )
+      {
+        if( var->value == nullptr || (var->value->tflag & (kABufTFl | kFBufTFl | kMBufTFl | kRBufTFl))==0 )
+          return false;
+        
+        for(const variable_t* dst=var->dst_head; dst!=nullptr; dst=dst->dst_link)
+          if( !_is_voice_net(v->net,dst->proc->net) )
+            return true;
 
+        return false;
+      }
+
+      // Allocate the voice in/out var arrays large enough to hold every var in the voice network.
+      void _voice_alloc_io_var_arrays( voice_t* v )
+      {
+        unsigned varN = 0;
+        for(unsigned i=0; i<v->net->procN; ++i)
+          varN += proc_var_count(v->net->procA[i]);
+
+        v->inVarA  = mem::allocZ<variable_t*>(varN);
+        v->outVarA = mem::allocZ<variable_t*>(varN);
+      }
+
+      // Locate the var's which connect the voice network to proc's outside of the voice.
+      // This must be done after the proc's which follow the 'poly' have been connected
+      // and is therefore done on the first call to exec().
+      void _voice_fill_io_var_arrays( voice_t* v )
+      {
+        v->inVarN  = 0;
+        v->outVarN = 0;
+        
+        for(unsigned i=0; i<v->net->procN; ++i)
+          for(variable_t* var=v->net->procA[i]->varL; var!=nullptr; var=var->var_link)
+          {
+            if( _is_voice_input_var(v,var) )
+              v->inVarA[ v->inVarN++ ] = var;
+            
+            if( _is_voice_output_var(v,var) )
+              v->outVarA[ v->outVarN++ ] = var;
+          }
+      }
+
+      // Returns true if the voice should be executed on this cycle.
+      bool _voice_is_active( proc_t* proc, inst_t* p, const voice_t* v )
+      {
+        // a voice remains active for 'idle_tail_cycleN' cycles after the last cycle on which it reported activity
+        if( proc->ctx->cycleIndex - v->net->activity_cycle_idx <= p->idle_tail_cycleN + 1 )
+          return true;
+
+        // an idle voice is woken by incoming events or notifications from outside of the voice
+        for(unsigned i=0; i<v->inVarN; ++i)
+        {
+          const variable_t* var = v->inVarA[i];
+          if( var->modN.load(std::memory_order_acquire) > 0 || ((var->value->tflag & (kMBufTFl | kRBufTFl)) && value_has_elements_now(var->value)) )
+            return true;
+        }
+
+        return false;
+      }
+
+      // Clear the outputs of a voice which has become idle so that downstream proc's
+      // do not continue to read the contents of the last executed cycle.
+      void _voice_clear_outputs( voice_t* v )
+      {
+        for(unsigned i=0; i<v->outVarN; ++i)
+        {
+          value_t* value = v->outVarA[i]->value;
+          
+          switch( value->tflag & kTypeMask )
+          {
+            case kABufTFl:
+              abuf_set_silent(value->u.abuf);
+              break;
+              
+            case kFBufTFl:
+              for(unsigned ch=0; ch<value->u.fbuf->chN; ++ch)
+                value->u.fbuf->readyFlV[ch] = false;
+              break;
+              
+            case kMBufTFl:
+              value->u.mbuf->msgN = 0;
+              break;
+              
+            case kRBufTFl:
+              value->u.rbuf->recdN = 0;
+              break;
+          }
+        }
+      }
 
       rc_t create( proc_t* proc )
       {
@@ -706,6 +828,7 @@ namespace cw
         bool             het_poly_fl   = false;
         unsigned         poly_cnt      = 1;
         const object_t*  cpuAffinityL  = nullptr;
+        ftime_t          idle_tail_ms  = 0;
         
         proc->userPtr = inst;
 
@@ -722,7 +845,9 @@ namespace cw
                                         kPresetLabelPId,"preset_label",  kBaseSfxId, preset_label,
                                         kThreadCntPId,  "thread_cnt",    kBaseSfxId, inst->thread_cnt,
                                         kCpuAffinityPId,"cpu_affinityL", kBaseSfxId, cpuAffinityL,
-                                        kParallelFlPId, "parallel_fl",   kBaseSfxId, inst->parallel_fl )) != kOkRC )
+                                        kParallelFlPId, "parallel_fl",   kBaseSfxId, inst->parallel_fl,
+                                        kIdleSkipFlPId, "idle_skip_fl",  kBaseSfxId, inst->idle_skip_fl,
+                                        kIdleTailMsPId, "idle_tail_ms",  kBaseSfxId, idle_tail_ms )) != kOkRC )
         {
           goto errLabel;
         }
@@ -795,11 +920,30 @@ namespace cw
         for(network_t* net=internal_net; net!=nullptr; net=net->poly_link)
           inst->voiceN += 1;
 
+        // the voiceA[] array is needed to hold voice specific info. for the call to thread_ftasks::run()
+        // and to track voice activity
+        inst->voiceA = mem::allocZ<voice_t>(inst->voiceN);
+        
+        {
+          network_t* net = internal_net;
+          for(unsigned i=0; net !=nullptr; ++i)
+          {            
+            inst->voiceA[i].voice_idx = i;
+            inst->voiceA[i].net       = net;
+            inst->voiceA[i].active_fl = true;
+
+            if( inst->idle_skip_fl )
+              _voice_alloc_io_var_arrays(inst->voiceA + i);
+            
+            net = net->poly_link;
+          }
+        }
 
+        // convert the idle tail duration to cycles
+        inst->idle_tail_cycleN = (unsigned)ceil( (idle_tail_ms * proc->ctx->sample_rate) / (1000.0 * proc->ctx->framesPerCycle) );
 
         if( inst->parallel_fl )
         {
-          network_t* net = internal_net;
           unsigned cpuAffinityA[ inst->thread_cnt ];
           
           unsigned cpuAffinityN = cpuAffinityL->child_count();
@@ -830,19 +974,13 @@ namespace cw
             goto errLabel;
           }
 
-          // the taskA[] array is needed to hold voice specific info. for the call to thread_ftasks::run()
+          // taskA[] is filled with the active voices on each cycle
           inst->taskA  = mem::allocZ<thread_stasks::task_t>(inst->voiceN);
-          inst->voiceA = mem::allocZ<voice_t>(inst->voiceN);
           
-          for(unsigned i=0; net !=nullptr; ++i)
+          for(unsigned i=0; i<inst->voiceN; ++i)
           {            
-            inst->voiceA[i].voice_idx = i;
-            inst->voiceA[i].net       = net;
-            
             inst->taskA[i].func = _poly_thread_func;
             inst->taskA[i].arg  = inst->voiceA + i;
-
-            net = net->poly_link;
           }
         }
           
@@ -866,6 +1004,13 @@ namespace cw
           network_destroy(proc->internal_net);
 
         thread_stasks::destroy(p->threadTasksH);
+
+        for(unsigned i=0; i<p->voiceN; ++i)
+        {
+          mem::release(p->voiceA[i].inVarA);
+          mem::release(p->voiceA[i].outVarA);
+        }
+        
         mem::release( p->taskA);
         mem::release( p->voiceA);
         mem::release( proc->userPtr );
@@ -883,6 +1028,7 @@ namespace cw
         inst_t* p = (inst_t*)proc->userPtr;
         rc_t   rc = kOkRC;
         unsigned preset_sfx_id = kInvalidId;
+        unsigned taskN = 0;
         
         if((rc = var_get(proc,kPresetSfxIdPId,kAnyChIdx,preset_sfx_id)) != kOkRC )
           goto errLabel;
@@ -904,19 +1050,57 @@ namespace cw
               goto errLabel;
         }
 
+        if( p->idle_skip_fl && !p->io_var_fill_fl )
+        {
+          for(unsigned i=0; i<p->voiceN; ++i)
+            _voice_fill_io_var_arrays(p->voiceA + i);
+          
+          p->io_var_fill_fl = true;
+        }
+
+        // update the voice activity state
+        if( p->idle_skip_fl )
+          for(unsigned i=0; i<p->voiceN; ++i)
+          {
+            voice_t* v       = p->voiceA + i;
+            bool     prv_fl  = v->active_fl;
+            
+            v->active_fl = _voice_is_active(proc,p,v);
+
+            // if the voice just became idle then clear it's outputs
+            if( prv_fl && !v->active_fl )
+              _voice_clear_outputs(v);
+          }
 
         if( p->parallel_fl )
         {
-          if((rc = thread_stasks::run(p->threadTasksH,p->taskA,p->voiceN)) != kOkRC )
+          // Pack the active voices into the front of taskA[]. thread_stasks::run() distributes the tasks
+          // by having each thread take the next unclaimed task and therefore threads which
+          // finish early continue to pull voices from the list rather than waiting on a fixed assignment.
+          for(unsigned i=0; i<p->voiceN; ++i)
+            if( p->voiceA[i].active_fl )
+              p->taskA[ taskN++ ].arg = p->voiceA + i;
+
+          // a single voice does not warrant waking the worker threads
+          if( taskN == 1 )
+            rc = _poly_thread_func(p->taskA[0].arg);
+          else
+            if( taskN > 1 )
+              rc = thread_stasks::run(p->threadTasksH,p->taskA,taskN);
+          
+          if( rc != kOkRC )
           {
             rc = proc_error(proc,rc,"poly internal network parallel exec failed.");
           }
         }
         else
         {
-          for(network_t* net=proc->internal_net; net!=nullptr; net=net->poly_link)
+          for(unsigned i=0; i<p->voiceN; ++i)
           {
-            if((rc = exec_cycle(*net)) != kOkRC )
+            if( !p->voiceA[i].active_fl )
+              continue;
+            
+            if((rc = exec_cycle(*p->voiceA[i].net)) != kOkRC )
             {
               rc = proc_error(proc,rc,"poly internal network exec failed.");
               break;
@@ -1034,8 +1218,8 @@ namespace cw
       
       typedef struct
       {
-        midi::ch_msg_t*    buf;
-        unsigned           bufN;
+        unsigned*          idxA;     // idxA[ idxN ] index view of the device msg array used when the device filter is set
+        unsigned           idxN;
         bool               dev_filt_fl;
         bool               port_filt_fl;        
         external_device_t* ext_dev;
@@ -1098,9 +1282,9 @@ namespace cw
 
         // printf("%s : DEV FILTER: %s %s : %i %i : enabled:%i %i\n", proc->label, inst->ext_dev->devLabel, inst->ext_dev->portLabel, inst->ext_dev->ioDevIdx, inst->ext_dev->ioPortIdx, inst->dev_filt_fl, inst->port_filt_fl );
 
-        // Allocate a buffer large enough to hold the max. number of messages arriving on a single call to exec().
-        inst->bufN = inst->ext_dev->u.m.maxMsgCnt;
-        inst->buf = mem::allocZ<midi::ch_msg_t>( inst->bufN );
+        // Allocate an index buffer large enough to hold the max. number of messages arriving on a single call to exec().
+        inst->idxN = inst->ext_dev->u.m.maxMsgCnt;
+        inst->idxA = mem::allocZ<unsigned>( inst->idxN );
 
         // create one output MIDI buffer
         if((rc = var_register_and_set( proc, "out", kBaseSfxId, kOutPId, kAnyChIdx, nullptr, 0  )) != kOkRC )
@@ -1126,7 +1310,7 @@ namespace cw
         rc_t rc = kOkRC;
 
         inst_t* inst = (inst_t*)proc->userPtr;
-        mem::release(inst->buf);
+        mem::release(inst->idxA);
 
         recd_array_destroy(inst->recd_array);
         
@@ -1175,28 +1359,24 @@ namespace cw
         }
         else
         {
-          mbuf->msgA = nullptr;
-          mbuf->msgN = 0;
+          mbuf->msgA = inst->ext_dev->u.m.msgArray;
+          mbuf->msgN = inst->ext_dev->u.m.msgCnt;
+          mbuf->idxA = nullptr;
           
-          // if the device filter is not set
-          if( !inst->dev_filt_fl)
-          {
-            mbuf->msgA = inst->ext_dev->u.m.msgArray;
-            mbuf->msgN = inst->ext_dev->u.m.msgCnt;
-          }
-          else // the device filter is set
+          // if the device filter is set then output an index view of the selected messages
+          if( inst->dev_filt_fl)
           {
             const midi::ch_msg_t* m = inst->ext_dev->u.m.msgArray;
             unsigned j = 0;
-            for(unsigned i=0; i<inst->ext_dev->u.m.msgCnt && j<inst->bufN; ++i)
+            for(unsigned i=0; i<inst->ext_dev->u.m.msgCnt && j<inst->idxN; ++i)
             {
               // printf("%s : dev:(msg:%i io:%i) : port:(msg:%i io:%i)\n",proc->label, m[i].devIdx,inst->ext_dev->ioDevIdx, m[i].portIdx,inst->ext_dev->ioPortIdx);
               
               if( m[i].devIdx == inst->ext_dev->ioDevIdx && (!inst->port_filt_fl || m[i].portIdx == inst->ext_dev->ioPortIdx) )
-                inst->buf[j++] = m[i];
+                inst->idxA[j++] = i;
             }
             mbuf->msgN = j;
-            mbuf->msgA = inst->buf;
+            mbuf->idxA = inst->idxA;
           }
 
           if( print_fl )
@@ -1204,7 +1384,7 @@ namespace cw
             
             for(unsigned i=0; i<mbuf->msgN; ++i)
             {
-              const midi::ch_msg_t* m = mbuf->msgA + i;
+              const midi::ch_msg_t* m = mbuf_msg(mbuf,i);
               proc_info(proc,"%s : %i 0x%x %i %i : dev:%i port:%i",cwStringNullGuard(proc->label),m->ch,m->status,m->d0,m->d1,m->devIdx,m->portIdx);
             }
           }
@@ -1223,7 +1403,7 @@ namespace cw
             
             for(unsigned i=0; i<mbuf->msgN; ++i)
             {
-              _set_output_record(proc,inst,rbuf1, mbuf->msgA + i);
+              _set_output_record(proc,inst,rbuf1, mbuf_msg(mbuf,i));
             }
 
             //if( rbuf->recdN )
@@ -1419,7 +1599,7 @@ namespace cw
           {
             for(unsigned i=0; i<src_mbuf->msgN; ++i)
             {
-              _send_msg(proc,p,print_fl,enable_fl,src_mbuf->msgA + i);
+              _send_msg(proc,p,print_fl,enable_fl,mbuf_msg(src_mbuf,i));
             }
           }
         }
@@ -2458,13 +2638,15 @@ namespace cw
 
       typedef struct inst_str
       {
+        var_plan_t plan;
       } inst_t;
 
       rc_t create( proc_t* proc )
       {
         rc_t          rc     = kOkRC;
         const abuf_t* abuf    = nullptr; //
-        proc->userPtr = mem::allocZ<inst_t>();
+        inst_t*       inst   = mem::allocZ<inst_t>();
+        proc->userPtr = inst;
 
         // get the source audio buffer
         if((rc = var_register_and_get(proc, kAnyChIdx,kInPId,"in",kBaseSfxId,abuf )) != kOkRC )
@@ -2476,7 +2658,10 @@ namespace cw
             goto errLabel;
           
         // create the output audio buffer
-        rc = var_register_and_set( proc, "out", kBaseSfxId, kOutPId, kAnyChIdx, abuf->srate, abuf->chN, abuf->frameN );
+        if((rc = var_register_and_set( proc, "out", kBaseSfxId, kOutPId, kAnyChIdx, abuf->srate, abuf->chN, abuf->frameN )) != kOkRC )
+          goto errLabel;
+
+        rc = var_plan_create(proc,inst->plan);
 
 
       errLabel:
@@ -2486,6 +2671,7 @@ namespace cw
       rc_t destroy( proc_t* proc )
       {
         inst_t* inst = (inst_t*)(proc->userPtr);
+        var_plan_destroy(inst->plan);
         mem::release(inst);
         return kOkRC;
       }
@@ -2498,15 +2684,16 @@ namespace cw
       rc_t exec( proc_t* proc )
       {
         rc_t     rc           = kOkRC;
+        inst_t*       inst = (inst_t*)(proc->userPtr);
         const abuf_t* ibuf = nullptr;
         abuf_t*       obuf = nullptr;
 
         // get the src buffer
-        if((rc = var_get(proc,kInPId, kAnyChIdx, ibuf )) != kOkRC )
+        if((rc = var_plan_get(inst->plan,kInPId, kAnyChIdx, ibuf )) != kOkRC )
           goto errLabel;
 
         // get the dst buffer
-        if((rc = var_get(proc,kOutPId, kAnyChIdx, obuf)) != kOkRC )
+        if((rc = var_plan_get(inst->plan,kOutPId, kAnyChIdx, obuf)) != kOkRC )
           goto errLabel;
 
         // for each channel
@@ -2516,7 +2703,7 @@ namespace cw
           sample_t* osig = obuf->buf + i*obuf->frameN;
           sample_t  gain = 1;
           
-          var_get(proc,kGainPId,i,gain);
+          var_plan_get(inst->plan,kGainPId,i,gain);
 
           // apply the gain
           for(unsigned j=0; j<ibuf->frameN; ++j)
@@ -2529,6 +2716,31 @@ namespace cw
       }
 
       
+      rc_t linear( proc_t* proc, linear_term_t* termA, unsigned termAllocN, unsigned& termN_ref )
+      {
+        rc_t        rc      = kOkRC;
+        inst_t*     inst    = (inst_t*)(proc->userPtr);
+        variable_t* in_var  = nullptr;
+        variable_t* out_var = nullptr;
+
+        if((rc = var_find(proc,kInPId,kAnyChIdx,in_var)) != kOkRC || (rc = var_find(proc,kOutPId,kAnyChIdx,out_var)) != kOkRC )
+          goto errLabel;
+
+        if((termN_ref = in_var->value->u.abuf->chN) > termAllocN )
+          return kBufTooSmallRC;
+
+        for(unsigned i=0; i<termN_ref; ++i)
+        {
+          sample_t gain = 1;
+          var_plan_get(inst->plan,kGainPId,i,gain);
+          
+          termA[i] = { .in_var=in_var, .in_ch=i, .out_var=out_var, .out_ch=i, .coeff=gain };
+        }
+        
+      errLabel:
+        return rc;
+      }
+      
       class_members_t members = {
         .create = create,
         .destroy = destroy,
@@ -2813,6 +3025,8 @@ namespace cw
 
         unsigned  iChN;        // count of input audio channels
         coeff_t*  igainV;      // igainV[ inChN ] input ch. gain coeff's
+
+        var_plan_t plan;
           
       } inst_t;
 
@@ -2926,6 +3140,9 @@ namespace cw
           if((rc = var_register_and_get( proc, i, kInGainPId, "igain", kBaseSfxId, p->igainV[i] )) != kOkRC )
             goto errLabel;
 
+        if((rc = var_plan_create(proc,p->plan)) != kOkRC )
+          goto errLabel;
+
 
       errLabel:
         mem::release(oVarSelMap);
@@ -2942,6 +3159,7 @@ namespace cw
         }
         mem::release(p->oVarA);
         mem::release(p->igainV);
+        var_plan_destroy(p->plan);
         
         return rc;
       }
@@ -2987,7 +3205,7 @@ namespace cw
         const abuf_t* ibuf = nullptr;
 
         // get the input audio buffer
-        if((rc = var_get(proc,kInPId, kAnyChIdx, ibuf )) != kOkRC )
+        if((rc = var_plan_get(p->plan,kInPId, kAnyChIdx, ibuf )) != kOkRC )
           goto errLabel;
 
         for(unsigned i=0; i<p->oVarN; ++i)
@@ -2995,7 +3213,7 @@ namespace cw
           abuf_t*    obuf = nullptr;
           
           // get the ith output buffer
-          if((rc = var_get(proc, p->baseOutPId +i, kAnyChIdx, obuf)) != kOkRC )
+          if((rc = var_plan_get(p->plan, p->baseOutPId +i, kAnyChIdx, obuf)) != kOkRC )
             goto errLabel;
 
           for( unsigned oChIdx=0; oChIdx<obuf->chN; ++oChIdx)
@@ -3020,6 +3238,41 @@ namespace cw
       rc_t _report( proc_t* proc, inst_t* p )
       { return kOkRC; }
 
+      rc_t _linear( proc_t* proc, inst_t* p, linear_term_t* termA, unsigned termAllocN, unsigned& termN_ref )
+      {
+        rc_t        rc     = kOkRC;
+        variable_t* in_var = nullptr;
+        unsigned    k      = 0;
+
+        termN_ref = 0;
+        for(unsigned i=0; i<p->oVarN; ++i)
+          termN_ref += p->oVarA[i].ogainV == nullptr ? 0 : p->oVarA[i].audioChN;
+
+        if( termN_ref > termAllocN )
+          return kBufTooSmallRC;
+        
+        if((rc = var_find(proc,kInPId,kAnyChIdx,in_var)) != kOkRC )
+          goto errLabel;
+
+        for(unsigned i=0; i<p->oVarN; ++i)
+          if( p->oVarA[i].ogainV != nullptr )
+          {
+            variable_t* out_var = nullptr;
+            
+            if((rc = var_find(proc,p->baseOutPId+i,kAnyChIdx,out_var)) != kOkRC )
+              goto errLabel;
+            
+            for(unsigned oChIdx=0; oChIdx<p->oVarA[i].audioChN; ++oChIdx)
+            {
+              unsigned iChIdx = p->oVarA[i].iChIdxV[oChIdx];
+              termA[k++] = { .in_var=in_var, .in_ch=iChIdx, .out_var=out_var, .out_ch=oChIdx, .coeff=p->igainV[iChIdx] * p->oVarA[i].ogainV[oChIdx] };
+            }
+          }
+        
+      errLabel:
+        return rc;
+      }
+
       class_members_t members = {
         .create  = std_create<inst_t>,
         .destroy = std_destroy<inst_t>,
@@ -3027,6 +3280,9 @@ namespace cw
         .exec    = std_exec<inst_t>,
         .report  = std_report<inst_t>
       };
+
+      rc_t linear( proc_t* proc, linear_term_t* termA, unsigned termAllocN, unsigned& termN_ref )
+      { return std_linear<inst_t>(proc,termA,termAllocN,termN_ref); }
       
     }    
     
@@ -3198,6 +3454,8 @@ namespace cw
 
         audio_gain_t  oag;  
         audio_gain_t* iagV; // iagV[ inAudioVarCnt ]
+
+        var_plan_t    plan;
         
       } inst_t;
 
@@ -3212,14 +3470,14 @@ namespace cw
 
       // Mix the the first N channels of the input audio signal from iag->aVId
       // into the first N channels of the output signal.
-      rc_t _mix( proc_t* proc, audio_gain_t* iag, audio_gain_t* oag, abuf_t* obuf )
+      rc_t _mix( inst_t* p, audio_gain_t* iag, audio_gain_t* oag, abuf_t* obuf )
       {
         rc_t rc = kOkRC;
         const abuf_t* ibuf = nullptr;
         unsigned chN;
         
         // get the input audio buffer
-        if((rc = var_get(proc, iag->aVId, kAnyChIdx, ibuf )) != kOkRC )
+        if((rc = var_plan_get(p->plan, iag->aVId, kAnyChIdx, ibuf )) != kOkRC )
           goto errLabel;
 
         chN = std::min(ibuf->chN,obuf->chN);
@@ -3329,6 +3587,9 @@ namespace cw
         // setup the audio_gain record for the output gains
         if((rc= _setup_gain(proc, "ogain", kBaseSfxId, kOutPId, kOutGainPId, maxInAudioChCnt, &p->oag )) != kOkRC )
           goto errLabel;
+
+        if((rc = var_plan_create(proc,p->plan)) != kOkRC )
+          goto errLabel;
         
 
       errLabel:
@@ -3346,6 +3607,8 @@ namespace cw
         
         mem::release(p->iagV);
 
+        var_plan_destroy(p->plan);
+
         return rc;
       }
 
@@ -3403,7 +3666,7 @@ namespace cw
         abuf_t*       obuf  = nullptr;
 
         // get the output audio buffer
-        if((rc = var_get(proc,kOutPId, kAnyChIdx, obuf)) != kOkRC )
+        if((rc = var_plan_get(p->plan,kOutPId, kAnyChIdx, obuf)) != kOkRC )
           goto errLabel;
         
         // zero the output buffer
@@ -3411,7 +3674,7 @@ namespace cw
 
         // mix each input port into the output buffer
         for(unsigned i=0; i<p->inAudioVarCnt; ++i)
-          if((rc =_mix(proc, p->iagV + i, &p->oag, obuf )) != kOkRC )
+          if((rc =_mix(p, p->iagV + i, &p->oag, obuf )) != kOkRC )
             goto errLabel;
 
         //if( proc->ctx->cycleIndex == 10 )
@@ -3425,6 +3688,37 @@ namespace cw
       rc_t _report( proc_t* proc, inst_t* p )
       { return kOkRC; }
 
+      rc_t _linear( proc_t* proc, inst_t* p, linear_term_t* termA, unsigned termAllocN, unsigned& termN_ref )
+      {
+        rc_t        rc      = kOkRC;
+        variable_t* out_var = nullptr;
+        unsigned    k       = 0;
+
+        termN_ref = 0;
+        for(unsigned i=0; i<p->inAudioVarCnt; ++i)
+          termN_ref += std::min(p->iagV[i].audioChN,p->oag.audioChN);
+
+        if( termN_ref > termAllocN )
+          return kBufTooSmallRC;
+        
+        if((rc = var_find(proc,kOutPId,kAnyChIdx,out_var)) != kOkRC )
+          goto errLabel;
+
+        for(unsigned i=0; i<p->inAudioVarCnt; ++i)
+        {
+          variable_t* in_var = nullptr;
+          
+          if((rc = var_find(proc,p->iagV[i].aVId,kAnyChIdx,in_var)) != kOkRC )
+            goto errLabel;
+
+          for(unsigned j=0; j<std::min(p->iagV[i].audioChN,p->oag.audioChN); ++j)
+            termA[k++] = { .in_var=in_var, .in_ch=j, .out_var=out_var, .out_ch=j, .coeff=p->iagV[i].gainV[j] * p->oag.gainV[j] };
+        }
+        
+      errLabel:
+        return rc;
+      }
+
       class_members_t members = {
         .create  = std_create<inst_t>,
         .destroy = std_destroy<inst_t>,
@@ -3432,6 +3726,9 @@ namespace cw
         .exec    = std_exec<inst_t>,
         .report  = std_report<inst_t>
       };
+
+      rc_t linear( proc_t* proc, linear_term_t* termA, unsigned termAllocN, unsigned& termN_ref )
+      { return std_linear<inst_t>(proc,termA,termAllocN,termN_ref); }
       
     }    
     
@@ -3587,7 +3884,15 @@ namespace cw
       { return kOkRC; }
 
       rc_t _exec( proc_t* proc, inst_t* p )
-      { return kOkRC; }
+      {
+        rc_t    rc   = kOkRC;
+        abuf_t* abuf = nullptr;
+        
+        if((rc = var_get(proc,kOutPId,kAnyChIdx,abuf)) == kOkRC )
+          abuf_set_silent(abuf);
+        
+        return rc;
+      }
 
       rc_t _report( proc_t* proc, inst_t* p )
       { return kOkRC; }
@@ -3885,6 +4190,8 @@ namespace cw
         }
         else
         {
+          bool silentFl = true;
+          
           for(unsigned i=0; i<abuf->chN; ++i)
           {
             coeff_t    gain  = val_get<coeff_t>( proc, kGainPId, i );
@@ -3893,15 +4200,23 @@ namespace cw
             coeff_t    dc    = val_get<coeff_t>( proc, kDcPId, i );
             srate_t    srate = val_get<srate_t>(proc, kSratePId, i );                        
             sample_t*  v     = abuf->buf + (i*abuf->frameN);
-            
-            for(unsigned j=0; j<abuf->frameN; ++j)
-              v[j] = (sample_t)((gain * sin( inst->phaseA[i] + phase + (2.0 * M_PI * j * hz/srate)))+dc);
+
+            // a zero gain channel contains only the DC offset
+            if( gain == 0 )
+              vop::fill(v,abuf->frameN,(sample_t)dc);
+            else
+              for(unsigned j=0; j<abuf->frameN; ++j)
+                v[j] = (sample_t)((gain * sin( inst->phaseA[i] + phase + (2.0 * M_PI * j * hz/srate)))+dc);
+
+            silentFl = silentFl && gain==0 && dc==0;
 
             inst->phaseA[i] += 2.0 * M_PI * abuf->frameN * hz/srate;
 
             //if( i==0 )
             //  printf("hz:%f gain:%f phs:%f : %f\n",hz,gain,inst->phaseA[i],v[0]);
           }
+
+          abuf->silentFl = silentFl;
         }
         
         return rc;
@@ -3924,6 +4239,7 @@ namespace cw
     namespace pv_analysis
     {
       typedef struct dsp::pv_anl::obj_str<sample_t,fd_sample_t> pv_t;
+      typedef struct dsp::multi_ch_pv_anl::obj_str<sample_t,fd_sample_t> mc_pv_t;
 
       enum {
         kInPId,
@@ -3939,6 +4255,8 @@ namespace cw
       {
         pv_t**   pvA;       // pvA[ srcBuf.chN ]
         unsigned pvN;
+        mc_pv_t* mcpv;      // batched analysis used in place of pvA[] when all channels share the same parameters
+        unsigned* wndSmpNV; // wndSmpNV[ pvN ] requested window length per channel (batched analysis only)
         unsigned maxWndSmpN;
         unsigned wndSmpN;
         unsigned hopSmpN;
@@ -3973,40 +4291,67 @@ namespace cw
           unsigned maxBinNV[ srcBuf->chN ];
           unsigned binNV[ srcBuf->chN ];
           unsigned hopNV[ srcBuf->chN ];
+          unsigned maxWndNV[ srcBuf->chN ];
+          unsigned wndNV[ srcBuf->chN ];
+          bool     batchFl = srcBuf->chN > 1;
           
-          // create a pv anlaysis object for each input channel
           for(unsigned i=0; i<srcBuf->chN; ++i)
           {
-            
-            unsigned maxWndSmpN = 0;
-            unsigned wndSmpN = 0;
-            unsigned hopSmpN = 0;
             bool hzFl = false;
             
             if((rc = var_register_and_get( proc, i,
-                                           kMaxWndSmpNPId, "maxWndSmpN", kBaseSfxId, maxWndSmpN,
-                                           kWndSmpNPId, "wndSmpN",       kBaseSfxId, wndSmpN,
-                                           kHopSmpNPId, "hopSmpN",       kBaseSfxId, hopSmpN,
+                                           kMaxWndSmpNPId, "maxWndSmpN", kBaseSfxId, maxWndNV[i],
+                                           kWndSmpNPId, "wndSmpN",       kBaseSfxId, wndNV[i],
+                                           kHopSmpNPId, "hopSmpN",       kBaseSfxId, hopNV[i],
                                            kHzFlPId,    "hzFl",          kBaseSfxId, hzFl )) != kOkRC )
             {
               goto errLabel;
             }
-            
-            if((rc = create( inst->pvA[i], proc->ctx->framesPerCycle, srcBuf->srate, maxWndSmpN, wndSmpN, hopSmpN, flags )) != kOkRC )
+
+            // all channels must share the same parameters to be analyzed with a single batched FFT
+            if( maxWndNV[i] != maxWndNV[0] || wndNV[i] != wndNV[0] || hopNV[i] != hopNV[0] )
+              batchFl = false;
+          }
+
+          if( batchFl )
+          {
+            if((rc = create( inst->mcpv, srcBuf->chN, proc->ctx->framesPerCycle, srcBuf->srate, maxWndNV[0], wndNV[0], hopNV[0], flags )) != kOkRC )
             {
-              rc = proc_error(proc,kOpFailRC,"The PV analysis object create failed on the instance '%s'.",proc->label);
+              rc = proc_error(proc,kOpFailRC,"The multi-channel PV analysis object create failed on the instance '%s'.",proc->label);
               goto errLabel;
             }
 
-            maxBinNV[i] = inst->pvA[i]->maxBinCnt;
-            binNV[i] = inst->pvA[i]->binCnt;
-            hopNV[i] = hopSmpN;
+            inst->wndSmpNV = mem::allocZ<unsigned>( inst->pvN );
             
-            magV[i]  = inst->pvA[i]->magV;
-            phsV[i]  = inst->pvA[i]->phsV;
-            hzV[i]   = inst->pvA[i]->hzV;
+            for(unsigned i=0; i<srcBuf->chN; ++i)
+            {
+              inst->wndSmpNV[i] = wndNV[i];
+              maxBinNV[i] = inst->mcpv->maxBinCnt;
+              binNV[i]    = inst->mcpv->binCnt;
+              magV[i]     = dsp::multi_ch_pv_anl::magn(  inst->mcpv, i );
+              phsV[i]     = dsp::multi_ch_pv_anl::phase( inst->mcpv, i );
+              hzV[i]      = dsp::multi_ch_pv_anl::hz(    inst->mcpv, i );
+            }
           }
+          else
+          {
+            // create a pv anlaysis object for each input channel
+            for(unsigned i=0; i<srcBuf->chN; ++i)
+            {
+              if((rc = create( inst->pvA[i], proc->ctx->framesPerCycle, srcBuf->srate, maxWndNV[i], wndNV[i], hopNV[i], flags )) != kOkRC )
+              {
+                rc = proc_error(proc,kOpFailRC,"The PV analysis object create failed on the instance '%s'.",proc->label);
+                goto errLabel;
+              }
 
+              maxBinNV[i] = inst->pvA[i]->maxBinCnt;
+              binNV[i] = inst->pvA[i]->binCnt;
+            
+              magV[i]  = inst->pvA[i]->magV;
+              phsV[i]  = inst->pvA[i]->phsV;
+              hzV[i]   = inst->pvA[i]->hzV;
+            }
+          }
         
           // create the fbuf 'out'
           if((rc = var_register_and_set(proc, "out", kBaseSfxId, kOutPId, kAnyChIdx, srcBuf->srate, srcBuf->chN, maxBinNV, binNV, hopNV, magV, phsV, hzV )) != kOkRC )
@@ -4028,7 +4373,9 @@ namespace cw
         
         for(unsigned i=0; i<inst->pvN; ++i)
           destroy(inst->pvA[i]);
-        
+
+        destroy(inst->mcpv);
+        mem::release(inst->wndSmpNV);
         mem::release(inst->pvA);
         mem::release(inst);
         
@@ -4049,7 +4396,22 @@ namespace cw
           {
             case kWndSmpNPId:
               rc = var_get( var, val );
-              dsp::pv_anl::set_window_length(pva,val);
+              
+              if( inst->mcpv == nullptr )
+                dsp::pv_anl::set_window_length(pva,val);
+              else
+              {
+                // the batched analysis changes window length once all channels agree
+                inst->wndSmpNV[ var->chIdx ] = val;
+                
+                unsigned i = 1;
+                for(; i<inst->pvN; ++i)
+                  if( inst->wndSmpNV[i] != inst->wndSmpNV[0] )
+                    break;
+                
+                if( i == inst->pvN && val != inst->mcpv->wndSmpCnt )
+                  dsp::multi_ch_pv_anl::set_window_length(inst->mcpv,val);
+              }
               //printf("WL:%i %i\n",val,var->chIdx);
               break;              
           }
@@ -4095,6 +4457,25 @@ namespace cw
           fbuf_zero(dstBuf);
           vop::fill(dstBuf->readyFlV,dstBuf->chN,false);
         }
+        else if( inst->mcpv != nullptr )
+        {
+          const sample_t* xA[ srcBuf->chN ];
+          
+          for(unsigned i=0; i<srcBuf->chN; ++i)
+            xA[i] = srcBuf->buf + i*srcBuf->frameN;
+
+          // analyze all channels with one batched FFT
+          bool fl = dsp::multi_ch_pv_anl::exec( inst->mcpv, xA, srcBuf->frameN );
+          
+          for(unsigned i=0; i<srcBuf->chN; ++i)
+          {
+            // rescale the frequency domain magnitude
+            if( fl )
+              vop::mul(dstBuf->magV[i], dstBuf->binN_V[i]/2, dstBuf->binN_V[i]);
+            
+            dstBuf->readyFlV[i] = fl;
+          }
+        }
         else
         {
           // for each input channel
@@ -4133,6 +4514,7 @@ namespace cw
     namespace pv_synthesis
     {
       typedef struct dsp::pv_syn::obj_str<sample_t,fd_sample_t> pv_t;
+      typedef struct dsp::multi_ch_pv_syn::obj_str<sample_t,fd_sample_t> mc_pv_t;
 
       enum {
         kInPId,
@@ -4145,6 +4527,7 @@ namespace cw
       {
         pv_t**   pvA;     // pvA[ srcBuf.chN ]
         unsigned pvN;
+        mc_pv_t* mcpv;    // batched synthesis used in place of pvA[] when all channels share the same parameters
         unsigned wndSmpN; //  
         unsigned hopSmpN; //
         bool     hzFl;    //
@@ -4169,21 +4552,41 @@ namespace cw
         else
         {
 
+          bool batchFl = srcBuf->chN > 1;
+          
           // allocate pv channel array
           inst->pvN = srcBuf->chN;
           inst->pvA = mem::allocZ<pv_t*>( inst->pvN );  
 
-          // create a pv anlaysis object for each input channel
-          for(unsigned i=0; i<srcBuf->chN; ++i)
+          // all channels must share the same parameters to be synthesized with a single batched IFFT
+          for(unsigned i=1; i<srcBuf->chN; ++i)
+            if( srcBuf->binN_V[i] != srcBuf->binN_V[0] || srcBuf->hopSmpN_V[i] != srcBuf->hopSmpN_V[0] )
+              batchFl = false;
+
+          if( batchFl )
           {
-            unsigned wndSmpN = (srcBuf->binN_V[i]-1)*2;
+            unsigned wndSmpN = (srcBuf->binN_V[0]-1)*2;
             
-            if((rc = create( inst->pvA[i], proc->ctx->framesPerCycle, srcBuf->srate, wndSmpN, srcBuf->hopSmpN_V[i] )) != kOkRC )
+            if((rc = create( inst->mcpv, srcBuf->chN, proc->ctx->framesPerCycle, srcBuf->srate, wndSmpN, srcBuf->hopSmpN_V[0] )) != kOkRC )
             {
-              rc = proc_error(proc,kOpFailRC,"The PV synthesis object create failed on the instance '%s'.",proc->label);
+              rc = proc_error(proc,kOpFailRC,"The multi-channel PV synthesis object create failed on the instance '%s'.",proc->label);
               goto errLabel;
             }
           }
+          else
+          {
+            // create a pv anlaysis object for each input channel
+            for(unsigned i=0; i<srcBuf->chN; ++i)
+            {
+              unsigned wndSmpN = (srcBuf->binN_V[i]-1)*2;
+            
+              if((rc = create( inst->pvA[i], proc->ctx->framesPerCycle, srcBuf->srate, wndSmpN, srcBuf->hopSmpN_V[i] )) != kOkRC )
+              {
+                rc = proc_error(proc,kOpFailRC,"The PV synthesis object create failed on the instance '%s'.",proc->label);
+                goto errLabel;
+              }
+            }
+          }
 
           if((rc = var_register( proc, kAnyChIdx, kInPId, "in", kBaseSfxId)) != kOkRC )
             goto errLabel;
@@ -4203,7 +4606,8 @@ namespace cw
         inst_t* inst = (inst_t*)proc->userPtr;
         for(unsigned i=0; i<inst->pvN; ++i)
           destroy(inst->pvA[i]);
-        
+
+        destroy(inst->mcpv);
         mem::release(inst->pvA);
         mem::release(inst);
         
@@ -4240,6 +4644,18 @@ namespace cw
         {
           abuf_zero(dstBuf);
         }
+        else if( inst->mcpv != nullptr )
+        {
+          // synthesize the ready channels with one batched IFFT
+          dsp::multi_ch_pv_syn::exec( inst->mcpv, srcBuf->magV, srcBuf->phsV, srcBuf->readyFlV );
+
+          for(unsigned i=0; i<srcBuf->chN; ++i)
+          {
+            const sample_t* ola_out = dsp::multi_ch_pv_syn::execOut(inst->mcpv,i);
+            if( ola_out != nullptr )
+              abuf_set_channel( dstBuf, i, ola_out, inst->mcpv->procSmpCnt );
+          }
+        }
         else
         {
         
@@ -5192,6 +5608,170 @@ namespace cw
     }
     
  
+    //------------------------------------------------------------------------------------------------------------------
+    //
+    // convolve
+    //
+    namespace convolve
+    {
+      enum
+      {
+        kInPId,
+        kBypassPId,
+        kIrFnamePId,
+        kIrScalePId,
+        kTailFactPId,
+        kOutPId,
+      };
+
+      typedef dsp::part_convolve::obj_str<sample_t> conv_t;
+      
+      typedef struct
+      {
+        conv_t** convA;  // convA[ convN ] one convolver per input channel
+        unsigned convN;
+      } inst_t;
+    
+
+      rc_t create( proc_t* proc )
+      {
+        rc_t              rc        = kOkRC;
+        const abuf_t*     srcBuf    = nullptr;
+        const char*       ir_fname  = nullptr;
+        char*             fname     = nullptr;
+        coeff_t           ir_scale  = 1;
+        unsigned          tail_fact = 0;
+        float**           hChBuf    = nullptr;
+        unsigned          hChN      = 0;
+        unsigned          hFrmN     = 0;
+        audiofile::info_t info;
+        inst_t*           inst      = mem::allocZ<inst_t>();
+        
+        proc->userPtr = inst;
+
+        if((rc = var_register_and_get(proc, kAnyChIdx,
+                                      kInPId,       "in",        kBaseSfxId, srcBuf,
+                                      kIrFnamePId,  "ir_fname",  kBaseSfxId, ir_fname,
+                                      kIrScalePId,  "ir_scale",  kBaseSfxId, ir_scale,
+                                      kTailFactPId, "tail_fact", kBaseSfxId, tail_fact)) != kOkRC )
+        {
+          goto errLabel;
+        }
+
+        if((rc = var_register(proc, kAnyChIdx, kBypassPId, "bypass", kBaseSfxId)) != kOkRC )
+          goto errLabel;
+
+        if((fname = proc_expand_filename(proc,ir_fname)) == nullptr )
+        {
+          rc = proc_error(proc,kInvalidArgRC,"The impulse response filename could not be formed.");
+          goto errLabel;
+        }
+
+        // read the impulse response
+        if((rc = audiofile::allocFloatBuf(fname, hChBuf, hChN, hFrmN, info)) != kOkRC || hChN == 0 )
+        {
+          rc = proc_error(proc,kOpFailRC,"The impulse response file '%s' could not be read.",fname);
+          goto errLabel;
+        }
+
+        if( info.srate != srcBuf->srate )
+        {
+          rc = proc_error(proc,kInvalidArgRC,"The impulse response sample rate (%f) does not match the input sample rate (%f).",info.srate,srcBuf->srate);
+          goto errLabel;
+        }
+        
+        inst->convN = srcBuf->chN;
+        inst->convA = mem::allocZ<conv_t*>( inst->convN );
+
+        // the IR channels are assigned to the input channels in rotation
+        for(unsigned i=0; i<inst->convN; ++i)
+          if((rc = dsp::part_convolve::create( inst->convA[i], (const sample_t*)hChBuf[ i % hChN ], hFrmN, srcBuf->frameN, ir_scale, tail_fact )) != kOkRC )
+          {
+            rc = proc_error(proc,kOpFailRC,"The convolver create failed on channel %i.",i);
+            goto errLabel;
+          }
+
+        proc_info(proc,"IR:'%s' chs:%i frames:%i %f seconds.",fname,hChN,hFrmN,hFrmN/info.srate);
+        
+        // create the output audio buffer
+        if((rc = var_register_and_set( proc, "out", kBaseSfxId, kOutPId, kAnyChIdx, srcBuf->srate, srcBuf->chN, srcBuf->frameN )) != kOkRC )
+          goto errLabel;
+        
+      errLabel:
+        audiofile::freeFloatBuf(hChBuf,hChN);
+        mem::release(fname);
+        return rc;
+      }
+
+      rc_t destroy( proc_t* proc )
+      {
+        rc_t rc = kOkRC;
+
+        inst_t* inst = (inst_t*)proc->userPtr;
+        for(unsigned i=0; i<inst->convN; ++i)
+          dsp::part_convolve::destroy(inst->convA[i]);
+        
+        mem::release(inst->convA);
+        mem::release(inst);
+        
+        return rc;
+      }
+      
+      rc_t notify( proc_t* proc, variable_t* var )
+      {
+        return kOkRC;
+      }
+
+      rc_t exec( proc_t* proc )
+      {
+        rc_t          rc     = kOkRC;
+        inst_t*       inst   = (inst_t*)proc->userPtr;
+        const abuf_t* srcBuf = nullptr;
+        abuf_t*       dstBuf = nullptr;
+        unsigned      chN    = 0;
+        
+        if((rc = var_get(proc,kInPId, kAnyChIdx, srcBuf )) != kOkRC )
+          goto errLabel;
+
+        if((rc = var_get(proc,kOutPId, kAnyChIdx, dstBuf)) != kOkRC )
+          goto errLabel;
+
+        chN = std::min(srcBuf->chN,inst->convN);
+       
+        for(unsigned i=0; i<chN; ++i)
+        {
+          conv_t* c = inst->convA[i];
+          dsp::part_convolve::exec( c, srcBuf->buf + i*srcBuf->frameN, srcBuf->frameN );
+          vop::copy( dstBuf->buf + i*dstBuf->frameN, (const sample_t*)c->outV, c->outN );
+        }
+
+      errLabel:
+        return rc;
+      }
+
+      rc_t report( proc_t* proc )
+      {
+        inst_t* inst = (inst_t*)proc->userPtr;
+        for(unsigned i=0; i<inst->convN; ++i)
+        {
+          conv_t* c = inst->convA[i];
+          proc_info(proc,"%s ch:%i : head:%i x %i tail:%i x %i",
+                    proc->label,i,c->head.pN,c->head.partN,c->tail.pN,c->tail.partN );
+        }
+        
+        return kOkRC;
+      }
+
+      class_members_t members = {
+        .create  = create,
+        .destroy = destroy,
+        .notify  = notify,
+        .exec    = exec,
+        .report  = report
+      };      
+    }
+    
+ 
     //------------------------------------------------------------------------------------------------------------------
     //
     // audio_meter
@@ -6295,6 +6875,8 @@ namespace cw
 
         bool isSustainDownFl;
         bool heldByPedalFl;
+
+        var_plan_t plan;
         
       } inst_t;
 
@@ -6338,6 +6920,8 @@ namespace cw
           p->hzA[i] = midi::midiToHz(i);
 
         p->done_fl = true;
+
+        rc = var_plan_create(proc,p->plan);
         
       errLabel:
         return rc;
@@ -6349,6 +6933,7 @@ namespace cw
 
         mem::release(p->wtAllocA);
         mem::release(p->hzA);
+        var_plan_destroy(p->plan);
 
         return rc;
       }
@@ -6383,19 +6968,19 @@ namespace cw
         bool    print_fl = false;
 
         // get the input MIDI buffer
-        if((rc = var_get(proc,kInPId,kAnyChIdx,mbuf)) != kOkRC )
+        if((rc = var_plan_get(p->plan,kInPId,kAnyChIdx,mbuf)) != kOkRC )
           goto errLabel;
         
         // get the output audio buffer
-        if((rc = var_get(proc,kOutPId,kAnyChIdx,abuf)) != kOkRC )
+        if((rc = var_plan_get(p->plan,kOutPId,kAnyChIdx,abuf)) != kOkRC )
           goto errLabel;
 
-        var_get(proc,kPrintFlPId,kAnyChIdx,print_fl);
+        var_plan_get(p->plan,kPrintFlPId,kAnyChIdx,print_fl);
 
         // if there are MIDI messages - update cur_hz and cur_vel
         for(unsigned i=0; i<mbuf->msgN; ++i)
         {
-          const midi::ch_msg_t* m = mbuf->msgA + i;
+          const midi::ch_msg_t* m = mbuf_msg(mbuf,i);
           
           if( print_fl )
             proc_info(proc,"%2i 0x%2x %3i %3i : %s:%i\n",m->ch, m->status, m->d0, m->d1, cwStringNullGuard(proc->label),proc->label_sfx_id);
@@ -6414,7 +6999,7 @@ namespace cw
                 p->gain = (coeff_t)p->cur_vel / 127;
                 p->gain_coeff = 1.0;
                 p->gain_thresh = 0.001;
-                var_set(proc,kDoneFlPId,kAnyChIdx,false);
+                var_plan_set(p->plan,kDoneFlPId,kAnyChIdx,false);
                 
                 //printf("NO: %i\n",proc->label_sfx_id);
               }
@@ -6470,11 +7055,15 @@ namespace cw
           
           if( p->gain < p->gain_thresh )
           {
-            var_set(proc,kDoneFlPId,kAnyChIdx,true);
+            var_plan_set(p->plan,kDoneFlPId,kAnyChIdx,true);
             p->done_fl = true;
           }
           
         }
+
+        // inform the voice network that this voice is sounding
+        if( !p->done_fl )
+          proc_report_activity(proc);
         
       errLabel:
             return rc;
@@ -6554,6 +7143,8 @@ namespace cw
         unsigned rms_buf_cnt;
 
         unsigned age_idx;
+
+        var_plan_t plan;
         
       } inst_t;
 
@@ -6703,6 +7294,8 @@ namespace cw
 
         TRACE_REG(proc->label,proc->label_sfx_id,proc->trace_id);
 
+        rc = var_plan_create(proc,p->plan);
+
       errLabel:
         
         return rc;
@@ -6736,8 +7329,8 @@ namespace cw
         p->rms_buf_cnt    = 0;
         p->age_idx        = 0;
 
-        var_set(proc,kDoneFlPId,kAnyChIdx,false);
-        var_set(proc,kGateFlPId,kAnyChIdx,true);
+        var_plan_set(p->plan,kDoneFlPId,kAnyChIdx,false);
+        var_plan_set(p->plan,kGateFlPId,kAnyChIdx,true);
 
         TRACE_TIME(proc->trace_id,tracer::kBegEvtId,0,0);
 
@@ -6840,6 +7433,7 @@ namespace cw
 
         destroy(&p->osc);
         mem::release(p->test_pitch_map);
+        var_plan_destroy(p->plan);
 
         return rc;
       }
@@ -6847,8 +7441,8 @@ namespace cw
       void _finish_note( proc_t* proc, inst_t* p )
       {
         p->done_fl = true;
-        var_set(proc,kDoneFlPId,kAnyChIdx,true);
-        var_set(proc,kGateFlPId,kAnyChIdx,false);        
+        var_plan_set(p->plan,kDoneFlPId,kAnyChIdx,true);
+        var_plan_set(p->plan,kGateFlPId,kAnyChIdx,false);        
         _store_note_state(proc, p, 0, 0, p->pitch, 0);
         p->gain_coeff = 0.0;  //
         TRACE_TIME(proc->trace_id,tracer::kEndEvtId,0,0);
@@ -6896,13 +7490,13 @@ namespace cw
         //sample_t rms = 0;
 
         // get the input MIDI buffer
-        if((rc = var_get(proc,kInPId,kAnyChIdx,mbuf)) != kOkRC )
+        if((rc = var_plan_get(p->plan,kInPId,kAnyChIdx,mbuf)) != kOkRC )
         {
           goto errLabel;
         }
         
         // get the output audio buffer
-        if((rc = var_get(proc,kOutPId,kAnyChIdx,abuf)) != kOkRC )
+        if((rc = var_plan_get(p->plan,kOutPId,kAnyChIdx,abuf)) != kOkRC )
         {
           goto errLabel;
         }
@@ -6910,7 +7504,7 @@ namespace cw
         // if there are MIDI messages - update the wavetable oscillators
         for(unsigned i=0; i<mbuf->msgN; ++i)
         {
-          const midi::ch_msg_t* m = mbuf->msgA + i;
+          const midi::ch_msg_t* m = mbuf_msg(mbuf,i);
 
           //printf("pv: 0x%x %i %i\n",m->status,m->d0,m->d1);
           
@@ -6980,6 +7574,10 @@ namespace cw
           _finish_note(proc,p);
         }
 
+        // inform the voice network that this voice is sounding
+        if( !p->done_fl )
+          proc_report_activity(proc);
+
       errLabel:
         return rc;
       }
@@ -7165,6 +7763,7 @@ namespace cw
         unsigned inAudioVarCnt;
         unsigned gainVarCnt;
         unsigned baseGainPId;
+        var_plan_t plan;
       } inst_t;
 
 
@@ -7242,7 +7841,10 @@ namespace cw
           
         }
 
-        rc = var_register_and_set( proc, "out", kBaseSfxId, kOutPId, kAnyChIdx, srate, inAudioChCnt, audioFrameN );
+        if((rc = var_register_and_set( proc, "out", kBaseSfxId, kOutPId, kAnyChIdx, srate, inAudioChCnt, audioFrameN )) != kOkRC )
+          goto errLabel;
+
+        rc = var_plan_create(proc,p->plan);
 
       errLabel:
         return rc;
@@ -7250,6 +7852,7 @@ namespace cw
 
       rc_t _destroy( proc_t* proc, inst_t* p )
       {
+        var_plan_destroy(p->plan);
         return kOkRC;
       }
 
@@ -7285,11 +7888,11 @@ namespace cw
         coeff_t       ogain   = 1;
 
         // get the output audio buffer
-        if((rc = var_get(proc,kOutPId, kAnyChIdx, obuf)) != kOkRC )
+        if((rc = var_plan_get(p->plan,kOutPId, kAnyChIdx, obuf)) != kOkRC )
           goto errLabel;
 
         // get the output audio gain
-        if((rc = var_get(proc,kOutGainPId, kAnyChIdx, ogain)) != kOkRC )
+        if((rc = var_plan_get(p->plan,kOutGainPId, kAnyChIdx, ogain)) != kOkRC )
           goto errLabel;
 
         // for each audio input variable
@@ -7298,12 +7901,12 @@ namespace cw
           const abuf_t* ibuf = nullptr;
 
           // get the input audio buffer
-          if((rc = var_get(proc,kInBasePId+i, kAnyChIdx, ibuf )) != kOkRC )
+          if((rc = var_plan_get(p->plan,kInBasePId+i, kAnyChIdx, ibuf )) != kOkRC )
             goto errLabel;
 
           // get the input gain
           if( i < p->gainVarCnt )
-            var_get(proc,p->baseGainPId+i,kAnyChIdx,igain);
+            var_plan_get(p->plan,p->baseGainPId+i,kAnyChIdx,igain);
 
           // merge the input audio signal into the output audio buffer
           oChIdx = _merge_in_one_audio_var( proc, ibuf, obuf, oChIdx, igain * ogain );
@@ -7553,6 +8156,7 @@ namespace cw
         unsigned inVarN;
         unsigned store_vid;
         bool     send_fl;
+        var_plan_t plan;
       } inst_t;
 
       rc_t _create( proc_t* proc, inst_t* p )
@@ -7644,13 +8248,18 @@ namespace cw
         
 
         p->store_vid = kInvalidId;
+
+        rc = var_plan_create(proc,p->plan);
         
       errLabel:
         return rc;
       }
 
       rc_t _destroy( proc_t* proc, inst_t* p )
-      { return kOkRC; }
+      {
+        var_plan_destroy(p->plan);
+        return kOkRC;
+      }
 
       rc_t _notify( proc_t* proc, inst_t* p, variable_t* var )
       {
@@ -7684,14 +8293,14 @@ namespace cw
 
         if( p->store_vid != kInvalidIdx )
         {
-          variable_t* var = nullptr;
+          variable_t* var = var_plan_var(p->plan, p->store_vid );
           
           // Note that we set the 'value' directly from var->value so that
           // no extra type converersion is applied. In this case the value
           // 'store'  will be coerced to the type of 'value'
-          if((rc = var_find(proc, p->store_vid, kAnyChIdx, var )) == kOkRC && var->value != nullptr /*&& is_connected_to_source(var)*/ )
+          if( var != nullptr && var->value != nullptr /*&& is_connected_to_source(var)*/ )
           {
-            rc = var_set(proc,kOutPId,var->value);
+            rc = var_plan_set(p->plan,kOutPId,var->value);
           }
 
           p->store_vid = kInvalidIdx;
@@ -7803,7 +8412,7 @@ namespace cw
           goto errLabel;
         }
           
-        if((rc = objectFromFile( fn, cfg )) != kOkRC )
+        if((rc = proc_object_from_file(proc,fn,cfg)) != kOkRC )
         {
           rc = proc_error(proc,rc,"Unable to parse msg table from '%s'.",cwStringNullGuard(fn));
           goto errLabel;
@@ -8972,7 +9581,7 @@ namespace cw
  
           }
           
-          if((rc = objectFromFile(exp_cfg_fname,p->file_list)) != kOkRC )
+          if((rc = proc_object_from_file(proc,exp_cfg_fname,p->file_list)) != kOkRC )
           {
             rc = proc_error(proc,rc,"The list configuration file '%s' could not be parsed.",cwStringNullGuard(exp_cfg_fname));
             goto errLabel;
@@ -10132,7 +10741,9 @@ namespace cw
         kOutChPId,
         kOutStatusPId,
         kOutD0PId,
-        kOutD1PId
+        kOutD1PId,
+        kBufCntPId,
+        kOutPId
       };
       
       typedef struct
@@ -10141,6 +10752,9 @@ namespace cw
         unsigned sel_status;
         unsigned sel_d0;
         unsigned sel_d1;
+
+        unsigned* idxA;  // idxA[ idxN ] index view of the selected 'in' messages
+        unsigned  idxN;
       } inst_t;
 
 
@@ -10170,7 +10784,18 @@ namespace cw
           goto errLabel;
         }
                               
-                              
+        if((rc = var_register_and_get(proc,kAnyChIdx,kBufCntPId,"buf_cnt",kBaseSfxId,p->idxN)) != kOkRC )
+        {
+          goto errLabel;
+        }
+
+        // create the output MIDI buffer
+        if((rc = var_register_and_set( proc, "out", kBaseSfxId, kOutPId, kAnyChIdx, nullptr, 0  )) != kOkRC )
+        {
+          goto errLabel;
+        }
+
+        p->idxA = mem::allocZ<unsigned>(p->idxN);
         
       errLabel:
         return rc;
@@ -10179,6 +10804,7 @@ namespace cw
       rc_t _destroy( proc_t* proc, inst_t* p )
       {
         rc_t rc = kOkRC;
+        mem::release(p->idxA);
         return rc;
       }
 
@@ -10213,15 +10839,21 @@ namespace cw
 
       rc_t _exec( proc_t* proc, inst_t* p )
       {
-        rc_t rc      = kOkRC;
-        const mbuf_t* mbuf;
+        rc_t          rc       = kOkRC;
+        const mbuf_t* mbuf     = nullptr;
+        mbuf_t*       out_mbuf = nullptr;
+        unsigned      j        = 0;
+        unsigned      dropN    = 0;
 
         if( var_get(proc,kInPId,kAnyChIdx,mbuf) != kOkRC )
           goto errLabel;
 
+        if( var_get(proc,kOutPId,kAnyChIdx,out_mbuf) != kOkRC )
+          goto errLabel;
+
         for(unsigned i=0; i<mbuf->msgN; ++i)
         {
-          const midi::ch_msg_t* m = mbuf->msgA + i;
+          const midi::ch_msg_t* m = mbuf_msg(mbuf,i);
           
           if( p->sel_status != kInvalidId && m->status != p->sel_status )
             continue;
@@ -10240,7 +10872,20 @@ namespace cw
           var_set(proc,kOutD0PId,kAnyChIdx,m->d0);
           var_set(proc,kOutD1PId,kAnyChIdx,m->d1);
           //printf("SELECT: %i %i %i %i\n",m->ch,m->status,m->d0,m->d1);
+
+          // the output indexes refer to the same msg array as the input so that chained selections are not copied
+          if( j < p->idxN )
+            p->idxA[j++] = mbuf_msg_index(mbuf,i);
+          else
+            dropN += 1;
         }
+
+        if( dropN > 0 )
+          proc_warn(proc,"The MIDI select buffer is full. %i messages were dropped. (buf_cnt:%i)",dropN,p->idxN);
+
+        out_mbuf->msgA = j > 0 ? mbuf->msgA : nullptr;
+        out_mbuf->msgN = j;
+        out_mbuf->idxA = j > 0 ? p->idxA : nullptr;
         
       errLabel:
         return rc;
@@ -10334,10 +10979,11 @@ namespace cw
         
         for(unsigned i=0; i<mbuf->msgN; ++i)
         {
-          var_set(proc, kChPId,     kAnyChIdx, mbuf->msgA[i].ch);
-          var_set(proc, kStatusPId, kAnyChIdx, mbuf->msgA[i].status);
-          var_set(proc, kD0PId,     kAnyChIdx, mbuf->msgA[i].d0);
-          var_set(proc, kD1PId,     kAnyChIdx, mbuf->msgA[i].d1);
+          const midi::ch_msg_t* m = mbuf_msg(mbuf,i);
+          var_set(proc, kChPId,     kAnyChIdx, m->ch);
+          var_set(proc, kStatusPId, kAnyChIdx, m->status);
+          var_set(proc, kD0PId,     kAnyChIdx, m->d0);
+          var_set(proc, kD1PId,     kAnyChIdx, m->d1);
         }
         
       errLabel:
@@ -10990,7 +11636,7 @@ namespace cw
           }
 
           // load and parse the cfg. file.
-          if((rc = objectFromFile(fn,p->cfg)) != kOkRC )
+          if((rc = proc_object_from_file(proc,fn,p->cfg)) != kOkRC )
           {
             rc = proc_error(proc,kOpFailRC,"The cfg. file '%s' could not be parsed.",cwStringNullGuard(fn));
             goto errLabel;
@@ -11163,6 +11809,9 @@ namespace cw
         unsigned       sel_fld_idx;
         recd_array_t** recd_arrayA; // recd_arrayA[ outVarN ] - one record array per output variable
         recd_type_t*   recd_type;
+        
+        recd_layout_t*            i_layout; // layout of the incoming record
+        recd_accessor_t<unsigned> sel_acc;  // selection field accessor
       } inst_t;
 
       
@@ -11235,7 +11884,17 @@ namespace cw
           {
             rc = proc_warn(proc,"The incoming record does not have a field named '%s'. The selection field has been diabled.",cwStringNullGuard(sel_field_label));
             p->sel_fld_idx = kInvalidIdx;
-          }         
+          }
+          else
+          {
+            // resolve the location of the selection field once
+            if((rc = recd_layout_create(p->i_layout,i_rbuf->type)) != kOkRC
+               || (rc = recd_accessor_create(p->i_layout,p->sel_fld_idx,p->sel_acc)) != kOkRC )
+            {
+              rc = proc_error(proc,rc,"The selection field accessor create failed.");
+              goto errLabel;
+            }
+          }
         }
 
         
@@ -11253,6 +11912,7 @@ namespace cw
             recd_array_destroy(p->outVarA[i].recd_array);
         mem::release(p->outVarA);
         recd_type_destroy(p->recd_type);
+        recd_layout_destroy(p->i_layout);
         
         return rc;
       }
@@ -11292,7 +11952,7 @@ namespace cw
 
           // if a selector field index was given then get the associated value 
           if( p->sel_fld_idx != kInvalidIdx )
-            recd_get(i_rbuf->type,i_r, p->sel_fld_idx, ovar_idx);
+            recd_read(p->sel_acc, i_r, ovar_idx);
 
           // if the output variable index is not valid then skip this record
           if( ovar_idx == kInvalidIdx )
@@ -11527,6 +12187,8 @@ namespace cw
         unsigned  field_indexN;
         unsigned* i_field_indexA;
         unsigned* o_field_indexA;
+
+        recd_layout_t* i_layout; // layout of the incoming record
       } inst_t;
 
       rc_t _create_field_index_array(proc_t* proc, inst_t* p, const rbuf_t* i_rbuf )
@@ -11595,6 +12257,13 @@ namespace cw
           goto errLabel;
         }
 
+        // resolve the location of the incoming fields once
+        if((rc = recd_layout_create(p->i_layout,i_rbuf->type)) != kOkRC )
+        {
+          rc = proc_error(proc,rc,"The input record layout create failed on '%s'.",cwStringNullGuard(proc->label));
+          goto errLabel;
+        }
+
 
         if((rc = recd_array_create( p->recd_array, p->recd_fmt->recd_type, nullptr,  p->recd_fmt->alloc_cnt )) != kOkRC )
         {
@@ -11617,6 +12286,9 @@ namespace cw
         rc_t rc = kOkRC;
 
         recd_array_destroy(p->recd_array);
+        recd_layout_destroy(p->i_layout);
+        mem::release(p->i_field_indexA);
+        mem::release(p->o_field_indexA);
         //recd_type_destroy(p->recd_fmt);
 
         return rc;
@@ -11642,28 +12314,32 @@ namespace cw
 
         o_rbuf->recdN = 0;
 
+        if( i_rbuf->recdN > p->recd_array->allocRecdN )
+        {
+          rc = proc_error(proc,kBufTooSmallRC,"The incoming record count (%i) is greater than the output record buffer size (%i) in '%s'.",i_rbuf->recdN,p->recd_array->allocRecdN,cwStringNullGuard(proc->label));
+          goto errLabel;
+        }
+        
         for(unsigned i=0; i<i_rbuf->recdN; ++i)
         {
+          recd_t* o_r = p->recd_array->recdA + i;
+          
+          o_r->base = nullptr;
+          
           for(unsigned j=0; j<p->field_indexN; ++j)
           {
-            value_t v = {};
-
             // get the field value from the incoming record
-            if((rc = recd_get_value( i_rbuf->type, i_rbuf->recdA+i, p->i_field_indexA[j], v)) != kOkRC )
-            {
-              rc = proc_error(proc,rc,"Unable to get the input record field '%s' in '%s'.",cwStringNullGuard(recd_type_field_index_to_label(i_rbuf->type,p->i_field_indexA[j])),cwStringNullGuard(proc->label));
-              goto errLabel;
-            }
+            const value_t* v = recd_layout_value( p->i_layout->fieldA + p->i_field_indexA[j], i_rbuf->recdA + i );
             
             // set the field in the outgoing recd
-            if((rc = recd_set_value( o_rbuf->type, nullptr, p->recd_array->recdA + i, p->o_field_indexA[j], v)) != kOkRC )
+            if((rc = value_from_value( *v, o_r->valA[ p->o_field_indexA[j] ] )) != kOkRC )
             {
-              rc = proc_error(proc,rc,"Unable to get the input record field '%s' in '%s'.",cwStringNullGuard(recd_type_field_index_to_label(o_rbuf->type,p->o_field_indexA[j])),cwStringNullGuard(proc->label));
+              rc = proc_error(proc,rc,"Unable to set the output record field '%s' in '%s'.",cwStringNullGuard(recd_type_field_index_to_label(o_rbuf->type,p->o_field_indexA[j])),cwStringNullGuard(proc->label));
               goto errLabel;
             }
-
-            o_rbuf->recdN += 1;
           }
+          
+          o_rbuf->recdN += 1;
         }
         
       errLabel:
@@ -11934,26 +12610,44 @@ namespace cw
             // no midi events arrived
             out_mbuf->msgA = nullptr;
             out_mbuf->msgN = 0;
+            out_mbuf->idxA = nullptr;
             break;
             
           case 1:
-            // exactly one full midi buffer was found
+            // exactly one full midi buffer was found - pass on a view of it
             out_mbuf->msgA = mbufA[0]->msgA;
             out_mbuf->msgN = mbufA[0]->msgN;
+            out_mbuf->idxA = mbufA[0]->idxA;
             break;
             
           default:
             // multiple full midi buffers were found
             {
               unsigned i,j,k;
+              bool     sorted_fl = true;
               for(i=0,j=0; i<mbufN && j<p->msgN; ++i)
-                for(k=0; j<p->msgN && k<mbufA[i]->msgN; ++k)
-                  p->msgA[j++] = mbufA[i]->msgA[k];
+                for(k=0; j<p->msgN && k<mbufA[i]->msgN; ++k,++j)
+                {
+                  p->msgA[j] = *mbuf_msg(mbufA[i],k);
+                  
+                  if( j>0 && !time::isLTE(p->msgA[j-1].timeStamp,p->msgA[j].timeStamp) )
+                    sorted_fl = false;
+                }
 
-              std::sort(p->msgA, p->msgA + j, [](const midi::ch_msg_t& a, const midi::ch_msg_t& b){ return time::isLTE(a.timeStamp,b.timeStamp); } );
+              for(i=0,k=0; i<mbufN; ++i)
+                k += mbufA[i]->msgN;
               
+              if( k > j )
+                proc_warn(proc,"The MIDI merge buffer is full. %i messages were dropped.",k-j);
+
+              // the input buffers are usually already in time order
+              if( !sorted_fl )
+                std::stable_sort(p->msgA, p->msgA + j, [](const midi::ch_msg_t& a, const midi::ch_msg_t& b){ return time::isLT(a.timeStamp,b.timeStamp); } );
+
+              p->msg_idx     = j;
               out_mbuf->msgA = p->msg_idx > 0 ? p->msgA : nullptr;
               out_mbuf->msgN = p->msg_idx;          
+              out_mbuf->idxA = nullptr;
             }
         }
         
@@ -12195,7 +12889,7 @@ namespace cw
 
           // for each received note-on msg set the output var of the associated output channel
           for(unsigned j=0; j<mbuf->msgN; ++j)
-            if( midi::isNoteOn(mbuf->msgA[j].status,mbuf->msgA[j].d1) )
+            if( midi::isNoteOn(mbuf_msg(mbuf,j)->status,mbuf_msg(mbuf,j)->d1) )
             {
               p->inVarA[i].out_idx          = p->out_idx;
               p->outVarA[ p->out_idx ].cnt += 1;
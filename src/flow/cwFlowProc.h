@@ -35,6 +35,10 @@ namespace cw
     template< typename inst_t >
     rc_t std_report( proc_t* proc )
     { return _report(proc,(inst_t*)proc->userPtr); }
+
+    template< typename inst_t >
+    rc_t std_linear( proc_t* proc, linear_term_t* termA, unsigned termAllocN, unsigned& termN_ref )
+    { return _linear(proc,(inst_t*)proc->userPtr,termA,termAllocN,termN_ref); }
     
     namespace user_def_proc   { extern class_members_t members;  }
     namespace poly            { extern class_members_t members;  }
@@ -45,12 +49,12 @@ namespace cw
     namespace audio_file_in   { extern class_members_t members;  }
     namespace audio_file_out  { extern class_members_t members;  }
     namespace audio_buf_file_out { extern class_members_t members; }
-    namespace audio_gain      { extern class_members_t members;  }
+    namespace audio_gain      { extern class_members_t members; rc_t linear( proc_t* proc, linear_term_t* termA, unsigned termAllocN, unsigned& termN_ref ); }
     namespace audio_xfade     { extern class_members_t members;  }
-    namespace audio_split     { extern class_members_t members;  }
+    namespace audio_split     { extern class_members_t members; rc_t linear( proc_t* proc, linear_term_t* termA, unsigned termAllocN, unsigned& termN_ref ); }
     namespace audio_merge     { extern class_members_t members;  }
     namespace audio_duplicate { extern class_members_t members;  }
-    namespace audio_mix       { extern class_members_t members;  }
+    namespace audio_mix       { extern class_members_t members; rc_t linear( proc_t* proc, linear_term_t* termA, unsigned termAllocN, unsigned& termN_ref ); }
     namespace audio_marker    { extern class_members_t members;  }
     namespace audio_silence   { extern class_members_t members;  }
     namespace audio_pass      { extern class_members_t members;  }
@@ -62,6 +66,7 @@ namespace cw
     namespace limiter         { extern class_members_t members;  }
     namespace audio_delay     { extern class_members_t members;  }
     namespace dc_filter       { extern class_members_t members;  }
+    namespace convolve        { extern class_members_t members;  }
     namespace balance         { extern class_members_t members;  }
     namespace audio_meter     { extern class_members_t members;  }
     namespace audio_marker    { extern class_members_t members;  }
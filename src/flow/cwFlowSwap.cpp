@@ -0,0 +1,306 @@
+//| Copyright: (C) 2020-2024 Kevin Larke <contact AT larke DOT org>
+//| License: GNU GPL version 3.0 or above. See the accompanying LICENSE file.
+#include "cwCommon.h"
+#include "cwLog.h"
+#include "cwCommonImpl.h"
+#include "cwTest.h"
+#include "cwMem.h"
+#include "cwText.h"
+#include "cwObject.h"
+#include "cwTime.h"
+#include "cwThread.h"
+#include "cwVectOps.h"
+#include "cwMtx.h"
+#include "cwMidiDecls.h"
+#include "cwDspTypes.h"
+#include "cwFlowDecl.h"
+#include "cwFlow.h"
+#include "cwFlowValue.h"
+#include "cwFlowSwap.h"
+
+namespace cw
+{
+  namespace flow
+  {
+    namespace swap
+    {
+      void _xfade_buf_release( swap_t& s )
+      {
+        if( s.xfadeBufA != nullptr )
+          for(unsigned i=0; i<s.args.oBufN; ++i)
+            mem::release(s.xfadeBufA[i]);
+
+        mem::release(s.xfadeBufA);
+        mem::release(s.args.oBufA);
+        s.args.oBufN = 0;
+      }
+
+      // Create, initialize and pre-warm the next program. Called on the swap thread.
+      bool _thread_func( void* arg )
+      {
+        rc_t    rc = kOkRC;
+        swap_t* s  = (swap_t*)arg;
+
+        if((rc = create( s->nextFlowH,
+                         s->args.proc_class_cfg,
+                         s->args.pgm_cfg,
+                         s->args.udp_cfg,
+                         s->args.proj_dir,
+                         s->args.ui_callback,
+                         s->args.ui_callback_arg)) != kOkRC )
+        {
+          rc = cwLogError(rc,"Network configuration failed.");
+          goto errLabel;
+        }
+
+        // the audio devices cannot be reconfigured without interrupting the audio
+        if( is_non_real_time(s->nextFlowH) || sample_rate(s->nextFlowH) != sample_rate(s->curFlowH) || frames_per_cycle(s->nextFlowH) != frames_per_cycle(s->curFlowH) )
+        {
+          rc = cwLogError(kInvalidArgRC,"The next program must be real-time and have the same sample rate and frames per cycle as the current program.");
+          goto errLabel;
+        }
+
+        if((rc = initialize( s->nextFlowH, s->args.deviceA, s->args.deviceN, s->args.preset_idx )) != kOkRC )
+        {
+          rc = cwLogError(rc,"Network create failed.");
+          goto errLabel;
+        }
+
+        if((rc = prewarm( s->nextFlowH )) != kOkRC )
+          goto errLabel;
+
+      errLabel:
+        if( rc != kOkRC )
+        {
+          cwLogError(rc,"The next program could not be prepared for swapping.");
+          destroy(s->nextFlowH);
+        }
+
+        s->state.store( rc==kOkRC ? kReadyStateId : kFailStateId, std::memory_order_release );
+
+        // the thread exits after one call
+        return false;
+      }
+
+      // Save the output of the outgoing program and clear the output buffers for the incoming program.
+      void _xfade_save_output( swap_t& s )
+      {
+        for(unsigned i=0; i<s.args.oBufN; ++i)
+        {
+          abuf_t* abuf = s.args.oBufA[i];
+          unsigned n   = abuf->chN * abuf->frameN;
+
+          memcpy(s.xfadeBufA[i],abuf->buf,n*sizeof(sample_t));
+          memset(abuf->buf,0,n*sizeof(sample_t));
+        }
+      }
+
+      // Mix the output of the outgoing program into the output of the incoming program
+      // with a linear crossfade.
+      void _xfade_mix_output( swap_t& s )
+      {
+        for(unsigned i=0; i<s.args.oBufN; ++i)
+        {
+          abuf_t*  abuf   = s.args.oBufA[i];
+          unsigned frameN = abuf->frameN;
+
+          for(unsigned ch=0; ch<abuf->chN; ++ch)
+          {
+            const sample_t* x0 = s.xfadeBufA[i] + ch*frameN;
+            sample_t*       x1 = abuf->buf      + ch*frameN;
+
+            for(unsigned j=0; j<frameN; ++j)
+            {
+              unsigned k = std::min(s.xfadeFrameIdx + j, s.args.xfadeFrameN);
+              sample_t g = (sample_t)k / s.args.xfadeFrameN;
+              x1[j] = g*x1[j] + (1-g)*x0[j];
+            }
+          }
+        }
+      }
+
+      // Adopt the next program and release the outgoing program once the audio thread is
+      // no longer executing it.
+      rc_t _finish( swap_t& s, handle_t& flowH_ref )
+      {
+        rc_t rc = kOkRC;
+
+        if((rc = thread::destroy(s.threadH)) != kOkRC )
+          goto errLabel;
+
+        flowH_ref = s.nextFlowH;
+
+        // the audio thread executes 'flowH_ref' once the state returns to idle
+        s.state.store(kIdleStateId,std::memory_order_release);
+
+        if((rc = destroy(s.curFlowH)) != kOkRC )
+          rc = cwLogError(rc,"The outgoing program destroy failed.");
+
+        _xfade_buf_release(s);
+
+      errLabel:
+        return rc;
+      }
+    }
+  }
+}
+
+cw::rc_t cw::flow::swap::begin( swap_t& s, handle_t curFlowH, const args_t& args )
+{
+  rc_t rc = kOkRC;
+
+  if( s.state.load(std::memory_order_acquire) != kIdleStateId )
+    return cwLogError(kInvalidStateRC,"A program swap is already in progress.");
+
+  s.args          = args;
+  s.curFlowH      = curFlowH;
+  s.nextFlowH     = handle_t();
+  s.xfadeFrameIdx = 0;
+
+  // the output buffers are copied because the caller's array need not outlive this call
+  s.args.oBufA = mem::allocZ<abuf_t*>(args.oBufN);
+  s.xfadeBufA  = mem::allocZ<sample_t*>(args.oBufN);
+
+  for(unsigned i=0; i<args.oBufN; ++i)
+  {
+    s.args.oBufA[i] = args.oBufA[i];
+    s.xfadeBufA[i]  = mem::allocZ<sample_t>( args.oBufA[i]->chN * args.oBufA[i]->frameN );
+  }
+
+  // create the next program on a background thread
+  if((rc = thread::create(s.threadH,_thread_func,&s,"flow_swap")) != kOkRC )
+  {
+    rc = cwLogError(rc,"The program swap thread create failed.");
+    goto errLabel;
+  }
+
+  s.state.store(kBuildStateId,std::memory_order_release);
+
+  // don't wait for the 'running' state because the thread may exit before the state is observed
+  if((rc = thread::pause(s.threadH,0)) != kOkRC )
+  {
+    rc = cwLogError(rc,"The program swap thread start failed.");
+    goto errLabel;
+  }
+
+errLabel:
+  if( rc != kOkRC )
+  {
+    thread::destroy(s.threadH);
+
+    // if the swap thread never ran
+    if( s.state.load(std::memory_order_acquire) == kBuildStateId )
+      s.state.store(kIdleStateId,std::memory_order_release);
+
+    bool done_fl = false;
+    release(s,curFlowH,done_fl);
+    rc = cwLogError(rc,"Program swap failed.");
+  }
+
+  return rc;
+}
+
+cw::rc_t cw::flow::swap::exec_cycle( swap_t& s, const handle_t& flowH )
+{
+  rc_t rc = kOkRC;
+
+  switch( s.state.load(std::memory_order_acquire) )
+  {
+    case kReadyStateId:
+      s.xfadeFrameIdx = 0;
+
+      if( s.args.xfadeFrameN == 0 )
+      {
+        s.state.store(kDoneStateId,std::memory_order_release);
+        return flow::exec_cycle(s.nextFlowH);
+      }
+
+      s.state.store(kXfadeStateId,std::memory_order_release);
+
+      // fall through
+
+    case kXfadeStateId:
+      // a failure of the outgoing program does not stop the incoming program
+      flow::exec_cycle(s.curFlowH);
+
+      _xfade_save_output(s);
+
+      rc = flow::exec_cycle(s.nextFlowH);
+
+      _xfade_mix_output(s);
+
+      s.xfadeFrameIdx += frames_per_cycle(s.nextFlowH);
+
+      if( s.xfadeFrameIdx >= s.args.xfadeFrameN )
+        s.state.store(kDoneStateId,std::memory_order_release);
+      break;
+
+    case kDoneStateId:
+      rc = flow::exec_cycle(s.nextFlowH);
+      break;
+
+    default:
+      rc = flow::exec_cycle(flowH);
+  }
+
+  return rc;
+}
+
+cw::rc_t cw::flow::swap::update( swap_t& s, handle_t& flowH_ref, bool& pending_fl_ref, bool& done_fl_ref )
+{
+  rc_t rc = kOkRC;
+
+  pending_fl_ref = false;
+  done_fl_ref    = false;
+
+  switch( s.state.load(std::memory_order_acquire) )
+  {
+    case kIdleStateId:
+      break;
+
+    case kDoneStateId:
+      if((rc = _finish(s,flowH_ref)) == kOkRC )
+        done_fl_ref = true;
+      break;
+
+    case kFailStateId:
+      rc = cwLogError(kOpFailRC,"The program swap failed.");
+      release(s,flowH_ref,done_fl_ref);
+      break;
+
+    default:
+      pending_fl_ref = true;
+  }
+
+  return rc;
+}
+
+cw::rc_t cw::flow::swap::release( swap_t& s, handle_t& flowH_ref, bool& done_fl_ref )
+{
+  rc_t rc = kOkRC;
+
+  done_fl_ref = false;
+
+  // wait for the swap thread to finish creating the next program
+  while( s.state.load(std::memory_order_acquire) == kBuildStateId )
+    sleepMs(10);
+
+  switch( s.state.load(std::memory_order_acquire) )
+  {
+    case kReadyStateId:
+    case kXfadeStateId:
+      destroy(s.nextFlowH);
+      break;
+
+    case kDoneStateId:
+      if((rc = _finish(s,flowH_ref)) == kOkRC )
+        done_fl_ref = true;
+      return rc;
+  }
+
+  thread::destroy(s.threadH);
+  _xfade_buf_release(s);
+  s.state.store(kIdleStateId,std::memory_order_release);
+
+  return rc;
+}
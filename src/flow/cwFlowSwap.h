@@ -0,0 +1,83 @@
+//| Copyright: (C) 2020-2024 Kevin Larke <contact AT larke DOT org>
+//| License: GNU GPL version 3.0 or above. See the accompanying LICENSE file.
+#ifndef cwFlowSwap_h
+#define cwFlowSwap_h
+
+namespace cw
+{
+  namespace flow
+  {
+    namespace swap
+    {
+      // Replace a running real-time program without interrupting the audio.
+      // The next program is created, initialized and pre-warmed on a background thread
+      // and is then swapped in by exec_cycle() at a cycle boundary.  The output of the
+      // outgoing program is crossfaded with the output of the incoming program.
+      //
+      // Threads:
+      //   begin(), update() and release() are called from a single non-audio thread.
+      //   exec_cycle() is called from the audio thread.
+
+      enum {
+        kIdleStateId,   // no program swap is pending
+        kBuildStateId,  // the next program is being created on the swap thread
+        kReadyStateId,  // the next program is ready to be swapped in by the audio thread
+        kXfadeStateId,  // the audio thread is crossfading from the current program to the next program
+        kDoneStateId,   // the audio thread is executing only the next program
+        kFailStateId    // the next program could not be created
+      };
+
+      typedef struct args_str
+      {
+        const object_t*    proc_class_cfg;  // processor class dictionary
+        const object_t*    pgm_cfg;         // next program cfg.
+        const object_t*    udp_cfg;         // (optional)
+        const char*        proj_dir;        // (optional)
+        ui_callback_t      ui_callback;     // (optional)
+        void*              ui_callback_arg; //
+        external_device_t* deviceA;         // devices given to the next program (See flow::initialize())
+        unsigned           deviceN;         //
+        unsigned           preset_idx;      // initial preset of the next program or kInvalidIdx
+        abuf_t**           oBufA;           // oBufA[ oBufN ] output device buffers written by both programs
+        unsigned           oBufN;           //
+        unsigned           xfadeFrameN;     // length of the crossfade in sample frames
+      } args_t;
+
+      typedef struct swap_str
+      {
+        std::atomic<unsigned> state;         // See k???StateId
+        thread::handle_t      threadH;       // creates and initializes the next program
+        args_t                args;          //
+        handle_t              curFlowH;      // outgoing program
+        handle_t              nextFlowH;     // incoming program
+        sample_t**            xfadeBufA;     // xfadeBufA[ args.oBufN ] output of the outgoing program during the crossfade
+        unsigned              xfadeFrameIdx; // current crossfade frame (audio thread only)
+      } swap_t;
+
+      // Begin replacing 'curFlowH' with the program described by 'args'.
+      // The next program must be real-time and have the same sample rate and frames per cycle
+      // as 'curFlowH' otherwise the swap fails (kFailStateId).
+      // 'args' must remain valid until the swap is complete.
+      rc_t begin( swap_t& s, handle_t curFlowH, const args_t& args );
+
+      // Execute one cycle of the current program or, during a swap, of the outgoing and
+      // incoming programs. 'flowH' is the current program as updated by update().
+      rc_t exec_cycle( swap_t& s, const handle_t& flowH );
+
+      // Complete a swap which the audio thread has finished.
+      // When the swap completes 'flowH_ref' is set to the incoming program, the outgoing program
+      // is destroyed and 'done_fl_ref' is set. 'pending_fl_ref' is set if the swap is still in progress.
+      // Returns an error if the next program could not be created.
+      rc_t update( swap_t& s, handle_t& flowH_ref, bool& pending_fl_ref, bool& done_fl_ref );
+
+      // Complete a finished swap (as update()) and release the resources of an unfinished swap.
+      // The audio thread must not be running.
+      rc_t release( swap_t& s, handle_t& flowH_ref, bool& done_fl_ref );
+
+      // Return the state of the swap (See k???StateId).
+      inline unsigned state( const swap_t& s ) { return s.state.load(std::memory_order_acquire); }
+    }
+  }
+}
+
+#endif
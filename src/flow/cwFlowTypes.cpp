@@ -18,6 +18,7 @@
 #include "cwFlow.h"
 #include "cwFlowValue.h"
 #include "cwFlowTypes.h"
+#include "cwFlowNet.h"
 
 
 namespace cw
@@ -38,6 +39,7 @@ namespace cw
       { kUiHideVarDescFl,   "ui_hide" },
       { kNotifyVarDescFl,   "notify" },
       { kReadOnlyVarDescFl, "ro" }, // read-only
+      { kUiLowPriVarDescFl, "ui_low" }, // high rate output (e.g. a meter) which may be dropped when the UI update budget is exceeded
       { kInvalidVarDescFl, "<invalid>" }
     };
 
@@ -73,17 +75,85 @@ namespace cw
       return proc_error(proc,kInvalidIdRC,"The variable matching id:%i ch:%i on proc '%s:%i' could not be found.", vid, chIdx, proc->label, proc->label_sfx_id);
     }
 
+    // 32 bit FNV-1a hash of a string
+    unsigned _sym_hash( const char* label )
+    {
+      unsigned h = 2166136261u;
+      for(; *label; ++label)
+        h = (h ^ (unsigned char)(*label)) * 16777619u;
+      return h;
+    }
+
+    unsigned _hash_index_key_hash( unsigned sym_id, unsigned id0, unsigned id1 )
+    {
+      unsigned h = sym_id * 0x9e3779b1u ^ id0 * 0x85ebca77u ^ id1 * 0xc2b2ae3du;
+      h ^= h >> 16;
+      h *= 0x7feb352du;
+      h ^= h >> 15;
+      return h;
+    }
+
+    // Return the slot which contains 'label' or the empty slot where it should be inserted.
+    unsigned _sym_tbl_slot( const sym_tbl_t& tbl, const char* label, unsigned hash )
+    {
+      unsigned i = hash & (tbl.slotN-1);
+      for(; tbl.slotA[i] != kInvalidId; i = (i+1) & (tbl.slotN-1))
+        if( textIsEqual(tbl.labelA[ tbl.slotA[i] ], label) )
+          break;
+      return i;
+    }
+
+    void _sym_tbl_rehash( sym_tbl_t& tbl, unsigned slotN )
+    {
+      mem::release(tbl.slotA);
+      tbl.slotN = slotN;
+      tbl.slotA = mem::alloc<unsigned>(slotN);
+      
+      for(unsigned i=0; i<slotN; ++i)
+        tbl.slotA[i] = kInvalidId;
+
+      for(unsigned sym_id=0; sym_id<tbl.labelN; ++sym_id)
+        tbl.slotA[ _sym_tbl_slot(tbl, tbl.labelA[sym_id], _sym_hash(tbl.labelA[sym_id])) ] = sym_id;
+    }
+    
+    // Return the slot which contains the key or the empty slot where it should be inserted.
+    unsigned _hash_index_slot( const hash_index_t& idx, unsigned sym_id, unsigned id0, unsigned id1 )
+    {
+      unsigned i = _hash_index_key_hash(sym_id,id0,id1) & (idx.eleN-1);
+      for(; idx.eleA[i].sym_id != kInvalidId; i = (i+1) & (idx.eleN-1))
+        if( idx.eleA[i].sym_id == sym_id && idx.eleA[i].id0 == id0 && idx.eleA[i].id1 == id1 )
+          break;
+      return i;
+    }
+
+    void _hash_index_rehash( hash_index_t& idx, unsigned eleN )
+    {
+      hash_index_ele_t* eleA0 = idx.eleA;
+      unsigned          eleN0 = idx.eleN;
+
+      idx.eleN = eleN;
+      idx.eleA = mem::alloc<hash_index_ele_t>(eleN);
+      
+      for(unsigned i=0; i<eleN; ++i)
+        idx.eleA[i].sym_id = kInvalidId;
+
+      for(unsigned i=0; i<eleN0; ++i)
+        if( eleA0[i].sym_id != kInvalidId )
+          idx.eleA[ _hash_index_slot(idx,eleA0[i].sym_id,eleA0[i].id0,eleA0[i].id1) ] = eleA0[i];
+      
+      mem::release(eleA0);
+    }
+    
     // Variable lookup: Exact match on label and chIdx
     variable_t* _var_find_on_label_and_ch( proc_t* proc, const char* var_label, unsigned sfx_id, unsigned chIdx )
     {
-      for(variable_t* var = proc->varL; var!=nullptr; var=var->var_link)
-      {
-        // the variable vid and chIdx should form a unique pair
-        if( var->label_sfx_id==sfx_id && textCompare(var->label,var_label)==0 && var->chIdx == chIdx )
-          return var;
-      }
-      
-      return nullptr;
+      unsigned sym_id;
+
+      // the variable label, sfx_id and chIdx should form a unique key
+      if((sym_id = sym_find(proc->ctx->symTbl,var_label)) == kInvalidId )
+        return nullptr;
+
+      return static_cast<variable_t*>(hash_index_find(proc->varIdx,sym_id,sfx_id,chIdx));
     }
     
     rc_t _var_find_on_label_and_ch( proc_t* proc, const char* var_label, unsigned sfx_id, unsigned chIdx, variable_t*& var_ref )
@@ -168,6 +238,93 @@ namespace cw
       }
     }
     
+    // Return true if a proc with a decimated or on-change exec_rate should execute on this cycle.
+    // All proc's execute on the first runtime cycle so that values set prior to runtime are emitted.
+    bool _proc_is_exec_cycle( const proc_t* proc )
+    {
+      unsigned cycleIdx = proc->ctx->cycleIndex;
+      
+      if( cycleIdx == 0 )
+        return true;
+      
+      if( proc->exec_rate != kOnChangeExecRate )
+        return cycleIdx % proc->exec_rate == 0;
+
+      // are there any pending automatic notifications?
+      if( proc->modVarMapFullCnt.load(std::memory_order_acquire) > 0 )
+        return true;
+
+      // would proc_notify() generate any manual notifications?
+      for(unsigned i=0; i<proc->manualNotifyVarN; ++i)
+        if( !proc->manualNotifyVarA[i].check_ele_cnt_fl || value_has_elements_now( proc->manualNotifyVarA[i].var->src_var->value ) )
+          return true;
+
+      return false;
+    }
+    
+    bool _bypass_vars_are_equal( variable_t** varA, unsigned varN, double value )
+    {
+      for(unsigned i=0; i<varN; ++i)
+      {
+        double v = 0;
+        if( var_get(varA[i],v) != kOkRC || v != value )
+          return false;
+      }
+      return varN > 0;
+    }
+    
+    // Apply the declarative bypass to 'proc'. Returns false if the proc should execute normally.
+    bool _proc_bypass_exec( proc_t* proc )
+    {
+      proc_bypass_t* b       = proc->bypass;
+      abuf_t*        obuf    = b->outVar->value->u.abuf;
+      unsigned       modeId  = kInvalidId;
+      bool           silentFl= b->desc->silenceFl;
+
+      for(unsigned i=0; silentFl && i<b->inVarN; ++i)
+        silentFl = b->inVarA[i]->value->u.abuf->silentFl;
+      
+      if( _bypass_vars_are_equal(b->ctlVarA,b->ctlVarN,1) )
+        modeId = b->desc->modeId;
+      else
+        if( silentFl || _bypass_vars_are_equal(b->gainVarA,b->gainVarN,0) )
+          modeId = kZeroBypassModeId;
+
+      switch( modeId )
+      {
+        case kCopyBypassModeId:
+          {
+            const abuf_t* ibuf = b->inVarA[0]->value->u.abuf;
+            unsigned      chN  = std::min(ibuf->chN,obuf->chN);
+            unsigned      n    = std::min(ibuf->frameN,obuf->frameN);
+
+            vop::zero(obuf->buf,obuf->chN*obuf->frameN);
+            for(unsigned i=0; i<chN; ++i)
+              vop::copy(obuf->buf + i*obuf->frameN, ibuf->buf + i*ibuf->frameN, n );
+            
+            obuf->silentFl = ibuf->silentFl;
+          }
+          break;
+          
+        case kZeroBypassModeId:
+          abuf_set_silent(obuf);
+          break;
+
+        default:
+          return false;
+      }
+
+      return true;
+    }
+    
+    // Mark the fused kernel which computes the output of 'proc' for rebuild.
+    inline void _fuse_mark_dirty( proc_t* proc )
+    {
+      proc_t* sink = proc->fuse_sink != nullptr ? proc->fuse_sink : proc;
+      if( sink->fuse_kernel != nullptr )
+        sink->fuse_dirty_fl.store(true,std::memory_order_release);
+    }
+    
     // Incr the var->modN value and put the var pointer in var->proc->modVarMapA[]
     // where it will be picked up by a later call to proc_notify().
     // This function runs in a multi-thread context.
@@ -257,6 +414,9 @@ namespace cw
 
       // make the new local value current
       var->value           = &var->my_value;
+
+      // a coefficient of a fused kernel may have changed
+      _fuse_mark_dirty(var->proc);
             
       // Record the fact that this variable changed on this cycle for logging purposes
       if( cwIsFlag(var->flags,kLogRtVarFl) )
@@ -277,6 +437,8 @@ namespace cw
         // Once this bug is fixed the assertion can be turned back on
         // and the following line deleted.
         con_var->value = var->value;
+
+        _fuse_mark_dirty(con_var->proc);
         
         // add the connected variable to con_var->proc->modVarMapA[].
         if((rc = var_schedule_notification(con_var)) != kOkRC )
@@ -518,21 +680,19 @@ namespace cw
         if((rc = var_set_from_cfg( var, value_cfg )) != kOkRC )
           goto errLabel;
 
+      // link the new var into the ch_link list
+      if((rc = _var_add_to_ch_list(proc, var )) != kOkRC )
+        goto errLabel;
+
       // Add the variable to the end of the chain
       if( proc->varL == nullptr )
         proc->varL = var;
       else
-      {
-        variable_t* v = proc->varL;
-        while( v->var_link != nullptr )
-          v=v->var_link;
-        v->var_link = var;
-        
-      }
+        proc->varTail->var_link = var;
 
-      // link the new var into the ch_link list
-      if((rc = _var_add_to_ch_list(proc, var )) != kOkRC )
-        goto errLabel;
+      proc->varTail = var;
+
+      hash_index_insert(proc->varIdx, sym_intern(proc->ctx->symTbl,var->label), sfx_id, chIdx, var );
 
 
     errLabel:
@@ -744,6 +904,7 @@ void cw::flow::class_desc_destroy( class_desc_t* class_desc)
     pr0 = pr1;
   }
   class_desc->presetL = nullptr;
+  hash_index_destroy(class_desc->presetIdx);
 
   if( class_desc->ui != nullptr )
   {
@@ -755,15 +916,7 @@ void cw::flow::class_desc_destroy( class_desc_t* class_desc)
 
 cw::flow::class_desc_t* cw::flow::class_desc_find( flow_t* p, const char* label )
 {
-  for(unsigned i=0; i<p->classDescN; ++i)
-    if( textIsEqual(p->classDescA[i].label,label))
-      return p->classDescA + i;
-
-  for(unsigned i=0; i<p->udpDescN; ++i)
-    if( textIsEqual(p->udpDescA[i].label,label))
-      return p->udpDescA + i;
-  
-  return nullptr;
+  return static_cast<class_desc_t*>(hash_index_find(p->classDescIdx, sym_find(p->symTbl,label), 0, 0 ));
 }
 
 const cw::flow::class_desc_t* cw::flow::class_desc_find(  const flow_t* p, const char* class_desc_label )
@@ -799,12 +952,10 @@ bool cw::flow::var_desc_has_recd_format( var_desc_t* vd )
 
 const cw::flow::class_preset_t* cw::flow::class_preset_find( const class_desc_t* cd, const char* preset_label )
 {
-  const class_preset_t* pr;
-  for(pr=cd->presetL; pr!=nullptr; pr=pr->link)
-    if( textCompare(pr->label,preset_label) == 0 )
-      return pr;
+  if( cd->symTbl == nullptr )
+    return nullptr;
   
-  return nullptr;
+  return static_cast<const class_preset_t*>(hash_index_find(cd->presetIdx, sym_find(*cd->symTbl,preset_label), 0, 0 ));
 }
 
 cw::rc_t cw::flow::class_preset_value_channel_count( const class_preset_t* class_preset, const char* var_label, unsigned& ch_cnt_ref )
@@ -999,10 +1150,7 @@ void cw::flow::network_print( const network_t& net )
 
 const cw::flow::network_preset_t* cw::flow::network_preset_from_label( const network_t& net, const char* preset_label )
 {
-  for(unsigned i=0; i<net.presetN; ++i)
-    if( textIsEqual(net.presetA[i].label,preset_label))
-      return net.presetA + i;
-  return nullptr;
+  return static_cast<const network_preset_t*>(hash_index_find(net.presetIdx, sym_find(net.flow->symTbl,preset_label), 0, 0 ));
 }
 
 
@@ -1135,15 +1283,30 @@ void cw::flow::proc_destroy( proc_t* proc )
   }
   proc->presetL = nullptr;
       
-  proc->varL = nullptr;
+  proc->varL    = nullptr;
+  proc->varTail = nullptr;
+  hash_index_destroy(proc->varIdx);
       
   mem::release(proc->label);
   mem::release(proc->varMapA);
   mem::release(proc->modVarMapA);
   mem::release(proc->manualNotifyVarA);
+  mem::release(proc->audioOutVarA);
+  proc_bypass_destroy(proc->bypass);
   mem::release(proc);
 }
 
+void cw::flow::proc_bypass_destroy( proc_bypass_t*& bypass )
+{
+  if( bypass == nullptr )
+    return;
+  
+  mem::release(bypass->inVarA);
+  mem::release(bypass->ctlVarA);
+  mem::release(bypass->gainVarA);
+  mem::release(bypass);
+}
+
 cw::rc_t cw::flow::proc_validate( proc_t* proc )
 {
   rc_t rc = kOkRC;
@@ -1201,17 +1364,16 @@ cw::rc_t cw::flow::proc_validate( proc_t* proc )
 
 cw::flow::proc_t* cw::flow::proc_find( network_t& net, const char* proc_label, unsigned sfx_id )
 {
-  
-  for(unsigned i=0; i<net.procN; ++i)
-  {
-    assert( net.procA[i] != nullptr );
-    
-    if( net.procA[i]->label_sfx_id==sfx_id && textIsEqual(proc_label,net.procA[i]->label) )
-      return net.procA[i];
-  }
+  unsigned sym_id;
+  proc_t*  proc;
 
-  if( net.poly_link != nullptr )
-    return proc_find(*net.poly_link, proc_label, sfx_id );
+  // if the label was never interned then it does not name any proc
+  if((sym_id = sym_find(net.flow->symTbl,proc_label)) == kInvalidId )
+    return nullptr;
+  
+  for(network_t* n=&net; n!=nullptr; n=n->poly_link)
+    if((proc = static_cast<proc_t*>(hash_index_find(n->procIdx, sym_id, sfx_id, 0))) != nullptr )
+      return proc;
 
   return nullptr;
 }
@@ -1578,6 +1740,11 @@ char* cw::flow::proc_expand_filename( const proc_t* proc, const char* fname )
   return fn1;
 }  
 
+cw::rc_t cw::flow::proc_object_from_file( const proc_t* proc, const char* fname, object_t*& cfg_ref )
+{
+  return objectFromFileCached(fname,proc->ctx->cfg_cache_dir,cfg_ref);
+}
+
 // Call proc->proc_desc->value() on every var in the proc->modVarMapA[].
 // This function is called inside proc->proc_desc->exec() and is therefore guaranteed to be executed without
 // contention from other threads.
@@ -1608,6 +1775,7 @@ cw::rc_t cw::flow::proc_notify( proc_t* proc, unsigned flags )
           
           // callback to inform the proc that the var has changed
           proc->class_desc->members->notify( var->proc, var );
+          _fuse_mark_dirty(var->proc);
           
           // mark this var as having been removed from the modVarMapA[]
           var->modN.store(0,std::memory_order_release );
@@ -1628,6 +1796,7 @@ cw::rc_t cw::flow::proc_notify( proc_t* proc, unsigned flags )
     {
       variable_t* var = proc->manualNotifyVarA[i].var;
       var->proc->class_desc->members->notify( var->proc, var );
+      _fuse_mark_dirty(var->proc);
     }
   }
 
@@ -1639,19 +1808,40 @@ errLabel:
 cw::rc_t cw::flow::proc_exec( proc_t* proc )
 {
   rc_t rc = kOkRC;
+
+  // skip decimated and on-change proc's on cycles where they are not scheduled to run
+  if( proc->exec_rate != kEveryCycleExecRate && !_proc_is_exec_cycle(proc) )
+  {
+    proc->rate_skip_cnt += 1;
+    return rc;
+  }
   
   proc->modVarRecurseFl = true;
         
   // Call notify() on all variables marked for notification that have changed since the last exec_cycle()
   proc_notify(proc, kCallbackPnFl | kQuietPnFl);
 
-  // Execute the network.
-  // Note that kEofRC is not an error, but indicates that the network
-  // should shutudown at the end of this cycle. 
-  if((rc = proc->class_desc->members->exec(proc)) != kOkRC && rc != kEofRC )
-  {
-    rc = proc_error(proc,rc,"Execution failed on the proc:%s:%i.",cwStringNullGuard(proc->label),proc->label_sfx_id);    
+  // the output of a fused proc is computed by the kernel of its sink proc
+  if( proc->fuse_sink != nullptr )
     goto errLabel;
+
+  // apply the declarative bypass in place of exec()
+  if( proc->bypass != nullptr && proc->fuse_kernel == nullptr && _proc_bypass_exec(proc) )
+    proc->bypass_cnt += 1;
+  else
+  {
+    // exec() is responsible for marking its outputs as silent
+    for(unsigned i=0; i<proc->audioOutVarN; ++i)
+      proc->audioOutVarA[i]->value->u.abuf->silentFl = false;
+    
+    // Execute the network.
+    // Note that kEofRC is not an error, but indicates that the network
+    // should shutudown at the end of this cycle. 
+    if((rc = proc->fuse_kernel != nullptr ? fuse_kernel_exec(proc) : proc->class_desc->members->exec(proc)) != kOkRC && rc != kEofRC )
+    {
+      rc = proc_error(proc,rc,"Execution failed on the proc:%s:%i.",cwStringNullGuard(proc->label),proc->label_sfx_id);    
+      goto errLabel;
+    }
   }
 
   // execute logging according to the proc 'log:{}' statement.
@@ -1664,6 +1854,190 @@ errLabel:
   return rc;
 }
 
+void cw::flow::proc_report_activity( proc_t* proc )
+{
+  proc->net->activity_cycle_idx = proc->ctx->cycleIndex;
+}
+
+unsigned cw::flow::sym_intern( sym_tbl_t& tbl, const char* label )
+{
+  unsigned hash;
+  unsigned i;
+  
+  if( label == nullptr )
+    return kInvalidId;
+
+  // keep the table at most half full
+  if( 2*(tbl.labelN+1) > tbl.slotN )
+    _sym_tbl_rehash(tbl, tbl.slotN==0 ? 64 : 2*tbl.slotN );
+
+  hash = _sym_hash(label);
+  i    = _sym_tbl_slot(tbl,label,hash);
+
+  // if the label already exists
+  if( tbl.slotA[i] != kInvalidId )
+    return tbl.slotA[i];
+
+  if( tbl.labelN >= tbl.labelAllocN )
+  {
+    tbl.labelAllocN = tbl.labelAllocN==0 ? 64 : 2*tbl.labelAllocN;
+    tbl.labelA      = mem::resize<char*>(tbl.labelA,tbl.labelAllocN);
+  }
+
+  tbl.labelA[ tbl.labelN ] = mem::duplStr(label);
+  tbl.slotA[i]             = tbl.labelN;
+  
+  return tbl.labelN++;
+}
+
+unsigned cw::flow::sym_find( const sym_tbl_t& tbl, const char* label )
+{
+  if( label == nullptr || tbl.slotN == 0 )
+    return kInvalidId;
+
+  return tbl.slotA[ _sym_tbl_slot(tbl,label,_sym_hash(label)) ];
+}
+
+const char* cw::flow::sym_label( const sym_tbl_t& tbl, unsigned sym_id )
+{ return sym_id < tbl.labelN ? tbl.labelA[sym_id] : nullptr; }
+
+void cw::flow::sym_tbl_destroy( sym_tbl_t& tbl )
+{
+  for(unsigned i=0; i<tbl.labelN; ++i)
+    mem::release(tbl.labelA[i]);
+  
+  mem::release(tbl.labelA);
+  mem::release(tbl.slotA);
+  tbl = {};
+}
+
+bool cw::flow::hash_index_insert( hash_index_t& idx, unsigned sym_id, unsigned id0, unsigned id1, void* value )
+{
+  unsigned i;
+  
+  if( sym_id == kInvalidId )
+    return false;
+  
+  // keep the index at most half full
+  if( 2*(idx.cnt+1) > idx.eleN )
+    _hash_index_rehash(idx, idx.eleN==0 ? 16 : 2*idx.eleN );
+
+  i = _hash_index_slot(idx,sym_id,id0,id1);
+
+  if( idx.eleA[i].sym_id != kInvalidId )
+    return false;
+
+  idx.eleA[i] = { .sym_id=sym_id, .id0=id0, .id1=id1, .value=value };
+  idx.cnt += 1;
+  
+  return true;
+}
+
+void* cw::flow::hash_index_find( const hash_index_t& idx, unsigned sym_id, unsigned id0, unsigned id1 )
+{
+  unsigned i;
+  
+  if( idx.eleN == 0 || sym_id == kInvalidId )
+    return nullptr;
+
+  i = _hash_index_slot(idx,sym_id,id0,id1);
+  
+  return idx.eleA[i].sym_id == kInvalidId ? nullptr : idx.eleA[i].value;
+}
+
+void cw::flow::hash_index_destroy( hash_index_t& idx )
+{
+  mem::release(idx.eleA);
+  idx = {};
+}
+
+void cw::flow::latency_hist_record( latency_hist_t& h, unsigned long long ns )
+{
+  unsigned idx = (unsigned)ns;
+  
+  if( ns >= kLatHistSubN )
+  {
+    // 'e' is the index of the most significant bit of 'ns'
+    unsigned e = 63 - __builtin_clzll(ns);
+    idx = (e - kLatHistSubBitN + 1) * kLatHistSubN + (unsigned)((ns >> (e - kLatHistSubBitN)) & (kLatHistSubN-1));
+  }
+
+  h.bucketA[ std::min(idx,(unsigned)kLatHistBucketN-1) ] += 1;
+  h.cnt   += 1;
+  h.max_ns = std::max(h.max_ns,ns);
+}
+
+unsigned long long cw::flow::latency_hist_percentile( const latency_hist_t& h, double pct )
+{
+  unsigned long long target = (unsigned long long)std::ceil(pct * h.cnt / 100.0);
+  unsigned long long acc    = 0;
+
+  if( h.cnt == 0 )
+    return 0;
+  
+  target = std::max(1ull,std::min(target,(unsigned long long)h.cnt));
+  
+  for(unsigned i=0; i<kLatHistBucketN; ++i)
+    if( (acc += h.bucketA[i]) >= target )
+    {
+      if( i < kLatHistSubN )
+        return std::min((unsigned long long)i,h.max_ns);
+
+      unsigned           shift = i/kLatHistSubN - 1;
+      unsigned long long upper = ((unsigned long long)(kLatHistSubN + i%kLatHistSubN + 1) << shift) - 1;
+      return std::min(upper,h.max_ns);
+    }
+
+  return h.max_ns;
+}
+
+void cw::flow::latency_hist_stats( const latency_hist_t& h, latency_stats_t& stats_ref )
+{
+  stats_ref.cnt     = h.cnt;
+  stats_ref.p50_us  = latency_hist_percentile(h,50.0)  / 1000.0;
+  stats_ref.p99_us  = latency_hist_percentile(h,99.0)  / 1000.0;
+  stats_ref.p999_us = latency_hist_percentile(h,99.9)  / 1000.0;
+  stats_ref.max_us  = h.max_ns / 1000.0;
+}
+
+cw::rc_t cw::flow::exec_rate_parse( const object_t* cfg, unsigned& exec_rate_ref )
+{
+  rc_t rc = kOkRC;
+
+  exec_rate_ref = kEveryCycleExecRate;
+
+  if( cfg == nullptr )
+    return rc;
+
+  if( cfg->is_string() )
+  {
+    const char* s = nullptr;
+    if((rc = cfg->value(s)) != kOkRC )
+      goto errLabel;
+
+    if( textIsEqual(s,"on_change") )
+      exec_rate_ref = kOnChangeExecRate;
+    else
+      if( !textIsEqual(s,"every_cycle") )
+        rc = kSyntaxErrorRC;
+  }
+  else
+  {
+    unsigned n = 0;
+    if((rc = cfg->value(n)) != kOkRC )
+      goto errLabel;
+
+    // 0 and 1 both indicate execution on every cycle
+    exec_rate_ref = n <= 1 ? (unsigned)kEveryCycleExecRate : n;
+  }
+  
+errLabel:
+  if( rc != kOkRC )
+    rc = cwLogError(kSyntaxErrorRC,"The 'rate' field must be a positive integer, 'on_change', or 'every_cycle'.");
+  
+  return rc;
+}
+
 cw::rc_t cw::flow::var_create( proc_t* proc, const char* var_label, unsigned sfx_id, unsigned id, unsigned chIdx, const object_t* value_cfg, unsigned altTypeFl, variable_t*& varRef )
 {
   rc_t rc = kOkRC;
@@ -1985,6 +2359,51 @@ cw::rc_t cw::flow::var_find( proc_t* proc, unsigned vid, unsigned chIdx, variabl
   return rc;
 }
 
+cw::rc_t cw::flow::var_plan_create( proc_t* proc, var_plan_t& plan )
+{
+  rc_t rc = kOkRC;
+
+  var_plan_destroy(plan);
+
+  // determine the max vid and channel index among all registered variables
+  for(variable_t* var=proc->varL; var!=nullptr; var=var->var_link)
+    if( var->vid != kInvalidId )
+    {
+      plan.vidN = std::max(plan.vidN, var->vid + 1);
+      plan.chN  = std::max(plan.chN,  var->chIdx == kAnyChIdx ? 1 : var->chIdx + 2);
+    }
+
+  plan.varA = mem::allocZ<variable_t*>( plan.vidN * plan.chN );
+
+  // store a pointer to each variable in it's plan slot
+  for(variable_t* var=proc->varL; var!=nullptr; var=var->var_link)
+    if( var->vid != kInvalidId )
+    {
+      unsigned idx = var->vid*plan.chN + (var->chIdx == kAnyChIdx ? 0 : var->chIdx+1);
+      
+      if( plan.varA[idx] != nullptr )
+      {
+        rc = var_error(var,kInvalidStateRC,"The variable '%s:%i' vid:%i ch:%i is duplicated in the variable access plan.",cwStringNullGuard(var->label),var->label_sfx_id,var->vid,var->chIdx);
+        goto errLabel;
+      }
+      
+      plan.varA[idx] = var;
+    }
+
+errLabel:
+  if( rc != kOkRC )
+    var_plan_destroy(plan);
+  
+  return rc;
+}
+
+void cw::flow::var_plan_destroy( var_plan_t& plan )
+{
+  mem::release(plan.varA);
+  plan.vidN = 0;
+  plan.chN  = 0;
+}
+
 cw::rc_t cw::flow::var_find( proc_t* proc, const char* label, unsigned sfx_id, unsigned chIdx, variable_t*& vRef )
 {
   variable_t* var;
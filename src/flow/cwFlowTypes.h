@@ -11,6 +11,22 @@ namespace cw
     typedef rc_t (*member_func_t)( struct proc_str* ctx );
     typedef rc_t (*member_notify_func_t)( struct proc_str* ctx, struct variable_str* var );
 
+    // One term of the linear form of a proc's audio output: out_var[out_ch] += coeff * in_var[in_ch]
+    typedef struct linear_term_str
+    {
+      const struct variable_str* in_var;  // audio input variable
+      unsigned                   in_ch;   // channel of 'in_var'
+      const struct variable_str* out_var; // audio output variable
+      unsigned                   out_ch;  // channel of 'out_var'
+      coeff_t                    coeff;   // current gain
+    } linear_term_t;
+
+    // Fill termA[] with the current linear form of a proc's audio outputs. Every output channel must be
+    // the target of at least one term. If 'termAllocN' is too small kBufTooSmallRC is returned
+    // and 'termN_ref' is set to the required count.
+    // Proc classes which are stateless and element-wise linear provide this function to the fusion pass (See flow_t.fuse_fl).
+    typedef rc_t (*member_linear_func_t)( struct proc_str* ctx, linear_term_t* termA, unsigned termAllocN, unsigned& termN_ref );
+
     // var_desc_t attribute flags
     enum
     {
@@ -25,7 +41,8 @@ namespace cw
       kUiDisableVarDescFl = 0x080,
       kUiHideVarDescFl    = 0x100,
       kNotifyVarDescFl    = 0x200,
-      kReadOnlyVarDescFl  = 0x400
+      kReadOnlyVarDescFl  = 0x400,
+      kUiLowPriVarDescFl  = 0x800
     };
     
     typedef struct class_members_str
@@ -60,6 +77,76 @@ namespace cw
       struct var_desc_str* link;    // class_desc->varDescL list link
     } var_desc_t;
 
+    //
+    // Latency histogram
+    //
+    // Execution times are counted in log-linear buckets: 2^kLatHistSubBitN linear buckets
+    // per power of two nanoseconds. This bounds the error of a percentile to 1/2^kLatHistSubBitN.
+    // Recording a value does not allocate memory and is therefore safe on the audio thread.
+    
+    enum {
+      kLatHistSubBitN = 3,
+      kLatHistSubN    = 1 << kLatHistSubBitN,
+      kLatHistBucketN = kLatHistSubN * 32     // covers durations up to 2^33 ns (8.6 seconds)
+    };
+    
+    typedef struct latency_hist_str
+    {
+      unsigned           bucketA[ kLatHistBucketN ];
+      unsigned           cnt;     // count of recorded values
+      unsigned long long max_ns;  // max. recorded value
+    } latency_hist_t;
+
+    void               latency_hist_record(     latency_hist_t& h, unsigned long long ns );
+    
+    // Returns the upper bound of the bucket which contains the 'pct' percentile (0.0 to 100.0) value.
+    unsigned long long latency_hist_percentile( const latency_hist_t& h, double pct );
+    void               latency_hist_stats(      const latency_hist_t& h, latency_stats_t& stats_ref );
+
+
+    //
+    // Symbol table and hash index
+    //
+    // Proc, variable, class and preset labels are interned into a per-program symbol table
+    // when the program is created. Label lookups then resolve the label to a symbol id once
+    // and find the named object in a hash index keyed on the symbol id.
+    // Symbols are only added at create time therefore lookups during runtime do not allocate.
+
+    typedef struct sym_tbl_str
+    {
+      char**    labelA;      // labelA[ labelN ] symbol id to label 
+      unsigned  labelN;      // count of symbols
+      unsigned  labelAllocN; // allocated size of labelA[]
+      unsigned* slotA;       // slotA[ slotN ] open addressing hash table of symbol id's (kInvalidId marks an empty slot)
+      unsigned  slotN;       // always 0 or a power of 2
+    } sym_tbl_t;
+
+    unsigned    sym_intern(      sym_tbl_t& tbl,       const char* label );  // Return the symbol id of 'label' adding it to the table if necessary.
+    unsigned    sym_find(        const sym_tbl_t& tbl, const char* label );  // Return the symbol id of 'label' or kInvalidId if it was never interned.
+    const char* sym_label(       const sym_tbl_t& tbl, unsigned sym_id );
+    void        sym_tbl_destroy( sym_tbl_t& tbl );
+
+    typedef struct hash_index_ele_str
+    {
+      unsigned sym_id;  // kInvalidId marks an empty slot
+      unsigned id0;     // e.g. label sfx id
+      unsigned id1;     // e.g. channel index
+      void*    value;
+    } hash_index_ele_t;
+
+    // Maps a (sym_id,id0,id1) key to a pointer. 
+    typedef struct hash_index_str
+    {
+      hash_index_ele_t* eleA; // eleA[ eleN ]
+      unsigned          eleN; // always 0 or a power of 2
+      unsigned          cnt;  // count of keys in eleA[]
+    } hash_index_t;
+
+    // If the key already exists then the existing value is retained and false is returned.
+    bool  hash_index_insert(  hash_index_t& idx,       unsigned sym_id, unsigned id0, unsigned id1, void* value );
+    void* hash_index_find(    const hash_index_t& idx, unsigned sym_id, unsigned id0, unsigned id1 );
+    void  hash_index_destroy( hash_index_t& idx );
+    
     typedef struct class_preset_str
     {
       const char*              label;
@@ -67,14 +154,52 @@ namespace cw
       struct class_preset_str* link;
     } class_preset_t;
     
+    // class_desc_t.execRate and proc_t.exec_rate values.
+    // Any other value N indicates that the proc is executed on every N'th cycle.
+    enum
+    {
+      kEveryCycleExecRate = 0,           // execute on every cycle (default)
+      kOnChangeExecRate   = kInvalidCnt  // execute only on cycles where a variable notification is pending
+    };
+    
+    // Declarative bypass action (See bypass_desc_t.modeId)
+    enum
+    {
+      kCopyBypassModeId, // copy the input to the output
+      kZeroBypassModeId  // zero the output
+    };
+
+    // A class 'bypass' field declares the conditions under which the proc's exec() may be
+    // replaced by a copy or zero of its audio output.
+    // { in:<audio var>, out:<audio var>, ctl:<bool var>, gain:<coeff var>, mode:copy|zero, silence_fl:<bool> }
+    // The bypass is applied when:
+    // 1. every channel of 'ctl' is true - the output is copied from the input or zeroed according to 'mode'.
+    // 2. every channel of 'gain' is 0 - the output is zeroed.
+    // 3. 'silence_fl' is set and every input variable labeled 'in' is silent - the output is zeroed.
+    typedef struct bypass_desc_str
+    {
+      const char* in_label;   // audio input(s)
+      const char* out_label;  // audio output or nullptr if the class does not declare a bypass
+      const char* ctl_label;  // optional bool variable which engages the bypass
+      const char* gain_label; // optional coeff variable which produces a silent output when 0
+      unsigned    modeId;     // action taken when 'ctl' is set (See k???BypassModeId)
+      bool        silenceFl;  // true if silent inputs produce a silent output
+    } bypass_desc_t;
+    
     typedef struct class_desc_str
     {
       const object_t*   cfg;        // class cfg 
       const char*       label;      // class label;      
       var_desc_t*       varDescL;   // varDescL variable description linked on var_desc_t.link
       class_preset_t*   presetL;    // preset linked list
+      hash_index_t      presetIdx;  // presetL indexed on the preset label symbol
+      const sym_tbl_t*  symTbl;     // symbol table used by presetIdx
       class_members_t*  members;    // member functions for this class
       unsigned          polyLimitN; // max. poly copies of this class per network_t or 0 if no limit
+      bool              parallelFl; // true if proc's of this class may execute concurrently with proc's they are not connected to
+      bool              abufPoolFl; // true if proc's of this class completely rewrite their audio outputs on every exec()
+      unsigned          execRate;   // default execution rate for proc's of this class (See k???ExecRate)
+      bypass_desc_t     bypass;     // declarative bypass
       ui_proc_desc_t*   ui;
     } class_desc_t;
 
@@ -146,6 +271,19 @@ namespace cw
       bool              check_ele_cnt_fl;
     } manual_notify_t;
     
+    // Variables referenced by the class bypass description of a proc.
+    typedef struct proc_bypass_str
+    {
+      const bypass_desc_t* desc;
+      variable_t**         inVarA;   // inVarA[ inVarN ]
+      unsigned             inVarN;
+      variable_t*          outVar;
+      variable_t**         ctlVarA;  // ctlVarA[ ctlVarN ]
+      unsigned             ctlVarN;
+      variable_t**         gainVarA; // gainVarA[ gainVarN ]
+      unsigned             gainVarN;
+    } proc_bypass_t;
+    
     typedef struct proc_str
     {
       struct flow_str*    ctx;  // global system context
@@ -164,6 +302,8 @@ namespace cw
       void*           userPtr;       // instance state
 
       variable_t*     varL;          // linked list of all variables on this instance
+      variable_t*     varTail;       // last variable in varL
+      hash_index_t    varIdx;        // varL indexed on (label symbol, label_sfx_id, chIdx)
 
       unsigned        varMapChN;     // max count of channels (max 'chIdx' + 2) among all variables on this instance, (2=kAnyChIdx+index to count)
       unsigned        varMapIdN;     // max 'vid' among all variables on this instance 
@@ -188,8 +328,25 @@ namespace cw
       struct network_str*  internal_net;
       unsigned             internal_net_cnt; // count of hetergenous networks contained in the internal_net linked list.
 
+      unsigned     exec_rate;     // execution rate (See k???ExecRate) from the class desc. or the proc inst 'rate' field
+      unsigned     rate_skip_cnt; // count of cycles where exec() was skipped because of 'exec_rate'
+
+      struct fuse_kernel_str* fuse_kernel; // fused kernel which replaces exec() on this proc or nullptr
+      struct proc_str*        fuse_sink;   // proc whose fused kernel computes the output of this proc or nullptr
+      std::atomic<bool>       fuse_dirty_fl; // set when a coefficient of 'fuse_kernel' may have changed
+
+      proc_bypass_t* bypass;       // declarative bypass or nullptr if the class does not declare a bypass
+      unsigned       bypass_cnt;   // count of cycles where exec() was replaced by the bypass
+      variable_t**   audioOutVarA; // audioOutVarA[ audioOutVarN ] audio outputs whose silence flag is cleared prior to exec()
+      unsigned       audioOutVarN; 
+
       time::spec_t prof_dur; // total time spent in this proc
       unsigned     prof_cnt; // total count of calls to this proc
+      
+      latency_hist_t     prof_hist;         // execution time histogram
+      unsigned long long prof_cycle_ns;     // execution time on cycle 'prof_cycle_idx'
+      unsigned           prof_cycle_idx;    // last cycle on which this proc was executed
+      unsigned           deadline_miss_cnt; // count of deadline misses where this proc was the longest running proc
       unsigned     trace_id;
       
     } proc_t;
@@ -267,6 +424,22 @@ namespace cw
       const value_t*    value;  //
     } network_preset_pair_t;
 
+    // State of an incremental preset application. See network_begin_preset_apply().
+    typedef struct preset_apply_str
+    {
+      const network_preset_t* preset;            // value list being applied or nullptr if no application is in progress
+      const network_preset_t* dual_sec;          // secondary preset if this is a dual preset application otherwise nullptr
+      double                  coeff;             // dual preset interpolation coefficient
+      unsigned                proc_label_sfx_id; // 
+      const preset_value_t*   next;              // next value to apply
+      unsigned                valueN;            // count of values in the preset
+      unsigned                applyN;            // count of values applied so far
+      unsigned                cycleN;            // count of cycles the application has spanned so far
+      unsigned                max_cycle_cnt;     // all remaining values are applied on this cycle (0=no limit)
+      unsigned long long      budget_ns;         // per cycle time budget (0=no budget)
+      rc_t                    rc;                // result of the last application step
+    } preset_apply_t;
+
     typedef struct global_var_str
     {
       const char* class_label;
@@ -293,9 +466,11 @@ namespace cw
 
       struct proc_str** procA;      
       unsigned          procN;
+      hash_index_t      procIdx;    // procA[] indexed on (label symbol, label_sfx_id)
 
       network_preset_t* presetA;
       unsigned          presetN;
+      hash_index_t      presetIdx;  // presetA[] indexed on the preset label symbol
 
       recd_reg_t*       recdFmtRegA;
       unsigned          recdFmtRegN;
@@ -304,6 +479,8 @@ namespace cw
       network_preset_pair_t* preset_pairA;
       unsigned               preset_pairN;
 
+      preset_apply_t         preset_apply;  // in-progress incremental preset application
+
       unsigned            polyN;       // Count of networks in poly net or 1 if not part of a poly net
                                        // (for het. poly net's this counts the number of net's for each het. array)
       unsigned            poly_idx;    // Index in poly net.
@@ -311,12 +488,32 @@ namespace cw
 
       ui_net_t* ui_net;
 
+      struct network_sched_str* sched;     // parallel execution schedule or nullptr if the network executes serially
+      struct abuf_pool_str*     abuf_pool; // shared audio output buffer storage or nullptr if abuf pooling is disabled
+      struct network_pipe_str*  pipe;      // pipelined execution stages or nullptr if the network is not pipelined
+      struct fuse_kernel_str*   fuse_kernelL; // fused kernels linked by fuse_kernel_t.link
+
+      unsigned activity_cycle_idx; // last cycle on which a proc in this network called proc_report_activity()
+
       time::spec_t prof_dur; // total time spent executing this network
       unsigned     prof_cnt; // total count of executions of this network
+      
+      latency_hist_t     prof_hist;     // execution time histogram
+      unsigned long long prof_cycle_ns; // execution time on the last cycle
             
     } network_t;
     
     
+    enum { kDeadlineMissRecdN = 32 };
+    
+    typedef struct deadline_miss_recd_str
+    {
+      unsigned           cycle_idx; // cycle on which the deadline was missed
+      unsigned long long dur_ns;    // root network execution time
+      proc_t*            proc;      // root network proc with the longest execution time on this cycle
+      unsigned long long proc_ns;   // execution time of 'proc'
+    } deadline_miss_recd_t;
+    
     typedef struct flow_str
     {
       const object_t*      pgmCfg;      // complete program cfg
@@ -330,6 +527,17 @@ namespace cw
       unsigned             maxCycleCount;        // count of cycles to run on flow::exec() or 0 if there is no limit.
       unsigned             uiUpdateCycleCount;   // count of cycles between UI updates (1)
       const char*          init_net_preset_label;// network initialization preset label or nullptr if there is no net. init. preset
+
+      bool                 parallel_fl;          // execute unconnected proc's of the root network concurrently
+      unsigned             thread_cnt;           // count of worker threads used when parallel_fl is set
+      const object_t*      cpu_affinityL;        // optional list of CPU affinities for each worker thread (or pipeline stage)
+      bool                 abuf_pool_fl;         // pack the audio outputs of each network into a shared buffer based on their lifetimes
+      bool                 fuse_fl;              // fuse chains of element-wise linear audio proc's into a single kernel
+      bool                 bypass_fl;            // apply the declarative class bypass and skip proc's whose inputs are silent
+      unsigned             ctl_queue_blk_cnt;    // count of blocks in the posted variable value queue
+      unsigned             ctl_queue_blk_byte_cnt; // size of each block in the posted variable value queue
+      unsigned             pipeline_stage_cnt;   // count of concurrent pipeline stages in the root network (0 or 1 disables pipelining)
+      const object_t*      pipeline_stageL;      // optional list of labels of the first proc in each stage following the first stage
       
       bool                 isInRuntimeFl;        // Set when compile-time is complete
       
@@ -347,11 +555,17 @@ namespace cw
 
       class_desc_t*        udpDescA;             // 
       unsigned             udpDescN;             //
+
+      sym_tbl_t            symTbl;               // interned proc, variable, class and preset labels
+      hash_index_t         classDescIdx;         // classDescA[] and udpDescA[] indexed on the class label symbol
       
       external_device_t*   deviceA;              // deviceA[ deviceN ] external device description array
       unsigned             deviceN;              //
 
       const char*          proj_dir;             // default input/output directory
+      char*                cfg_cache_dir;        // directory of binary images of the cfg files read by proc_object_from_file() or nullptr to disable caching
+      char*                fft_wisdom_fname;     // FFTW wisdom file loaded before and saved after the network is created or nullptr
+      unsigned             fft_plan_effort_id;   // dsp::fft_plan::effort_t used while the network is created
 
       // Top-level preset list.
       network_preset_t* presetA;  // presetA[presetN] partial (label and tid only) parsing of the network presets 
@@ -367,12 +581,23 @@ namespace cw
       variable_t               ui_var_stub;
       variable_t*              ui_var_tail;
 
+      unsigned          ui_update_budget;    // dflt: 0 Max. count of var updates sent to the UI per second or 0 for no limit. Set by network flag: ui_update_budget.
+      double            ui_budget_tokens;    // count of var updates available to the next UI update
+      unsigned          ui_budget_cycle_idx; // cycleIndex of the last budget refill
+      ui_update_stats_t ui_stats;
+
+      struct var_ctl_queue_str* ctl_queue;  // values posted by post_variable_value() which are applied at the start of each cycle
+
       global_var_t* globalVarL;
 
       bool         prof_fl;     // set to turn profiling on
       time::spec_t prof_dur;    // total execution time
       unsigned     prof_cnt;    // total count of execution cycles
       time::spec_t prof_ui_dur; // total time spent updating UI
+
+      unsigned long long deadline_ns;       // cycle time budget: framesPerCycle/sample_rate
+      unsigned           deadline_miss_cnt; // count of cycles where the root network execution time exceeded 'deadline_ns'
+      deadline_miss_recd_t deadline_missA[ kDeadlineMissRecdN ]; // ring buffer of the most recent deadline misses
       unsigned     trace_id;
       
     } flow_t;
@@ -563,6 +788,11 @@ namespace cw
     // The returned string must be release with a call to mem::free().
     char*              proc_expand_filename( const proc_t* proc, const char* fname );
 
+    // Parse a cfg file. If the program 'cfg_cache_dir' option is set the parsed
+    // object is cached as a binary image which is reused until the file changes.
+    // (See objectFromFileCached()).
+    rc_t               proc_object_from_file( const proc_t* proc, const char* fname, object_t*& cfg_ref );
+
     // Call this function from inside the proc instance exec() routine, with flags=kCallbackPnFl,
     // to get callbacks on variables marked for notification on change. Note that variables must have
     // their var. description 'kNotifyVarDescFl' (var. desc flag: 'notify') set in order
@@ -575,7 +805,26 @@ namespace cw
     // Execute a proc instance by calling it's custom 'exec' function.
     // Returns kEofRC to indicate that the network that this proc belongs to
     // show shutdown at the end of this execution cycle.
+    // Proc's with a decimated or on-change 'exec_rate' return immediately
+    // on cycles where they are not scheduled to run. Pending notifications
+    // are retained and delivered on the next cycle where the proc executes.
+    // Proc's whose class declares a 'bypass' (See bypass_desc_t) copy or zero their
+    // audio output, in place of calling exec(), when the bypass conditions are met.
     rc_t               proc_exec( proc_t* proc );
+
+    // Release the bypass state of a proc.
+    void               proc_bypass_destroy( proc_bypass_t*& bypass );
+
+    // Voice proc's (e.g. 'midi_voice','piano_voice') call this function from inside exec()
+    // on every cycle where they are producing output. 'poly' proc's with 'idle_skip_fl' set use this
+    // information to stop executing voice networks which are not sounding.
+    // Note that the activity is only registered with the network which directly contains 'proc'.
+    void               proc_report_activity( proc_t* proc );
+
+    // Parse a class or proc inst 'rate' field.
+    // The field may be a positive integer N (execute every N'th cycle),
+    // "on_change" (execute only when a notification is pending), or "every_cycle".
+    rc_t               exec_rate_parse( const object_t* cfg, unsigned& exec_rate_ref );
     
     //------------------------------------------------------------------------------------------------------------------------
     //
@@ -832,6 +1081,79 @@ namespace cw
     T val_get( proc_t* proc, unsigned vid )
     { return var_get<T>(proc,vid,kAnyChIdx); }
     
+    //
+    // Variable access plan
+    //
+    // A var_plan_t holds a direct pointer to every (vid,chIdx) variable registered on a proc.
+    // It is formed once, at the end of the proc's create function, by var_plan_create().
+    // At runtime var_plan_get() and var_plan_set() then access the variable without
+    // the var_find() lookup and, when the value already has the requested type, without
+    // the type coercion performed by var_get().
+    //
+
+    typedef struct var_plan_str
+    {
+      variable_t** varA;   // varA[ vidN*chN ]
+      unsigned     vidN;   // max. vid + 1
+      unsigned     chN;    // max. chIdx + 2 (index 0 is kAnyChIdx)
+    } var_plan_t;
+
+    rc_t var_plan_create(  proc_t* proc, var_plan_t& plan );
+    void var_plan_destroy( var_plan_t& plan );
+
+    // Returns nullptr if the (vid,chIdx) variable was not registered when the plan was created.
+    inline variable_t* var_plan_var( const var_plan_t& plan, unsigned vid, unsigned chIdx=kAnyChIdx )
+    {
+      unsigned ci = chIdx == kAnyChIdx ? 0 : chIdx+1;
+      return vid < plan.vidN && ci < plan.chN ? plan.varA[ vid*plan.chN + ci ] : nullptr;
+    }
+
+    // Map a value type to it's type flag and value_t union member.
+    template< typename T > struct var_plan_type;
+    template<> struct var_plan_type<bool>          { enum { kTFl=kBoolTFl };   static bool          get( const value_t* v ) { return v->u.b; } };
+    template<> struct var_plan_type<uint_t>        { enum { kTFl=kUIntTFl };   static uint_t        get( const value_t* v ) { return v->u.u; } };
+    template<> struct var_plan_type<int_t>         { enum { kTFl=kIntTFl };    static int_t         get( const value_t* v ) { return v->u.i; } };
+    template<> struct var_plan_type<float>         { enum { kTFl=kFloatTFl };  static float         get( const value_t* v ) { return v->u.f; } };
+    template<> struct var_plan_type<double>        { enum { kTFl=kDoubleTFl }; static double        get( const value_t* v ) { return v->u.d; } };
+    template<> struct var_plan_type<abuf_t*>       { enum { kTFl=kABufTFl };   static abuf_t*       get( const value_t* v ) { return v->u.abuf; } };
+    template<> struct var_plan_type<const abuf_t*> { enum { kTFl=kABufTFl };   static const abuf_t* get( const value_t* v ) { return v->u.abuf; } };
+    template<> struct var_plan_type<fbuf_t*>       { enum { kTFl=kFBufTFl };   static fbuf_t*       get( const value_t* v ) { return v->u.fbuf; } };
+    template<> struct var_plan_type<const fbuf_t*> { enum { kTFl=kFBufTFl };   static const fbuf_t* get( const value_t* v ) { return v->u.fbuf; } };
+    template<> struct var_plan_type<mbuf_t*>       { enum { kTFl=kMBufTFl };   static mbuf_t*       get( const value_t* v ) { return v->u.mbuf; } };
+    template<> struct var_plan_type<const mbuf_t*> { enum { kTFl=kMBufTFl };   static const mbuf_t* get( const value_t* v ) { return v->u.mbuf; } };
+    template<> struct var_plan_type<rbuf_t*>       { enum { kTFl=kRBufTFl };   static rbuf_t*       get( const value_t* v ) { return v->u.rbuf; } };
+    template<> struct var_plan_type<const rbuf_t*> { enum { kTFl=kRBufTFl };   static const rbuf_t* get( const value_t* v ) { return v->u.rbuf; } };
+
+    // Get the value of a variable. If the type of the value does not match 'T'
+    // then fall back to var_get() to perform the type conversion.
+    template< typename T >
+    inline rc_t var_get_direct( variable_t* var, T& valRef )
+    {
+      if( var != nullptr && var->value != nullptr && (var->value->tflag & kTypeMask) == (unsigned)var_plan_type<T>::kTFl )
+      {
+        valRef = var_plan_type<T>::get(var->value);
+        return kOkRC;
+      }
+
+      return var_get(var,valRef);
+    }
+
+    template< typename T >
+    inline rc_t var_plan_get( const var_plan_t& plan, unsigned vid, unsigned chIdx, T& valRef )
+    { return var_get_direct(var_plan_var(plan,vid,chIdx),valRef); }
+
+    template< typename T >
+    inline rc_t var_plan_get( const var_plan_t& plan, unsigned vid, T& valRef )
+    { return var_get_direct(var_plan_var(plan,vid,kAnyChIdx),valRef); }
+
+    template< typename T >
+    inline T val_plan_get( const var_plan_t& plan, unsigned vid, unsigned chIdx=kAnyChIdx )
+    {
+      T value = 0;
+      var_plan_get(plan,vid,chIdx,value);
+      return value;
+    }
+    
     //
     //  var_set() coerces the incoming value to the type of the variable (var->type)
     //
@@ -878,6 +1200,19 @@ namespace cw
     inline rc_t var_set( proc_t* proc, unsigned vid, rbuf_t* val )         { return var_set(proc,vid,kAnyChIdx,val); }
     inline rc_t var_set( proc_t* proc, unsigned vid, const object_t* val ) { return var_set(proc,vid,kAnyChIdx,val); }
 
+    template< typename T >
+    inline rc_t var_plan_set( const var_plan_t& plan, unsigned vid, unsigned chIdx, T val )
+    {
+      variable_t* var;
+      if((var = var_plan_var(plan,vid,chIdx)) == nullptr )
+        return cwLogError(kInvalidIdRC,"The variable vid:%i ch:%i is not part of the variable access plan.",vid,chIdx);
+      return var_set(var,val);
+    }
+
+    template< typename T >
+    inline rc_t var_plan_set( const var_plan_t& plan, unsigned vid, T val )
+    { return var_plan_set(plan,vid,kAnyChIdx,val); }
+
     
   }
 }
@@ -515,6 +515,23 @@ unsigned       cw::flow::value_print_verbosity_from_string( const char* s )
 const char*    cw::flow::value_print_verbosity_to_string( unsigned verbosity )
 { return idToLabel(_valVerbLevelA,verbosity,kInvalidValPrintVerb); }
 
+namespace cw
+{
+  namespace flow
+  {
+    // Round 'n' elements up to a whole count of kSignalAlignByteN blocks.
+    template< typename T >
+    unsigned _signal_pad_count( unsigned n )
+    {
+      const unsigned blkN = kSignalAlignByteN / sizeof(T);
+      return ((n + blkN - 1) / blkN) * blkN;
+    }
+
+    bool _is_aligned( const void* p, unsigned alignByteN )
+    { return ((uintptr_t)p % alignByteN) == 0; }
+  }
+}
+
 cw::flow::abuf_t* cw::flow::abuf_create( srate_t srate, unsigned chN, unsigned frameN )
 {
   if( chN*frameN == 0 )
@@ -527,10 +544,8 @@ cw::flow::abuf_t* cw::flow::abuf_create( srate_t srate, unsigned chN, unsigned f
   a->srate        = srate;
   a->chN          = chN;
   a->frameN       = frameN;
-  a->bufAllocSmpN = chN*frameN;
-
-  
-  a->buf          = mem::allocZ<sample_t>(a->bufAllocSmpN);
+  a->bufAllocSmpN = _signal_pad_count<sample_t>(chN*frameN);
+  a->buf          = mem::allocAlignedZ<sample_t>(a->bufAllocSmpN,kSignalAlignByteN);
   
   return a;
 }
@@ -557,7 +572,10 @@ cw::flow::abuf_t*  cw::flow::abuf_duplicate( abuf_t* dst, const abuf_t* src )
     abuf = dst;
 
   if( abuf != nullptr )
+  {
     vop::copy(abuf->buf,src->buf,src->chN*src->frameN);
+    abuf->silentFl = src->silentFl;
+  }
 
   return abuf;
 }
@@ -567,6 +585,12 @@ void cw::flow::abuf_zero( abuf_t* abuf )
   vop::zero(abuf->buf,abuf->bufAllocSmpN);
 }
 
+void cw::flow::abuf_set_silent( abuf_t* abuf )
+{
+  vop::zero(abuf->buf,abuf->chN*abuf->frameN);
+  abuf->silentFl = true;
+}
+
 cw::rc_t  cw::flow::abuf_set_channel( abuf_t* abuf, unsigned chIdx, const sample_t* v, unsigned vN )
 {
   rc_t rc = kOkRC;
@@ -577,11 +601,22 @@ cw::rc_t  cw::flow::abuf_set_channel( abuf_t* abuf, unsigned chIdx, const sample
     if( chIdx > abuf->chN )
       rc = cwLogError(kInvalidArgRC,"The abuf destination channel %i is out of range.", chIdx);
     else
+    {
       vop::copy( abuf->buf + (chIdx*abuf->frameN), v, vN);
+      abuf->silentFl = false;
+    }
   
   return rc;
 }
 
+bool cw::flow::abuf_is_aligned( const abuf_t* abuf, unsigned alignByteN )
+{
+  for(unsigned i=0; i<abuf->chN; ++i)
+    if( !_is_aligned(abuf->buf + i*abuf->frameN, alignByteN) )
+      return false;
+  return true;
+}
+
 const cw::flow::sample_t*   cw::flow::abuf_get_channel( abuf_t* abuf, unsigned chIdx )
 {
   assert( abuf->buf != nullptr );
@@ -637,8 +672,11 @@ cw::flow::fbuf_t* cw::flow::fbuf_create( srate_t srate, unsigned chN, const unsi
 
   bool proxy_fl = magV != nullptr || phsV != nullptr || hzV != nullptr;
   
-  // Calculate the total count of bins for each data vector.
-  unsigned maxTotalBinN = proxy_fl ? 0 : vop::sum(maxBinN_V, chN);
+  // Calculate the total count of elements in all of the padded signal vectors.
+  unsigned maxTotalBinN = 0;
+  if( !proxy_fl )
+    for(unsigned i=0; i<chN; ++i)
+      maxTotalBinN += kFbufVectN * _signal_pad_count<fd_sample_t>(maxBinN_V[i]);
   
   // allocate memory
   f->mem       = nullptr;
@@ -668,16 +706,21 @@ cw::flow::fbuf_t* cw::flow::fbuf_create( srate_t srate, unsigned chN, const unsi
   }
   else
   {
-    fd_sample_t* m  = mem::allocZ<fd_sample_t>(maxTotalBinN*kFbufVectN);
-    f->mem = m;
+    fd_sample_t* m  = mem::allocAlignedZ<fd_sample_t>(maxTotalBinN,kSignalAlignByteN);
+    f->mem      = m;
+    f->memByteN = maxTotalBinN * sizeof(fd_sample_t);
+    
     for(unsigned chIdx=0; chIdx<chN; ++chIdx)
-    {   
-      f->magV[chIdx] = m + 0 * f->binN_V[chIdx];
-      f->phsV[chIdx] = m + 1 * f->binN_V[chIdx];
-      f->hzV[ chIdx] = m + 2 * f->binN_V[chIdx];
-      m += f->maxBinN_V[chIdx];
-      assert( m <= m + kFbufVectN * maxTotalBinN );
+    {
+      unsigned strideN = _signal_pad_count<fd_sample_t>(f->maxBinN_V[chIdx]);
+      
+      f->magV[chIdx] = m + 0 * strideN;
+      f->phsV[chIdx] = m + 1 * strideN;
+      f->hzV[ chIdx] = m + 2 * strideN;
+      m += kFbufVectN * strideN;
     }
+    
+    assert( m == (fd_sample_t*)f->mem + maxTotalBinN );
   }
 
   return f;  
@@ -706,6 +749,14 @@ void cw::flow::fbuf_zero( fbuf_t* f )
   }
 }
 
+bool cw::flow::fbuf_is_aligned( const fbuf_t* f, unsigned alignByteN )
+{
+  for(unsigned i=0; i<f->chN; ++i)
+    if( !_is_aligned(f->magV[i],alignByteN) || !_is_aligned(f->phsV[i],alignByteN) || !_is_aligned(f->hzV[i],alignByteN) )
+      return false;
+  return true;
+}
+
 void cw::flow::fbuf_destroy( fbuf_t*& fbuf )
 {
   if( fbuf == nullptr )
@@ -731,7 +782,7 @@ cw::flow::fbuf_t*  cw::flow::fbuf_duplicate( fbuf_t* dst, const fbuf_t* src )
   fbuf_t* fbuf = nullptr;
   
   if( dst != nullptr && dst->memByteN < src->memByteN )
-    fbuf_destroy(dst);
+    fbuf_destroy(dst); // sets dst to nullptr
 
   if( dst == nullptr )
     fbuf = fbuf_create( src->srate, src->chN, src->maxBinN_V, src->binN_V, src->hopSmpN_V );
@@ -752,11 +803,12 @@ cw::flow::fbuf_t*  cw::flow::fbuf_duplicate( fbuf_t* dst, const fbuf_t* src )
 }
 
 
-cw::flow::mbuf_t* cw::flow::mbuf_create( const midi::ch_msg_t* msgA, unsigned msgN )
+cw::flow::mbuf_t* cw::flow::mbuf_create( const midi::ch_msg_t* msgA, unsigned msgN, const unsigned* idxA )
 {
   mbuf_t* m = mem::allocZ<mbuf_t>();
   m->msgA = msgA;
   m->msgN = msgN;
+  m->idxA = idxA;
   return m;
 }
 
@@ -807,7 +859,8 @@ void  cw::flow::fbuf_print( const fbuf_t* fbuf, unsigned verbosity )
 
 cw::flow::mbuf_t* cw::flow::mbuf_duplicate( const mbuf_t* src )
 {
-  return mbuf_create(src->msgA,src->msgN);
+  // the messages are not copied - the duplicate is a view of the same messages
+  return mbuf_create(src->msgA,src->msgN,src->idxA);
 }
 
 void cw::flow::mbuf_print( const mbuf_t* mbuf, unsigned verbosity )
@@ -829,7 +882,10 @@ void cw::flow::mbuf_print( const mbuf_t* mbuf, unsigned verbosity )
     {
       cwLogPrint("[ ");
       for(unsigned i=0; i<mbuf->msgN; ++i)
-        cwLogPrint("(0x%x 0x%x 0x%x) ",mbuf->msgA[i].status + mbuf->msgA[i].ch,mbuf->msgA[i].d0,mbuf->msgA[i].d1);
+      {
+        const midi::ch_msg_t* m = mbuf_msg(mbuf,i);
+        cwLogPrint("(0x%x 0x%x 0x%x) ",m->status + m->ch,m->d0,m->d1);
+      }
       cwLogPrint("] ");
     }    
   }
@@ -2331,6 +2387,212 @@ errLabel:
 */
 
 
+//------------------------------------------------------------------------------------------------------------------------
+//
+// Record Layout
+//
+
+namespace cw {
+  namespace flow {
+
+    unsigned _recd_layout_native_byte_count( unsigned tflag )
+    {
+      switch( tflag )
+      {
+        case kBoolTFl:   return sizeof(bool);
+        case kUIntTFl:   return sizeof(uint_t);
+        case kIntTFl:    return sizeof(int_t);
+        case kFloatTFl:  return sizeof(float);
+        case kDoubleTFl: return sizeof(double);
+      }
+      return 0;
+    }
+
+    void _recd_layout_fields( recd_layout_t* layout, const recd_field_t* fieldL, unsigned depth, unsigned field_idx_offs )
+    {
+      for(const recd_field_t* f=fieldL; f!=nullptr; f=f->link)
+        if( f->group_fl )
+          _recd_layout_fields( layout, f->u.group_fieldL, depth, field_idx_offs );
+        else
+        {
+          recd_layout_field_t* lf = layout->fieldA + field_idx_offs + f->u.index;
+          lf->label = f->label;
+          lf->depth = depth;
+          lf->index = f->u.index;
+          lf->byteN = _recd_layout_native_byte_count(f->value.tflag);
+          lf->tflag = lf->byteN==0 ? (unsigned)kInvalidTFl : f->value.tflag;
+        }
+    }
+
+    template< typename T >
+    void _recd_column_fill( const recd_layout_field_t* f, const rbuf_t* rbuf, T* col )
+    {
+      for(unsigned i=0; i<rbuf->recdN; ++i)
+      {
+        const value_t* v = recd_layout_value(f,rbuf->recdA + i);
+        if( v->tflag == f->tflag )
+          col[i] = recd_native_t<T>::get(v);
+        else
+          value_get(v,col[i]);
+      }
+    }
+    
+  }
+}
+
+cw::rc_t cw::flow::recd_layout_create( recd_layout_t*& layout_ref, const recd_type_t* type )
+{
+  rc_t           rc     = kOkRC;
+  recd_layout_t* layout = mem::allocZ<recd_layout_t>();
+  unsigned       depth  = 0;
+  unsigned       offs   = 0;
+  
+  layout_ref     = nullptr;
+  layout->type   = type;
+  layout->fieldN = recd_type_max_field_count(type);
+  layout->fieldA = mem::allocZ<recd_layout_field_t>(layout->fieldN);
+
+  // locate each field relative to the local record
+  for(const recd_type_t* t=type; t!=nullptr; t=t->base,++depth)
+  {
+    _recd_layout_fields(layout,t->fieldL,depth,offs);
+    offs += t->fieldN;
+  }
+
+  // assign the field offsets - each field is aligned on a multiple of its own size
+  offs = 0;
+  for(unsigned i=0; i<layout->fieldN; ++i)
+  {
+    recd_layout_field_t* f = layout->fieldA + i;
+    
+    if( f->label == nullptr )
+    {
+      rc = cwLogError(kInvalidStateRC,"The record field at index %i could not be located.",i);
+      goto errLabel;
+    }
+    
+    if( f->byteN > 0 )
+    {
+      offs      = ((offs + f->byteN - 1) / f->byteN) * f->byteN;
+      f->offset = offs;
+      offs     += f->byteN;
+    }
+  }
+
+  // pad the row to the largest alignment so that rows may be stored in arrays
+  layout->rowByteN = ((offs + sizeof(double) - 1) / sizeof(double)) * sizeof(double);
+  layout_ref       = layout;
+  
+errLabel:
+  if( rc != kOkRC )
+  {
+    rc = cwLogError(rc,"Record layout create failed.");
+    recd_layout_destroy(layout);
+  }
+  
+  return rc;
+}
+
+void cw::flow::recd_layout_destroy( recd_layout_t*& layout_ref )
+{
+  if( layout_ref != nullptr )
+  {
+    mem::release(layout_ref->fieldA);
+    mem::release(layout_ref);
+  }
+}
+
+cw::rc_t cw::flow::recd_pack( const recd_layout_t* layout, const recd_t* r, void* row )
+{
+  rc_t     rc = kOkRC;
+  uint8_t* b  = (uint8_t*)row;
+
+  for(unsigned i=0; i<layout->fieldN && rc==kOkRC; ++i)
+  {
+    const recd_layout_field_t* f = layout->fieldA + i;
+    const value_t*             v = recd_layout_value(f,r);
+    
+    switch( f->tflag )
+    {
+      case kBoolTFl:   rc = value_get(v,*(bool*)(b + f->offset));   break;
+      case kUIntTFl:   rc = value_get(v,*(uint_t*)(b + f->offset)); break;
+      case kIntTFl:    rc = value_get(v,*(int_t*)(b + f->offset));  break;
+      case kFloatTFl:  rc = value_get(v,*(float*)(b + f->offset));  break;
+      case kDoubleTFl: rc = value_get(v,*(double*)(b + f->offset)); break;
+    }
+
+    if( rc != kOkRC )
+      rc = cwLogError(rc,"Record pack failed on the field '%s'.",cwStringNullGuard(f->label));
+  }
+  
+  return rc;
+}
+
+cw::rc_t cw::flow::recd_columns_create( recd_columns_t*& cols_ref, const recd_layout_t* layout, unsigned allocRecdN )
+{
+  recd_columns_t* cols = mem::allocZ<recd_columns_t>();
+  
+  cols->layout     = layout;
+  cols->mem        = mem::allocZ<uint8_t>(layout->rowByteN * allocRecdN);
+  cols->colA       = mem::allocZ<void*>(layout->fieldN);
+  cols->allocRecdN = allocRecdN;
+
+  // because each field offset is a multiple of the field size each column is also aligned
+  for(unsigned i=0; i<layout->fieldN; ++i)
+    if( layout->fieldA[i].byteN > 0 )
+      cols->colA[i] = ((uint8_t*)cols->mem) + layout->fieldA[i].offset * allocRecdN;
+
+  cols_ref = cols;
+  return kOkRC;
+}
+
+void cw::flow::recd_columns_destroy( recd_columns_t*& cols_ref )
+{
+  if( cols_ref != nullptr )
+  {
+    mem::release(cols_ref->colA);
+    mem::release(cols_ref->mem);
+    mem::release(cols_ref);
+  }
+}
+
+cw::rc_t cw::flow::recd_columns_update( recd_columns_t* cols, const rbuf_t* rbuf )
+{
+  rc_t rc = kOkRC;
+  
+  // recd_array_create() makes a copy of the record type and so the type pointers may not match
+  if( rbuf->type != cols->layout->type && recd_type_max_field_count(rbuf->type) != cols->layout->fieldN )
+  {
+    rc = cwLogError(kInvalidArgRC,"The record buffer type does not match the record layout.");
+    goto errLabel;
+  }
+
+  if( rbuf->recdN > cols->allocRecdN )
+  {
+    rc = cwLogError(kBufTooSmallRC,"The record buffer count (%i) is greater than the column buffer size (%i).",rbuf->recdN,cols->allocRecdN);
+    goto errLabel;
+  }
+
+  for(unsigned i=0; i<cols->layout->fieldN; ++i)
+  {
+    const recd_layout_field_t* f = cols->layout->fieldA + i;
+    switch( f->tflag )
+    {
+      case kBoolTFl:   _recd_column_fill(f,rbuf,(bool*)  cols->colA[i]); break;
+      case kUIntTFl:   _recd_column_fill(f,rbuf,(uint_t*)cols->colA[i]); break;
+      case kIntTFl:    _recd_column_fill(f,rbuf,(int_t*) cols->colA[i]); break;
+      case kFloatTFl:  _recd_column_fill(f,rbuf,(float*) cols->colA[i]); break;
+      case kDoubleTFl: _recd_column_fill(f,rbuf,(double*)cols->colA[i]); break;
+    }
+  }
+
+  cols->recdN = rbuf->recdN;
+  
+errLabel:
+  return rc;
+}
+
+
 //------------------------------------------------------------------------------------------------------------------------
 //
 // List
@@ -20,7 +20,8 @@ namespace cw
       kFbufVectN = 3,  // count of signal vectors in fbuf (mag,phs,hz)
       kAnyChIdx = kInvalidIdx,
       kDefaultFramesPerCycle=64,
-      kDefaultSampleRate=48000
+      kDefaultSampleRate=48000,
+      kSignalAlignByteN=64 // alignment and padding of abuf and fbuf signal vectors (one cache line)
     };
         
     typedef struct abuf_str
@@ -28,15 +29,16 @@ namespace cw
       srate_t            srate;        // Signal sample rate
       unsigned           chN;          // Count of channels
       unsigned           frameN;       // Count of sample frames per channel
-      unsigned           bufAllocSmpN; // Size of allocated buf[] in samples.
+      unsigned           bufAllocSmpN; // Size of allocated buf[] in samples. (padded to a multiple of kSignalAlignByteN)
       sample_t*          buf;          // buf[ chN * frameN ] ch0: 0:frameN, ch1: frameN:2*frame, ...
+      bool               silentFl;     // true if buf[] is known to contain only zeros (See abuf_set_silent())
     } abuf_t;
 
 
     typedef struct fbuf_str
     {
       unsigned          memByteN;  // Count of bytes in mem[].
-      void*             mem;       // mem[ memByteN ] All dynamically allocated memory used by this fbuf.
+      void*             mem;       // mem[ memByteN ] Signal vector memory. Each vector is aligned to kSignalAlignByteN.
       
       srate_t           srate;     // signal sample rate
       unsigned          flags;     // See kXXXFbufFl
@@ -50,12 +52,24 @@ namespace cw
       bool*             readyFlV;  // readyFlV[chN] true if this channel is ready to be processed (used to sync. fbuf rate to abuf rate)
     } fbuf_t;
 
+    // An mbuf is a read-only view of MIDI messages owned by the proc that produced them.
+    // The view remains valid until the producing proc next executes and may therefore
+    // be shared by any number of downstream procs without copying.
     typedef struct mbuf_str
     {
       const midi::ch_msg_t* msgA;
       unsigned              msgN;
+      const unsigned*       idxA;  // (optional) idxA[ msgN ] When set this is an index view: the i'th msg is msgA[ idxA[i] ]
     } mbuf_t;
 
+    // Return the i'th message in an mbuf (use this rather than msgA[i] to support index views).
+    inline const midi::ch_msg_t* mbuf_msg( const mbuf_t* mbuf, unsigned i )
+    { return mbuf->idxA == nullptr ? mbuf->msgA + i : mbuf->msgA + mbuf->idxA[i]; }
+
+    // Return the index into mbuf->msgA[] of the i'th message in an mbuf.
+    inline unsigned mbuf_msg_index( const mbuf_t* mbuf, unsigned i )
+    { return mbuf->idxA == nullptr ? i : mbuf->idxA[i]; }
+
     enum
     {
       kInvalidTFl  = 0x00000000,
@@ -165,6 +179,10 @@ namespace cw
     const char*    value_print_verbosity_to_string( unsigned verbosity );
 
     
+    // The signal buffer is aligned to kSignalAlignByteN and padded to a multiple of kSignalAlignByteN
+    // so that buffers written by different proc's never share a cache line.
+    // Channels are stored contiguously, and therefore every channel is aligned when
+    // frameN*sizeof(sample_t) is a multiple of kSignalAlignByteN (e.g. frameN is a multiple of 16).
     abuf_t*         abuf_create( srate_t srate, unsigned chN, unsigned frameN );
     void            abuf_destroy( abuf_t*& buf );
     void            abuf_print( const abuf_t* abuf, unsigned verbosity );
@@ -174,19 +192,35 @@ namespace cw
     // If there is not enough space then dst is reallocated.
     abuf_t*         abuf_duplicate( abuf_t* dst, const abuf_t* src );
     void            abuf_zero(        abuf_t* buf );
+
+    // Zero 'buf' and mark it as silent. Proc's which declare a 'bypass' with 'silence_fl' set
+    // do not execute when all of their inputs are silent.
+    // The silence flag of a proc's audio outputs is cleared prior to every call to the proc's exec().
+    void            abuf_set_silent(  abuf_t* buf );
+    inline bool     abuf_is_silent(   const abuf_t* buf ) { return buf->silentFl; }
+    
     rc_t            abuf_set_channel( abuf_t* buf, unsigned chIdx, const sample_t* v, unsigned vN );
     const sample_t* abuf_get_channel( abuf_t* buf, unsigned chIdx );
 
+    // Return true if every channel of the buffer begins on an 'alignByteN' boundary.
+    // Vectorized proc's should assert this prior to using aligned loads and stores.
+    bool            abuf_is_aligned( const abuf_t* buf, unsigned alignByteN=kSignalAlignByteN );
+
+    // Unless the vectors are supplied by the caller (magV,phsV,hzV) every mag, phs and hz vector
+    // is allocated on a kSignalAlignByteN boundary and is padded to a multiple of kSignalAlignByteN.
     fbuf_t*        fbuf_create( srate_t srate, unsigned chN, const unsigned* maxBinN_V, const unsigned* binN_V, const unsigned* hopSmpN_V, const fd_sample_t** magV=nullptr, const fd_sample_t** phsV=nullptr, const fd_sample_t** hzV=nullptr );
     fbuf_t*        fbuf_create( srate_t srate, unsigned chN, unsigned maxBinN, unsigned binN, unsigned hopSmpN, const fd_sample_t** magV=nullptr, const fd_sample_t** phsV=nullptr, const fd_sample_t** hzV=nullptr );
     void           fbuf_zero( fbuf_t* fbuf );
     void           fbuf_destroy( fbuf_t*& buf );
     void           fbuf_print( const fbuf_t* fbuf, unsigned verbosity );
 
+    // Return true if every signal vector of the buffer begins on an 'alignByteN' boundary.
+    bool           fbuf_is_aligned( const fbuf_t* fbuf, unsigned alignByteN=kSignalAlignByteN );
+
     // Memory allocation will only occur if dst is null, or the size of dst's internal buffer are too small.
     fbuf_t*        fbuf_duplicate( fbuf_t* dst, const fbuf_t* src );
 
-    mbuf_t*        mbuf_create( const midi::ch_msg_t* msgA=nullptr, unsigned msgN=0 );
+    mbuf_t*        mbuf_create( const midi::ch_msg_t* msgA=nullptr, unsigned msgN=0, const unsigned* idxA=nullptr );
     void           mbuf_destroy( mbuf_t*& buf );
     mbuf_t*        mbuf_duplicate( const mbuf_t* src );
     void           mbuf_print( const mbuf_t* mbuf, unsigned verbosity );
@@ -477,6 +511,142 @@ namespace cw
     //rc_t recd_copy( const recd_type_t* src_recd_type, const recd_t* src_recdA, unsigned src_recdN, recd_array_t* dst_recd_array, unsigned dst_recd_idx = 0 );
 
 
+    //------------------------------------------------------------------------------------------------------------------------
+    //
+    // Record Layout
+    //
+    // A record layout is a compiled form of a recd_type_t.  Every field, including the inherited
+    // fields, is resolved to a (base depth, value index) pair and given a fixed byte offset in a
+    // packed, native-typed, row.  Fields which are not bool,uint,int,float or double are located
+    // but not packed.
+
+    typedef struct recd_layout_field_str
+    {
+      const char* label;   // field label
+      unsigned    tflag;   // native type of this field or kInvalidTFl if the field is not packed
+      unsigned    depth;   // count of recd_t.base links to follow to reach the record which holds this field
+      unsigned    index;   // index into recd_t.valA[] of the record at 'depth'
+      unsigned    offset;  // byte offset of this field in a packed row
+      unsigned    byteN;   // size of this field in a packed row (0 if the field is not packed)
+    } recd_layout_field_t;
+
+    typedef struct recd_layout_str
+    {
+      const recd_type_t*   type;
+      recd_layout_field_t* fieldA;   // fieldA[ fieldN ] indexed by the recd_type_field_index() of the field
+      unsigned             fieldN;   // count of local and inherited fields
+      unsigned             rowByteN; // size of a packed row
+    } recd_layout_t;
+
+    rc_t recd_layout_create( recd_layout_t*& layout_ref, const recd_type_t* type );
+    void recd_layout_destroy( recd_layout_t*& layout_ref );
+
+    // Return the value of a field without walking the recd_type_t chain.
+    inline const value_t* recd_layout_value( const recd_layout_field_t* f, const recd_t* r )
+    {
+      for(unsigned i=0; i<f->depth; ++i)
+        r = r->base;
+      return r->valA + f->index;
+    }
+
+    // Write the packed fields of 'r' into row[ layout->rowByteN ].
+    rc_t recd_pack( const recd_layout_t* layout, const recd_t* r, void* row );
+
+    // Map a native type to a value_t type flag and union member.
+    template< typename T > struct recd_native_t;
+    template<> struct recd_native_t<bool>     { enum { tflag=kBoolTFl   }; static bool     get( const value_t* v ) { return v->u.b; } static void set( value_t* v, bool x )     { v->u.b=x; } };
+    template<> struct recd_native_t<uint_t>   { enum { tflag=kUIntTFl   }; static uint_t   get( const value_t* v ) { return v->u.u; } static void set( value_t* v, uint_t x )   { v->u.u=x; } };
+    template<> struct recd_native_t<int_t>    { enum { tflag=kIntTFl    }; static int_t    get( const value_t* v ) { return v->u.i; } static void set( value_t* v, int_t x )    { v->u.i=x; } };
+    template<> struct recd_native_t<float>    { enum { tflag=kFloatTFl  }; static float    get( const value_t* v ) { return v->u.f; } static void set( value_t* v, float x )    { v->u.f=x; } };
+    template<> struct recd_native_t<double>   { enum { tflag=kDoubleTFl }; static double   get( const value_t* v ) { return v->u.d; } static void set( value_t* v, double x )   { v->u.d=x; } };
+
+    // Typed field accessor.  The field location is resolved once by recd_accessor_create().
+    // recd_read() and recd_write() then access the value union directly when the stored
+    // value has the native type of the accessor and fall back to value_get()/value_set() otherwise.
+    template< typename T >
+    struct recd_accessor_t
+    {
+      unsigned depth;
+      unsigned index;
+    };
+
+    template< typename T >
+    rc_t recd_accessor_create( const recd_layout_t* layout, unsigned field_idx, recd_accessor_t<T>& acc_ref )
+    {
+      if( field_idx >= layout->fieldN )
+        return cwLogError(kInvalidArgRC,"The record field index %i is out of range (%i).",field_idx,layout->fieldN);
+
+      acc_ref.depth = layout->fieldA[ field_idx ].depth;
+      acc_ref.index = layout->fieldA[ field_idx ].index;
+      return kOkRC;
+    }
+
+    template< typename T >
+    rc_t recd_accessor_create( const recd_layout_t* layout, const char* field_label, recd_accessor_t<T>& acc_ref )
+    {
+      unsigned field_idx;
+      if((field_idx = recd_type_field_index(layout->type,field_label)) == kInvalidIdx )
+        return kInvalidArgRC;
+      return recd_accessor_create(layout,field_idx,acc_ref);
+    }
+
+    template< typename T >
+    inline rc_t recd_read( const recd_accessor_t<T>& acc, const recd_t* r, T& val_ref )
+    {
+      for(unsigned i=0; i<acc.depth; ++i)
+        r = r->base;
+
+      const value_t* v = r->valA + acc.index;
+      
+      if( v->tflag != (unsigned)recd_native_t<T>::tflag )
+        return value_get(v,val_ref);
+      
+      val_ref = recd_native_t<T>::get(v);
+      return kOkRC;
+    }
+
+    // Only local fields (depth==0) may be written.
+    template< typename T >
+    inline rc_t recd_write( const recd_accessor_t<T>& acc, recd_t* r, T val )
+    {
+      if( acc.depth != 0 )
+        return cwLogError(kInvalidArgRC,"Fields in the inherited record may not be set.");
+
+      value_t* v = r->valA + acc.index;
+      
+      if( v->tflag != (unsigned)recd_native_t<T>::tflag )
+        return value_set(v,val);
+      
+      recd_native_t<T>::set(v,val);
+      return kOkRC;
+    }
+
+    // Struct-of-arrays view of a buffer of records. Each packed field is held in a contiguous,
+    // native-typed, column.  All columns share a single allocation.
+    typedef struct recd_columns_str
+    {
+      const recd_layout_t* layout;
+      void*                mem;        // mem[ allocRecdN * layout->rowByteN ]
+      void**               colA;       // colA[ layout->fieldN ] column base address or nullptr if the field is not packed
+      unsigned             allocRecdN;
+      unsigned             recdN;
+    } recd_columns_t;
+
+    rc_t recd_columns_create( recd_columns_t*& cols_ref, const recd_layout_t* layout, unsigned allocRecdN );
+    void recd_columns_destroy( recd_columns_t*& cols_ref );
+
+    // Fill the columns from the records in 'rbuf'. 'rbuf->type' must match the layout type.
+    rc_t recd_columns_update( recd_columns_t* cols, const rbuf_t* rbuf );
+
+    // Return the column associated with 'field_idx' or nullptr if the field is not packed as type T.
+    template< typename T >
+    const T* recd_column( const recd_columns_t* cols, unsigned field_idx )
+    {
+      if( field_idx >= cols->layout->fieldN || cols->layout->fieldA[ field_idx ].tflag != (unsigned)recd_native_t<T>::tflag )
+        return nullptr;
+      return (const T*)cols->colA[ field_idx ];
+    }
+
     //------------------------------------------------------------------------------------------------------------------------
     //
     // List
@@ -4393,6 +4393,24 @@ cw::rc_t cw::io::uiSendMsg( handle_t h, const char* msg )
   return rc;
 }
 
+cw::rc_t cw::io::uiBeginBatch( handle_t h )
+{
+  io_t* p = _handleToPtr(h);
+  rc_t   rc = kOkRC;
+  if( p->wsUiH.isValid() )
+    rc = ui::beginBatch( ui::ws::uiHandle(p->wsUiH) );
+  return rc;
+}
+
+cw::rc_t cw::io::uiEndBatch( handle_t h )
+{
+  io_t* p = _handleToPtr(h);
+  rc_t   rc = kOkRC;
+  if( p->wsUiH.isValid() )
+    rc = ui::endBatch( ui::ws::uiHandle(p->wsUiH) );
+  return rc;
+}
+
 void cw::io::latency_measure_setup(handle_t h)
 {
   io_t* p = _handleToPtr(h);
@@ -467,6 +467,11 @@ namespace cw
 
     rc_t uiSendMsg( handle_t h, const char* msg );
 
+    // Send the UI messages generated by the calling thread between uiBeginBatch() and uiEndBatch() as a single message.
+    // These functions do nothing if the UI is not enabled. See ui::beginBatch().
+    rc_t uiBeginBatch( handle_t h );
+    rc_t uiEndBatch( handle_t h );
+
 
     typedef struct
     {
@@ -88,6 +88,7 @@ namespace cw
 
 
     const unsigned hashN = 0xffff;
+    const unsigned kBatchByteN = 16384; // size of the beginBatch()/endBatch() message buffer
     
     typedef struct bucket_str
     {
@@ -95,6 +96,17 @@ namespace cw
       struct bucket_str* link;
     } bucket_t;
 
+    // Collects outgoing messages into a single '{"op":"cache", "array":[...]}' message.
+    typedef struct msg_cache_str
+    {
+      unsigned sessId; // session id of the cached msg's or kInvalidId to send to all sessions
+      char*    buf;    // buf[allocN]
+      unsigned allocN;
+      unsigned dataN;  // allocN less the space reserved to terminate the message
+      unsigned N;      // count of bytes in use
+      unsigned msgN;   // count of msg's in the buffer
+    } msg_cache_t;
+
     typedef struct ui_str
     {
       unsigned        eleAllocN; // size of eleA[]
@@ -117,13 +129,12 @@ namespace cw
       unsigned        sessN;
       unsigned        sessAllocN;
            
-      bool     msgCacheEnableFl;
-      unsigned msgCacheSessId;
-      char*    msgCache;
-      unsigned msgCacheAllocN;
-      unsigned msgCacheDataN;
-      unsigned msgCacheN;
-      unsigned msgCacheMsgN;
+      bool        msgCacheEnableFl;
+      msg_cache_t msgCache;
+
+      // Messages sent from the thread which called beginBatch() are collected in 'batch' until endBatch().
+      std::atomic<thread::thread_id_t> batchThreadId; // 0=no batch in progress
+      msg_cache_t                      batch;
 
       unsigned sentMsgN;
       unsigned recvMsgN;
@@ -317,6 +328,8 @@ namespace cw
       mem::release(p->eleA);
       mem::release(p->buf);
       mem::release(p->recvBuf);
+      mem::release(p->msgCache.buf);
+      mem::release(p->batch.buf);
 
       if( p->uiRsrc != nullptr )
         p->uiRsrc->free();
@@ -489,64 +502,78 @@ namespace cw
     }
 
     
-    rc_t _cache_flush( ui_t* p )
+    void _cache_reset( msg_cache_t* c )
+    {
+      c->N      = snprintf(c->buf,c->dataN,"{\"op\":\"cache\", \"array\": [");
+      c->sessId = kInvalidId;
+      c->msgN   = 0;
+    }
+
+    void _cache_alloc( msg_cache_t* c, unsigned allocN )
+    {
+      c->allocN = allocN;
+      c->dataN  = c->allocN - 3; // "]}/0" three char's must be reserved to terminate the cache message (See _cache_flush().)
+      c->buf    = mem::allocZ<char>( c->allocN );
+      _cache_reset(c);
+    }
+    
+    rc_t _cache_flush( ui_t* p, msg_cache_t* c )
     {
       rc_t rc = kOkRC;
 
-      if( p->msgCacheMsgN > 0 )
+      if( c->msgN > 0 )
       {        
-        assert( p->msgCacheN <= p->msgCacheDataN );
-        p->msgCache[ p->msgCacheN+0 ] = ']';
-        p->msgCache[ p->msgCacheN+1 ] = '}';
-        p->msgCache[ p->msgCacheN+2 ] = 0;
-              
-        rc = _send_callback(p, p->msgCacheSessId, p->msgCache, strlen(p->msgCache) );
+        assert( c->N <= c->dataN );
+        c->buf[ c->N+0 ] = ']';
+        c->buf[ c->N+1 ] = '}';
+        c->buf[ c->N+2 ] = 0;
 
-        p->msgCacheN      = snprintf(p->msgCache,p->msgCacheAllocN,"{\"op\":\"cache\", \"array\": [");     
-        p->msgCacheSessId = kInvalidId;
-        p->msgCacheMsgN   = 0;
+        unsigned msgByteN = strlen(c->buf);
 
+        if( c->sessId != kInvalidId )
+          rc = _send_callback(p, c->sessId, c->buf, msgByteN );
+        else
+        {
+          for(unsigned i=0; i<p->sessN; ++i)
+            rc = _send_callback(p, p->sessA[i], c->buf, msgByteN );
+        }
+
+        _cache_reset(c);
       }
       
       return rc;
     }
 
-    rc_t _cache_send( ui_t* p, unsigned wsSessId, const char* msg, unsigned msgByteN )
+    rc_t _cache_send( ui_t* p, msg_cache_t* c, unsigned wsSessId, const char* msg, unsigned msgByteN )
     {
       rc_t rc = kOkRC;
 
       unsigned msgByteCommaN = msgByteN + 1;
 
       // if the cache buffer has not yet been allocated
-      if( p->msgCache == nullptr && p->msgCacheAllocN>0 )
-      {
-        p->msgCacheDataN  = p->msgCacheAllocN - 3; // "]}/0" three char's must be reserved to terminate the cache message (See _cache_flush().)
-        p->msgCache       = mem::allocZ<char>( p->msgCacheAllocN );
-        p->msgCacheSessId = kInvalidId;
-        p->msgCacheN      = snprintf(p->msgCache,p->msgCacheDataN,"{\"op\":\"cache\", \"array\": [");
-        p->msgCacheMsgN   = 0;
-      }
+      if( c->buf == nullptr && c->allocN>0 )
+        _cache_alloc(c,c->allocN);
       
-      if( wsSessId != p->msgCacheSessId ||  p->msgCacheN + msgByteCommaN > p->msgCacheDataN  || msgByteN > p->msgCacheDataN )        
-        rc = _cache_flush(p);
+      if( wsSessId != c->sessId ||  c->N + msgByteCommaN > c->dataN  || msgByteN > c->dataN )        
+        rc = _cache_flush(p,c);
 
-      if( msgByteN > p->msgCacheDataN )
+      if( msgByteN > c->dataN )
         rc = _send_callback(p, wsSessId, msg, msgByteN );
       else
       {
-        assert( p->msgCacheN + msgByteCommaN <= p->msgCacheDataN );
+        assert( c->N + msgByteCommaN <= c->dataN );
 
         // if this isn't the first msg is the buffer then prepend a ','
-        if( p->msgCacheMsgN != 0 )
-          strncat(p->msgCache,",",2);
+        if( c->msgN != 0 )
+          strncat(c->buf,",",2);
         else
           msgByteCommaN -= 1;  // otherwise the msgByteCommaN is the same as msgByteN
         
-        strncat(p->msgCache,msg,msgByteN);
+        strncat(c->buf,msg,msgByteN);
         
-        p->msgCacheN += msgByteCommaN;
-        p->msgCacheSessId = wsSessId;
-        p->msgCacheMsgN += 1;
+        c->N     += msgByteCommaN;
+        c->sessId = wsSessId;
+        c->msgN  += 1;
       }
       
       return rc;
@@ -556,7 +583,7 @@ namespace cw
     {
       rc_t rc = kOkRC;
       if( p->msgCacheEnableFl )
-        rc = _cache_send( p, sessId, msg, msgByteCnt );
+        rc = _cache_send( p, &p->msgCache, sessId, msg, msgByteCnt );
       else
         rc =  _send_callback(p, sessId, msg, msgByteCnt );
 
@@ -571,6 +598,10 @@ namespace cw
       {
         unsigned msgByteN = msg==nullptr ? 0 : strlen(msg);
 
+        // messages to all sessions are cached once and broadcast by _cache_flush()
+        if( p->batch.buf != nullptr && p->batchThreadId.load(std::memory_order_acquire) == thread::id() )
+          rc = _cache_send( p, &p->batch, wsSessId, msg, msgByteN );
+        else
         if( wsSessId != kInvalidId )
           rc = _send_or_cache( p, wsSessId, msg, msgByteN );
         else
@@ -1480,7 +1511,9 @@ cw::rc_t cw::ui::create(
   p->recvBufIdx = 0;
   p->recvShiftN = 0;
   p->uiRsrc     = uiRsrc->duplicate();
-  p->msgCacheSessId = kInvalidId;
+  p->msgCache.sessId = kInvalidId;
+  
+  _cache_alloc(&p->batch, kBatchByteN );
   
   // create the root element
   if((ele = _createBaseEle(p, nullptr, kRootAppId, kInvalidId, "uiDivId" )) == nullptr || ele->uuId != kRootUuId )
@@ -1541,7 +1574,7 @@ cw::rc_t cw::ui::enableCache( handle_t h, unsigned cacheByteCnt )
 {
   ui_t* p = _handleToPtr(h);
   p->msgCacheEnableFl = true;
-  p->msgCacheAllocN = cacheByteCnt;
+  p->msgCache.allocN  = cacheByteCnt;
   return kOkRC;
 }
 
@@ -1550,12 +1583,38 @@ cw::rc_t cw::ui::flushCache( handle_t h )
   rc_t rc = kOkRC;
   ui_t* p = _handleToPtr(h);
 
-  if( p->msgCacheEnableFl && p->msgCache != nullptr )
-    rc =_cache_flush(p);
+  if( p->msgCacheEnableFl && p->msgCache.buf != nullptr )
+    rc =_cache_flush(p,&p->msgCache);
   return rc;
  }
 
 
+cw::rc_t cw::ui::beginBatch( handle_t h )
+{
+  ui_t*               p   = _handleToPtr(h);
+  thread::thread_id_t id0 = 0;
+
+  if( !p->batchThreadId.compare_exchange_strong(id0,thread::id(),std::memory_order_acq_rel) )
+    return id0 == thread::id() ? kOkRC : kInvalidStateRC; // a batch is already in progress
+  
+  return kOkRC;
+}
+
+cw::rc_t cw::ui::endBatch( handle_t h )
+{
+  rc_t  rc = kOkRC;
+  ui_t* p  = _handleToPtr(h);
+
+  if( p->batchThreadId.load(std::memory_order_acquire) != thread::id() )
+    return kInvalidStateRC;
+  
+  rc = _cache_flush(p,&p->batch);
+  
+  p->batchThreadId.store(0,std::memory_order_release);
+  
+  return rc;
+}
+
 unsigned        cw::ui::sessionIdCount(handle_t h)
 {
   ui_t* p = _handleToPtr(h);
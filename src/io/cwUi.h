@@ -36,6 +36,12 @@ namespace cw
 
     rc_t enableCache( handle_t h, unsigned cacheByteCnt=4096 );
     rc_t flushCache( handle_t h );
+
+    // Collect the messages sent by the calling thread until endBatch() and then send them as a single message.
+    // Messages sent by other threads during the batch are not affected.
+    // beginBatch() returns kInvalidStateRC if another thread has a batch in progress.
+    rc_t beginBatch( handle_t h );
+    rc_t endBatch( handle_t h );
     
     unsigned        sessionIdCount(handle_t h);  // Count of connected remote UI's
     const unsigned* sessionIdArray(handle_t h);  // Array of 'sessionIdCount()' remote UI id's
@@ -10,6 +10,7 @@
 #include "cwFileSys.h"
 #include "cwFile.h"
 #include "cwTime.h"
+#include "cwThread.h"
 #include "cwVectOps.h"
 #include "cwMtx.h"
 #include "cwTime.h"
@@ -23,6 +24,7 @@
 #include "cwFlow.h"
 #include "cwFlowValue.h"
 #include "cwFlowTypes.h"
+#include "cwFlowSwap.h"
 
 #include "cwIo.h"
 
@@ -86,6 +88,12 @@ namespace cw
 
       bool            init_fl; 
       bool            done_fl;
+
+      // program swap
+      flow::swap::swap_t    swap;            //
+      unsigned              next_pgm_idx;    //
+      char*                 next_proj_dir;   //
+      bool                  ui_attach_fl;    // false while the UI of a swapped-in program has not been attached (See program_ui_attached())
     } io_flow_ctl_t;
 
     io_flow_ctl_t* _handleToPtr( handle_t h )
@@ -103,7 +111,9 @@ namespace cw
           mem::release( ag->iDeviceA[di].abuf.buf );
 
         for(unsigned di=0; di<ag->oDeviceN; ++di)
+        {
           mem::release( ag->oDeviceA[di].abuf.buf );
+        }
 
         mem::release( ag->iDeviceA);
         mem::release( ag->oDeviceA);
@@ -113,9 +123,16 @@ namespace cw
       p->audioGroupN = 0;
     }
     
+    rc_t _swap_release( io_flow_ctl_t* p );
+    
     rc_t _program_unload( io_flow_ctl_t* p )
     {
       rc_t rc;
+
+      // release any pending program swap
+      if((rc = _swap_release(p)) != kOkRC )
+        goto errLabel;
+      
       if((rc = destroy(p->flowH)) != kOkRC )
       {
         rc = cwLogError(rc,"Program unload failed.");
@@ -208,6 +225,7 @@ namespace cw
       const object_t* pgmL             = nullptr;
       const object_t* tracer_cfg       = nullptr;  // tracer_cfg is parsed just to satify readv() it is not used by cwIoFlowCtl
       const object_t* log_cfg          = nullptr;
+      const char*     cache_dir        = nullptr;  // optional directory of binary images of the proc and udp dictionaries
       
       // parse the cfg parameters
       if((rc = cfg->readv("base_dir",    kReqFl,   p->base_dir,
@@ -216,6 +234,7 @@ namespace cw
                           "io_dict",     kOptFl,   io_cfg_fname,
                           "tracer",      kOptFl,   tracer_cfg,
                           "log",         kOptFl,   log_cfg,
+                          "cache_dir",   kOptFl,   cache_dir,
                           "programs",    kDictTId, pgmL)) != kOkRC )
       {
         rc = cwLogError(rc,"'caw' system parameter processing failed.");
@@ -223,14 +242,14 @@ namespace cw
       }
 
       // parse the proc dict. file
-      if((rc = objectFromFile(proc_cfg_fname,p->proc_class_dict_cfg)) != kOkRC )
+      if((rc = objectFromFileCached(proc_cfg_fname,cache_dir,p->proc_class_dict_cfg)) != kOkRC )
       {
         rc = cwLogError(rc,"The flow proc dictionary could not be read from '%s'.",cwStringNullGuard(proc_cfg_fname));
         goto errLabel;
       }
 
       // parse the udp dict file
-      if((rc = objectFromFile(udp_cfg_fname,p->udp_dict_cfg)) != kOkRC )
+      if((rc = objectFromFileCached(udp_cfg_fname,cache_dir,p->udp_dict_cfg)) != kOkRC )
       {
         rc = cwLogError(rc,"The flow user-defined-proc dictionary could not be read from '%s'.",cwStringNullGuard(udp_cfg_fname));
         goto errLabel;
@@ -291,7 +310,8 @@ namespace cw
       dev->abuf.srate  = audioDeviceSampleRate(   p->ioH, ioDevIdx );
       dev->abuf.chN    = audioDeviceChannelCount( p->ioH, ioDevIdx, inOrOutFl );
       dev->abuf.frameN = dspFrameCnt;
-      dev->abuf.buf    = mem::allocZ< flow::sample_t >( dev->abuf.chN * dev->abuf.frameN );
+      dev->abuf.bufAllocSmpN = dev->abuf.chN * dev->abuf.frameN;
+      dev->abuf.buf    = mem::allocAlignedZ< flow::sample_t >( dev->abuf.bufAllocSmpN, flow::kSignalAlignByteN );
 
       //printf("%i %s\n", dev->abuf.chN, audioDeviceLabel( p->ioH, ioDevIdx ) );
 
@@ -420,7 +440,7 @@ namespace cw
 
     }
 
-    rc_t _device_index_to_abuf( io_flow_ctl_t* p, unsigned ioGroupIdx, unsigned ioDevIdx, unsigned inOrOutFl, unsigned ioDevErrCnt, unsigned overrunCnt, flow::abuf_t*& abuf_ref )
+    rc_t _device_index_to_audio_dev( io_flow_ctl_t* p, unsigned ioGroupIdx, unsigned ioDevIdx, unsigned inOrOutFl, unsigned ioDevErrCnt, unsigned overrunCnt, audio_dev_t*& ad_ref )
     {
 
       rc_t rc = kOkRC;
@@ -436,7 +456,7 @@ namespace cw
             {
               adA[di].adc->ioDevErrCnt = ioDevErrCnt;
               adA[di].adc->overrunCnt = overrunCnt;
-              abuf_ref = &adA[di].abuf;
+              ad_ref = adA + di;
               return rc;
             }
         
@@ -446,6 +466,17 @@ namespace cw
       return cwLogError(kOpFailRC,"The '%s' audio group index:%i ,device index '%i' was not found.", dir, ioGroupIdx, ioDevIdx);
     }
 
+    rc_t _device_index_to_abuf( io_flow_ctl_t* p, unsigned ioGroupIdx, unsigned ioDevIdx, unsigned inOrOutFl, unsigned ioDevErrCnt, unsigned overrunCnt, flow::abuf_t*& abuf_ref )
+    {
+      rc_t         rc;
+      audio_dev_t* ad = nullptr;
+      
+      if((rc = _device_index_to_audio_dev(p,ioGroupIdx,ioDevIdx,inOrOutFl,ioDevErrCnt,overrunCnt,ad)) == kOkRC )
+        abuf_ref = &ad->abuf;
+      
+      return rc;
+    }
+
     void _fill_input_buffer( flow::sample_t** bufChArray, unsigned bufChArrayN, flow::abuf_t* dst_abuf )
     {
       for(unsigned i=0; i<bufChArrayN; ++i)
@@ -532,8 +563,11 @@ namespace cw
       }
 
 
+      // the UI updates generated by this cycle are sent as a single message
+      io::uiBeginBatch(p->ioH);
+      
       // update the flow network - this will generate audio into the output audio buffers
-      if((rc = flow::exec_cycle(p->flowH)) != kOkRC )
+      if((rc = flow::swap::exec_cycle(p->swap,p->flowH)) != kOkRC )
       {
         if( rc == kEofRC )
         {
@@ -542,6 +576,8 @@ namespace cw
           rc = kOkRC;
         }
       }
+
+      io::uiEndBatch(p->ioH);
       
 
       // if there are empty output (playback) buffers
@@ -641,11 +677,9 @@ namespace cw
         
       io_flow_ctl_t* p = (io_flow_ctl_t*)arg;
 
+      // the variables of a program whose UI has not been attached have no user_arg
       if( ui_var->user_arg == nullptr )
-      {
-        rc = cwLogError(kInvalidArgRC,"The user_id (uuid) of the variable was not set.");
-        goto errLabel;
-      }
+        return rc;
 
       // for each UI mod. msg in ui_var->msgIdA[]
       for(unsigned i=0; i<ui_var->msgId_idx; ++i)
@@ -728,6 +762,50 @@ namespace cw
       return rc;
       
     }
+
+    // Adopt the program index and project directory of a completed program swap.
+    void _swap_adopt( io_flow_ctl_t* p )
+    {
+      mem::release(p->proj_dir);
+      
+      p->proj_dir      = p->next_proj_dir;
+      p->pgm_idx       = p->next_pgm_idx;
+      p->init_fl       = true;
+      p->done_fl       = false;
+      p->ui_attach_fl  = false;
+      p->next_proj_dir = nullptr;
+    }
+
+    // Complete a finished swap and release the resources of an unfinished swap.
+    // The audio thread must not be running.
+    rc_t _swap_release( io_flow_ctl_t* p )
+    {
+      rc_t rc      = kOkRC;
+      bool done_fl = false;
+      
+      rc = flow::swap::release(p->swap,p->flowH,done_fl);
+
+      if( done_fl )
+        _swap_adopt(p);
+      else
+        mem::release(p->next_proj_dir);
+      
+      return rc;
+    }
+
+    // Complete a swap which the audio thread has finished.
+    rc_t _swap_update( io_flow_ctl_t* p, bool& pending_fl_ref, bool& done_fl_ref )
+    {
+      rc_t rc = flow::swap::update(p->swap,p->flowH,pending_fl_ref,done_fl_ref);
+
+      if( done_fl_ref )
+        _swap_adopt(p);
+      else
+        if( !pending_fl_ref )
+          mem::release(p->next_proj_dir);
+
+      return rc;
+    }
     
   }
 }
@@ -884,6 +962,86 @@ errLabel:
   return rc;
 }
 
+cw::rc_t cw::io_flow_ctl::program_swap( handle_t h, unsigned pgm_idx, unsigned preset_idx, double xfade_ms )
+{
+  rc_t                 rc    = kOkRC;
+  io_flow_ctl_t*       p     = _handleToPtr(h);
+  flow::abuf_t**       oBufA = nullptr;
+  unsigned             oBufN = 0;
+  flow::swap::args_t   args;
+
+  if((rc = _validate_pgm_idx(p,pgm_idx)) != kOkRC )
+    return rc;
+
+  if( !p->init_fl || p->done_fl || is_non_real_time(p->flowH) )
+    return cwLogError(kInvalidStateRC,"A program swap requires an initialized real-time program.");
+
+  if( flow::swap::state(p->swap) != flow::swap::kIdleStateId )
+    return cwLogError(kInvalidStateRC,"A program swap is already in progress.");
+
+  // form and create the next program project directory
+  if((p->next_proj_dir = filesys::makeFn(p->base_dir,nullptr,nullptr,p->pgmA[pgm_idx].label,nullptr)) == nullptr )
+  {
+    rc = cwLogError(kOpFailRC,"The project directory formation failed.");
+    goto errLabel;
+  }
+
+  if( !filesys::isDir(p->next_proj_dir) )
+    if((rc = filesys::makeDir(p->next_proj_dir)) != kOkRC )
+      goto errLabel;
+
+  // both programs write to the output device buffers
+  for(unsigned gi=0; gi<p->audioGroupN; ++gi)
+    oBufN += p->audioGroupA[gi].oDeviceN;
+
+  oBufA = mem::allocZ<flow::abuf_t*>(oBufN);
+  
+  for(unsigned gi=0,k=0; gi<p->audioGroupN; ++gi)
+    for(unsigned di=0; di<p->audioGroupA[gi].oDeviceN; ++di)
+      oBufA[k++] = &p->audioGroupA[gi].oDeviceA[di].abuf;
+
+  args.proc_class_cfg  = p->proc_class_dict_cfg;
+  args.pgm_cfg         = p->pgmA[ pgm_idx ].cfg;
+  args.udp_cfg         = p->udp_dict_cfg;
+  args.proj_dir        = p->next_proj_dir;
+  args.ui_callback     = _ui_callback;
+  args.ui_callback_arg = p;
+  args.deviceA         = p->deviceA;
+  args.deviceN         = p->deviceN;
+  args.preset_idx      = preset_idx;
+  args.oBufA           = oBufA;
+  args.oBufN           = oBufN;
+  args.xfadeFrameN     = (unsigned)(std::max(0.0,xfade_ms) * sample_rate(p->flowH) / 1000.0);
+
+  p->next_pgm_idx = pgm_idx;
+  
+  rc = flow::swap::begin(p->swap,p->flowH,args);
+  
+errLabel:
+  if( rc != kOkRC )
+  {
+    mem::release(p->next_proj_dir);
+    rc = cwLogError(rc,"Program swap of '%s' failed.",cwStringNullGuard(p->pgmA[pgm_idx].label));
+  }
+
+  mem::release(oBufA);
+  
+  return rc;
+}
+
+cw::rc_t cw::io_flow_ctl::program_swap_update( handle_t h, bool& pending_fl_ref, bool& done_fl_ref )
+{
+  io_flow_ctl_t* p  = _handleToPtr(h);
+  return _swap_update(p,pending_fl_ref,done_fl_ref);
+}
+
+cw::rc_t cw::io_flow_ctl::program_ui_attached( handle_t h )
+{
+  io_flow_ctl_t* p  = _handleToPtr(h);
+  p->ui_attach_fl = true;
+  return kOkRC;
+}
+
 unsigned    cw::io_flow_ctl::program_current_index( handle_t h )
 {
   io_flow_ctl_t* p = _handleToPtr(h);
@@ -950,7 +1108,8 @@ cw::rc_t cw::io_flow_ctl::program_initialize( handle_t h, unsigned preset_idx )
     goto errLabel;
   }
 
-  p->init_fl = true;
+  p->init_fl      = true;
+  p->ui_attach_fl = true;
 errLabel:
   return rc;
 }
@@ -1068,11 +1227,31 @@ bool cw::io_flow_ctl::is_exec_complete( handle_t h )
 }
 
 cw::rc_t cw::io_flow_ctl::send_ui_updates( handle_t h )
+{
+  bool swap_done_fl = false;
+  return send_ui_updates(h,swap_done_fl);
+}
+
+cw::rc_t cw::io_flow_ctl::send_ui_updates( handle_t h, bool& swap_done_fl_ref )
 {
   rc_t rc = kOkRC;
+  rc_t rc0;
+  bool pending_fl = false;
   io_flow_ctl_t* p  = _handleToPtr(h);
-  if( program_is_initialized(h) )
+
+  // complete a program swap which the audio thread has finished
+  rc0 = _swap_update(p,pending_fl,swap_done_fl_ref);
+
+  // the updates of a swapped-in program are held until its UI is attached
+  if( program_is_initialized(h) && p->ui_attach_fl )
+  {
+    io::uiBeginBatch(p->ioH);
     rc = send_ui_updates(p->flowH);
+    io::uiEndBatch(p->ioH);
+  }
+
+  if( rc0 != kOkRC )
+    rc = rc0;
 
   return rc;
 }
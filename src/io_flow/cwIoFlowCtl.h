@@ -27,6 +27,25 @@ namespace cw
     // Create the program but do not instantiate the network.
     rc_t        program_load(  handle_t h, unsigned pgm_idx );
 
+    // Replace the current real-time program without interrupting the audio.
+    // The next program is created, initialized and pre-warmed on a background thread
+    // and is then swapped in by the audio thread at a cycle boundary.  The output of
+    // the outgoing program is crossfaded with the output of the incoming program over 'xfade_ms'.
+    // The next program must have the same sample rate and frames per cycle as the current program.
+    // The outgoing program is released by program_swap_update() or send_ui_updates().
+    // Note that the UI description (program_ui_net()) changes when the swap completes.
+    // The UI updates of the new program are held until program_ui_attached() is called.
+    rc_t        program_swap( handle_t h, unsigned pgm_idx, unsigned preset_idx=kInvalidIdx, double xfade_ms=50 );
+
+    // Complete a finished program swap. 'pending_fl_ref' is set if the swap is still in progress.
+    // 'done_fl_ref' is set if the swap completed on this call.
+    // Returns an error if the next program could not be created.
+    rc_t        program_swap_update( handle_t h, bool& pending_fl_ref, bool& done_fl_ref );
+
+    // Called once the UI of a swapped-in program has been built from program_ui_net()
+    // and its variables have been given user args (See set_variable_user_arg()).
+    rc_t        program_ui_attached( handle_t h );
+
     // Return the index of the currently loaded program or kInvalidIdx if no program is loaded.
     unsigned    program_current_index( handle_t h );
 
@@ -59,7 +78,10 @@ namespace cw
     // The current program has completed.
     bool is_exec_complete( handle_t h );
 
+    // Send pending updates to the UI and complete a finished program swap.
+    // 'swap_done_fl_ref' is set if a program swap completed on this call.
     rc_t send_ui_updates( handle_t h );
+    rc_t send_ui_updates( handle_t h, bool& swap_done_fl_ref );
 
     rc_t get_variable_value( handle_t h, const flow::ui_var_t* ui_var, bool& value_ref );
     rc_t get_variable_value( handle_t h, const flow::ui_var_t* ui_var, int& value_ref );
@@ -354,7 +354,6 @@ TEST_F(AudioTransformsTest, SpecDist) {
     spec_dist::destroy(p);
 }
 
-#ifdef cwFFTW
 TEST_F(AudioTransformsTest, PvAnlSyn) {
     unsigned procSmpCnt = 16;
     double srate = 44100.0;
@@ -383,4 +382,103 @@ TEST_F(AudioTransformsTest, PvAnlSyn) {
     pv_anl::destroy(pva);
     pv_syn::destroy(pvs);
 }
-#endif
+
+TEST_F(AudioTransformsTest, MultiChPvAnlSyn) {
+    unsigned chN = 3;
+    unsigned procSmpCnt = 16;
+    float srate = 44100.0f;
+    unsigned maxWndSmpCnt = 128;
+    unsigned wndSmpCnt = 64;
+    unsigned hopSmpCnt = 32;
+    unsigned flags = pv_anl::kCalcHzPvaFl;
+    
+    // the batched analysis and synthesis must match one pv_anl/pv_syn per channel
+    multi_ch_pv_anl::obj_str<float, float>* mca = nullptr;
+    EXPECT_EQ(multi_ch_pv_anl::create(mca, chN, procSmpCnt, srate, maxWndSmpCnt, wndSmpCnt, hopSmpCnt, flags), kOkRC);
+    
+    multi_ch_pv_syn::obj_str<float, float>* mcs = nullptr;
+    EXPECT_EQ(multi_ch_pv_syn::create(mcs, chN, procSmpCnt, srate, maxWndSmpCnt, hopSmpCnt), kOkRC);
+    
+    std::vector<pv_anl::fobj_t*> pvaA(chN, nullptr);
+    std::vector<pv_syn::fobj_t*> pvsA(chN, nullptr);
+    for(unsigned ch=0; ch<chN; ++ch) {
+        EXPECT_EQ(pv_anl::create(pvaA[ch], procSmpCnt, srate, maxWndSmpCnt, wndSmpCnt, hopSmpCnt, flags), kOkRC);
+        EXPECT_EQ(pv_syn::create(pvsA[ch], procSmpCnt, srate, maxWndSmpCnt, hopSmpCnt), kOkRC);
+    }
+    
+    unsigned binN = mca->binCnt;
+    unsigned frameN = 0;
+    std::vector<float> xV(chN * procSmpCnt);
+    
+    for(unsigned k=0; k<64; ++k) {
+        // change the window length part way through
+        if( k == 32 ) {
+            EXPECT_EQ(multi_ch_pv_anl::set_window_length(mca, 48u), kOkRC);
+            for(unsigned ch=0; ch<chN; ++ch)
+                EXPECT_EQ(pv_anl::set_window_length(pvaA[ch], 48u), kOkRC);
+        }
+        
+        const float* xA[chN];
+        for(unsigned ch=0; ch<chN; ++ch) {
+            for(unsigned i=0; i<procSmpCnt; ++i)
+                xV[ch*procSmpCnt + i] = std::sin(2.0 * M_PI * (k*procSmpCnt + i) * (ch+1) * 1000.0 / srate);
+            xA[ch] = xV.data() + ch*procSmpCnt;
+        }
+        
+        bool fl = multi_ch_pv_anl::exec(mca, xA, procSmpCnt);
+        
+        for(unsigned ch=0; ch<chN; ++ch) {
+            EXPECT_EQ(pv_anl::exec(pvaA[ch], xA[ch], procSmpCnt), fl);
+            
+            if( fl ) {
+                const float* magV = multi_ch_pv_anl::magn(mca, ch);
+                const float* phsV = multi_ch_pv_anl::phase(mca, ch);
+                for(unsigned i=0; i<binN; ++i) {
+                    EXPECT_NEAR(magV[i], pvaA[ch]->magV[i], 1e-5f);
+                    
+                    // the phase of very small bins is not well defined
+                    if( pvaA[ch]->magV[i] > 1e-3f ) {
+                        EXPECT_NEAR(std::cos(phsV[i]), std::cos(pvaA[ch]->phsV[i]), 1e-3f);
+                    }
+                }
+                
+                EXPECT_EQ(pv_syn::exec(pvsA[ch], pvaA[ch]->magV, pvaA[ch]->phsV), kOkRC);
+            }
+        }
+        
+        if( fl ) {
+            const float* magA[chN];
+            const float* phsA[chN];
+            for(unsigned ch=0; ch<chN; ++ch) {
+                magA[ch] = pvaA[ch]->magV;
+                phsA[ch] = pvaA[ch]->phsV;
+            }
+            
+            EXPECT_EQ(multi_ch_pv_syn::exec(mcs, magA, phsA), kOkRC);
+            ++frameN;
+        }
+        
+        for(unsigned ch=0; ch<chN; ++ch) {
+            const float* y0 = ola::execOut(pvsA[ch]->ola);
+            const float* y1 = multi_ch_pv_syn::execOut(mcs, ch);
+            
+            EXPECT_EQ(y0 == nullptr, y1 == nullptr);
+            
+            if( y0 != nullptr && y1 != nullptr ) {
+                for(unsigned i=0; i<procSmpCnt; ++i) {
+                    EXPECT_NEAR(y0[i], y1[i], 1e-4f);
+                }
+            }
+        }
+    }
+    
+    EXPECT_GT(frameN, 0u);
+    
+    for(unsigned ch=0; ch<chN; ++ch) {
+        pv_anl::destroy(pvaA[ch]);
+        pv_syn::destroy(pvsA[ch]);
+    }
+    
+    multi_ch_pv_anl::destroy(mca);
+    multi_ch_pv_syn::destroy(mcs);
+}
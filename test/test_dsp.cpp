@@ -8,6 +8,7 @@
 #include "cwVectOps.h"
 #include "cwDspTypes.h"
 #include "cwDsp.h"
+#include "cwFFT.h"
 #include <cmath>
 #include <vector>
 
@@ -126,7 +127,6 @@ TEST(DspTest, GaussWindow) {
     EXPECT_NEAR(w[5], 1.0, 1e-6);
 }
 
-#ifdef cwFFTW
 TEST(DspTest, FftIfft) {
     const unsigned n = 16;
     std::vector<float> x(n);
@@ -213,4 +213,144 @@ TEST(DspTest, Convolution) {
     EXPECT_NEAR(y[5], 0.5f, 1e-6);
     EXPECT_NEAR(y[6], 0.25f, 1e-6);
 }
-#endif
+
+// Stream a signal through the partitioned convolver and compare the result to direct convolution.
+static void part_convolve_test( unsigned hN, unsigned procSmpN, unsigned tailFact )
+{
+    const unsigned cycleN = 24;
+    const unsigned xN     = cycleN * procSmpN;
+    std::vector<float> h(hN), x(xN), y(xN), ref(xN,0);
+
+    for(unsigned i=0; i<hN; ++i)
+        h[i] = std::exp(-(float)i/(hN/4.0f)) * std::sin(0.37f*i + 1);
+
+    for(unsigned i=0; i<xN; ++i)
+        x[i] = (i % 53 == 0 ? 1.0f : 0.0f) + 0.1f*std::sin(0.05f*i);
+
+    for(unsigned i=0; i<xN; ++i)
+        for(unsigned j=0; j<hN && j<=i; ++j)
+            ref[i] += 0.5f * h[j] * x[i-j];
+
+    part_convolve::obj_str<float>* p = nullptr;
+    ASSERT_EQ(part_convolve::create(p, h.data(), hN, procSmpN, 0.5f, tailFact), kOkRC);
+
+    for(unsigned i=0; i<xN; i+=procSmpN)
+    {
+        part_convolve::exec(p, x.data() + i, procSmpN);
+        std::copy(p->outV, p->outV + procSmpN, y.begin() + i);
+    }
+
+    for(unsigned i=0; i<xN; ++i)
+        ASSERT_NEAR(y[i], ref[i], 1e-4) << "i=" << i;
+
+    part_convolve::destroy(p);
+}
+
+TEST(DspTest, PartConvolveUniform) {
+    part_convolve_test( 5, 16, 0 );     // IR shorter than a partition
+    part_convolve_test( 100, 16, 0 );   // multiple partitions with a partial last partition
+}
+
+TEST(DspTest, PartConvolveNonUniform) {
+    part_convolve_test( 300, 8, 4 );    // head: 7 partitions of 8, tail: partitions of 32
+    part_convolve_test( 50, 8, 4 );     // IR fits in the head
+}
+TEST(DspTest, FftPlanShare) {
+    const unsigned n = 1024;
+    fft_plan::effort_t effort_id = fft_plan::set_effort(fft_plan::effort_from_label("estimate"));
+    unsigned planN = fft_plan::plan_count();
+
+    std::vector<float> x0(n), x1(n);
+    cw::vop::sine(x0.data(), n, (float)n, 3.0f);
+    cw::vop::sine(x1.data(), n, (float)n, 5.0f);
+
+    fft::obj_str<float>* ft0 = nullptr;
+    fft::obj_str<float>* ft1 = nullptr;
+    fft::create(ft0, n, fft::kToPolarFl);
+    fft::create(ft1, n, fft::kToPolarFl);
+    ASSERT_EQ(fft_plan::plan_count(), planN + 1);
+
+    ifft::obj_str<float>* ift = nullptr;
+    ifft::create(ift, fft::bin_count(ft0));
+    ASSERT_EQ(fft_plan::plan_count(), planN + 2);
+
+    // each object transforms its own arrays through the shared plan
+    fft::exec(ft0, x0.data(), n);
+    fft::exec(ft1, x1.data(), n);
+    EXPECT_NEAR(fft::magn(ft0)[3], 1.0f, 1e-4);
+    EXPECT_NEAR(fft::magn(ft1)[5], 1.0f, 1e-4);
+    EXPECT_NEAR(fft::magn(ft0)[5], 0.0f, 1e-4);
+
+    ifft::exec_polar(ift, fft::magn(ft1), fft::phase(ft1));
+    for(unsigned i=0; i<n; ++i)
+        ASSERT_NEAR(ifft::out(ift)[i], x1[i], 1e-4);
+
+    fft::destroy(ft0);
+    EXPECT_EQ(fft_plan::plan_count(), planN + 2);
+    fft::destroy(ft1);
+    ifft::destroy(ift);
+    EXPECT_EQ(fft_plan::plan_count(), planN);
+
+    EXPECT_EQ(fft_plan::effort(), fft_plan::kEstimateEffortId);
+    fft_plan::set_effort(effort_id);
+}
+
+TEST(DspTest, FftPlanWisdom) {
+    const char* fname = "fft_plan_wisdom_test.txt";
+    EXPECT_EQ(fft_plan::effort_from_label("bogus"), fft_plan::kInvalidEffortId);
+
+    fft_plan::effort_t effort_id = fft_plan::set_effort(fft_plan::kEstimateEffortId);
+    fft::obj_str<double>* ft = nullptr;
+    fft::create(ft, 256, fft::kToPolarFl);
+
+    remove(fname);
+    ASSERT_EQ(fft_plan::save_wisdom(fname), kOkRC);
+    ASSERT_EQ(fft_plan::load_wisdom(fname), kOkRC);
+    EXPECT_EQ(fft_plan::load_wisdom("fft_plan_wisdom_missing.txt"), kOkRC);
+
+    fft::destroy(ft);
+    fft_plan::set_effort(effort_id);
+    remove(fname);
+}
+
+template< typename T >
+void native_fft_test( unsigned n )
+{
+    native_fft::plan_str<T>* p = native_fft::create<T>(n);
+    ASSERT_NE(p, nullptr);
+
+    std::vector<T>               x(n), xw(n), y(n);
+    std::vector<std::complex<T>> X(n/2+1), Xw(n/2+1);
+    for(unsigned i=0; i<n; ++i)
+        x[i] = (T)(std::sin(0.37*i) + 0.25*std::cos(1.9*i) + (i%3==0 ? 0.5 : -0.125));
+
+    // r2c against a direct DFT
+    xw = x;
+    native_fft::exec_r2c(p, xw.data(), X.data());
+    for(unsigned k=0; k<=n/2; ++k)
+    {
+        std::complex<double> d = 0;
+        for(unsigned i=0; i<n; ++i)
+            d += (double)x[i] * std::polar(1.0, -2.0*M_PI*i*k/n);
+        ASSERT_NEAR(X[k].real(), d.real(), 1e-4*n) << "n=" << n << " k=" << k;
+        ASSERT_NEAR(X[k].imag(), d.imag(), 1e-4*n) << "n=" << n << " k=" << k;
+    }
+
+    // c2r is the unnormalized inverse
+    Xw = X;
+    native_fft::exec_c2r(p, Xw.data(), y.data());
+    for(unsigned i=0; i<n; ++i)
+        ASSERT_NEAR(y[i]/n, x[i], 1e-4) << "n=" << n << " i=" << i;
+
+    native_fft::destroy(p);
+    EXPECT_EQ(p, nullptr);
+}
+
+TEST(DspTest, NativeFft) {
+    EXPECT_EQ(native_fft::create<float>(12), nullptr);
+    for(unsigned n=1; n<=4096; n*=2)
+    {
+        native_fft_test<float>(n);
+        native_fft_test<double>(n);
+    }
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <thread>
 
 #include "cwCommon.h"
 #include "cwLog.h"
@@ -8,64 +9,152 @@
 #include "cwTime.h"
 #include "cwMidiDecls.h"
 #include "cwMidi.h"
+#include "cwMem.h"
+#include "cwVectOps.h"
+#include "cwAudioFile.h"
+#include "cwFileSys.h"
+#include "cwMtx.h"
+#include "cwDspTypes.h"
+#include "cwFlowValue.h"
 #include "cwFlowDecl.h"
 #include "cwFlow.h"
+#include "cwFlowBatch.h"
+#include "cwFlowBench.h"
+#include "cwThread.h"
+#include "cwFlowSwap.h"
 
 #define PROC_DICT_FNAME "../../../src/flow/rsrc/proc_dict.cfg"
 
 using namespace cw;
 
 
-rc_t FlowExec( const char* pgm_src_code, const char* result )
+// A flow program created from source code.
+typedef struct flow_pgm_str
 {
-  rc_t rc,rc1=kOkRC;
-  
   object_t*         proc_class_cfg = nullptr;
   object_t*         pgm_cfg        = nullptr;
   log::logLevelId_t level0         = log::level();
   flow::handle_t    flowH;
+} flow_pgm_t;
+
+// Release the program and restore the log level.
+rc_t FlowDestroy( flow_pgm_t& pgm )
+{
+  rc_t rc;
+  
+  EXPECT_EQ(rc = flow::destroy(pgm.flowH), kOkRC ) << "Flow object destroy failed.";
+  log::set_level( pgm.level0 );
+  
+  if( pgm.pgm_cfg != nullptr )
+    pgm.pgm_cfg->free();
+  
+  if( pgm.proc_class_cfg != nullptr )
+    pgm.proc_class_cfg->free();
+
+  pgm.pgm_cfg        = nullptr;
+  pgm.proc_class_cfg = nullptr;
+  
+  return rc;
+}
+
+// Create and initialize the program in 'pgm_src_code' and set the log level to 'error'.
+// The program is released if it cannot be created.
+rc_t FlowCreate( flow_pgm_t& pgm, const char* pgm_src_code )
+{
+  rc_t rc;
   
-  EXPECT_EQ(rc = objectFromFile(PROC_DICT_FNAME,proc_class_cfg),kOkRC) << "The proc. class dictionary parse failed.";
+  EXPECT_EQ(rc = objectFromFile(PROC_DICT_FNAME,pgm.proc_class_cfg),kOkRC) << "The proc. class dictionary parse failed.";
   if( rc != kOkRC )
     goto errLabel;
 
-  EXPECT_EQ(rc = objectFromString(pgm_src_code,pgm_cfg),kOkRC) << "The program source code could not be parsed.";
+  EXPECT_EQ(rc = objectFromString(pgm_src_code,pgm.pgm_cfg),kOkRC) << "The program source code could not be parsed.";
   if( rc != kOkRC )
     goto errLabel;
 
-  EXPECT_EQ(rc = flow::create(flowH,proc_class_cfg,pgm_cfg),kOkRC) << "Flow object create failed.";
+  EXPECT_EQ(rc = flow::create(pgm.flowH,pgm.proc_class_cfg,pgm.pgm_cfg),kOkRC) << "Flow object create failed.";
   if( rc != kOkRC )
     goto errLabel;
 
-  EXPECT_EQ(rc = flow::initialize(flowH), kOkRC ) << "Flow program initialize failed.";
+  EXPECT_EQ(rc = flow::initialize(pgm.flowH), kOkRC ) << "Flow program initialize failed.";
   if( rc != kOkRC )
     goto errLabel;
 
-  log::set_flags( log::flags() | log::kBufEnableFl );
   log::set_level( log::kError_LogLevel );
-
-  EXPECT_EQ(rc = flow::exec(flowH), kEofRC ) << "Flow program execution failed.";
-  if( rc == kEofRC )
-    rc = kOkRC;
   
-  log::set_flags( cwClrFlag(log::flags(), log::kBufEnableFl));
-  log::set_level( level0 );
+errLabel:
+  if( rc != kOkRC )
+    FlowDestroy(pgm);
+  
+  return rc;
+}
 
-  EXPECT_STREQ( log::buffer(), result ) << "Program result mismatch.";
+// Execute 'cycleN' cycles.
+rc_t FlowCycles( flow_pgm_t& pgm, unsigned cycleN )
+{
+  rc_t rc = kOkRC;
   
-errLabel:
+  for(unsigned i=0; i<cycleN && rc==kOkRC; ++i)
+    EXPECT_EQ(rc = flow::exec_cycle(pgm.flowH), kOkRC ) << "Cycle " << i << " failed.";
+
+  return rc;
+}
 
-  EXPECT_EQ(rc1 = flow::destroy(flowH), kOkRC ) << "Flow object destroy failed.";
+// Execute 'cycleN' cycles and then compare the value of 'proc_label:var_label' on channel 'ch_idx' to 'value'.
+// If 'tol' is zero the values must be equal to within 4 ULP's.
+rc_t FlowCheck( flow_pgm_t& pgm, unsigned cycleN, const char* proc_label, const char* var_label, float value, unsigned ch_idx=0, float tol=0 )
+{
+  rc_t  rc;
+  float v = 0;
   
-  if( pgm_cfg != nullptr )
-    pgm_cfg->free();
+  if((rc = FlowCycles(pgm,cycleN)) != kOkRC )
+    return rc;
+
+  EXPECT_EQ(rc = flow::get_variable_value(pgm.flowH,proc_label,var_label,ch_idx,v), kOkRC ) << proc_label << ":" << var_label;
   
-  if( proc_class_cfg != nullptr )
-    proc_class_cfg->free();
+  if( tol == 0 )
+    EXPECT_FLOAT_EQ(v, value ) << proc_label << ":" << var_label;
+  else
+    EXPECT_NEAR(v, value, tol ) << proc_label << ":" << var_label;
+
+  return rc;
+}
+
+// Create the program in 'pgm_src_code', execute 'cycleN' cycles, compare the value of 'proc_label:var_label' to 'value'
+// and release the program.
+rc_t FlowExecCheck( const char* pgm_src_code, unsigned cycleN, const char* proc_label, const char* var_label, float value )
+{
+  rc_t       rc;
+  flow_pgm_t pgm;
   
-  return rcSelect(rc,rc1);
+  if((rc = FlowCreate(pgm,pgm_src_code)) != kOkRC )
+    return rc;
+
+  rc = FlowCheck(pgm,cycleN,proc_label,var_label,value);
+
+  return rcSelect(rc,FlowDestroy(pgm));
 }
 
+rc_t FlowExec( const char* pgm_src_code, const char* result )
+{
+  rc_t       rc;
+  flow_pgm_t pgm;
+
+  if((rc = FlowCreate(pgm,pgm_src_code)) != kOkRC )
+    return rc;
+
+  log::clear_buffer();
+  log::set_flags( log::flags() | log::kBufEnableFl );
+
+  EXPECT_EQ(rc = flow::exec(pgm.flowH), kEofRC ) << "Flow program execution failed.";
+  if( rc == kEofRC )
+    rc = kOkRC;
+  
+  log::set_flags( cwClrFlag(log::flags(), log::kBufEnableFl));
+
+  EXPECT_STREQ( log::buffer(), result ) << "Program result mismatch.";
+  
+  return rcSelect(rc,FlowDestroy(pgm));
+}
 
 TEST( FlowTest, NumberTest )
 {
@@ -97,6 +186,1468 @@ TEST( FlowTest, NumberTest )
     
 }
 
+TEST( FlowTest, ParallelNumberTest )
+{
+  // The 'a' and 'b' chains are not connected to one another and
+  // therefore execute concurrently, however the output must match
+  // the output of the serial execution order.
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+      max_cycle_count:5,
+      parallel_fl:true,
+      thread_cnt:2
+
+	    network:
+	    {
+	      procs: {
+	        n_a   : { class: number, args:{ in:1 } }
+	        add_a : { class: add, in: { in0:n_a.out }, args:{ in1:1 }, out:{ out:n_a.in } }
+
+	        n_b   : { class: number, args:{ in:10 } }
+	        add_b : { class: add, in: { in0:n_b.out }, args:{ in1:10 }, out:{ out:n_b.in } }
+
+	        add_c : { class: add,   in: { in0:add_a.out, in1:add_b.out } }
+	        p_c   : { class: print, in: { in0:add_c.out }, args:{ text:["C:"], eol_str:" " } }
+	      } 
+	    }
+    })";
+
+  const char* result = "C:22.000000 C:33.000000 C:44.000000 C:55.000000 C:66.000000 ";
+
+  EXPECT_EQ( FlowExec(pgm_src,result), kOkRC );
+}
+
+TEST( FlowTest, ExecRateTest )
+{
+  // 'add_a' executes on every second cycle and therefore the 'a' chain
+  // increments at half the rate of the 'b' chain. The 'number' and 'add' classes
+  // default to 'on_change' execution and only run when their inputs change.
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+      max_cycle_count:6
+
+	    network:
+	    {
+	      procs: {
+	        n_a   : { class: number, args:{ in:1 } }
+	        add_a : { class: add, rate:2, in: { in0:n_a.out }, args:{ in1:1 }, out:{ out:n_a.in } }
+
+	        n_b   : { class: number, args:{ in:10 } }
+	        add_b : { class: add, in: { in0:n_b.out }, args:{ in1:10 }, out:{ out:n_b.in } }
+
+	        add_c : { class: add,   in: { in0:add_a.out, in1:add_b.out } }
+	        p_c   : { class: print, in: { in0:add_c.out }, args:{ text:["C:"], eol_str:" " } }
+	      } 
+	    }
+    })";
+
+  const char* result = "C:22.000000 C:32.000000 C:43.000000 C:53.000000 C:64.000000 C:74.000000 ";
+
+  EXPECT_EQ( FlowExec(pgm_src,result), kOkRC );
+}
+
+TEST( FlowTest, AbufPoolTest )
+{
+  // The audio outputs of the 'audio_gain' and 'audio_mix' proc's are packed into a shared
+  // arena. 'mx' reads 'g_a' and 'g_b' and therefore cannot share their storage,
+  // however 'g_c' may reuse the storage of 'g_a' or 'g_b'.
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+      abuf_pool_fl:true,
+
+	    network:
+	    {
+	      procs: {
+	        osc : { class: sine_tone, args:{ ch_cnt:1, hz:0, gain:0, dc:1 } }
+	        g_a : { class: audio_gain, in:{ in:osc.out }, args:{ gain:0.5  } }
+	        g_b : { class: audio_gain, in:{ in:osc.out }, args:{ gain:0.25 } }
+	        mx  : { class: audio_mix,  in:{ in0:g_a.out, in1:g_b.out }, args:{ igain0:1, igain1:1 } }
+	        g_c : { class: audio_gain, in:{ in:mx.out }, args:{ gain:2 } }
+	        sh  : { class: sample_hold, in:{ in:g_c.out }, args:{ period_ms:1 } }
+	      } 
+	    }
+    })";
+
+  EXPECT_EQ(FlowExecCheck(pgm_src,3,"sh","out",1.5f), kOkRC );
+}
+
+TEST( FlowTest, FuseTest )
+{
+  // 'g_a', 'g_b', 'mx' and 'g_c' are fused into a single kernel which is executed by 'sp'.
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+      fuse_fl:true,
+      abuf_pool_fl:true,
+
+	    network:
+	    {
+	      procs: {
+	        osc : { class: sine_tone, args:{ ch_cnt:1, hz:0, gain:0, dc:1 } }
+	        g_a : { class: audio_gain, in:{ in:osc.out }, args:{ gain:0.5  } }
+	        g_b : { class: audio_gain, in:{ in:osc.out }, args:{ gain:0.25 } }
+	        mx  : { class: audio_mix,  in:{ in0:g_a.out, in1:g_b.out }, args:{ igain0:1, igain1:1 } }
+	        g_c : { class: audio_gain, in:{ in:mx.out }, args:{ gain:2 } }
+	        sp  : { class: audio_split, in:{ in:g_c.out }, args:{ select:[0], igain:0.5 } }
+	        sh  : { class: sample_hold, in:{ in:sp.out0 }, args:{ period_ms:1 } }
+	      } 
+	    }
+    })";
+
+  flow_pgm_t pgm;
+  
+  ASSERT_EQ(FlowCreate(pgm,pgm_src), kOkRC );
+  
+  EXPECT_EQ(FlowCheck(pgm,3,"sh","out",0.75f), kOkRC );
+
+  // the gain of a fused proc is still applied
+  EXPECT_EQ(flow::set_variable_value(pgm.flowH,"g_a","gain",0,1.0f), kOkRC );
+  EXPECT_EQ(flow::set_variable_value(pgm.flowH,"g_b","gain",0,0.0f), kOkRC );
+  
+  EXPECT_EQ(FlowCheck(pgm,3,"sh","out",1.0f), kOkRC );
+  
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+}
+
+TEST( FlowTest, PipelineTest )
+{
+  // The network is split into two stages which begin at 'osc' and 'g_b'.
+  // 'g_b' reads the output of 'g_a' from the previous cycle and therefore
+  // the output of the second stage lags the first stage by one cycle.
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+      pipeline_stageL: [ g_b ],
+
+	    network:
+	    {
+	      procs: {
+	        osc : { class: sine_tone, args:{ ch_cnt:1, hz:0, gain:0, dc:1 } }
+	        g_a : { class: audio_gain, in:{ in:osc.out }, args:{ gain:0.5 } }
+	        g_b : { class: audio_gain, in:{ in:g_a.out }, args:{ gain:4 } }
+	        sh  : { class: sample_hold, in:{ in:g_b.out }, args:{ period_ms:1 } }
+	      } 
+	    }
+    })";
+
+  flow_pgm_t pgm;
+  
+  ASSERT_EQ(FlowCreate(pgm,pgm_src), kOkRC );
+  
+  EXPECT_EQ(FlowCheck(pgm,1,"sh","out",0.0f), kOkRC );
+
+  for(unsigned i=0; i<3; ++i)
+    EXPECT_EQ(FlowCheck(pgm,1,"sh","out",2.0f), kOkRC );
+
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+}
+
+TEST( FlowTest, PipelineSilenceTest )
+{
+  // 'g' reads the silent output of 'osc' across a stage boundary. The silence flag is
+  // delayed along with the buffer and therefore 'g' is bypassed on every cycle after the first.
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+      pipeline_stageL: [ g ],
+
+	    network:
+	    {
+	      procs: {
+	        osc : { class: sine_tone, args:{ ch_cnt:1, hz:100, gain:0, dc:0 } }
+	        g   : { class: audio_gain, in:{ in:osc.out }, args:{ gain:0.5 } }
+	        sh  : { class: sample_hold, in:{ in:g.out }, args:{ period_ms:1 } }
+	      } 
+	    }
+    })";
+
+  const unsigned        cycleN = 4;
+  flow_pgm_t            pgm;
+  flow::latency_stats_t stats;
+  
+  ASSERT_EQ(FlowCreate(pgm,pgm_src), kOkRC );
+  
+  EXPECT_EQ(FlowCheck(pgm,cycleN,"sh","out",0.0f), kOkRC );
+
+  EXPECT_EQ(flow::latency_stats(pgm.flowH,"g",flow::kBaseSfxId,stats), kOkRC );
+  EXPECT_EQ(stats.bypass_cnt, cycleN-1 );
+
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+}
+
+TEST( FlowTest, LatencyTest )
+{
+  // The 1ns cycle deadline (frames_per_cycle/sample_rate) guarantees that every cycle misses the deadline.
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+      profile_fl:true,
+      frames_per_cycle:1,
+      sample_rate:1000000000,
+
+	    network:
+	    {
+	      procs: {
+	        osc : { class: sine_tone, args:{ ch_cnt:1, hz:0, gain:0, dc:1 } }
+	        g_a : { class: audio_gain, in:{ in:osc.out }, args:{ gain:0.5 } }
+	      } 
+	    }
+    })";
+
+  rc_t                  rc;
+  flow_pgm_t            pgm;
+  flow::latency_stats_t stats;
+  flow::deadline_miss_t miss;
+  const unsigned        cycleN = 10;
+  
+  ASSERT_EQ(FlowCreate(pgm,pgm_src), kOkRC );
+  
+  EXPECT_EQ(FlowCycles(pgm,cycleN), kOkRC );
+
+  EXPECT_DOUBLE_EQ(flow::deadline_us(pgm.flowH), 0.001 );
+
+  EXPECT_EQ(rc = flow::latency_stats(pgm.flowH,"g_a",0,stats), kOkRC );
+  EXPECT_EQ(stats.cnt, cycleN );
+  EXPECT_LE(stats.p50_us, stats.p99_us );
+  EXPECT_LE(stats.p99_us, stats.p999_us );
+  EXPECT_LE(stats.p999_us, stats.max_us );
+  EXPECT_GT(stats.max_us, 0.0 );
+
+  EXPECT_EQ(rc = flow::latency_stats(pgm.flowH,nullptr,0,stats), kOkRC );
+  EXPECT_EQ(stats.cnt, cycleN );
+  
+  EXPECT_EQ(flow::deadline_miss_count(pgm.flowH), cycleN );
+  EXPECT_EQ(rc = flow::deadline_miss(pgm.flowH,0,miss), kOkRC );
+  EXPECT_EQ(miss.cycle_idx, cycleN-1 );
+  EXPECT_NE(miss.proc_label, nullptr );
+  EXPECT_LE(miss.proc_dur_us, miss.dur_us );
+  EXPECT_NE(rc = flow::deadline_miss(pgm.flowH,cycleN,miss), kOkRC );
+
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+}
+
+TEST( FlowTest, IncrementalPresetTest )
+{
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+
+	    network:
+	    {
+	      procs: {
+	        o_a : { class: sine_tone, args:{ ch_cnt:1, hz:220 } }
+	        o_b : { class: sine_tone, args:{ ch_cnt:1, hz:220 } }
+	        o_c : { class: sine_tone, args:{ ch_cnt:1, hz:220 } }
+	        o_d : { class: sine_tone, args:{ ch_cnt:1, hz:220 } }
+	      }
+
+	      presets: {
+	        high: { o_a:{ hz:440, gain:0.5 }, o_b:{ hz:440, gain:0.5 }, o_c:{ hz:440, gain:0.5 }, o_d:{ hz:440, gain:0.5 } },
+	        low:  { o_a:{ hz:110 },           o_b:{ hz:110 },           o_c:{ hz:110 },           o_d:{ hz:110 } },
+	      }
+	    }
+    })";
+
+  rc_t              rc;
+  flow_pgm_t        pgm;
+  unsigned          appliedN       = 0;
+  unsigned          totalN         = 0;
+  rc_t              apply_rc       = kOkRC;
+  const char*       labelA[]       = { "o_a", "o_b", "o_c", "o_d" };
+  const unsigned    labelN         = sizeof(labelA)/sizeof(labelA[0]);
+  
+  ASSERT_EQ(FlowCreate(pgm,pgm_src), kOkRC );
+
+  // spread 'high' over four cycles - one proc (two values) per cycle
+  EXPECT_EQ(rc = flow::begin_preset_apply(pgm.flowH,"high",labelN,0), kOkRC );
+  EXPECT_FALSE(flow::preset_apply_status(pgm.flowH,appliedN,totalN,apply_rc));
+  EXPECT_EQ(totalN, 2*labelN );
+  
+  for(unsigned i=0; i<labelN; ++i)
+  {
+    EXPECT_EQ(FlowCycles(pgm,1), kOkRC );
+    EXPECT_EQ(flow::preset_apply_status(pgm.flowH,appliedN,totalN,apply_rc), i==labelN-1 );
+    EXPECT_EQ(appliedN, 2*(i+1) );
+    EXPECT_EQ(apply_rc, kOkRC );
+
+    // both values of a proc are always applied on the same cycle
+    for(unsigned j=0; j<labelN; ++j)
+    {
+      EXPECT_EQ(FlowCheck(pgm,0,labelA[j],"hz",  j<=i ? 440.0f : 220.0f), kOkRC );
+      EXPECT_EQ(FlowCheck(pgm,0,labelA[j],"gain",j<=i ? 0.5f   : 0.8f), kOkRC );
+    }
+  }
+
+  // a direct application completes the in-progress incremental application first
+  EXPECT_EQ(rc = flow::begin_preset_apply(pgm.flowH,"low",labelN,0), kOkRC );
+  EXPECT_EQ(FlowCycles(pgm,1), kOkRC );
+  EXPECT_EQ(rc = flow::apply_preset(pgm.flowH,"high"), kOkRC );
+  EXPECT_TRUE(flow::preset_apply_status(pgm.flowH,appliedN,totalN,apply_rc));
+  EXPECT_EQ(appliedN, totalN );
+  
+  for(unsigned j=0; j<labelN; ++j)
+    EXPECT_EQ(FlowCheck(pgm,0,labelA[j],"hz",440.0f), kOkRC );
+
+  // a generous time budget with no cycle limit applies the whole preset on the next cycle
+  EXPECT_EQ(rc = flow::begin_preset_apply(pgm.flowH,"low",0,1e6), kOkRC );
+  EXPECT_EQ(FlowCycles(pgm,1), kOkRC );
+  EXPECT_TRUE(flow::preset_apply_status(pgm.flowH,appliedN,totalN,apply_rc));
+  
+  for(unsigned j=0; j<labelN; ++j)
+    EXPECT_EQ(FlowCheck(pgm,0,labelA[j],"hz",110.0f), kOkRC );
+
+  EXPECT_NE(rc = flow::begin_preset_apply(pgm.flowH,"missing",1,0), kOkRC );
+  
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+}
+
+TEST( FlowTest, ControlHandleTest )
+{
+  // Values are posted to 'g' by multiple threads and applied at the start of the next cycle.
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+
+	    network:
+	    {
+	      procs: {
+	        osc : { class: sine_tone, args:{ ch_cnt:1, hz:0, gain:0, dc:1 } }
+	        g   : { class: audio_gain, in:{ in:osc.out }, args:{ gain:0.5 } }
+	        sh  : { class: sample_hold, in:{ in:g.out }, args:{ period_ms:1 } }
+	      } 
+	    }
+    })";
+
+  const unsigned         threadN        = 4;
+  const unsigned         postN          = 64;
+  rc_t                   rc;
+  flow_pgm_t             pgm;
+  flow::var_ctl_handle_t ctlH;
+  flow::var_ctl_handle_t badH;
+  std::thread            threadA[ threadN ];
+  
+  ASSERT_EQ(FlowCreate(pgm,pgm_src), kOkRC );
+
+  log::set_level( log::kFatal_LogLevel );
+  EXPECT_NE(rc = flow::var_control(pgm.flowH,"g","xyz",0,badH), kOkRC );
+  EXPECT_FALSE( badH.isValid() );
+  log::set_level( log::kError_LogLevel );
+  
+  EXPECT_EQ(rc = flow::var_control(pgm.flowH,"g","gain",0,ctlH), kOkRC );
+
+  for(unsigned i=0; i<threadN; ++i)
+    threadA[i] = std::thread([&pgm,&ctlH,postN](){
+      for(unsigned j=0; j<postN; ++j)
+        flow::post_variable_value(pgm.flowH,ctlH,0.25f);
+    });
+
+  for(unsigned i=0; i<threadN; ++i)
+    threadA[i].join();
+  
+  EXPECT_EQ(FlowCheck(pgm,3,"sh","out",0.25f), kOkRC );
+
+  // the last value posted is the one which is applied
+  EXPECT_EQ(rc = flow::post_variable_value(pgm.flowH,ctlH,0.1f), kOkRC );
+  EXPECT_EQ(rc = flow::post_variable_value(pgm.flowH,ctlH,2.0),  kOkRC );
+  
+  EXPECT_EQ(FlowCheck(pgm,3,"sh","out",2.0f), kOkRC );
+  
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+}
+
+TEST( FlowTest, RecordLayoutTest )
+{
+  // 'ra1' records inherit the fields of 'ra0' records.
+  const char* fmt0_src = "{ fields: { a:{ type:uint, value:1, doc:\"a\" }, g:{ type:group, doc:\"g\", fields:{ b:{ type:bool, value:false, doc:\"b\" }, c:{ type:double, value:0, doc:\"c\" } } } } }";
+  const char* fmt1_src = "{ fields: { d:{ type:float, value:0, doc:\"d\" }, s:{ type:string, value:\"x\", doc:\"s\" } } }";
+  const unsigned recdN = 4;
+  
+  rc_t                   rc;
+  object_t*              cfg0   = nullptr;
+  object_t*              cfg1   = nullptr;
+  flow::recd_type_t*     t0     = nullptr;
+  flow::recd_type_t*     t1     = nullptr;
+  flow::recd_array_t*    ra0    = nullptr;
+  flow::recd_array_t*    ra1    = nullptr;
+  flow::recd_layout_t*   layout = nullptr;
+  flow::recd_columns_t*  cols   = nullptr;
+  flow::rbuf_t*          rbuf   = nullptr;
+  flow::recd_accessor_t<unsigned> a_acc;
+  flow::recd_accessor_t<double>   c_acc;
+  flow::recd_accessor_t<float>    d_acc;
+  
+  ASSERT_EQ(rc = objectFromString(fmt0_src,cfg0),kOkRC);
+  ASSERT_EQ(rc = objectFromString(fmt1_src,cfg1),kOkRC);
+  ASSERT_EQ(rc = flow::recd_type_create(t0,nullptr,cfg0),kOkRC);
+  ASSERT_EQ(rc = flow::recd_type_create(t1,t0,cfg1),kOkRC);
+  ASSERT_EQ(rc = flow::recd_array_create(ra0,t0,nullptr,recdN),kOkRC);
+  ASSERT_EQ(rc = flow::recd_array_create(ra1,t1,t0,recdN),kOkRC);
+
+  for(unsigned i=0; i<recdN; ++i)
+  {
+    EXPECT_EQ(rc = flow::recd_set(ra0->type,nullptr,ra0->recdA+i,flow::recd_type_field_index(ra0->type,"a"),i,flow::recd_type_field_index(ra0->type,"g.c"),i*0.5), kOkRC);
+    EXPECT_EQ(rc = flow::recd_set(ra1->type,ra0->recdA+i,ra1->recdA+i,flow::recd_type_field_index(ra1->type,"d"),i*2.0f), kOkRC);
+  }
+
+  ASSERT_EQ(rc = flow::recd_layout_create(layout,ra1->type),kOkRC);
+  EXPECT_EQ(layout->fieldN, 5u );
+  EXPECT_EQ(layout->rowByteN % sizeof(double), 0u );
+
+  // the string field is located but not packed
+  EXPECT_EQ(layout->fieldA[ flow::recd_type_field_index(ra1->type,"s") ].byteN, 0u );
+
+  // read inherited and local fields through resolved accessors
+  EXPECT_EQ(rc = flow::recd_accessor_create(layout,"a",a_acc),kOkRC);
+  EXPECT_EQ(rc = flow::recd_accessor_create(layout,"g.c",c_acc),kOkRC);
+  EXPECT_EQ(rc = flow::recd_accessor_create(layout,"d",d_acc),kOkRC);
+  EXPECT_EQ(a_acc.depth, 1u );
+  
+  for(unsigned i=0; i<recdN; ++i)
+  {
+    unsigned a = 0;
+    double   c = 0;
+    float    d = 0;
+    EXPECT_EQ(rc = flow::recd_read(a_acc,ra1->recdA+i,a),kOkRC);
+    EXPECT_EQ(rc = flow::recd_read(c_acc,ra1->recdA+i,c),kOkRC);
+    EXPECT_EQ(rc = flow::recd_read(d_acc,ra1->recdA+i,d),kOkRC);
+    EXPECT_EQ(a, i );
+    EXPECT_DOUBLE_EQ(c, i*0.5 );
+    EXPECT_FLOAT_EQ(d, i*2.0f );
+  }
+
+  // inherited fields may not be written
+  log::logLevelId_t level0 = log::level();
+  log::set_level( log::kFatal_LogLevel );
+  EXPECT_NE(rc = flow::recd_write(a_acc,ra1->recdA,7u),kOkRC);
+  log::set_level( level0 );
+  EXPECT_EQ(rc = flow::recd_write(d_acc,ra1->recdA,7.0f),kOkRC);
+
+  // struct-of-arrays view
+  rbuf = flow::rbuf_create(ra1->type,ra1->recdA,recdN,recdN);
+  ASSERT_EQ(rc = flow::recd_columns_create(cols,layout,recdN),kOkRC);
+  EXPECT_EQ(rc = flow::recd_columns_update(cols,rbuf),kOkRC);
+  EXPECT_EQ(cols->recdN, recdN );
+
+  const unsigned* aV = flow::recd_column<unsigned>(cols,flow::recd_type_field_index(ra1->type,"a"));
+  const double*   cV = flow::recd_column<double>(cols,flow::recd_type_field_index(ra1->type,"g.c"));
+  const float*    dV = flow::recd_column<float>(cols,flow::recd_type_field_index(ra1->type,"d"));
+  ASSERT_NE(aV, nullptr );
+  ASSERT_NE(cV, nullptr );
+  ASSERT_NE(dV, nullptr );
+  EXPECT_EQ(flow::recd_column<float>(cols,flow::recd_type_field_index(ra1->type,"a")), nullptr );
+  EXPECT_EQ(((uintptr_t)cV) % alignof(double), 0u );
+
+  for(unsigned i=0; i<recdN; ++i)
+  {
+    EXPECT_EQ(aV[i], i );
+    EXPECT_DOUBLE_EQ(cV[i], i*0.5 );
+    EXPECT_FLOAT_EQ(dV[i], i==0 ? 7.0f : i*2.0f );
+  }
+
+  flow::rbuf_destroy(rbuf);
+  flow::recd_columns_destroy(cols);
+  flow::recd_layout_destroy(layout);
+  flow::recd_array_destroy(ra1);
+  flow::recd_array_destroy(ra0);
+  flow::recd_type_destroy(t1);
+  flow::recd_type_destroy(t0);
+  cfg0->free();
+  cfg1->free();
+}
+
+TEST( FlowTest, BackgroundPrepareTest )
+{
+  // The network is created, initialized and pre-warmed on a background thread
+  // and then executed on this thread.  (See io_flow_ctl::program_swap())
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+
+	    network:
+	    {
+	      procs: {
+	        osc : { class: sine_tone, args:{ ch_cnt:1, hz:0, gain:0, dc:1 } }
+	        g   : { class: audio_gain, in:{ in:osc.out }, args:{ gain:0.5 } }
+	        sh  : { class: sample_hold, in:{ in:g.out }, args:{ period_ms:1 } }
+	      } 
+	    }
+    })";
+
+  rc_t              rc;
+  flow_pgm_t        pgm;
+  rc_t              prep_rc        = kOpFailRC;
+  
+  ASSERT_EQ(rc = objectFromFile(PROC_DICT_FNAME,pgm.proc_class_cfg),kOkRC);
+  ASSERT_EQ(rc = objectFromString(pgm_src,pgm.pgm_cfg),kOkRC);
+
+  std::thread t([&](){
+    if((prep_rc = flow::create(pgm.flowH,pgm.proc_class_cfg,pgm.pgm_cfg)) == kOkRC )
+      if((prep_rc = flow::initialize(pgm.flowH)) == kOkRC )
+        prep_rc = flow::prewarm(pgm.flowH);
+  });
+  t.join();
+  
+  EXPECT_EQ(prep_rc, kOkRC );
+
+  log::set_level( log::kError_LogLevel );
+  
+  EXPECT_EQ(FlowCheck(pgm,3,"sh","out",0.5f), kOkRC );
+  
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+}
+
+TEST( FlowTest, ProgramSwapTest )
+{
+  // The outgoing program writes 0.75 and the incoming program writes 0.25 to the
+  // output device. The programs are crossfaded over 4 cycles.
+  const char* cur_src = R"(
+    {
+      sample_rate:48000, frames_per_cycle:64,
+	    network: { procs: {
+	        osc  : { class: sine_tone, args:{ ch_cnt:1, hz:0, gain:0, dc:0.75 } }
+	        aout : { class: audio_out, in:{ in:osc.out }, args:{ dev_label:"out" } }
+	    } }
+    })";
+  
+  const char* next_src = R"(
+    {
+      sample_rate:48000, frames_per_cycle:64,
+	    network: { procs: {
+	        osc  : { class: sine_tone, args:{ ch_cnt:1, hz:0, gain:0, dc:0.25 } }
+	        aout : { class: audio_out, in:{ in:osc.out }, args:{ dev_label:"out" } }
+	    } }
+    })";
+
+  // the sample rate or frames per cycle of these programs do not match the current program
+  const char* bad_srcA[] = {
+    R"({ sample_rate:44100, frames_per_cycle:64, network: { procs: { osc : { class: sine_tone, args:{ ch_cnt:1, hz:0, gain:0, dc:0 } } } } })",
+    R"({ sample_rate:48000, frames_per_cycle:128, network: { procs: { osc : { class: sine_tone, args:{ ch_cnt:1, hz:0, gain:0, dc:0 } } } } })"
+  };
+
+  const unsigned          frameN         = 64;
+  const unsigned          xfadeFrameN    = 4*frameN;
+  rc_t                    rc;
+  object_t*               proc_class_cfg = nullptr;
+  object_t*               cur_cfg        = nullptr;
+  object_t*               next_cfg       = nullptr;
+  log::logLevelId_t       level0         = log::level();
+  flow::handle_t          flowH;
+  flow::handle_t          nextH;
+  flow::sample_t          bufV[ frameN ];
+  flow::abuf_t            oBuf           = {};
+  flow::abuf_t*           oBufA[]        = { &oBuf };
+  flow::external_device_t dev            = {};
+  flow::swap::swap_t      s              = {};
+  flow::swap::args_t      args           = {};
+  bool                    pending_fl     = false;
+  bool                    done_fl        = false;
+
+  auto wait_for_build = [&]() {
+    while( flow::swap::state(s) == flow::swap::kBuildStateId )
+      sleepMs(1);
+  };
+
+  auto exec_cycle = [&]() {
+    vop::zero(bufV,frameN);
+    return flow::swap::exec_cycle(s,flowH);
+  };
+  
+  oBuf.srate        = 48000;
+  oBuf.chN          = 1;
+  oBuf.frameN       = frameN;
+  oBuf.bufAllocSmpN = frameN;
+  oBuf.buf          = bufV;
+  
+  dev.devLabel      = "out";
+  dev.typeId        = flow::kAudioDevTypeId;
+  dev.flags         = flow::kOutFl;
+  dev.u.a.abuf      = &oBuf;
+  
+  ASSERT_EQ(rc = objectFromFile(PROC_DICT_FNAME,proc_class_cfg),kOkRC);
+  ASSERT_EQ(rc = objectFromString(cur_src,cur_cfg),kOkRC);
+  ASSERT_EQ(rc = objectFromString(next_src,next_cfg),kOkRC);
+
+  log::set_level( log::kError_LogLevel );
+  
+  EXPECT_EQ(rc = flow::create(flowH,proc_class_cfg,cur_cfg),kOkRC);
+  EXPECT_EQ(rc = flow::initialize(flowH,&dev,1), kOkRC );
+
+  args.proc_class_cfg = proc_class_cfg;
+  args.deviceA        = &dev;
+  args.deviceN        = 1;
+  args.preset_idx     = kInvalidIdx;
+  args.oBufA          = oBufA;
+  args.oBufN          = 1;
+  args.xfadeFrameN    = xfadeFrameN;
+
+  // without a pending swap the current program is executed
+  EXPECT_EQ(rc = exec_cycle(), kOkRC );
+  EXPECT_FLOAT_EQ(bufV[0], 0.75f );
+  
+  // a next program which does not match the current program fails and leaves the current program running
+  log::set_level( log::kPrint_LogLevel );
+  for(const char* bad_src : bad_srcA)
+  {
+    object_t* bad_cfg = nullptr;
+    ASSERT_EQ(rc = objectFromString(bad_src,bad_cfg),kOkRC);
+    args.pgm_cfg = bad_cfg;
+    
+    EXPECT_EQ(rc = flow::swap::begin(s,flowH,args), kOkRC );
+    wait_for_build();
+    EXPECT_EQ(flow::swap::state(s), (unsigned)flow::swap::kFailStateId );
+
+    EXPECT_EQ(rc = exec_cycle(), kOkRC );
+    EXPECT_FLOAT_EQ(bufV[0], 0.75f );
+
+    EXPECT_NE(rc = flow::swap::update(s,flowH,pending_fl,done_fl), kOkRC );
+    EXPECT_FALSE(pending_fl);
+    EXPECT_FALSE(done_fl);
+    EXPECT_EQ(flow::swap::state(s), (unsigned)flow::swap::kIdleStateId );
+    
+    bad_cfg->free();
+  }
+  log::set_level( log::kError_LogLevel );
+
+  // build -> ready
+  args.pgm_cfg = next_cfg;
+  EXPECT_EQ(rc = flow::swap::begin(s,flowH,args), kOkRC );
+  
+  log::set_level( log::kPrint_LogLevel );
+  EXPECT_NE(rc = flow::swap::begin(s,flowH,args), kOkRC ); // a second swap cannot be started
+  log::set_level( log::kError_LogLevel );
+  
+  wait_for_build();
+  EXPECT_EQ(flow::swap::state(s), (unsigned)flow::swap::kReadyStateId );
+
+  EXPECT_EQ(rc = flow::swap::update(s,flowH,pending_fl,done_fl), kOkRC );
+  EXPECT_TRUE(pending_fl);
+  EXPECT_FALSE(done_fl);
+
+  // ready -> xfade: the output is a linear crossfade from 0.75 to 0.25
+  for(unsigned i=0; i<xfadeFrameN/frameN; ++i)
+  {
+    EXPECT_EQ(rc = exec_cycle(), kOkRC );
+    for(unsigned j=0; j<frameN; ++j)
+    {
+      flow::sample_t g = (flow::sample_t)(i*frameN + j) / xfadeFrameN;
+      EXPECT_NEAR(bufV[j], g*0.25f + (1-g)*0.75f, 1e-6 );
+    }
+  }
+
+  // xfade -> done
+  EXPECT_EQ(flow::swap::state(s), (unsigned)flow::swap::kDoneStateId );
+  EXPECT_EQ(rc = exec_cycle(), kOkRC );
+  EXPECT_FLOAT_EQ(bufV[0], 0.25f );
+
+  // done -> idle: the incoming program is adopted and the outgoing program is released
+  nextH = s.nextFlowH;
+  EXPECT_EQ(rc = flow::swap::update(s,flowH,pending_fl,done_fl), kOkRC );
+  EXPECT_FALSE(pending_fl);
+  EXPECT_TRUE(done_fl);
+  EXPECT_EQ(flowH.p, nextH.p );
+  EXPECT_EQ(flow::swap::state(s), (unsigned)flow::swap::kIdleStateId );
+  
+  EXPECT_EQ(rc = exec_cycle(), kOkRC );
+  EXPECT_FLOAT_EQ(bufV[frameN-1], 0.25f );
+
+  // an unfinished swap is released without changing the current program
+  EXPECT_EQ(rc = flow::swap::begin(s,flowH,args), kOkRC );
+  wait_for_build();
+  EXPECT_EQ(rc = exec_cycle(), kOkRC );
+  EXPECT_EQ(rc = flow::swap::release(s,flowH,done_fl), kOkRC );
+  EXPECT_FALSE(done_fl);
+  EXPECT_EQ(flowH.p, nextH.p );
+  EXPECT_EQ(flow::swap::state(s), (unsigned)flow::swap::kIdleStateId );
+  
+  EXPECT_EQ(rc = flow::destroy(flowH), kOkRC );
+  log::set_level( level0 );
+
+  next_cfg->free();
+  cur_cfg->free();
+  proc_class_cfg->free();
+}
+
+TEST( FlowTest, PolyIdleSkipTest )
+{
+  // The 'midi_voice' in each voice reports activity only while it is sounding.
+  // The voices therefore become idle, and their outputs are cleared, after the
+  // first cycles and are woken again by the note-on sent from 'mm'.
+  // (The note-on sent prior to runtime has a velocity of 0 and is therefore a note-off.)
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+
+	    network:
+	    {
+	      procs: {
+	        vel  : { class: number, args:{ in:0, out_type:uint } }
+	        trig : { class: number, args:{ in:0 } }
+	        mm   : { class: midi_msg, in:{ d1d:vel.out, trigger:trig.out }, args:{ status:144, d0d:60 } }
+	        
+	        vp : {
+	          class: poly,
+	          args: { count:2, parallel_fl:true, thread_cnt:2, idle_skip_fl:true },
+
+	          network: {
+	            procs: {
+	              mv  : { class: midi_voice, in:{ in:_.mm.out }, args:{ chCnt:1 } }
+	              osc : { class: sine_tone, args:{ ch_cnt:1, hz:0, gain:0, dc:1 } }
+	            }
+	          }
+	        }
+	        
+	        mx : { class: audio_mix,   in:{ in_:vp.osc_.out } }
+	        sh : { class: sample_hold, in:{ in:mx.out }, args:{ period_ms:1 } }
+	      } 
+	    }
+    })";
+
+  rc_t       rc;
+  flow_pgm_t pgm;
+  
+  ASSERT_EQ(FlowCreate(pgm,pgm_src), kOkRC );
+
+  // the voices execute on the first cycles ...
+  EXPECT_EQ(FlowCheck(pgm,1,"sh","out",1.0f), kOkRC );
+
+  // ... and then become idle because the 'midi_voice' is not sounding
+  EXPECT_EQ(FlowCheck(pgm,3,"sh","out",0.0f), kOkRC );
+
+  // a note-on wakes the voices
+  EXPECT_EQ(rc = flow::set_variable_value(pgm.flowH,"vel","out",kInvalidIdx,100u), kOkRC );
+  EXPECT_EQ(rc = flow::set_variable_value(pgm.flowH,"trig","out",kInvalidIdx,1.0), kOkRC );
+  
+  EXPECT_EQ(FlowCheck(pgm,3,"sh","out",1.0f), kOkRC );
+
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+}
+
+TEST( FlowTest, BatchRenderTest )
+{
+  // Each job renders the same program with a different preset or arg. override.
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+      max_cycle_count:50,
+
+	    network:
+	    {
+	      procs: {
+	        osc : { class: sine_tone, args:{ ch_cnt:2, hz:220 } }
+	        g   : { class: audio_gain, in:{ in:osc.out }, args:{ gain:0.5 } }
+	        mx  : { class: audio_mix,  in:{ in0:g.out, in1:osc.out } }
+	      }
+
+	      presets: {
+	        quiet: { g:{ gain:0.1 } },
+	        loud:  { g:{ gain:0.9 } },
+	      }
+	    }
+    })";
+
+  const char* args_src = R"( { g:{ gain:0.75 }, osc:{ hz:440 } } )";
+  const char* bad_src  = R"( { xyz:{ gain:0.75 } } )";
+
+  rc_t              rc;
+  object_t*         proc_class_cfg = nullptr;
+  object_t*         pgm_cfg        = nullptr;
+  object_t*         args_cfg       = nullptr;
+  object_t*         bad_cfg        = nullptr;
+  log::logLevelId_t level0         = log::level();
+  flow::batch::job_t jobA[5];
+  const unsigned     jobN          = sizeof(jobA)/sizeof(jobA[0]);
+  
+  ASSERT_EQ(rc = objectFromFile(PROC_DICT_FNAME,proc_class_cfg),kOkRC);
+  ASSERT_EQ(rc = objectFromString(pgm_src,pgm_cfg),kOkRC);
+  ASSERT_EQ(rc = objectFromString(args_src,args_cfg),kOkRC);
+  ASSERT_EQ(rc = objectFromString(bad_src,bad_cfg),kOkRC);
+
+  memset(jobA,0,sizeof(jobA));
+  for(unsigned i=0; i<jobN; ++i)
+    jobA[i].pgm_cfg = pgm_cfg;
+
+  jobA[1].preset_label = "quiet";
+  jobA[2].preset_label = "loud";
+  jobA[3].arg_cfg      = args_cfg;
+  
+  log::set_level( log::kError_LogLevel );
+  
+  EXPECT_EQ(rc = flow::batch::run(proc_class_cfg,jobA,jobN-1,2,64*1024*1024), kOkRC );
+
+  for(unsigned i=0; i<jobN-1; ++i)
+  {
+    EXPECT_EQ(jobA[i].rc, kOkRC );
+    EXPECT_EQ(jobA[i].cycle_cnt, jobA[0].cycle_cnt );
+    EXPECT_GT(jobA[i].audio_sec, 0.0 );
+    EXPECT_GT(jobA[i].rt_factor, 0.0 );
+    EXPECT_GT(jobA[i].peak_byte_cnt, 0 );
+  }
+
+  // a job which overrides the args of a proc which does not exist fails
+  // without affecting the other jobs
+  jobA[4].arg_cfg      = bad_cfg;
+  jobA[1].preset_label = "xyz";
+  
+  log::set_level( log::kFatal_LogLevel );
+  EXPECT_NE(rc = flow::batch::run(proc_class_cfg,jobA,jobN,3), kOkRC );
+  log::set_level( level0 );
+
+  EXPECT_NE(jobA[1].rc, kOkRC );
+  EXPECT_NE(jobA[4].rc, kOkRC );
+  EXPECT_EQ(jobA[0].rc, kOkRC );
+  EXPECT_EQ(jobA[2].rc, kOkRC );
+  EXPECT_EQ(jobA[3].rc, kOkRC );
+  
+  bad_cfg->free();
+  args_cfg->free();
+  pgm_cfg->free();
+  proc_class_cfg->free();
+}
+
+TEST( FlowTest, BypassTest )
+{
+  // 'g_a' and 'mx' are skipped because their inputs are silent, 'g_b' is skipped
+  // because its gain is 0 and 'lim' copies its input to its output because 'bypass' is set.
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+
+	    network:
+	    {
+	      procs: {
+	        silent : { class: sine_tone, args:{ ch_cnt:1, hz:100, gain:0, dc:0 } }
+	        dc     : { class: sine_tone, args:{ ch_cnt:1, hz:0,   gain:0, dc:1 } }
+	        g_a    : { class: audio_gain, in:{ in:silent.out }, args:{ gain:0.5 } }
+	        g_b    : { class: audio_gain, in:{ in:dc.out },     args:{ gain:0 } }
+	        g_c    : { class: audio_gain, in:{ in:dc.out },     args:{ gain:0.5 } }
+	        mx     : { class: audio_mix,  in:{ in0:g_a.out, in1:g_b.out } }
+	        lim    : { class: limiter,    in:{ in:g_c.out },    args:{ bypass:true, thresh:0.1 } }
+	        sh_mx  : { class: sample_hold, in:{ in:mx.out },  args:{ period_ms:1 } }
+	        sh_lim : { class: sample_hold, in:{ in:lim.out }, args:{ period_ms:1 } }
+	      } 
+	    }
+    })";
+
+  const unsigned         cycleN         = 4;
+  rc_t                   rc;
+  flow_pgm_t             pgm;
+  flow::latency_stats_t  stats;
+  const char*            labelA[]       = { "g_a", "g_b", "mx", "lim", "g_c" };
+  const unsigned         bypassA[]      = { cycleN, cycleN, cycleN, cycleN, 0 };
+  
+  ASSERT_EQ(FlowCreate(pgm,pgm_src), kOkRC );
+
+  EXPECT_EQ(FlowCheck(pgm,cycleN,"sh_mx","out",0.0f), kOkRC );
+  EXPECT_EQ(FlowCheck(pgm,0,"sh_lim","out",0.5f), kOkRC );
+
+  for(unsigned i=0; i<sizeof(labelA)/sizeof(labelA[0]); ++i)
+  {
+    EXPECT_EQ(rc = flow::latency_stats(pgm.flowH,labelA[i],flow::kBaseSfxId,stats), kOkRC );
+    EXPECT_EQ(stats.bypass_cnt, bypassA[i] ) << labelA[i];
+  }
+
+  // a non-zero gain on 'g_b' brings 'g_b' and 'mx' back into execution
+  EXPECT_EQ(rc = flow::set_variable_value(pgm.flowH,"g_b","gain",flow::kAnyChIdx,1.0f), kOkRC );
+  
+  EXPECT_EQ(FlowCheck(pgm,3,"sh_mx","out",0.5f), kOkRC );
+
+  EXPECT_EQ(rc = flow::latency_stats(pgm.flowH,"g_b",flow::kBaseSfxId,stats), kOkRC );
+  EXPECT_EQ(stats.bypass_cnt, cycleN );
+  
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+}
+
+TEST( FlowTest, SignalAlignmentTest )
+{
+  // aligned blocks are released by mem::release()
+  for(unsigned alignByteN : { 8u, 16u, 64u, 4096u })
+  {
+    double* v = mem::allocAlignedZ<double>(13,alignByteN);
+    EXPECT_EQ( (uintptr_t)v % alignByteN, 0u );
+    EXPECT_EQ( mem::byteCount(v), 13*sizeof(double) );
+    EXPECT_DOUBLE_EQ( v[12], 0.0 );
+    mem::release(v);
+    EXPECT_EQ( v, nullptr );
+  }
+
+  // every channel is aligned when the channel length is a multiple of the alignment ...
+  flow::abuf_t* a = flow::abuf_create(48000,3,64);
+  EXPECT_TRUE( flow::abuf_is_aligned(a) );
+  EXPECT_EQ( a->bufAllocSmpN % (flow::kSignalAlignByteN/sizeof(flow::sample_t)), 0u );
+  flow::abuf_destroy(a);
+
+  // ... otherwise only the buffer is aligned and padded
+  a = flow::abuf_create(48000,2,10);
+  EXPECT_FALSE( flow::abuf_is_aligned(a) );
+  EXPECT_TRUE( flow::abuf_is_aligned(a,sizeof(flow::sample_t)) );
+  EXPECT_EQ( (uintptr_t)a->buf % flow::kSignalAlignByteN, 0u );
+  EXPECT_EQ( a->bufAllocSmpN, 2*flow::kSignalAlignByteN/sizeof(flow::sample_t) );
+  flow::abuf_destroy(a);
+
+  // every fbuf vector is aligned and the vectors of different channels do not overlap
+  unsigned       maxBinA[] = { 33, 7 };
+  unsigned       binA[]    = { 33, 5 };
+  unsigned       hopA[]    = { 16, 16 };
+  flow::fbuf_t*  f         = flow::fbuf_create(48000,2,maxBinA,binA,hopA);
+  flow::fbuf_t*  g         = nullptr;
+  
+  EXPECT_TRUE( flow::fbuf_is_aligned(f) );
+  
+  for(unsigned i=0; i<f->chN; ++i)
+  {
+    vop::fill(f->magV[i],f->maxBinN_V[i],(flow::fd_sample_t)(1+i));
+    vop::fill(f->phsV[i],f->maxBinN_V[i],(flow::fd_sample_t)(3+i));
+    vop::fill(f->hzV[i], f->maxBinN_V[i],(flow::fd_sample_t)(5+i));
+  }
+  
+  for(unsigned i=0; i<f->chN; ++i)
+    for(unsigned j=0; j<f->maxBinN_V[i]; ++j)
+    {
+      EXPECT_EQ( f->magV[i][j], (flow::fd_sample_t)(1+i) );
+      EXPECT_EQ( f->phsV[i][j], (flow::fd_sample_t)(3+i) );
+      EXPECT_EQ( f->hzV[i][j],  (flow::fd_sample_t)(5+i) );
+    }
+
+  g = flow::fbuf_duplicate(nullptr,f);
+  EXPECT_TRUE( flow::fbuf_is_aligned(g) );
+  EXPECT_EQ( g->hzV[1][4], (flow::fd_sample_t)6 );
+  
+  flow::fbuf_destroy(g);
+  flow::fbuf_destroy(f);
+}
+
+TEST( FlowTest, FlowBenchTest )
+{
+  // A serial, a fanned-out parallel, and a poly network.
+  const char* cfg_src = R"(
+    {
+      proc_cfg_fname: "../../../src/flow/rsrc/proc_dict.cfg",
+      out_fname: "flow_bench_test.json",
+      cycle_cnt: 20,
+      networks: [
+        { label:"serial", width:1, depth:4, ch_cnt:2, procs:[ audio_gain, dc_filter ], proc_args:{ audio_gain:{ gain:0.5 } } },
+        { label:"wide",   width:4, depth:2, ch_cnt:1, fan_out:2, procs:[ audio_gain ], options:{ parallel_fl:true } },
+        { label:"poly",   width:2, depth:1, ch_cnt:1, voice_cnt:3, procs:[ audio_gain ] },
+      ]
+    })";
+
+  // A baseline which is much faster than any real run.
+  const char* fast_src = R"( { networks: [ { label:"serial", cycles_per_sec:1e15 } ] } )";
+
+  rc_t              rc;
+  object_t*         cfg      = nullptr;
+  object_t*         fast_cfg = nullptr;
+  object_t*         out_cfg  = nullptr;
+  const object_t*   nets_cfg = nullptr;
+  log::logLevelId_t level0   = log::level();
+  const unsigned    procCntA[] = { 6, 13, 17 }; // poly: 3 voices * (2 osc + 2 procs + mix) + poly + mix
+
+  // replace a top level cfg value
+  auto set_value = [&cfg]( const char* label, auto value )
+  {
+    object_t* o;
+    if((o = cfg->find(label)) != nullptr )
+    {
+      o = o->parent;
+      o->unlink();
+      o->free();
+    }
+    newPairObject(label,value,cfg);
+  };
+
+  ASSERT_EQ(rc = objectFromString(cfg_src,cfg),kOkRC);
+  ASSERT_EQ(rc = objectFromString(fast_src,fast_cfg),kOkRC);
+  ASSERT_EQ(rc = objectToFile("flow_bench_fast.json",fast_cfg),kOkRC);
+
+  log::set_level( log::kError_LogLevel );
+
+  EXPECT_EQ(rc = flow::bench::run(cfg), kOkRC );
+
+  // the JSON output must be readable and report each network
+  ASSERT_EQ(rc = objectFromFile("flow_bench_test.json",out_cfg),kOkRC);
+  ASSERT_EQ(rc = out_cfg->getv("networks",nets_cfg),kOkRC);
+  ASSERT_EQ(nets_cfg->child_count(),3u);
+
+  for(unsigned i=0; i<nets_cfg->child_count(); ++i)
+  {
+    const char*     label          = nullptr;
+    unsigned        cycle_cnt      = 0;
+    unsigned        proc_cnt       = 0;
+    double          cycles_per_sec = 0;
+    double          mem_bytes      = 0;
+    const object_t* classes_cfg    = nullptr;
+    
+    EXPECT_EQ(rc = nets_cfg->child_ele(i)->getv("label",label,"cycle_cnt",cycle_cnt,"proc_cnt",proc_cnt,"cycles_per_sec",cycles_per_sec,"mem_bytes",mem_bytes,"classes",classes_cfg), kOkRC );
+    EXPECT_EQ(cycle_cnt, 20u );
+    EXPECT_EQ(proc_cnt, procCntA[i] );
+    EXPECT_GT(cycles_per_sec, 0.0 );
+    EXPECT_GT(mem_bytes, 0.0 );
+    ASSERT_NE(classes_cfg, nullptr );
+    EXPECT_GE(classes_cfg->child_count(), 3u ); // sine_tone, audio_gain, audio_mix, ...
+
+    // each class has a measured execution time
+    for(unsigned j=0; j<classes_cfg->child_count(); ++j)
+    {
+      double ns = 0;
+      EXPECT_EQ(rc = classes_cfg->child_ele(j)->getv("ns_per_proc_cycle",ns), kOkRC );
+      EXPECT_GT(ns, 0.0 );
+    }
+  }
+
+  // a run compared to its own output passes ...
+  set_value("baseline_fname","flow_bench_test.json");
+  set_value("max_regression_pct",100.0);
+  EXPECT_EQ(rc = flow::bench::run(cfg), kOkRC );
+
+  // ... but fails against a faster baseline
+  set_value("baseline_fname","flow_bench_fast.json");
+  set_value("max_regression_pct",10.0);
+  EXPECT_EQ(rc = flow::bench::run(cfg), kOpFailRC );
+
+  log::set_level( level0 );
+
+  remove("flow_bench_test.json");
+  remove("flow_bench_fast.json");
+  
+  out_cfg->free();
+  fast_cfg->free();
+  cfg->free();
+}
+
+namespace
+{
+  // Count the UI updates per var.
+  typedef struct ui_count_str
+  {
+    unsigned total_cnt;
+    unsigned gain_cnt;  // 'g.gain' (normal priority)
+    unsigned low_cnt;   // 'sh.out' and 'sh.mean' ('ui_low' priority)
+  } ui_count_t;
+
+  rc_t _ui_count_callback( void* arg, flow::ui_var_t* ui_var )
+  {
+    ui_count_t* c = (ui_count_t*)arg;
+    
+    c->total_cnt += 1;
+
+    if( strcmp(ui_var->label,"gain") == 0 )
+      c->gain_cnt += 1;
+    else
+      if( strcmp(ui_var->label,"out") == 0 || strcmp(ui_var->label,"mean") == 0 )
+        c->low_cnt += 1;
+    
+    return kOkRC;
+  }
+}
+
+TEST( FlowTest, UiUpdateTest )
+{
+  // 'g.gain' is set on every cycle and 'sh' updates its 'ui_low' output on every cycle.
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+      ui_update_ms:10,
+      
+	    network:
+	    {
+	      procs: {
+	        osc : { class: sine_tone,   args:{ ch_cnt:1, hz:100 } }
+	        g   : { class: audio_gain,  in:{ in:osc.out } }
+	        sh  : { class: sample_hold, in:{ in:g.out }, args:{ period_ms:1 } }
+	      } 
+	    }
+    })";
+
+  const unsigned    cycleN         = 750;  // 1 second at 48000/64
+  rc_t              rc;
+  object_t*         proc_class_cfg = nullptr;
+  object_t*         pgm_cfg        = nullptr;
+  log::logLevelId_t level0         = log::level();
+  
+  ASSERT_EQ(rc = objectFromFile(PROC_DICT_FNAME,proc_class_cfg),kOkRC);
+  ASSERT_EQ(rc = objectFromString(pgm_src,pgm_cfg),kOkRC);
+
+  auto run = [&]( unsigned budget, ui_count_t& cnt, flow::ui_update_stats_t& stats )
+  {
+    flow::handle_t flowH;
+    object_t*      cfg = pgm_cfg->duplicate();
+
+    memset(&cnt,0,sizeof(cnt));
+    newPairObject("ui_update_budget",budget,cfg);
+    
+    EXPECT_EQ(rc = flow::create(flowH,proc_class_cfg,cfg,nullptr,nullptr,_ui_count_callback,&cnt),kOkRC);
+    EXPECT_EQ(rc = flow::initialize(flowH), kOkRC );
+
+    // enable the UI for every var of the root network
+    const flow::ui_net_t* ui_net = flow::ui_net(flowH);
+    for(unsigned i=0; i<ui_net->procN; ++i)
+      for(unsigned j=0; j<ui_net->procA[i].varN; ++j)
+        EXPECT_EQ(rc = flow::set_variable_user_arg(flowH,ui_net->procA[i].varA + j,mem::allocZ<unsigned>()), kOkRC );
+        
+    for(unsigned i=0; i<cycleN; ++i)
+    {
+      EXPECT_EQ(rc = flow::set_variable_value(flowH,"g","gain",flow::kAnyChIdx,0.5f + (i%2)*0.25f), kOkRC );
+      EXPECT_EQ(rc = flow::exec_cycle(flowH), kOkRC );
+    }
+
+    flow::ui_update_stats(flowH,stats);
+    mem::clear_warn_on_alloc();
+    
+    EXPECT_EQ(rc = flow::destroy(flowH), kOkRC );
+    cfg->free();
+  };
+
+  ui_count_t              cnt;
+  flow::ui_update_stats_t stats;
+
+  log::set_level( log::kError_LogLevel );
+
+  // without a budget every var is sent once per UI update (every 7 cycles) and the remaining updates are coalesced
+  run(0,cnt,stats);
+  EXPECT_EQ(stats.sent_cnt, cnt.total_cnt );
+  EXPECT_GE(stats.flush_cnt, cycleN/7 - 1 );
+  EXPECT_GE(cnt.gain_cnt, cycleN/7 - 1 );
+  EXPECT_GE(cnt.low_cnt, cycleN/7 - 1 );
+  EXPECT_GT(stats.coalesced_cnt, cnt.total_cnt );
+  EXPECT_EQ(stats.deferred_cnt, 0u );
+  EXPECT_EQ(stats.dropped_cnt, 0u );
+
+  // a budget of 50 updates/sec is given to 'g.gain' before the low priority meters
+  run(50,cnt,stats);
+  EXPECT_EQ(stats.sent_cnt, cnt.total_cnt );
+  EXPECT_LE(cnt.total_cnt, 51u );
+  EXPECT_GT(cnt.gain_cnt, 40u );
+  EXPECT_LT(cnt.low_cnt, cnt.gain_cnt );
+  EXPECT_GT(stats.deferred_cnt, 0u );
+  EXPECT_GT(stats.dropped_cnt, 0u );
+  
+  log::set_level( level0 );
+  
+  pgm_cfg->free();
+  proc_class_cfg->free();
+}
+
+TEST( FlowTest, MidiChainTest )
+{
+  // A chord and a pedal change are merged and then pass through a chain of
+  // 'midi_select' procs. Each selection is an index view of the merged
+  // messages and therefore the chain should not allocate or copy messages.
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+
+	    network:
+	    {
+	      procs: {
+	        vel  : { class: number, args:{ in:0, out_type:uint } }
+	        ped  : { class: number, args:{ in:0, out_type:uint } }
+	        trig : { class: number, args:{ in:0 } }
+	        
+	        na : { class: midi_msg, in:{ d1d:vel.out, trigger:trig.out }, args:{ status:144, d0d:60 } }
+	        nb : { class: midi_msg, in:{ d1d:vel.out, trigger:trig.out }, args:{ status:144, d0d:62 } }
+	        nc : { class: midi_msg, in:{ d1d:vel.out, trigger:trig.out }, args:{ status:144, d0d:64 } }
+	        pd : { class: midi_msg, in:{ d1d:ped.out, trigger:trig.out }, args:{ status:176, d0d:64 } }
+	        mg : { class: midi_merge, in:{ in0:na.out, in1:nb.out, in2:nc.out, in3:pd.out } }
+
+	        sa : { class: midi_select, in:{ in:mg.out }, args:{ sel_status:-1 } }
+	        sb : { class: midi_select, in:{ in:sa.out }, args:{ sel_status:-1 } }
+	        sc : { class: midi_select, in:{ in:sb.out }, args:{ sel_status:-1 } }
+	        sd : { class: midi_select, in:{ in:sc.out }, args:{ sel_status:-1 } }
+	        se : { class: midi_select, in:{ in:sd.out }, args:{ sel_status:-1 } }
+	        sf : { class: midi_select, in:{ in:se.out }, args:{ sel_status:-1 } }
+	        sg : { class: midi_select, in:{ in:sf.out }, args:{ sel_status:-1 } }
+	        
+	        notes : { class: midi_select, in:{ in:sg.out },    args:{ sel_status:144 } }
+	        note  : { class: midi_select, in:{ in:notes.out }, args:{ sel_status:-1, sel_byte_a:62 } }
+	        pedal : { class: midi_select, in:{ in:sg.out },    args:{ sel_status:176 } }
+	        split : { class: midi_split,  in:{ in:note.out } }
+	      } 
+	    }
+    })";
+
+  rc_t              rc;
+  flow_pgm_t        pgm;
+  unsigned          value          = 0;
+  long long         peak_byte_cnt  = 0;
+  
+  ASSERT_EQ(FlowCreate(pgm,pgm_src), kOkRC );
+
+  EXPECT_EQ(FlowCycles(pgm,1), kOkRC );
+
+  mem::reset_thread_byte_count();
+  
+  for(unsigned i=0; i<100; ++i)
+  {
+    // send a chord and a pedal change on every cycle
+    EXPECT_EQ(rc = flow::set_variable_value(pgm.flowH,"vel","out",kInvalidIdx,i%127+1), kOkRC );
+    EXPECT_EQ(rc = flow::set_variable_value(pgm.flowH,"ped","out",kInvalidIdx,i%2 ? 0u : 127u), kOkRC );
+    EXPECT_EQ(rc = flow::set_variable_value(pgm.flowH,"trig","out",kInvalidIdx,(double)i), kOkRC );
+    
+    EXPECT_EQ(FlowCycles(pgm,1), kOkRC );
+  }
+
+  // no memory was allocated while the messages were passed through the network
+  peak_byte_cnt = mem::thread_peak_byte_count();
+  EXPECT_EQ(peak_byte_cnt, 0 );
+
+  // the last note-on of the chord ...
+  EXPECT_EQ(rc = flow::get_variable_value(pgm.flowH,"notes","byte_a",flow::kAnyChIdx,value), kOkRC );
+  EXPECT_EQ(value, 64u );
+
+  // ... the second note-on of the chord
+  EXPECT_EQ(rc = flow::get_variable_value(pgm.flowH,"note","byte_a",flow::kAnyChIdx,value), kOkRC );
+  EXPECT_EQ(value, 62u );
+  EXPECT_EQ(rc = flow::get_variable_value(pgm.flowH,"split","d1d",flow::kAnyChIdx,value), kOkRC );
+  EXPECT_EQ(value, 100u );
+
+  // the last pedal change
+  EXPECT_EQ(rc = flow::get_variable_value(pgm.flowH,"pedal","byte_a",flow::kAnyChIdx,value), kOkRC );
+  EXPECT_EQ(value, 64u );
+  EXPECT_EQ(rc = flow::get_variable_value(pgm.flowH,"pedal","byte_b",flow::kAnyChIdx,value), kOkRC );
+  EXPECT_EQ(value, 0u );
+
+  mem::clear_warn_on_alloc();
+  
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+}
+
+TEST( FlowTest, MidiSelectOverflowTest )
+{
+  // Three note-on's are selected into a buffer with room for two messages.
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+
+	    network:
+	    {
+	      procs: {
+	        vel  : { class: number, args:{ in:0, out_type:uint } }
+	        trig : { class: number, args:{ in:0 } }
+	        
+	        na : { class: midi_msg, in:{ d1d:vel.out, trigger:trig.out }, args:{ status:144, d0d:60 } }
+	        nb : { class: midi_msg, in:{ d1d:vel.out, trigger:trig.out }, args:{ status:144, d0d:62 } }
+	        nc : { class: midi_msg, in:{ d1d:vel.out, trigger:trig.out }, args:{ status:144, d0d:64 } }
+	        mg : { class: midi_merge, in:{ in0:na.out, in1:nb.out, in2:nc.out } }
+	        
+	        sel : { class: midi_select, in:{ in:mg.out }, args:{ sel_status:-1, buf_cnt:2 } }
+	      } 
+	    }
+    })";
+
+  rc_t       rc;
+  flow_pgm_t pgm;
+  
+  ASSERT_EQ(FlowCreate(pgm,pgm_src), kOkRC );
+
+  EXPECT_EQ(FlowCycles(pgm,1), kOkRC );
+  
+  EXPECT_EQ(rc = flow::set_variable_value(pgm.flowH,"vel","out",kInvalidIdx,100u), kOkRC );
+  EXPECT_EQ(rc = flow::set_variable_value(pgm.flowH,"trig","out",kInvalidIdx,1.0), kOkRC );
+
+  log::clear_buffer();
+  log::set_flags( log::flags() | log::kBufEnableFl );
+  log::set_level( log::kWarning_LogLevel );
+  
+  EXPECT_EQ(FlowCycles(pgm,1), kOkRC );
+  
+  log::set_flags( cwClrFlag(log::flags(), log::kBufEnableFl));
+  log::set_level( log::kError_LogLevel );
+
+  // the truncation is reported
+  EXPECT_NE(strstr(log::buffer(),"1 messages were dropped"), nullptr ) << log::buffer();
+  
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+}
+
+TEST( FlowTest, SymbolIndexTest )
+{
+  // Create a long chain of 'number' procs and a large number of network presets
+  // to exercise the proc, variable and preset label indexes.
+  const unsigned procN   = 500;
+  const unsigned presetN = 100;
+  char*          pgm_src = nullptr;
+
+  pgm_src = mem::printp(pgm_src,"{ non_real_time_fl:true, network: { procs: { n0x: { class:number, args:{ in:7 } } ");
+  for(unsigned i=1; i<procN; ++i)
+    pgm_src = mem::printp(pgm_src,"n%ix: { class:number, in:{ in:n%ix.out } } ",i,i-1);
+  
+  pgm_src = mem::printp(pgm_src,"} presets: { ");
+  for(unsigned i=0; i<presetN; ++i)
+    pgm_src = mem::printp(pgm_src,"p%ix: { n0x:{ in:%i } } ",i,i);
+  pgm_src = mem::printp(pgm_src,"} } }");
+
+  rc_t              rc;
+  flow_pgm_t        pgm;
+  double            value          = 0;
+  char              label[32];
+  
+  ASSERT_EQ(FlowCreate(pgm,pgm_src), kOkRC );
+
+  EXPECT_EQ(FlowCycles(pgm,1), kOkRC );
+
+  // the initial value propagated to the end of the chain
+  snprintf(label,sizeof(label),"n%ix",procN-1);
+  EXPECT_EQ(rc = flow::get_variable_value(pgm.flowH,label,"out",flow::kAnyChIdx,value), kOkRC );
+  EXPECT_DOUBLE_EQ(value, 7.0 );
+
+  // the presets are found by label
+  EXPECT_EQ(rc = flow::apply_preset(pgm.flowH,"p37x"), kOkRC );
+  EXPECT_EQ(rc = flow::get_variable_value(pgm.flowH,"n0x","in",flow::kAnyChIdx,value), kOkRC );
+  EXPECT_DOUBLE_EQ(value, 37.0 );
+
+  EXPECT_EQ(rc = flow::apply_preset(pgm.flowH,"p99x"), kOkRC );
+  EXPECT_EQ(rc = flow::get_variable_value(pgm.flowH,"n0x","in",flow::kAnyChIdx,value), kOkRC );
+  EXPECT_DOUBLE_EQ(value, 99.0 );
+
+  // unknown proc, variable and preset labels are not found
+  log::set_level( log::kFatal_LogLevel );
+  EXPECT_NE(rc = flow::get_variable_value(pgm.flowH,"n500x","out",flow::kAnyChIdx,value), kOkRC );
+  EXPECT_NE(rc = flow::get_variable_value(pgm.flowH,"n0x","no_var",flow::kAnyChIdx,value), kOkRC );
+  EXPECT_NE(rc = flow::apply_preset(pgm.flowH,"p100x"), kOkRC );
+  log::set_level( log::kError_LogLevel );
+
+  mem::clear_warn_on_alloc();
+  
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+  
+  mem::release(pgm_src);
+}
+
+TEST( FlowTest, ConvolveTest )
+{
+  // The IR is an impulse of 1 followed by an impulse of 0.5 which lies in the tail segment
+  // (the head covers (2*tail_fact-1)*64=192 frames) and a DC input is convolved with it.
+  const char*    ir_fname = "convolve_test_ir.wav";
+  const unsigned irN      = 300;
+  float          irV[ irN ] = { 0 };
+  const float*   irChA[]  = { irV };
+  irV[0]   = 1.0f;
+  irV[250] = 0.5f;
+  
+  ASSERT_EQ(audiofile::writeFileFloat(ir_fname, 48000, 0, irN, 1, irChA), kOkRC);
+  
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+
+	    network:
+	    {
+	      procs: {
+	        dc    : { class: sine_tone, args:{ ch_cnt:2, hz:0, gain:0, dc:1 } }
+	        conv  : { class: convolve, in:{ in:dc.out }, args:{ ir_fname:"convolve_test_ir.wav", ir_scale:0.5, tail_fact:2 } }
+	        sh    : { class: sample_hold, in:{ in:conv.out }, args:{ period_ms:1 } }
+	      } 
+	    }
+    })";
+
+  flow_pgm_t pgm;
+  
+  ASSERT_EQ(FlowCreate(pgm,pgm_src), kOkRC );
+
+  // only the first IR impulse has been reached
+  EXPECT_EQ(FlowCheck(pgm,1,"sh","out",0.5f,1,1e-5), kOkRC );
+
+  // both impulses are summed
+  EXPECT_EQ(FlowCheck(pgm,6,"sh","out",0.75f,0,1e-5), kOkRC );
+  EXPECT_EQ(FlowCheck(pgm,0,"sh","out",0.75f,1,1e-5), kOkRC );
+
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+  
+  remove(ir_fname);
+}
+
+#ifdef cwFFTW
+TEST( FlowTest, FftWisdomTest )
+{
+  // The FFT plans made while the network is created are written to the program's wisdom file.
+  const char* ir_fname     = "fft_wisdom_test_ir.wav";
+  const char* wisdom_fname = "fft_wisdom_test.txt";
+  float       irV[ 300 ]   = { 1.0f };
+  const float* irChA[]     = { irV };
+
+  ASSERT_EQ(audiofile::writeFileFloat(ir_fname, 48000, 0, 300, 1, irChA), kOkRC);
+  remove(wisdom_fname);
+
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+      fft_plan_effort:estimate,
+      fft_wisdom_fname:"fft_wisdom_test.txt",
+
+	    network:
+	    {
+	      procs: {
+	        dc    : { class: sine_tone, args:{ ch_cnt:1, hz:0, gain:0, dc:1 } }
+	        conv  : { class: convolve, in:{ in:dc.out }, args:{ ir_fname:"fft_wisdom_test_ir.wav" } }
+	      } 
+	    }
+    })";
+
+  rc_t           rc;
+  flow_pgm_t     pgm;
+  object_t*      bad_cfg = nullptr;
+  flow::handle_t badH;
+
+  ASSERT_EQ(FlowCreate(pgm,pgm_src), kOkRC );
+  EXPECT_TRUE(filesys::isFile(wisdom_fname));
+  EXPECT_EQ(FlowCycles(pgm,1), kOkRC );
+
+  // an unknown planning effort is rejected
+  ASSERT_EQ(rc = objectFromString("{ fft_plan_effort:fast, network:{ procs:{} } }",bad_cfg),kOkRC);
+  EXPECT_NE(rc = flow::create(badH,pgm.proc_class_cfg,bad_cfg),kOkRC);
+  bad_cfg->free();
+
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+  
+  remove(ir_fname);
+  remove(wisdom_fname);
+}
+#endif
+
+TEST( FlowTest, MultiChPvTest )
+{
+  // Both channels of the same signal pass through the batched PV analysis and synthesis.
+  const char* pgm_src = R"(
+    {
+      non_real_time_fl:true,
+
+	    network:
+	    {
+	      procs: {
+	        osc   : { class: sine_tone, args:{ ch_cnt:2, hz:1000, gain:0.5 } }
+	        pva   : { class: pv_analysis, in:{ in:osc.out }, args:{ maxWndSmpN:512, wndSmpN:512, hopSmpN:128 } }
+	        pvs   : { class: pv_synthesis, in:{ in:pva.out } }
+	        sh    : { class: sample_hold, in:{ in:pvs.out }, args:{ period_ms:1 } }
+	      } 
+	    }
+    })";
+
+  flow_pgm_t pgm;
+  float      maxV[2] = { 0, 0 };
+
+  ASSERT_EQ(FlowCreate(pgm,pgm_src), kOkRC );
+
+  for(unsigned i=0; i<64; ++i)
+  {
+    float v0 = 0, v1 = 0;
+    EXPECT_EQ(FlowCycles(pgm,1), kOkRC );
+    EXPECT_EQ(flow::get_variable_value(pgm.flowH,"sh","out",0,v0), kOkRC );
+    EXPECT_EQ(flow::get_variable_value(pgm.flowH,"sh","out",1,v1), kOkRC );
+    EXPECT_NEAR(v0, v1, 1e-6 );
+    maxV[0] = std::max(maxV[0],std::fabs(v0));
+    maxV[1] = std::max(maxV[1],std::fabs(v1));
+  }
+
+  // the signal was resynthesized
+  EXPECT_GT(maxV[0], 0.01f);
+  EXPECT_GT(maxV[1], 0.01f);
+
+  EXPECT_EQ(FlowDestroy(pgm), kOkRC );
+}
+
 /*
 class GlobalEnvironment : public ::testing::Environment {
 public:
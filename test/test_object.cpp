@@ -373,3 +373,37 @@ TEST_F(ObjectTest, StringEscapeTest)
     obj = nullptr;
 }
 
+
+// Test binary image serialization and invalidation
+TEST_F(ObjectTest, BinaryImageTest)
+{
+    const char* src = "{ name:\"test\", values:[ 1, [ \"nested\", true ], 3.5, -2 ], d:{ x:null, y:\"\" } }";
+    unsigned long long hash = objectTextHash(src,strlen(src));
+    object_t* obj  = nullptr;
+    object_t* obj2 = nullptr;
+    char*     buf  = nullptr;
+    unsigned  bufN = 0;
+
+    ASSERT_EQ(objectFromString(src, obj), kOkRC);
+    ASSERT_EQ(objectToBinary(obj, hash, buf, bufN), kOkRC);
+    ASSERT_EQ(objectFromBinary(buf, bufN, hash, obj2), kOkRC);
+    ASSERT_NE(obj2, nullptr);
+
+    char* s0 = obj->to_string();
+    char* s1 = obj2->to_string();
+    EXPECT_STREQ(s0, s1);
+    mem::release(s0);
+    mem::release(s1);
+    obj2->free();
+
+    // an image made from different source text is rejected
+    EXPECT_EQ(objectFromBinary(buf, bufN, hash+1, obj2), kInvalidStateRC);
+    EXPECT_EQ(obj2, nullptr);
+
+    // a truncated image is rejected
+    EXPECT_NE(objectFromBinary(buf, bufN-1, hash, obj2), kOkRC);
+    EXPECT_EQ(obj2, nullptr);
+
+    mem::release(buf);
+    obj->free();
+}
@@ -3,8 +3,10 @@
 #include "cwLog.h"
 #include "cwCommonImpl.h"
 #include "cwTest.h"
+#include "cwObject.h"
 #include "cwTime.h"
 #include "cwThread.h"
+#include "cwThreadMach.h"
 #include <atomic>
 
 using namespace cw;
@@ -176,3 +178,45 @@ TEST_F(ThreadTest, Properties) {
     
     thread::destroy(h);
 }
+
+// Counts the tasks executed by a thread_stasks machine.
+rc_t stask_cb(void* arg) {
+    std::atomic<unsigned>* counter = static_cast<std::atomic<unsigned>*>(arg);
+    counter->fetch_add(1);
+    return kOkRC;
+}
+
+TEST_F(ThreadTest, StasksDestroyAfterRun) {
+    const unsigned threadN = 4;
+    const unsigned taskN   = 8;
+    const unsigned iterN   = 2000;
+    
+    std::atomic<unsigned>   counter{0};
+    thread_stasks::task_t   taskA[ taskN ];
+
+    for(unsigned i=0; i<taskN; ++i) {
+        taskA[i].func = stask_cb;
+        taskA[i].arg  = &counter;
+        taskA[i].rc   = kOkRC;
+    }
+
+    // destroy() is called while the workers may still be returning from the tasks of run()
+    // and must neither hang nor lose the 'exit' request.
+    for(unsigned i=0; i<iterN; ++i) {
+        thread_stasks::handle_t h;
+        ASSERT_EQ(thread_stasks::create(h, threadN), kOkRC);
+        ASSERT_EQ(thread_stasks::run(h, taskA, taskN), kOkRC);
+        ASSERT_EQ(thread_stasks::destroy(h), kOkRC);
+    }
+
+    EXPECT_EQ(counter.load(), taskN * iterN);
+
+    // consecutive runs on the same machine execute every task once
+    thread_stasks::handle_t h;
+    counter.store(0);
+    ASSERT_EQ(thread_stasks::create(h, threadN), kOkRC);
+    for(unsigned i=0; i<iterN; ++i)
+        EXPECT_EQ(thread_stasks::run(h, taskA, taskN), kOkRC);
+    EXPECT_EQ(thread_stasks::destroy(h), kOkRC);
+    EXPECT_EQ(counter.load(), taskN * iterN);
+}
@@ -488,6 +488,143 @@ TEST(VectOpsTest, Filter) {
     EXPECT_NEAR(y_fill[3], 0.0, 1e-9);
 }
 
+// Compare each SIMD kernel set supported by this CPU against plain loops.
+// The sizes exercise the vector body and the scalar tail and the +1 offset forces unaligned access.
+template< typename T >
+void simd_equivalence_test()
+{
+    using namespace cw::vop;
+
+    const unsigned sizeA[] = { 0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1023 };
+    const T        eps     = std::is_same_v<T,float> ? 1e-5 : 1e-12;
+    const T        s0      = 0.75;
+    const T        s1      = -1.25;
+
+    simd::isa_id_t max_isa_id = simd::detect_isa();
+
+    for(unsigned isa_id=simd::kScalarIsaId; isa_id<=max_isa_id; ++isa_id)
+    {
+        ASSERT_EQ(simd::set_isa((simd::isa_id_t)isa_id), isa_id);
+
+        for(unsigned n : sizeA)
+        {
+            SCOPED_TRACE(std::string(simd::isa_label((simd::isa_id_t)isa_id)) + " n=" + std::to_string(n));
+
+            std::vector<T> xb0(n+1), xb1(n+1), yb(n+1), yb2(n+1);
+            for(unsigned i=0; i<n; ++i)
+            {
+                xb0[i+1] = (T)std::sin(0.1*i + 0.3);
+                xb1[i+1] = (T)std::cos(0.07*i) * 2;
+            }
+
+            // the inputs must be const to select the vector (rather than scalar) overloads
+            const T* x0 = xb0.data() + 1;
+            const T* x1 = xb1.data() + 1;
+            T*       y  = yb.data()  + 1;
+            T*       y2 = yb2.data() + 1;
+
+            // element-wise kernels match the scalar code exactly
+            mul(y,x0,x1,n);
+            for(unsigned i=0; i<n; ++i) ASSERT_EQ(y[i], x0[i]*x1[i]);
+
+            mul(y,x0,s0,n);
+            for(unsigned i=0; i<n; ++i) ASSERT_EQ(y[i], x0[i]*s0);
+
+            copy(y,x0,n);
+            mul(y,x1,n);
+            for(unsigned i=0; i<n; ++i) ASSERT_EQ(y[i], x0[i]*x1[i]);
+
+            add(y,x0,x1,n);
+            for(unsigned i=0; i<n; ++i) ASSERT_EQ(y[i], x0[i]+x1[i]);
+
+            add(y,x0,s1,n);
+            for(unsigned i=0; i<n; ++i) ASSERT_EQ(y[i], x0[i]+s1);
+
+            copy(y,x0,n);
+            add(y,x1,n);
+            for(unsigned i=0; i<n; ++i) ASSERT_EQ(y[i], x0[i]+x1[i]);
+
+            // the multiply-add kernels are compared to the scalar kernels because this file may be
+            // compiled with floating point contraction
+            simd::set_isa(simd::kScalarIsaId);
+            scale_add(y2,x0,s0,x1,s1,n);
+            simd::set_isa((simd::isa_id_t)isa_id);
+            
+            scale_add(y,x0,s0,x1,s1,n);
+            for(unsigned i=0; i<n; ++i) ASSERT_EQ(y[i], y2[i]);
+
+            copy(y,x0,n);
+            scale_add(y,s0,x1,s1,n);
+            for(unsigned i=0; i<n; ++i) ASSERT_EQ(y[i], y2[i]);
+
+            std::vector<T> cr(n), ci(n), cr2(n), ci2(n);
+            for(unsigned i=0; i<n; ++i) { cr[i] = cr2[i] = x1[i]; ci[i] = ci2[i] = -x0[i]; }
+            
+            simd::set_isa(simd::kScalarIsaId);
+            cmac(cr2.data(),ci2.data(),x0,x1,x1,x0,n);
+            simd::set_isa((simd::isa_id_t)isa_id);
+            
+            cmac(cr.data(),ci.data(),x0,x1,x1,x0,n);
+            for(unsigned i=0; i<n; ++i)
+            {
+                ASSERT_EQ(cr[i], cr2[i]);
+                ASSERT_EQ(ci[i], ci2[i]);
+                ASSERT_NEAR(ci[i], -x0[i] + (x0[i]*x0[i] + x1[i]*x1[i]), eps*4);
+            }
+
+            // reductions may differ by rounding
+            double mac_ref = 0, sum_ref = 0, sum_sq_ref = 0;
+            for(unsigned i=0; i<n; ++i)
+            {
+                mac_ref    += (double)x0[i]*x1[i];
+                sum_ref    += x0[i];
+                sum_sq_ref += (double)x0[i]*x0[i];
+            }
+
+            EXPECT_NEAR(mac(x0,x1,n),  mac_ref,    eps*(1+n));
+            EXPECT_NEAR(sum(x0,n),     sum_ref,    eps*(1+n));
+            EXPECT_NEAR(sum_sq(x0,n),  sum_sq_ref, eps*(1+n));
+            EXPECT_NEAR(rms(x0,n),     n==0 ? 0 : std::sqrt(sum_sq_ref/n), eps*(1+n));
+
+            // interleave/deinterleave are exact; x0[] holds 2 channels of n/2 frames
+            unsigned frameN = n/2;
+            interleave(y2,x0,frameN,2);
+            for(unsigned i=0; i<frameN; ++i)
+            {
+                ASSERT_EQ(y2[2*i],   x0[i]);
+                ASSERT_EQ(y2[2*i+1], x0[frameN+i]);
+            }
+
+            deinterleave(y,y2,frameN,2);
+            for(unsigned i=0; i<2*frameN; ++i)
+                ASSERT_EQ(y[i], x0[i]);
+
+        }
+    }
+
+    simd::set_isa(max_isa_id);
+}
+
+TEST(VectOpsTest, SimdFloatEquivalence) {
+    simd_equivalence_test<float>();
+}
+
+TEST(VectOpsTest, SimdDoubleEquivalence) {
+    simd_equivalence_test<double>();
+}
+
+TEST(VectOpsTest, SimdIsaSelect) {
+    using namespace cw::vop;
+    simd::isa_id_t max_isa_id = simd::detect_isa();
+
+    // requests above the CPU capability are limited to the detected instruction set
+    EXPECT_EQ(simd::set_isa(simd::kAvx512IsaId), max_isa_id);
+    EXPECT_EQ(simd::isa(), max_isa_id);
+    EXPECT_EQ(simd::set_isa(simd::kScalarIsaId), simd::kScalarIsaId);
+    EXPECT_STREQ(simd::isa_label(simd::kScalarIsaId), "scalar");
+    simd::set_isa(max_isa_id);
+}
+
 // The test function in cwVectOps is a placeholder in this context,
 // but we can call it for completeness.
 TEST(VectOpsTest, TestRunner) {